@@ -0,0 +1,431 @@
+// Copyright (C) 2024 Albin Johansson (GNU General Public License v3.0)
+
+#pragma once
+
+#include <algorithm>     // min, max
+#include <atomic>        // atomic, memory_order
+#include <cerrno>        // errno, EINTR, EEXIST
+#include <concepts>      // invocable
+#include <cstddef>       // size_t
+#include <cstdint>       // uint64_t
+#include <expected>      // expected
+#include <filesystem>    // path, rename, remove, status, permissions
+#include <format>        // format
+#include <ios>           // streamsize
+#include <ostream>       // ostream
+#include <streambuf>     // streambuf
+#include <system_error>  // error_code
+#include <utility>       // move, forward
+#include <vector>        // vector
+
+#include "tactile/base/debug/error_code.hpp"
+#include "tactile/base/io/byte_stream.hpp"
+#include "tactile/base/prelude.hpp"
+
+#if TACTILE_OS_WINDOWS
+  #include <fcntl.h>     // _O_WRONLY, _O_CREAT, _O_EXCL, _O_BINARY, _O_NOINHERIT
+  #include <io.h>        // _wsopen_s, _write, _commit, _close
+  #include <process.h>   // _getpid
+  #include <share.h>     // _SH_DENYNO
+  #include <sys/stat.h>  // _S_IREAD, _S_IWRITE
+#else
+  #include <fcntl.h>   // open, fcntl, O_WRONLY, O_CREAT, O_EXCL, O_CLOEXEC
+  #include <unistd.h>  // write, fsync, close, getpid
+#endif
+
+namespace tactile {
+
+/**
+ * The default size of the write buffers used by atomic file writes.
+ *
+ * \details
+ * This is considerably larger than the buffers used by file streams by default,
+ * which reduces the number of write calls, especially on network file systems.
+ */
+inline constexpr std::size_t kAtomicFileBufferSize = 256 * 1'024;
+
+/**
+ * Provides options for atomic file writes.
+ */
+struct AtomicWriteOptions final
+{
+  /** Whether the parent directory is synchronized after the file is replaced. */
+  bool sync_directory {true};
+};
+
+namespace atomic_file_detail {
+
+inline constexpr int kInvalidFile = -1;
+
+// The number of names that are tried before giving up on creating a temporary file.
+inline constexpr int kMaxTemporaryFileAttempts = 16;
+
+// Only used to make collisions unlikely, uniqueness is guaranteed by create_file.
+inline std::atomic<std::uint64_t> temporary_file_counter {0};
+
+[[nodiscard]]
+inline auto get_process_id() noexcept -> std::uint64_t
+{
+#if TACTILE_OS_WINDOWS
+  return static_cast<std::uint64_t>(_getpid());
+#else
+  return static_cast<std::uint64_t>(::getpid());
+#endif
+}
+
+[[nodiscard]]
+inline auto make_temporary_path(const std::filesystem::path& target_path)
+    -> std::filesystem::path
+{
+  const auto index = temporary_file_counter.fetch_add(1, std::memory_order_relaxed);
+
+  auto path = target_path;
+  path += std::format(".{}.{}.tmp", get_process_id(), index);
+
+  return path;
+}
+
+/**
+ * Creates a new file, failing with EEXIST if the file already exists.
+ */
+[[nodiscard]]
+inline auto create_file(const std::filesystem::path& path) noexcept -> int
+{
+#if TACTILE_OS_WINDOWS
+  int file {kInvalidFile};
+  errno = _wsopen_s(&file,
+                    path.c_str(),
+                    _O_WRONLY | _O_CREAT | _O_EXCL | _O_BINARY | _O_NOINHERIT,
+                    _SH_DENYNO,
+                    _S_IREAD | _S_IWRITE);
+  return file;
+#else
+  int file {};
+  do {
+    file = ::open(path.c_str(), O_WRONLY | O_CREAT | O_EXCL | O_CLOEXEC, 0666);
+  } while (file == kInvalidFile && errno == EINTR);
+  return file;
+#endif
+}
+
+[[nodiscard]]
+inline auto write_file(const int file, const char* data, std::size_t size) noexcept -> bool
+{
+  while (size > 0) {
+#if TACTILE_OS_WINDOWS
+    const auto chunk_size = std::min(size, std::size_t {1} << 30);
+    const auto written = _write(file, data, static_cast<unsigned>(chunk_size));
+#else
+    const auto written = ::write(file, data, size);
+    if (written < 0 && errno == EINTR) {
+      continue;
+    }
+#endif
+
+    if (written < 0) {
+      return false;
+    }
+
+    data += written;
+    size -= static_cast<std::size_t>(written);
+  }
+
+  return true;
+}
+
+[[nodiscard]]
+inline auto sync_file(const int file) noexcept -> bool
+{
+#if TACTILE_OS_WINDOWS
+  return _commit(file) == 0;
+#elif TACTILE_OS_APPLE
+  // A plain fsync doesn't flush the drive cache on macOS, but not all file systems
+  // support F_FULLFSYNC.
+  return fcntl(file, F_FULLFSYNC) != -1 || fsync(file) == 0;
+#else
+  return fsync(file) == 0;
+#endif
+}
+
+inline void close_file(const int file) noexcept
+{
+#if TACTILE_OS_WINDOWS
+  _close(file);
+#else
+  ::close(file);
+#endif
+}
+
+inline void sync_directory(const std::filesystem::path& dir) noexcept
+{
+#if TACTILE_OS_WINDOWS
+  // Directories can't be opened through the C runtime. NTFS journals renames anyway.
+  static_cast<void>(dir);
+#else
+  const auto file = ::open(dir.empty() ? "." : dir.c_str(), O_RDONLY | O_CLOEXEC);
+  if (file != kInvalidFile) {
+    fsync(file);
+    ::close(file);
+  }
+#endif
+}
+
+}  // namespace atomic_file_detail
+
+/**
+ * A stream buffer that atomically replaces a file once all content has been written.
+ *
+ * \details
+ * The content is written to a temporary file in the same directory as the target
+ * file, which is synchronized to disk and renamed to the target file when the
+ * buffer is committed. As a result, the target file is never observed in a
+ * partially written state, even if the editor crashes or the disk is full. The
+ * temporary file is removed if the buffer is destroyed without being committed.
+ *
+ * Each buffer creates a temporary file with a unique name, so several writers,
+ * possibly in different processes, may replace the same file concurrently. In
+ * that case, the target file features the content of the last committed buffer.
+ */
+class AtomicFileBuffer final : public std::streambuf
+{
+ public:
+  TACTILE_DELETE_COPY(AtomicFileBuffer);
+  TACTILE_DELETE_MOVE(AtomicFileBuffer);
+
+  /**
+   * Creates the temporary file for a target file.
+   *
+   * \param target_path The file path of the file to replace.
+   * \param buffer_size The size of the write buffer, in bytes.
+   */
+  explicit AtomicFileBuffer(std::filesystem::path target_path,
+                            const std::size_t buffer_size = kAtomicFileBufferSize)
+    : m_target_path {std::move(target_path)},
+      m_temporary_path {},
+      m_buffer(std::max(buffer_size, std::size_t {1}))
+  {
+    // Names may be taken by other writers, or by files left behind by crashed processes.
+    for (int attempt = 0; attempt < atomic_file_detail::kMaxTemporaryFileAttempts; ++attempt) {
+      m_temporary_path = atomic_file_detail::make_temporary_path(m_target_path);
+      m_file = atomic_file_detail::create_file(m_temporary_path);
+
+      if (is_open() || errno != EEXIST) {
+        break;
+      }
+    }
+
+    setp(m_buffer.data(), m_buffer.data() + m_buffer.size());
+  }
+
+  ~AtomicFileBuffer() noexcept override
+  {
+    discard();
+  }
+
+  /**
+   * Replaces the target file with the written content.
+   *
+   * \param options The write options to use.
+   *
+   * \return
+   * Nothing if the target file was replaced; an error code otherwise.
+   */
+  [[nodiscard]]
+  auto commit(const AtomicWriteOptions& options = {}) -> std::expected<void, ErrorCode>
+  {
+    if (!is_open()) {
+      return std::unexpected {ErrorCode::kBadFileStream};
+    }
+
+    std::error_code error_code {};
+
+    // Replacing a file shouldn't change who can access it.
+    const auto target_status = std::filesystem::status(m_target_path, error_code);
+    if (!error_code && std::filesystem::exists(target_status)) {
+      std::filesystem::permissions(m_temporary_path, target_status.permissions(), error_code);
+    }
+
+    const auto wrote_content = _flush_buffer() && atomic_file_detail::sync_file(m_file);
+
+    atomic_file_detail::close_file(m_file);
+    m_file = atomic_file_detail::kInvalidFile;
+
+    if (wrote_content) {
+      std::filesystem::rename(m_temporary_path, m_target_path, error_code);
+    }
+
+    if (!wrote_content || error_code) {
+      std::filesystem::remove(m_temporary_path, error_code);
+      return std::unexpected {ErrorCode::kWriteError};
+    }
+
+    // The file has already been replaced, so failures here are ignored, which
+    // happens with file systems that don't support synchronizing directories.
+    if (options.sync_directory) {
+      atomic_file_detail::sync_directory(m_target_path.parent_path());
+    }
+
+    return {};
+  }
+
+  /**
+   * Removes the temporary file, leaving the target file unchanged.
+   */
+  void discard() noexcept
+  {
+    if (is_open()) {
+      atomic_file_detail::close_file(m_file);
+      m_file = atomic_file_detail::kInvalidFile;
+
+      std::error_code error_code {};
+      std::filesystem::remove(m_temporary_path, error_code);
+    }
+  }
+
+  /**
+   * Returns the path of the temporary file that the content is written to.
+   *
+   * \return
+   * A file path in the same directory as the target file.
+   */
+  [[nodiscard]]
+  auto get_temporary_path() const noexcept -> const std::filesystem::path&
+  {
+    return m_temporary_path;
+  }
+
+  /**
+   * Indicates whether the temporary file is open.
+   *
+   * \return
+   * True if content can be written; false otherwise.
+   */
+  [[nodiscard]]
+  auto is_open() const noexcept -> bool
+  {
+    return m_file != atomic_file_detail::kInvalidFile;
+  }
+
+ protected:
+  auto overflow(const int_type ch) -> int_type override
+  {
+    if (!_flush_buffer()) {
+      return traits_type::eof();
+    }
+
+    if (!traits_type::eq_int_type(ch, traits_type::eof())) {
+      *pptr() = traits_type::to_char_type(ch);
+      pbump(1);
+    }
+
+    return traits_type::not_eof(ch);
+  }
+
+  auto xsputn(const char_type* data, const std::streamsize count) -> std::streamsize override
+  {
+    // Large blocks bypass the buffer instead of being copied in pieces.
+    if (static_cast<std::size_t>(count) < m_buffer.size()) {
+      return std::streambuf::xsputn(data, count);
+    }
+
+    if (!_flush_buffer() ||
+        !atomic_file_detail::write_file(m_file, data, static_cast<std::size_t>(count))) {
+      m_failed = true;
+      return 0;
+    }
+
+    return count;
+  }
+
+  auto sync() -> int override
+  {
+    return _flush_buffer() ? 0 : -1;
+  }
+
+ private:
+  std::filesystem::path m_target_path;
+  std::filesystem::path m_temporary_path;
+  std::vector<char> m_buffer;
+  int m_file {atomic_file_detail::kInvalidFile};
+  bool m_failed {false};
+
+  [[nodiscard]]
+  auto _flush_buffer() -> bool
+  {
+    if (!is_open() || m_failed) {
+      return false;
+    }
+
+    const auto size = static_cast<std::size_t>(pptr() - pbase());
+    if (size > 0 && !atomic_file_detail::write_file(m_file, pbase(), size)) {
+      m_failed = true;
+      return false;
+    }
+
+    setp(m_buffer.data(), m_buffer.data() + m_buffer.size());
+    return true;
+  }
+};
+
+/**
+ * Atomically replaces a file with content written to an output stream.
+ *
+ * \details
+ * The target file is left unchanged if any errors occur, including exceptions
+ * thrown by the writer function.
+ *
+ * \param path    The file path of the file to replace.
+ * \param write   A function that writes the file content to a provided stream.
+ * \param options The write options to use.
+ *
+ * \return
+ * Nothing if the file was replaced; an error code otherwise.
+ */
+template <std::invocable<std::ostream&> T>
+[[nodiscard]]
+auto write_file_atomically(const std::filesystem::path& path,
+                           T&& write,
+                           const AtomicWriteOptions& options = {})
+    -> std::expected<void, ErrorCode>
+{
+  AtomicFileBuffer buffer {path};
+  if (!buffer.is_open()) {
+    return std::unexpected {ErrorCode::kBadFileStream};
+  }
+
+  std::ostream stream {&buffer};
+  std::forward<T>(write)(stream);
+
+  if (!stream.good()) {
+    return std::unexpected {ErrorCode::kWriteError};
+  }
+
+  return buffer.commit(options);
+}
+
+/**
+ * Atomically replaces a file with a sequence of bytes.
+ *
+ * \param path    The file path of the file to replace.
+ * \param bytes   The new file content.
+ * \param options The write options to use.
+ *
+ * \return
+ * Nothing if the file was replaced; an error code otherwise.
+ */
+[[nodiscard]]
+inline auto write_file_atomically(const std::filesystem::path& path,
+                                  const ByteSpan bytes,
+                                  const AtomicWriteOptions& options = {})
+    -> std::expected<void, ErrorCode>
+{
+  return write_file_atomically(
+      path,
+      [bytes](std::ostream& stream) {
+        stream.write(reinterpret_cast<const char*>(bytes.data()),
+                     static_cast<std::streamsize>(bytes.size()));
+      },
+      options);
+}
+
+}  // namespace tactile
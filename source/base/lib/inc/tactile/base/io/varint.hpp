@@ -0,0 +1,103 @@
+// Copyright (C) 2024 Albin Johansson (GNU General Public License v3.0)
+
+#pragma once
+
+#include <cstddef>   // size_t
+#include <cstdint>   // uint8_t, int64_t, uint64_t
+#include <optional>  // optional, nullopt
+
+#include "tactile/base/io/byte_stream.hpp"
+#include "tactile/base/prelude.hpp"
+
+namespace tactile {
+
+/**
+ * Appends an unsigned integer to a byte stream, using a variable length encoding.
+ *
+ * \details
+ * Integers are stored in groups of seven bits, least significant group first,
+ * where the highest bit of each byte indicates whether more bytes follow. Small
+ * values therefore only require a single byte.
+ *
+ * \param stream The output byte stream.
+ * \param value  The value to write.
+ */
+inline void write_varint(ByteStream& stream, std::uint64_t value)
+{
+  while (value >= 0x80) {
+    stream.push_back(static_cast<std::uint8_t>(value | 0x80));
+    value >>= 7;
+  }
+
+  stream.push_back(static_cast<std::uint8_t>(value));
+}
+
+/**
+ * Appends a signed integer to a byte stream, using a variable length encoding.
+ *
+ * \details
+ * Signed integers are "zigzag" encoded, so that small negative values are as
+ * compact as small positive values.
+ *
+ * \param stream The output byte stream.
+ * \param value  The value to write.
+ */
+inline void write_signed_varint(ByteStream& stream, const std::int64_t value)
+{
+  const auto bits = static_cast<std::uint64_t>(value);
+  write_varint(stream, (bits << 1) ^ (value < 0 ? ~std::uint64_t {0} : std::uint64_t {0}));
+}
+
+/**
+ * Reads an unsigned integer written by \c write_varint.
+ *
+ * \param[in]     bytes  The input bytes.
+ * \param[in,out] offset The offset of the first byte, which is advanced past the value.
+ *
+ * \return
+ * The read value if successful; an empty optional otherwise.
+ */
+[[nodiscard]]
+inline auto read_varint(const ByteSpan bytes, std::size_t& offset)
+    -> std::optional<std::uint64_t>
+{
+  std::uint64_t value {0};
+
+  for (std::size_t shift = 0; shift < 64; shift += 7) {
+    if (offset >= bytes.size()) {
+      return std::nullopt;
+    }
+
+    const auto byte = bytes[offset++];
+    value |= static_cast<std::uint64_t>(byte & 0x7F) << shift;
+
+    if ((byte & 0x80) == 0) {
+      return value;
+    }
+  }
+
+  return std::nullopt;
+}
+
+/**
+ * Reads a signed integer written by \c write_signed_varint.
+ *
+ * \param[in]     bytes  The input bytes.
+ * \param[in,out] offset The offset of the first byte, which is advanced past the value.
+ *
+ * \return
+ * The read value if successful; an empty optional otherwise.
+ */
+[[nodiscard]]
+inline auto read_signed_varint(const ByteSpan bytes, std::size_t& offset)
+    -> std::optional<std::int64_t>
+{
+  const auto bits = read_varint(bytes, offset);
+  if (!bits.has_value()) {
+    return std::nullopt;
+  }
+
+  return static_cast<std::int64_t>((*bits >> 1) ^ (~(*bits & 1) + 1));
+}
+
+}  // namespace tactile
@@ -0,0 +1,240 @@
+// Copyright (C) 2024 Albin Johansson (GNU General Public License v3.0)
+
+#pragma once
+
+#include <cstddef>       // size_t
+#include <cstdint>       // int32_t, uint8_t, uint32_t, uint64_t
+#include <cstring>       // memcpy
+#include <filesystem>    // path, absolute, create_directories
+#include <format>        // format
+#include <ios>           // streamsize
+#include <optional>      // optional, nullopt
+#include <ostream>       // ostream
+#include <span>          // span
+#include <string>        // string
+#include <string_view>   // string_view
+#include <system_error>  // error_code
+
+#include "tactile/base/io/atomic_file.hpp"
+#include "tactile/base/prelude.hpp"
+#include "tactile/base/render/image_data.hpp"
+#include "tactile/base/util/hash.hpp"
+
+namespace tactile {
+
+/**
+ * Identifies the version of a source image that a cached image was created from.
+ */
+struct ImageCacheKey final
+{
+  /** The size of the source image file, in bytes. */
+  std::uint64_t file_size;
+
+  /** A hash of the content of the source image file. */
+  std::uint64_t content_hash;
+
+  [[nodiscard]]
+  auto operator==(const ImageCacheKey&) const -> bool = default;
+};
+
+/**
+ * Creates the cache key for an image file.
+ *
+ * \param file_content The raw content of the source image file.
+ *
+ * \return
+ * A cache key.
+ */
+[[nodiscard]]
+inline auto make_image_cache_key(const std::string_view file_content) -> ImageCacheKey
+{
+  const auto content_hash = hash_combine(file_content, file_content.size());
+
+  return ImageCacheKey {
+    .file_size = static_cast<std::uint64_t>(file_content.size()),
+    .content_hash = static_cast<std::uint64_t>(content_hash),
+  };
+}
+
+/**
+ * Returns the path of the cache file used for a variant of an image.
+ *
+ * \details
+ * Cache files are stored in a dedicated cache directory, e.g., in the
+ * persistent storage directory of the editor, rather than next to the source
+ * images. Cache files are named after a hash of the absolute source image path,
+ * so that different images with the same file name don't collide.
+ *
+ * \param cache_dir  The directory that contains the cached images.
+ * \param image_path The path to the source image file.
+ * \param variant    A short tag that identifies how the image was processed.
+ *
+ * \return
+ * A cache file path.
+ */
+[[nodiscard]]
+inline auto get_image_cache_path(const std::filesystem::path& cache_dir,
+                                 const std::filesystem::path& image_path,
+                                 const std::string_view variant) -> std::filesystem::path
+{
+  std::error_code error_code {};
+  auto absolute_path = std::filesystem::absolute(image_path, error_code);
+  if (error_code) {
+    absolute_path = image_path;
+  }
+
+  const auto path_hash = hash_combine(absolute_path.lexically_normal().generic_string());
+
+  return cache_dir / std::format("{}-{:016x}.{}",
+                                 image_path.filename().string(),
+                                 static_cast<std::uint64_t>(path_hash),
+                                 variant);
+}
+
+namespace image_cache_detail {
+
+inline constexpr std::uint32_t kMagic = 0x474D4954;  // "TIMG"
+inline constexpr std::uint32_t kVersion = 2;
+
+struct Header final
+{
+  std::uint32_t magic;
+  std::uint32_t version;
+  std::uint64_t file_size;
+  std::uint64_t content_hash;
+  std::int32_t width;
+  std::int32_t height;
+  std::uint32_t format;
+  std::uint32_t mip_count;
+  std::uint64_t byte_count;
+};
+
+// Returns an image with the properties described by a header, but without any pixels.
+[[nodiscard]]
+inline auto validate_header(const Header& header, const ImageCacheKey& key)
+    -> std::optional<ImageData>
+{
+  if (header.magic != kMagic ||                  //
+      header.version != kVersion ||              //
+      header.file_size != key.file_size ||       //
+      header.content_hash != key.content_hash) {
+    return std::nullopt;
+  }
+
+  const auto max_format = static_cast<std::uint32_t>(ImageFormat::kBC3);
+  if (header.width <= 0 || header.height <= 0 || header.format > max_format ||
+      header.mip_count == 0 || header.mip_count > 32) {
+    return std::nullopt;
+  }
+
+  ImageData image {};
+  image.size = TextureSize {header.width, header.height};
+  image.format = static_cast<ImageFormat>(header.format);
+  image.mip_count = header.mip_count;
+
+  // Guards against corrupt files, since the byte count determines the allocation size.
+  std::size_t expected_byte_count {0};
+  for (std::uint32_t level = 0; level < image.mip_count; ++level) {
+    expected_byte_count +=
+        get_image_byte_size(image.format, get_mip_level_size(image.size, level));
+  }
+
+  if (header.byte_count != expected_byte_count) {
+    return std::nullopt;
+  }
+
+  return image;
+}
+
+}  // namespace image_cache_detail
+
+/**
+ * Attempts to read a cached image from the content of a cache file.
+ *
+ * \details
+ * This function is intended to be used with memory mapped cache files, in
+ * which case the pixel data is copied directly from the mapped pages.
+ *
+ * \param bytes The content of the cache file.
+ * \param key   The expected cache key of the source image.
+ *
+ * \return
+ * The cached image if the content is valid and up-to-date; an empty optional
+ * otherwise.
+ */
+[[nodiscard]]
+inline auto read_cached_image(const std::span<const std::uint8_t> bytes,
+                              const ImageCacheKey& key) -> std::optional<ImageData>
+{
+  using image_cache_detail::Header;
+
+  if (bytes.size() < sizeof(Header)) {
+    return std::nullopt;
+  }
+
+  Header header {};
+  std::memcpy(&header, bytes.data(), sizeof header);
+
+  auto image = image_cache_detail::validate_header(header, key);
+  if (!image.has_value()) {
+    return std::nullopt;
+  }
+
+  const auto pixel_bytes = bytes.subspan(sizeof header);
+  if (pixel_bytes.size() != header.byte_count) {
+    return std::nullopt;
+  }
+
+  image->pixels.assign(pixel_bytes.begin(), pixel_bytes.end());
+  return image;
+}
+
+/**
+ * Attempts to store an image in a cache file.
+ *
+ * \param cache_path The path to the cache file, parent directories are created.
+ * \param key        The cache key of the source image.
+ * \param image      The image to store.
+ *
+ * \return
+ * True if the image was stored; false otherwise.
+ */
+inline auto save_cached_image(const std::filesystem::path& cache_path,
+                              const ImageCacheKey& key,
+                              const ImageData& image) -> bool
+{
+  using image_cache_detail::Header;
+
+  std::error_code error_code {};
+  std::filesystem::create_directories(cache_path.parent_path(), error_code);
+  if (error_code) {
+    return false;
+  }
+
+  const Header header {
+    .magic = image_cache_detail::kMagic,
+    .version = image_cache_detail::kVersion,
+    .file_size = key.file_size,
+    .content_hash = key.content_hash,
+    .width = image.size.width,
+    .height = image.size.height,
+    .format = static_cast<std::uint32_t>(image.format),
+    .mip_count = image.mip_count,
+    .byte_count = static_cast<std::uint64_t>(image.pixels.size()),
+  };
+
+  // Other threads or editor instances may have the cache file mapped into memory,
+  // and truncating a mapped file can crash them, so the file is replaced instead.
+  const auto write_result = write_file_atomically(
+      cache_path,
+      [&](std::ostream& stream) {
+        stream.write(reinterpret_cast<const char*>(&header), sizeof header);
+        stream.write(reinterpret_cast<const char*>(image.pixels.data()),
+                     static_cast<std::streamsize>(image.pixels.size()));
+      },
+      AtomicWriteOptions {.sync_directory = false});
+
+  return write_result.has_value();
+}
+
+}  // namespace tactile
@@ -0,0 +1,84 @@
+// Copyright (C) 2024 Albin Johansson (GNU General Public License v3.0)
+
+#pragma once
+
+#include <algorithm>  // max
+#include <cstddef>    // size_t
+#include <cstdint>    // uint8_t, uint32_t
+#include <vector>     // vector
+
+#include "tactile/base/prelude.hpp"
+#include "tactile/base/render/texture.hpp"
+
+namespace tactile {
+
+/**
+ * Represents the supported pixel formats of decoded images.
+ */
+enum class ImageFormat : std::uint8_t
+{
+  /** Four 8-bit channels per pixel. */
+  kRGBA8,
+
+  /** BC3 (also known as DXT5) block compression, 16 bytes per 4x4 block. */
+  kBC3,
+};
+
+/**
+ * Represents a decoded image that hasn't been uploaded to the GPU.
+ */
+struct ImageData final
+{
+  /** The size of the image, i.e., the size of the first mip level. */
+  TextureSize size;
+
+  /** The image data of each mip level, stored back to back, starting with level 0. */
+  std::vector<std::uint8_t> pixels;
+
+  /** The format of the image data. */
+  ImageFormat format {ImageFormat::kRGBA8};
+
+  /** The number of mip levels stored in the image data, always at least one. */
+  std::uint32_t mip_count {1};
+};
+
+/**
+ * Returns the size of a mip level of an image.
+ *
+ * \param size  The size of the first mip level.
+ * \param level The mip level index.
+ *
+ * \return
+ * The size of the mip level, which is always at least 1x1.
+ */
+[[nodiscard]]
+constexpr auto get_mip_level_size(const TextureSize& size, const std::uint32_t level)
+    -> TextureSize
+{
+  return TextureSize {std::max(size.width >> level, 1), std::max(size.height >> level, 1)};
+}
+
+/**
+ * Returns the number of bytes used by a single mip level of an image.
+ *
+ * \param format The image format.
+ * \param size   The size of the mip level.
+ *
+ * \return
+ * A number of bytes.
+ */
+[[nodiscard]]
+constexpr auto get_image_byte_size(const ImageFormat format, const TextureSize& size)
+    -> std::size_t
+{
+  const auto width = static_cast<std::size_t>(size.width);
+  const auto height = static_cast<std::size_t>(size.height);
+
+  switch (format) {
+    case ImageFormat::kBC3: return ((width + 3) / 4) * ((height + 3) / 4) * 16;
+    case ImageFormat::kRGBA8:
+    default:                return width * height * 4;
+  }
+}
+
+}  // namespace tactile
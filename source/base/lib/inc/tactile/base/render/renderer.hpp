@@ -2,12 +2,14 @@
 
 #pragma once
 
-#include <expected>    // expected
-#include <filesystem>  // path
+#include <expected>     // expected
+#include <filesystem>   // path
+#include <string_view>  // string_view
 
 #include "tactile/base/debug/error_code.hpp"
 #include "tactile/base/id.hpp"
 #include "tactile/base/prelude.hpp"
+#include "tactile/base/render/image_data.hpp"
 #include "tactile/base/render/renderer_options.hpp"
 
 struct ImGuiContext;
@@ -45,6 +47,10 @@ class IRenderer
   /**
    * Tries to load a texture from disk.
    *
+   * \details
+   * This is equivalent to decoding the image using \c decode_image, and then
+   * uploading it using \c upload_texture.
+   *
    * \param image_path The path to the image.
    *
    * \return
@@ -54,6 +60,53 @@ class IRenderer
   virtual auto load_texture(const std::filesystem::path& image_path)
       -> std::expected<TextureID, ErrorCode> = 0;
 
+  /**
+   * Tries to decode an image on disk, without creating a texture.
+   *
+   * \note
+   * This function is thread-safe, and is intended to be called from worker
+   * threads, so that only the texture upload has to happen on the render thread.
+   *
+   * \param image_path The path to the image.
+   *
+   * \return
+   * The decoded image if successful; an error code otherwise.
+   */
+  [[nodiscard]]
+  virtual auto decode_image(const std::filesystem::path& image_path) const
+      -> std::expected<ImageData, ErrorCode> = 0;
+
+  /**
+   * Returns a tag that identifies the kind of images produced by \c decode_image.
+   *
+   * \details
+   * Decoded images may be cached on disk, in which case the tag is used to
+   * distinguish between images decoded with different settings, e.g., with or
+   * without block compression.
+   *
+   * \return
+   * A short tag that can be used in file names, or an empty string if decoded
+   * images shouldn't be cached.
+   */
+  [[nodiscard]]
+  virtual auto get_image_cache_tag() const -> std::string_view = 0;
+
+  /**
+   * Tries to create a texture from a previously decoded image.
+   *
+   * \note
+   * This function must be called from the render thread.
+   *
+   * \param image_path The path to the image file the image was decoded from.
+   * \param image      The decoded image.
+   *
+   * \return
+   * The identifier assigned to the loaded texture.
+   */
+  [[nodiscard]]
+  virtual auto upload_texture(const std::filesystem::path& image_path, const ImageData& image)
+      -> std::expected<TextureID, ErrorCode> = 0;
+
   /**
    * Unloads a previously loaded texture.
    *
@@ -29,6 +29,9 @@ struct RendererOptions final
   /** Try to limit the frame rate to the monitor refresh rate. */
   bool limit_fps;
 
+  /** Store textures using lossy GPU block compression, cached on disk (OpenGL only). */
+  bool use_texture_compression;
+
   /** Load validation layers (Vulkan only). */
   bool vulkan_validation;
 };
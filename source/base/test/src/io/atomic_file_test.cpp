@@ -0,0 +1,174 @@
+// Copyright (C) 2024 Albin Johansson (GNU General Public License v3.0)
+
+#include "tactile/base/io/atomic_file.hpp"
+
+#include <filesystem>  // path, temp_directory_path, create_directories, exists, remove_all
+#include <fstream>     // ofstream
+#include <iterator>    // distance
+#include <ostream>     // ostream
+#include <stdexcept>   // runtime_error
+#include <string>      // string, to_string
+
+#include <gtest/gtest.h>
+
+#include "tactile/base/io/file_io.hpp"
+
+namespace tactile {
+
+class AtomicFileTest : public testing::Test
+{
+ protected:
+  void SetUp() override
+  {
+    std::filesystem::remove_all(mDir);
+    std::filesystem::create_directories(mDir);
+  }
+
+  void TearDown() override
+  {
+    std::filesystem::remove_all(mDir);
+  }
+
+  std::filesystem::path mDir {std::filesystem::temp_directory_path() / "tactile_atomic_file"};
+  std::filesystem::path mFilePath {mDir / "file.txt"};
+
+  [[nodiscard]]
+  auto count_files() const -> std::ptrdiff_t
+  {
+    return std::distance(std::filesystem::directory_iterator {mDir},
+                         std::filesystem::directory_iterator {});
+  }
+};
+
+// tactile::write_file_atomically
+TEST_F(AtomicFileTest, WriteNewFile)
+{
+  const auto result =
+      write_file_atomically(mFilePath, [](std::ostream& stream) { stream << "abc" << 123; });
+
+  ASSERT_TRUE(result.has_value());
+  EXPECT_EQ(read_binary_file(mFilePath), "abc123");
+  EXPECT_EQ(count_files(), 1);
+}
+
+// tactile::write_file_atomically
+TEST_F(AtomicFileTest, ReplaceFile)
+{
+  std::ofstream {mFilePath} << "old content";
+
+  const std::string content = "new";
+  ASSERT_TRUE(write_file_atomically(mFilePath, make_byte_span(content)).has_value());
+
+  EXPECT_EQ(read_binary_file(mFilePath), content);
+  EXPECT_EQ(count_files(), 1);
+}
+
+// tactile::write_file_atomically
+TEST_F(AtomicFileTest, WriteLargeFile)
+{
+  std::string content {};
+  for (std::size_t index = 0; content.size() < 3 * kAtomicFileBufferSize; ++index) {
+    content += std::to_string(index);
+  }
+
+  const auto result = write_file_atomically(mFilePath, [&](std::ostream& stream) {
+    stream << content.substr(0, 10);
+    stream.write(content.data() + 10, static_cast<std::streamsize>(content.size() - 10));
+  });
+
+  ASSERT_TRUE(result.has_value());
+  EXPECT_EQ(read_binary_file(mFilePath), content);
+}
+
+// tactile::write_file_atomically
+TEST_F(AtomicFileTest, WriterError)
+{
+  std::ofstream {mFilePath} << "old content";
+
+  const auto writer = [](std::ostream& stream) {
+    stream << "partial content";
+    throw std::runtime_error {"error"};
+  };
+
+  EXPECT_THROW((void) write_file_atomically(mFilePath, writer), std::runtime_error);
+
+  EXPECT_EQ(read_binary_file(mFilePath), "old content");
+  EXPECT_EQ(count_files(), 1);
+}
+
+// tactile::write_file_atomically
+TEST_F(AtomicFileTest, BadDirectory)
+{
+  const auto result = write_file_atomically(mDir / "missing" / "file.txt",
+                                            [](std::ostream& stream) { stream << "abc"; });
+
+  ASSERT_FALSE(result.has_value());
+  EXPECT_EQ(result.error(), ErrorCode::kBadFileStream);
+}
+
+// tactile::AtomicFileBuffer::discard
+TEST_F(AtomicFileTest, Discard)
+{
+  AtomicFileBuffer buffer {mFilePath};
+  ASSERT_TRUE(buffer.is_open());
+  EXPECT_TRUE(std::filesystem::exists(buffer.get_temporary_path()));
+
+  std::ostream stream {&buffer};
+  stream << "abc";
+
+  buffer.discard();
+  EXPECT_FALSE(buffer.is_open());
+  EXPECT_EQ(count_files(), 0);
+
+  EXPECT_EQ(buffer.commit(), std::unexpected {ErrorCode::kBadFileStream});
+}
+
+// tactile::AtomicFileBuffer::commit
+TEST_F(AtomicFileTest, ConcurrentWriters)
+{
+  AtomicFileBuffer first_buffer {mFilePath};
+  AtomicFileBuffer second_buffer {mFilePath};
+  ASSERT_TRUE(first_buffer.is_open());
+  ASSERT_TRUE(second_buffer.is_open());
+  EXPECT_NE(first_buffer.get_temporary_path(), second_buffer.get_temporary_path());
+
+  std::ostream first_stream {&first_buffer};
+  std::ostream second_stream {&second_buffer};
+  first_stream << "first";
+  second_stream << "second";
+
+  ASSERT_TRUE(second_buffer.commit().has_value());
+  EXPECT_EQ(read_binary_file(mFilePath), "second");
+
+  ASSERT_TRUE(first_buffer.commit().has_value());
+  EXPECT_EQ(read_binary_file(mFilePath), "first");
+  EXPECT_EQ(count_files(), 1);
+}
+
+// tactile::AtomicFileBuffer::AtomicFileBuffer
+TEST_F(AtomicFileTest, TemporaryFileCollision)
+{
+  AtomicFileBuffer first_buffer {mFilePath};
+  ASSERT_TRUE(first_buffer.is_open());
+
+  // Occupies the next few temporary file names, as if left behind by a crashed process.
+  const auto temporary_name = first_buffer.get_temporary_path().filename().string();
+  const auto counter_pos = temporary_name.rfind('.', temporary_name.size() - 5) + 1;
+  const auto counter = std::stoull(temporary_name.substr(counter_pos));
+
+  for (auto index = counter + 1; index < counter + 4; ++index) {
+    auto name = temporary_name.substr(0, counter_pos) + std::to_string(index) + ".tmp";
+    std::ofstream {mDir / name} << "stale";
+  }
+
+  AtomicFileBuffer second_buffer {mFilePath};
+  ASSERT_TRUE(second_buffer.is_open());
+
+  std::ostream stream {&second_buffer};
+  stream << "abc";
+
+  ASSERT_TRUE(second_buffer.commit().has_value());
+  EXPECT_EQ(read_binary_file(mFilePath), "abc");
+}
+
+}  // namespace tactile
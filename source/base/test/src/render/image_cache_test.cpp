@@ -0,0 +1,101 @@
+// Copyright (C) 2024 Albin Johansson (GNU General Public License v3.0)
+
+#include "tactile/base/render/image_cache.hpp"
+
+#include <cstdint>     // uint8_t
+#include <filesystem>  // path, temp_directory_path, remove_all, exists, directory_iterator
+#include <iterator>    // distance
+#include <span>        // span
+#include <vector>      // vector
+
+#include <gtest/gtest.h>
+
+#include "tactile/base/io/file_io.hpp"
+
+namespace tactile {
+
+class ImageCacheTest : public testing::Test
+{
+ protected:
+  void TearDown() override
+  {
+    std::filesystem::remove_all(mDir);
+  }
+
+  std::filesystem::path mDir {std::filesystem::temp_directory_path() / "tactile_image_cache"};
+  std::filesystem::path mImagePath {mDir / "image.png"};
+  std::filesystem::path mCacheDir {mDir / "cache"};
+};
+
+// tactile::make_image_cache_key
+TEST_F(ImageCacheTest, MakeImageCacheKey)
+{
+  const auto key1 = make_image_cache_key("abc");
+  const auto key2 = make_image_cache_key("abc");
+  const auto key3 = make_image_cache_key("abd");
+
+  EXPECT_EQ(key1.file_size, 3);
+  EXPECT_EQ(key1, key2);
+  EXPECT_NE(key1, key3);
+}
+
+// tactile::get_image_cache_path
+TEST_F(ImageCacheTest, GetImageCachePath)
+{
+  const auto cache_path = get_image_cache_path(mCacheDir, mImagePath, "bc3");
+  EXPECT_EQ(cache_path.parent_path(), mCacheDir);
+  EXPECT_TRUE(cache_path.filename().string().starts_with("image.png-"));
+  EXPECT_EQ(cache_path.extension(), ".bc3");
+
+  // Images with the same name in different directories use different cache files.
+  EXPECT_NE(get_image_cache_path(mCacheDir, mDir / "other" / "image.png", "bc3"),
+            cache_path);
+  EXPECT_EQ(get_image_cache_path(mCacheDir, mImagePath, "bc3"), cache_path);
+}
+
+// tactile::save_cached_image
+// tactile::read_cached_image
+TEST_F(ImageCacheTest, SaveAndReadCachedImage)
+{
+  const auto key = make_image_cache_key("not really an image");
+
+  ImageData image {};
+  image.size = TextureSize {2, 1};
+  image.pixels = {1, 2, 3, 4, 5, 6, 7, 8};
+
+  const auto cache_path = get_image_cache_path(mCacheDir, mImagePath, "rgba8");
+  ASSERT_TRUE(save_cached_image(cache_path, key, image));
+
+  // No temporary files are left behind.
+  const std::filesystem::directory_iterator cache_files {cache_path.parent_path()};
+  EXPECT_EQ(std::distance(cache_files, std::filesystem::directory_iterator {}), 1);
+
+  const auto content = read_binary_file(cache_path);
+  ASSERT_TRUE(content.has_value());
+
+  const std::vector<std::uint8_t> bytes {content->begin(), content->end()};
+
+  const auto cached_image = read_cached_image(bytes, key);
+  ASSERT_TRUE(cached_image.has_value());
+  EXPECT_EQ(cached_image->size.width, 2);
+  EXPECT_EQ(cached_image->size.height, 1);
+  EXPECT_EQ(cached_image->format, ImageFormat::kRGBA8);
+  EXPECT_EQ(cached_image->mip_count, 1);
+  EXPECT_EQ(cached_image->pixels, image.pixels);
+
+  // Cached images are discarded when the source image changes.
+  EXPECT_FALSE(read_cached_image(bytes, make_image_cache_key("something else")).has_value());
+
+  // Truncated cache files are rejected.
+  const std::span truncated_bytes {bytes.data(), bytes.size() - 1};
+  EXPECT_FALSE(read_cached_image(truncated_bytes, key).has_value());
+}
+
+// tactile::read_cached_image
+TEST_F(ImageCacheTest, ReadEmptyCachedImage)
+{
+  const auto key = make_image_cache_key("");
+  EXPECT_FALSE(read_cached_image({}, key).has_value());
+}
+
+}  // namespace tactile
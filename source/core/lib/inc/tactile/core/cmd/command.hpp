@@ -2,10 +2,14 @@
 
 #pragma once
 
+#include <cstddef>  // size_t
+
 #include "tactile/base/prelude.hpp"
 
 namespace tactile::core {
 
+struct CommandJournalRecord;
+
 /**
  * Represents editor actions that can be repeatedly executed and reverted.
  */
@@ -57,6 +61,73 @@ class ICommand
   {
     return false;
   }
+
+  /**
+   * Returns an estimate of the amount of memory that is kept alive by the command.
+   *
+   * \details
+   * This is used to limit the memory usage of command histories. Commands
+   * should account for any data they own or keep alive, e.g. snapshots or
+   * removed entities, but not the size of the command object itself. The
+   * estimate may change when the command is executed or reverted.
+   *
+   * \return
+   * An estimated memory usage, in bytes.
+   */
+  [[nodiscard]]
+  virtual auto get_memory_usage() const -> std::size_t
+  {
+    return 0;
+  }
+
+  /**
+   * Describes the changes made by the command, for use in persistent command journals.
+   *
+   * \details
+   * This is only called for commands that have been executed. Commands that
+   * cannot be described by a journal record should keep the default
+   * implementation, which prevents the command and any older commands from being
+   * journaled.
+   *
+   * \param[out] record The journal record that will be written to.
+   *
+   * \return
+   * True if the record was written; false otherwise.
+   */
+  [[nodiscard]]
+  virtual auto write_journal_record([[maybe_unused]] CommandJournalRecord& record) const
+      -> bool
+  {
+    return false;
+  }
+};
+
+/**
+ * Interface for objects that track the commands executed in a command stack.
+ */
+class ICommandObserver
+{
+ public:
+  TACTILE_INTERFACE_CLASS(ICommandObserver);
+
+  /**
+   * Called after a command has been executed, either when added to the stack
+   * or when it is redone.
+   *
+   * \details
+   * Commands that are merged into the top of the stack are reported before the
+   * merge, so the observed command only describes the most recent changes.
+   *
+   * \param command The executed command.
+   */
+  virtual void on_command_executed(const ICommand& command) = 0;
+
+  /**
+   * Called after a command has been reverted.
+   *
+   * \param command The reverted command.
+   */
+  virtual void on_command_reverted(const ICommand& command) = 0;
 };
 
 }  // namespace tactile::core
@@ -0,0 +1,215 @@
+// Copyright (C) 2024 Albin Johansson (GNU General Public License v3.0)
+
+#pragma once
+
+#include <cstddef>     // size_t
+#include <cstdint>     // int64_t, uint64_t
+#include <expected>    // expected
+#include <filesystem>  // path
+#include <optional>    // optional
+#include <span>        // span
+#include <vector>      // vector
+
+#include "tactile/base/debug/error_code.hpp"
+#include "tactile/base/id.hpp"
+#include "tactile/base/io/byte_stream.hpp"
+#include "tactile/base/prelude.hpp"
+#include "tactile/core/layer/tile_diff.hpp"
+
+namespace tactile::core {
+
+class MapDocument;
+class CommandStack;
+
+/**
+ * Describes the changes made by a command in a persistent command journal.
+ */
+struct CommandJournalRecord final
+{
+  /** The persistent identifier of the affected tile layer. */
+  LayerID layer_id;
+
+  /** The tile changes made by the command. */
+  TileDiff diff;
+};
+
+/**
+ * Identifies the version of a saved map file that a command journal belongs to.
+ */
+struct CommandJournalKey final
+{
+  /** The size of the map file, in bytes. */
+  std::uint64_t file_size;
+
+  /** The last modification time of the map file, in file clock ticks. */
+  std::int64_t write_time;
+
+  [[nodiscard]]
+  auto operator==(const CommandJournalKey&) const -> bool = default;
+};
+
+/**
+ * Appends the binary representation of a journal record to a byte stream.
+ *
+ * \details
+ * Tile changes are stored as runs of variable length integers, so typical
+ * records only require a few bytes per run.
+ *
+ * \param record The record to encode.
+ * \param stream The output byte stream.
+ */
+void encode_command_journal_record(const CommandJournalRecord& record, ByteStream& stream);
+
+/**
+ * Decodes a journal record written by \c encode_command_journal_record.
+ *
+ * \param[in]     bytes  The input bytes.
+ * \param[in,out] offset The offset of the record, which is advanced past the record.
+ *
+ * \return
+ * The decoded record if successful; an empty optional otherwise.
+ */
+[[nodiscard]]
+auto decode_command_journal_record(ByteSpan bytes, std::size_t& offset)
+    -> std::optional<CommandJournalRecord>;
+
+/**
+ * Creates the command journal key for a map file.
+ *
+ * \param map_path The path to the map file.
+ *
+ * \return
+ * A journal key if successful; an error code otherwise.
+ */
+[[nodiscard]]
+auto make_command_journal_key(const std::filesystem::path& map_path)
+    -> std::expected<CommandJournalKey, ErrorCode>;
+
+/**
+ * Returns the path of the command journal file associated with a map file.
+ *
+ * \details
+ * Command journals are stored in the persistent storage directory, named after
+ * a hash of the absolute map file path.
+ *
+ * \param map_path The path to the map file.
+ *
+ * \return
+ * A journal file path if successful; an error code otherwise.
+ */
+[[nodiscard]]
+auto get_command_journal_path(const std::filesystem::path& map_path)
+    -> std::expected<std::filesystem::path, ErrorCode>;
+
+/**
+ * Writes a command journal file.
+ *
+ * \details
+ * The oldest records are dropped if the journal would otherwise exceed the
+ * byte budget.
+ *
+ * \param journal_path The path of the journal file, parent directories are created.
+ * \param key          The key of the associated map file.
+ * \param records      The records to store, oldest first.
+ * \param byte_budget  The maximum size of the journal, in bytes.
+ *
+ * \return
+ * The number of stored records if successful; an error code otherwise.
+ */
+[[nodiscard]]
+auto write_command_journal(const std::filesystem::path& journal_path,
+                           const CommandJournalKey& key,
+                           std::span<const CommandJournalRecord> records,
+                           std::size_t byte_budget) -> std::expected<std::size_t, ErrorCode>;
+
+/**
+ * Reads a command journal file.
+ *
+ * \param journal_path The path of the journal file.
+ * \param key          The expected key of the associated map file.
+ *
+ * \return
+ * The stored records, oldest first, if successful; an error code otherwise.
+ */
+[[nodiscard]]
+auto read_command_journal(const std::filesystem::path& journal_path,
+                          const CommandJournalKey& key)
+    -> std::expected<std::vector<CommandJournalRecord>, ErrorCode>;
+
+/**
+ * Collects the journal records of the applied commands in a command history.
+ *
+ * \details
+ * Only the most recent applied commands that support journal records are
+ * collected, since older commands cannot be reverted without them.
+ *
+ * \param history The command history to inspect.
+ *
+ * \return
+ * The journal records, oldest first.
+ */
+[[nodiscard]]
+auto collect_command_journal_records(const CommandStack& history)
+    -> std::vector<CommandJournalRecord>;
+
+/**
+ * Stores the command history of a saved map document in its command journal.
+ *
+ * \details
+ * This function should be called after the document has been saved, and
+ * doesn't access any document state, so it may be called on worker threads.
+ * Any existing journal is removed if there are no records.
+ *
+ * \param map_path    The path of the saved map file.
+ * \param records     The records to store, see \c collect_command_journal_records.
+ * \param byte_budget The maximum size of the journal, in bytes.
+ *
+ * \return
+ * The number of stored commands if successful; an error code otherwise.
+ */
+[[nodiscard]]
+auto save_command_journal(const std::filesystem::path& map_path,
+                          std::span<const CommandJournalRecord> records,
+                          std::size_t byte_budget) -> std::expected<std::size_t, ErrorCode>;
+
+/**
+ * Restores the command history of a map document from its command journal.
+ *
+ * \details
+ * The journal is ignored if the map file has been modified since the journal
+ * was written. Restored commands are placed on the command stack as applied
+ * commands, after which the stack is marked as clean.
+ *
+ * \param document The opened map document.
+ * \param history  The command history of the document.
+ *
+ * \return
+ * The number of restored commands if successful; an error code otherwise.
+ */
+[[nodiscard]]
+auto restore_command_journal(MapDocument& document, CommandStack& history)
+    -> std::expected<std::size_t, ErrorCode>;
+
+/**
+ * Adds the commands described by a sequence of journal records to a command stack.
+ *
+ * \details
+ * All records are validated before any commands are added, so the command
+ * stack is left untouched if a record refers to an unknown tile layer.
+ *
+ * \param document The target map document.
+ * \param history  The command history of the document.
+ * \param records  The records to add, oldest first.
+ * \param execute  True if the commands should be executed; false if the changes
+ *                 have already been applied to the document.
+ *
+ * \return
+ * The number of added commands if successful; an error code otherwise.
+ */
+[[nodiscard]]
+auto add_command_journal_records(MapDocument& document,
+                                 CommandStack& history,
+                                 std::vector<CommandJournalRecord> records,
+                                 bool execute) -> std::expected<std::size_t, ErrorCode>;
+
+}  // namespace tactile::core
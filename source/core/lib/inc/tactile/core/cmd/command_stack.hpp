@@ -5,9 +5,11 @@
 #include <concepts>  // derived_from
 #include <cstdint>   // size_t
 #include <deque>     // deque
+#include <limits>    // numeric_limits
 #include <memory>    // unique_ptr, make_unique
 #include <optional>  // optional
 #include <utility>   // move, forward
+#include <vector>    // vector
 
 #include "tactile/base/prelude.hpp"
 #include "tactile/core/cmd/command.hpp"
@@ -39,6 +41,12 @@ namespace tactile::core {
  *   to the left but the command stack is otherwise untouched. Similarly, if a
  *   command is repeated after being reverted, this index is incremented and
  *   shifted to the right.
+ *
+ * The command stack is limited both by a command count and by a memory budget.
+ * The memory budget is based on the estimates provided by the commands, and
+ * the oldest commands are removed when the budget is exceeded. The estimates
+ * are cached, and only updated when the commands are pushed, merged, reverted,
+ * or repeated.
  */
 class CommandStack final
 {
@@ -49,9 +57,11 @@ class CommandStack final
   /**
    * Creates an empty command stack with the specified capacity.
    *
-   * \param capacity The maximum amount of stored commands.
+   * \param capacity      The maximum amount of stored commands.
+   * \param memory_budget The maximum estimated memory usage of the stored commands.
    */
-  explicit CommandStack(std::size_t capacity);
+  explicit CommandStack(std::size_t capacity,
+                        std::size_t memory_budget = std::numeric_limits<std::size_t>::max());
 
   ~CommandStack() noexcept = default;
 
@@ -96,7 +106,7 @@ class CommandStack final
   template <std::derived_from<ICommand> T, typename... Args>
   void store(Args&&... args)
   {
-    _store(make_unique<T>(std::forward<Args>(args)...));
+    _store(std::make_unique<T>(std::forward<Args>(args)...));
   }
 
   /**
@@ -122,17 +132,27 @@ class CommandStack final
     T cmd {std::forward<Args>(args)...};
     cmd.redo();
 
+    if (m_observer) {
+      m_observer->on_command_executed(cmd);
+    }
+
     // If the stack is empty, we simply push the command on the stack. However,
     // if there are commands on the stack, we try to merge the command into the
     // top of the stack. If that succeeds, we discard the temporary command.
     // Otherwise, just add the command to the stack as per usual.
-    if (m_commands.empty() || !m_commands.back()->merge_with(&cmd)) {
-      m_commands.push_back(std::make_unique<T>(std::move(cmd)));
+    if (m_commands.empty() || !m_commands.back().command->merge_with(&cmd)) {
+      m_commands.push_back(StoredCommand {
+        .command = std::make_unique<T>(std::move(cmd)),
+        .memory_usage = 0,
+      });
       _increase_current_index();
     }
     else {
       m_clean_index.reset();
     }
+
+    _update_memory_usage(m_commands.size() - 1);
+    _enforce_memory_budget();
   }
 
   /**
@@ -146,6 +166,25 @@ class CommandStack final
    */
   void set_capacity(std::size_t capacity);
 
+  /**
+   * Sets the maximum estimated memory usage of the stored commands.
+   *
+   * \details
+   * The oldest commands are removed until the memory usage is within the
+   * budget. However, the most recent command is always kept, even if it
+   * exceeds the budget on its own.
+   *
+   * \param memory_budget The memory budget, in bytes.
+   */
+  void set_memory_budget(std::size_t memory_budget);
+
+  /**
+   * Sets the observer that is notified when commands are executed or reverted.
+   *
+   * \param observer The new observer, may be null. Must outlive the stack.
+   */
+  void set_observer(ICommandObserver* observer);
+
   /**
    * Indicates whether the current command stack state is clean.
    */
@@ -176,6 +215,27 @@ class CommandStack final
   [[nodiscard]]
   auto capacity() const -> std::size_t;
 
+  /**
+   * Returns the maximum estimated memory usage of the stored commands.
+   */
+  [[nodiscard]]
+  auto memory_budget() const -> std::size_t;
+
+  /**
+   * Returns the estimated memory usage of the stored commands, in bytes.
+   */
+  [[nodiscard]]
+  auto memory_usage() const -> std::size_t;
+
+  /**
+   * Returns the commands that are currently applied, oldest first.
+   *
+   * \return
+   * The applied commands, excluding any reverted commands.
+   */
+  [[nodiscard]]
+  auto get_applied_commands() const -> std::vector<const ICommand*>;
+
   /**
    * Returns the current command index, if there is one.
    */
@@ -189,10 +249,19 @@ class CommandStack final
   auto clean_index() const -> std::optional<std::size_t>;
 
  private:
-  std::deque<std::unique_ptr<ICommand>> m_commands {};
+  struct StoredCommand final
+  {
+    std::unique_ptr<ICommand> command;
+    std::size_t memory_usage;
+  };
+
+  std::deque<StoredCommand> m_commands {};
   std::optional<std::size_t> m_current_index {};
   std::optional<std::size_t> m_clean_index {};
   std::size_t m_capacity {};
+  std::size_t m_memory_budget {};
+  std::size_t m_memory_usage {};
+  ICommandObserver* m_observer {nullptr};
 
   // Pushes a command onto the stack, but does not execute it.
   void _store(std::unique_ptr<ICommand> cmd);
@@ -200,9 +269,18 @@ class CommandStack final
   // Removes the oldest command from the stack, i.e., the one at the bottom.
   void _remove_oldest_command();
 
+  // Removes the most recent command, which must not be applied.
+  void _remove_newest_command();
+
   // Removes all commands to the right of the current index (newer ones).
   void _remove_commands_after_current_index();
 
+  // Refreshes the cached memory usage of the command at the specified index.
+  void _update_memory_usage(std::size_t index);
+
+  // Removes old commands until the memory usage is within the budget.
+  void _enforce_memory_budget();
+
   void _reset_or_decrease_clean_index();
 
   // Shifts the current index to the left (to an older command).
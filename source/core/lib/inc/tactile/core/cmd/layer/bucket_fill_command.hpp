@@ -0,0 +1,68 @@
+// Copyright (C) 2024 Albin Johansson (GNU General Public License v3.0)
+
+#pragma once
+
+#include <cstddef>   // size_t
+#include <optional>  // optional
+#include <vector>    // vector
+
+#include "tactile/base/id.hpp"
+#include "tactile/base/numeric/index_2d.hpp"
+#include "tactile/base/prelude.hpp"
+#include "tactile/core/cmd/command.hpp"
+#include "tactile/core/entity/entity.hpp"
+#include "tactile/core/layer/tile_layer_fill.hpp"
+
+namespace tactile::core {
+
+class MapDocument;
+
+/**
+ * A command for flood filling regions of tile layers.
+ *
+ * \details
+ * The fill is computed when the command is first applied. Since all replaced
+ * tiles featured the same tile identifier, only the spans of changed tiles are
+ * stored, which keeps the command small even for huge fills.
+ */
+class BucketFillCommand final : public ICommand
+{
+ public:
+  /**
+   * Creates a command.
+   *
+   * \pre The layer identifier must refer to a tile layer.
+   *
+   * \param document The host document, cannot be null.
+   * \param layer_id The target tile layer identifier.
+   * \param origin   The position of the first tile to replace.
+   * \param tile_id  The new tile identifier.
+   * \param region   An optional region that limits the fill.
+   */
+  BucketFillCommand(MapDocument* document,
+                    EntityID layer_id,
+                    const Index2D& origin,
+                    TileID tile_id,
+                    const std::optional<TileRegion>& region = std::nullopt);
+
+  void undo() override;
+
+  void redo() override;
+
+  [[nodiscard]]
+  auto get_memory_usage() const -> std::size_t override;
+
+  [[nodiscard]]
+  auto write_journal_record(CommandJournalRecord& record) const -> bool override;
+
+ private:
+  MapDocument* m_document;
+  EntityID m_layer_id;
+  Index2D m_origin;
+  TileID m_new_tile_id;
+  std::optional<TileRegion> m_region;
+  std::optional<TileID> m_old_tile_id;
+  std::vector<TileSpan> m_changed_spans;
+};
+
+}  // namespace tactile::core
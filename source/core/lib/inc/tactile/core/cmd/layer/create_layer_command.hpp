@@ -2,6 +2,8 @@
 
 #pragma once
 
+#include <cstddef>  // size_t
+
 #include "tactile/base/layer/layer_type.hpp"
 #include "tactile/base/prelude.hpp"
 #include "tactile/core/cmd/command.hpp"
@@ -31,6 +33,9 @@ class CreateLayerCommand final : public ICommand
 
   void dispose() override;
 
+  [[nodiscard]]
+  auto get_memory_usage() const -> std::size_t override;
+
  private:
   MapDocument* m_document;
   LayerType m_type;
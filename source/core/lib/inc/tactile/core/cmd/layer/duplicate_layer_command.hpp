@@ -2,6 +2,8 @@
 
 #pragma once
 
+#include <cstddef>  // size_t
+
 #include "tactile/base/prelude.hpp"
 #include "tactile/core/cmd/command.hpp"
 #include "tactile/core/entity/entity.hpp"
@@ -32,6 +34,9 @@ class DuplicateLayerCommand final : public ICommand
 
   void dispose() override;
 
+  [[nodiscard]]
+  auto get_memory_usage() const -> std::size_t override;
+
  private:
   MapDocument* m_document;
   EntityID m_layer_id;
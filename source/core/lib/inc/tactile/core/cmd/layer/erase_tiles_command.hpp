@@ -0,0 +1,67 @@
+// Copyright (C) 2024 Albin Johansson (GNU General Public License v3.0)
+
+#pragma once
+
+#include <cstddef>  // size_t
+#include <cstdint>  // uint64_t
+
+#include "tactile/base/numeric/index_2d.hpp"
+#include "tactile/base/prelude.hpp"
+#include "tactile/core/cmd/command.hpp"
+#include "tactile/core/entity/entity.hpp"
+#include "tactile/core/layer/tile_diff.hpp"
+
+namespace tactile::core {
+
+class MapDocument;
+
+/**
+ * A command for erasing tiles in a tile layer.
+ *
+ * \details
+ * Each command represents a single sample of an eraser tool stroke. Commands
+ * that share a stroke identifier are merged, so that a whole stroke results in
+ * a single entry in the command history. Only a run-length encoded diff of the
+ * erased tiles is stored.
+ */
+class EraseTilesCommand final : public ICommand
+{
+ public:
+  /**
+   * Creates a command.
+   *
+   * \pre The layer identifier must refer to a tile layer.
+   *
+   * \param document  The host document, cannot be null.
+   * \param layer_id  The target tile layer identifier.
+   * \param stroke_id The identifier of the associated tool stroke.
+   * \param position  The position of the tile to erase.
+   */
+  EraseTilesCommand(MapDocument* document,
+                    EntityID layer_id,
+                    std::uint64_t stroke_id,
+                    const Index2D& position);
+
+  void undo() override;
+
+  void redo() override;
+
+  [[nodiscard]]
+  auto merge_with(const ICommand* cmd) -> bool override;
+
+  [[nodiscard]]
+  auto get_memory_usage() const -> std::size_t override;
+
+  [[nodiscard]]
+  auto write_journal_record(CommandJournalRecord& record) const -> bool override;
+
+ private:
+  MapDocument* m_document;
+  EntityID m_layer_id;
+  std::uint64_t m_stroke_id;
+  Index2D m_position;
+  bool m_recorded_diff;
+  TileDiff m_diff;
+};
+
+}  // namespace tactile::core
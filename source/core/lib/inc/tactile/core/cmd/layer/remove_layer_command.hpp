@@ -2,8 +2,12 @@
 
 #pragma once
 
+#include <cstddef>  // size_t
+#include <vector>   // vector
+
 #include "tactile/base/prelude.hpp"
 #include "tactile/core/cmd/command.hpp"
+#include "tactile/core/cmd/undo_payload_store.hpp"
 #include "tactile/core/entity/entity.hpp"
 
 namespace tactile::core {
@@ -12,6 +16,11 @@ class MapDocument;
 
 /**
  * A command for removing layers from maps.
+ *
+ * \details
+ * The removed layer is kept alive so that it can be restored, but the tile data
+ * of large dense tile layers is moved to the undo payload store of the document
+ * while the layer is removed.
  */
 class RemoveLayerCommand final : public ICommand
 {
@@ -32,11 +41,27 @@ class RemoveLayerCommand final : public ICommand
 
   void dispose() override;
 
+  [[nodiscard]]
+  auto get_memory_usage() const -> std::size_t override;
+
  private:
+  struct OffloadedTiles final
+  {
+    EntityID layer_id;
+    UndoPayloadId payload_id;
+  };
+
   MapDocument* m_document;
   EntityID m_layer_id;
   EntityID m_parent_layer_id;
   bool m_layer_was_removed;
+  std::vector<OffloadedTiles> m_offloaded_tiles;
+
+  void _offload_tiles(EntityID layer_id);
+
+  void _restore_tiles();
+
+  void _release_offloaded_tiles();
 };
 
 }  // namespace tactile::core
@@ -0,0 +1,71 @@
+// Copyright (C) 2024 Albin Johansson (GNU General Public License v3.0)
+
+#pragma once
+
+#include <cstddef>   // size_t
+#include <cstdint>   // uint64_t
+#include <optional>  // optional
+
+#include "tactile/base/numeric/index_2d.hpp"
+#include "tactile/base/prelude.hpp"
+#include "tactile/base/util/tile_matrix.hpp"
+#include "tactile/core/cmd/command.hpp"
+#include "tactile/core/entity/entity.hpp"
+#include "tactile/core/layer/tile_diff.hpp"
+
+namespace tactile::core {
+
+class MapDocument;
+
+/**
+ * A command for stamping a pattern of tiles onto a tile layer.
+ *
+ * \details
+ * Each command represents a single sample of a stamp tool stroke. Commands
+ * that share a stroke identifier are merged, so that a whole stroke results in
+ * a single entry in the command history. Only a run-length encoded diff of the
+ * changed tiles is stored.
+ */
+class StampTilesCommand final : public ICommand
+{
+ public:
+  /**
+   * Creates a command.
+   *
+   * \pre The layer identifier must refer to a tile layer.
+   *
+   * \param document  The host document, cannot be null.
+   * \param layer_id  The target tile layer identifier.
+   * \param stroke_id The identifier of the associated tool stroke.
+   * \param position  The position of the top-left tile in the pattern.
+   * \param pattern   The tiles to stamp, empty tiles in the pattern are ignored.
+   */
+  StampTilesCommand(MapDocument* document,
+                    EntityID layer_id,
+                    std::uint64_t stroke_id,
+                    const Index2D& position,
+                    TileMatrix pattern);
+
+  void undo() override;
+
+  void redo() override;
+
+  [[nodiscard]]
+  auto merge_with(const ICommand* cmd) -> bool override;
+
+  [[nodiscard]]
+  auto get_memory_usage() const -> std::size_t override;
+
+  [[nodiscard]]
+  auto write_journal_record(CommandJournalRecord& record) const -> bool override;
+
+ private:
+  MapDocument* m_document;
+  EntityID m_layer_id;
+  std::uint64_t m_stroke_id;
+  Index2D m_position;
+  std::optional<TileMatrix> m_pattern;
+  TileDiff m_diff;
+};
+
+}  // namespace tactile::core
@@ -0,0 +1,53 @@
+// Copyright (C) 2024 Albin Johansson (GNU General Public License v3.0)
+
+#pragma once
+
+#include <cstddef>  // size_t
+
+#include "tactile/base/prelude.hpp"
+#include "tactile/core/cmd/command.hpp"
+#include "tactile/core/entity/entity.hpp"
+#include "tactile/core/layer/tile_diff.hpp"
+
+namespace tactile::core {
+
+class MapDocument;
+
+/**
+ * A command that applies a previously recorded tile diff to a tile layer.
+ *
+ * \details
+ * This is used to restore tile commands from command journals, where the
+ * original commands are replaced by the changes they made.
+ */
+class TileDiffCommand final : public ICommand
+{
+ public:
+  /**
+   * Creates a command.
+   *
+   * \pre The layer identifier must refer to a tile layer.
+   *
+   * \param document The host document, cannot be null.
+   * \param layer_id The target tile layer identifier.
+   * \param diff     The tile changes made by the command.
+   */
+  TileDiffCommand(MapDocument* document, EntityID layer_id, TileDiff diff);
+
+  void undo() override;
+
+  void redo() override;
+
+  [[nodiscard]]
+  auto get_memory_usage() const -> std::size_t override;
+
+  [[nodiscard]]
+  auto write_journal_record(CommandJournalRecord& record) const -> bool override;
+
+ private:
+  MapDocument* m_document;
+  EntityID m_layer_id;
+  TileDiff m_diff;
+};
+
+}  // namespace tactile::core
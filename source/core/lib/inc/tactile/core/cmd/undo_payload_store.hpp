@@ -0,0 +1,174 @@
+// Copyright (C) 2024 Albin Johansson (GNU General Public License v3.0)
+
+#pragma once
+
+#include <cstddef>     // size_t
+#include <cstdint>     // uint8_t, uint64_t
+#include <expected>    // expected
+#include <filesystem>  // path
+#include <limits>      // numeric_limits
+#include <map>         // map
+#include <optional>    // optional
+
+#include "tactile/base/debug/error_code.hpp"
+#include "tactile/base/io/byte_stream.hpp"
+#include "tactile/base/prelude.hpp"
+#include "tactile/core/platform/file_lock.hpp"
+
+namespace tactile {
+class ICompressionFormat;
+}  // namespace tactile
+
+namespace tactile::core {
+
+/** Identifies a payload in an undo payload store. */
+using UndoPayloadId = std::uint64_t;
+
+/**
+ * Stores large snapshots of data that commands need to revert their changes.
+ *
+ * \details
+ * Payloads are compressed if they are large enough, using either an external
+ * compression format or a built-in run-length codec that is well suited for tile
+ * data. The store can also move payloads to temporary files when the amount of
+ * payload data kept in memory exceeds a threshold, starting with the oldest
+ * payloads. Such files are removed when the payloads are released, or when the
+ * store is destroyed. The spill directory of each store is locked for as long as
+ * the store exists, see \c remove_stale_undo_spill_directories.
+ */
+class UndoPayloadStore final
+{
+ public:
+  TACTILE_DELETE_COPY(UndoPayloadStore);
+  TACTILE_DELETE_MOVE(UndoPayloadStore);
+
+  UndoPayloadStore() = default;
+
+  ~UndoPayloadStore() noexcept;
+
+  /**
+   * Stores a payload.
+   *
+   * \param bytes The payload data.
+   *
+   * \return
+   * The identifier associated with the payload.
+   */
+  [[nodiscard]]
+  auto store(ByteSpan bytes) -> UndoPayloadId;
+
+  /**
+   * Restores the original data of a payload.
+   *
+   * \param id The payload identifier.
+   *
+   * \return
+   * The payload data if successful; an error code otherwise.
+   */
+  [[nodiscard]]
+  auto load(UndoPayloadId id) const -> std::expected<ByteStream, ErrorCode>;
+
+  /**
+   * Removes a payload from the store.
+   *
+   * \details
+   * This function has no effect if there is no payload with the given identifier.
+   *
+   * \param id The payload identifier.
+   */
+  void release(UndoPayloadId id);
+
+  /**
+   * Sets the compression format used for new payloads.
+   *
+   * \details
+   * Payloads remember the format they were compressed with, so the format must
+   * outlive the store. The built-in codec is used if the format is null.
+   *
+   * \param format The compression format to use, may be null.
+   */
+  void set_compression_format(const ICompressionFormat* format);
+
+  /**
+   * Sets the maximum amount of payload data kept in memory.
+   *
+   * \details
+   * Payloads are moved to temporary files if this threshold is exceeded.
+   *
+   * \param byte_count The spill threshold, in bytes.
+   */
+  void set_spill_threshold(std::size_t byte_count);
+
+  /**
+   * Returns the amount of memory used by a payload.
+   *
+   * \param id The payload identifier.
+   *
+   * \return
+   * The size of the stored payload data in memory, in bytes.
+   */
+  [[nodiscard]]
+  auto get_resident_size(UndoPayloadId id) const -> std::size_t;
+
+  /**
+   * Returns the amount of memory used by all payloads.
+   *
+   * \return
+   * The total size of the stored payload data in memory, in bytes.
+   */
+  [[nodiscard]]
+  auto get_resident_size() const -> std::size_t;
+
+  /**
+   * Returns the number of payloads in the store.
+   *
+   * \return
+   * A payload count.
+   */
+  [[nodiscard]]
+  auto payload_count() const -> std::size_t;
+
+ private:
+  enum class PayloadEncoding : std::uint8_t
+  {
+    kRaw,
+    kBuiltin,
+    kCompressionFormat,
+  };
+
+  struct Payload final
+  {
+    PayloadEncoding encoding;
+    const ICompressionFormat* compression_format;
+    std::size_t raw_size;
+    ByteStream bytes;
+    bool is_spilled;
+  };
+
+  std::map<UndoPayloadId, Payload> m_payloads {};
+  const ICompressionFormat* m_compression_format {nullptr};
+  std::size_t m_spill_threshold {std::numeric_limits<std::size_t>::max()};
+  std::size_t m_resident_size {0};
+  UndoPayloadId m_next_id {1};
+  std::filesystem::path m_spill_directory {};
+  std::optional<FileLock> m_spill_lock {};
+
+  void _spill_payloads();
+
+  [[nodiscard]]
+  auto _get_spill_path(UndoPayloadId id) const -> std::filesystem::path;
+};
+
+/**
+ * Removes undo spill directories left behind by editor sessions that didn't exit normally.
+ *
+ * \details
+ * Spill directories that are locked by stores, possibly in other running editor
+ * instances, are left alone.
+ *
+ * \return
+ * The number of removed directories.
+ */
+auto remove_stale_undo_spill_directories() -> std::size_t;
+
+}  // namespace tactile::core
@@ -0,0 +1,43 @@
+// Copyright (C) 2024 Albin Johansson (GNU General Public License v3.0)
+
+#pragma once
+
+#include <expected>    // expected
+#include <filesystem>  // path
+#include <ostream>     // ostream
+#include <span>        // span
+
+#include "tactile/base/debug/error_code.hpp"
+#include "tactile/base/prelude.hpp"
+#include "tactile/core/debug/profiler.hpp"
+
+namespace tactile::core {
+
+/**
+ * Writes profiler zone events in the Chrome Trace Event JSON format.
+ *
+ * \details
+ * Each zone is emitted as a "complete" event, with timestamps in microseconds
+ * relative to the profiler epoch. The output can be loaded in Perfetto or the
+ * Chrome trace viewer (chrome://tracing).
+ *
+ * \param stream The output stream.
+ * \param events The zone events to write.
+ */
+void write_chrome_trace(std::ostream& stream, std::span<const ProfileZoneEvent> events);
+
+/**
+ * Saves profiler zone events to a Chrome Trace Event JSON file.
+ *
+ * \param path   The destination file path.
+ * \param events The zone events to save.
+ *
+ * \return
+ * Nothing if successful; an error code otherwise.
+ */
+[[nodiscard]]
+auto save_chrome_trace(const std::filesystem::path& path,
+                       std::span<const ProfileZoneEvent> events)
+    -> std::expected<void, ErrorCode>;
+
+}  // namespace tactile::core
@@ -0,0 +1,214 @@
+// Copyright (C) 2024 Albin Johansson (GNU General Public License v3.0)
+
+#pragma once
+
+#include <cstddef>  // size_t
+#include <cstdint>  // int64_t, uint32_t
+#include <string>   // string
+#include <vector>   // vector
+
+#include "tactile/base/prelude.hpp"
+
+/**
+ * Records the duration of the enclosing scope as a named profiler zone.
+ *
+ * \details
+ * Unlike \c TACTILE_DEBUG_PROFILE_SCOPE, profiler zones are available in all
+ * builds. The zone name must be a string literal (or otherwise outlive the
+ * profiler), since only the pointer is stored. At most one zone may be declared
+ * in each scope using this macro.
+ */
+#define TACTILE_PROFILE_ZONE(Name)                      \
+  const tactile::core::ProfileZone tactile_profile_zone \
+  {                                                     \
+    (Name)                                              \
+  }
+
+namespace tactile::core {
+
+/** The maximum number of zone events stored for each thread. */
+inline constexpr std::size_t kProfilerEventCapacity = 4'096;
+
+/** The number of frames included in the profiler frame history. */
+inline constexpr std::size_t kProfilerFrameCapacity = 240;
+
+/** The maximum number of zone events stored in a single capture. */
+inline constexpr std::size_t kProfilerCaptureCapacity = 1'000'000;
+
+/**
+ * Represents a single completed profiler zone.
+ */
+struct ProfileZoneEvent final
+{
+  /** The name of the zone. */
+  const char* name;
+
+  /** The index of the thread that recorded the zone, reused after the thread exits. */
+  std::uint32_t thread_index;
+
+  /** The nesting depth of the zone, where zero is used by outermost zones. */
+  std::uint32_t depth;
+
+  /** The start of the zone, in nanoseconds relative to the profiler epoch. */
+  std::int64_t start_ns;
+
+  /** The duration of the zone, in nanoseconds. */
+  std::int64_t duration_ns;
+};
+
+/**
+ * Provides the frame time history of a single profiler zone.
+ */
+struct ProfileZoneStats final
+{
+  /** The name of the zone. */
+  std::string name;
+
+  /** The total duration of the zone in each frame, oldest frame first. */
+  std::vector<float> frame_times_ms;
+
+  /** The average total duration of the zone per frame. */
+  float average_ms;
+
+  /** The largest total duration of the zone in a single frame. */
+  float max_ms;
+};
+
+/**
+ * Provides a snapshot of the profiler frame history.
+ */
+struct ProfilerFrameStats final
+{
+  /** The duration of each frame, oldest frame first. */
+  std::vector<float> frame_times_ms;
+
+  /** The history of each zone that has been recorded, sorted by name. */
+  std::vector<ProfileZoneStats> zones;
+};
+
+/**
+ * RAII type used to record a profiler zone.
+ *
+ * \details
+ * Prefer using the \c TACTILE_PROFILE_ZONE macro instead of using this class
+ * directly. Zones may be nested, and are recorded separately for each thread.
+ */
+class ProfileZone final
+{
+ public:
+  TACTILE_DELETE_COPY(ProfileZone);
+  TACTILE_DELETE_MOVE(ProfileZone);
+
+  /**
+   * Begins a profiler zone.
+   *
+   * \param name The name of the zone, must outlive the profiler.
+   */
+  [[nodiscard]]
+  explicit ProfileZone(const char* name) noexcept;
+
+  /**
+   * Ends the profiler zone.
+   */
+  ~ProfileZone() noexcept;
+};
+
+/**
+ * Enables or disables the recording of profiler zones.
+ *
+ * \details
+ * The profiler is enabled by default. Zones that are active when the profiler
+ * is toggled are recorded according to the state when they began.
+ *
+ * \param enabled True if zones should be recorded; false otherwise.
+ */
+void set_profiler_enabled(bool enabled) noexcept;
+
+/**
+ * Indicates whether profiler zones are recorded.
+ *
+ * \return
+ * True if the profiler is enabled; false otherwise.
+ */
+[[nodiscard]]
+auto is_profiler_enabled() noexcept -> bool;
+
+/**
+ * Begins a profiler zone on the calling thread.
+ *
+ * \note
+ * Each call to this function must be matched by a call to
+ * \c end_profile_zone on the same thread.
+ *
+ * \param name The name of the zone, must outlive the profiler.
+ */
+void begin_profile_zone(const char* name) noexcept;
+
+/**
+ * Ends the innermost active profiler zone on the calling thread.
+ *
+ * \details
+ * This function has no effect if there are no active zones on the thread.
+ */
+void end_profile_zone() noexcept;
+
+/**
+ * Marks the end of a frame.
+ *
+ * \details
+ * This function should be called once per frame by the main loop. The zone
+ * events recorded by all threads since the previous call are accumulated into
+ * the frame history. Each thread records events into a lock-free ring buffer,
+ * so events are lost if a thread records more than \c kProfilerEventCapacity
+ * events between two calls. The buffers of threads that have exited are reused
+ * by new threads.
+ */
+void mark_profiler_frame();
+
+/**
+ * Returns a snapshot of the profiler frame history.
+ *
+ * \return
+ * The recorded frame history.
+ */
+[[nodiscard]]
+auto get_profiler_frame_stats() -> ProfilerFrameStats;
+
+/**
+ * Clears all recorded zone events and the frame history, and stops any capture.
+ */
+void reset_profiler();
+
+/**
+ * Starts capturing zone events.
+ *
+ * \details
+ * While capturing, all zone events collected by \c mark_profiler_frame are
+ * stored (up to \c kProfilerCaptureCapacity events), in addition to being
+ * accumulated into the frame history. Starting a new capture discards any
+ * previously captured events.
+ */
+void start_profiler_capture();
+
+/**
+ * Stops capturing zone events.
+ *
+ * \note
+ * Events recorded after the most recent frame mark aren't included.
+ *
+ * \return
+ * The zone events captured since the capture was started.
+ */
+[[nodiscard]]
+auto stop_profiler_capture() -> std::vector<ProfileZoneEvent>;
+
+/**
+ * Indicates whether zone events are being captured.
+ *
+ * \return
+ * True if a capture is active; false otherwise.
+ */
+[[nodiscard]]
+auto is_profiler_capturing() -> bool;
+
+}  // namespace tactile::core
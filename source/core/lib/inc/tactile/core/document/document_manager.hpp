@@ -4,6 +4,7 @@
 
 #include <cstddef>        // size_t
 #include <expected>       // expected
+#include <limits>         // numeric_limits
 #include <memory>         // unique_ptr
 #include <unordered_map>  // unordered_map
 #include <vector>         // vector
@@ -12,13 +13,19 @@
 #include "tactile/base/document/document.hpp"
 #include "tactile/base/io/save/ir.hpp"
 #include "tactile/base/prelude.hpp"
-#include "tactile/base/render/renderer.hpp"
 #include "tactile/core/cmd/command_stack.hpp"
 #include "tactile/core/util/uuid.hpp"
 
+namespace tactile {
+class ICompressionFormat;
+}  // namespace tactile
+
 namespace tactile::core {
 
 struct MapSpec;
+class MapDocument;
+class UndoPayloadStore;
+class TextureCache;
 
 /**
  * Manages a collection of documents.
@@ -45,16 +52,17 @@ class DocumentManager final
    * Restores a map document from an intermediate map representation.
    *
    * \details
-   * This function behaves just like \c create_and_open_map(const MapSpec&).
+   * This function behaves just like \c create_and_open_map(const MapSpec&). The
+   * document is opened without waiting for tileset textures to be loaded.
    *
-   * \param renderer The renderer to use for loading textures.
-   * \param ir_map   The intermediate map representation.
+   * \param texture_cache The cache used to load textures.
+   * \param ir_map        The intermediate map representation.
    *
    * \return
    * The UUID of the map document if successful; an error code otherwise.
    */
   [[nodiscard]]
-  auto create_and_open_map(IRenderer& renderer, const ir::Map& ir_map)
+  auto create_and_open_map(TextureCache& texture_cache, const ir::Map& ir_map)
       -> std::expected<UUID, ErrorCode>;
 
   /**
@@ -114,6 +122,63 @@ class DocumentManager final
   [[nodiscard]]
   auto command_capacity() const -> std::size_t;
 
+  /**
+   * Sets the maximum estimated memory usage of the commands tracked by each document.
+   *
+   * \details
+   * Old commands are discarded when the budget is exceeded, even if the command
+   * capacity hasn't been reached.
+   *
+   * \param memory_budget The new memory budget, in bytes.
+   */
+  void set_command_memory_budget(std::size_t memory_budget);
+
+  /**
+   * Returns the maximum estimated memory usage of the commands stored by a document.
+   *
+   * \return
+   * The current memory budget, in bytes.
+   */
+  [[nodiscard]]
+  auto command_memory_budget() const -> std::size_t;
+
+  /**
+   * Sets the compression format used for large undo snapshots in map documents.
+   *
+   * \param format The compression format, the built-in codec is used if null.
+   */
+  void set_undo_compression_format(const ICompressionFormat* format);
+
+  /**
+   * Sets the amount of undo snapshot data kept in memory by each map document.
+   *
+   * \details
+   * Additional snapshot data is moved to temporary files.
+   *
+   * \param byte_count The spill threshold, in bytes.
+   */
+  void set_undo_spill_threshold(std::size_t byte_count);
+
+  /**
+   * Sets whether the tile animations in map documents are driven by a shared clock.
+   *
+   * \details
+   * Only the clock of the active map advances, and it's handed over to the
+   * next active map, so that animations resume where they left off.
+   *
+   * \param enabled True to use animation clocks; false to use per-tile animation state.
+   */
+  void set_tile_animation_sync(bool enabled);
+
+  /**
+   * Indicates whether the tile animations in map documents are driven by a shared clock.
+   *
+   * \return
+   * True if animation clocks are used; false otherwise.
+   */
+  [[nodiscard]]
+  auto tile_animation_sync() const -> bool;
+
   /**
    * Returns the command history associated with a given document.
    *
@@ -146,6 +211,16 @@ class DocumentManager final
   UUID mActiveDocument {};
   std::unordered_map<UUID, CommandStack> mHistories {};
   std::size_t mCommandCapacity {100};
+  std::size_t mCommandMemoryBudget {std::numeric_limits<std::size_t>::max()};
+  const ICompressionFormat* mUndoCompressionFormat {nullptr};
+  std::size_t mUndoSpillThreshold {std::numeric_limits<std::size_t>::max()};
+  bool mTileAnimationSync {false};
+
+  void _configure_undo_payload_store(UndoPayloadStore& store) const;
+
+  void _configure_animation_clock(MapDocument& document) const;
+
+  void _set_active_document(const UUID& document_uuid);
 };
 
 }  // namespace tactile::core
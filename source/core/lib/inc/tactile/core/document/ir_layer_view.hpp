@@ -0,0 +1,108 @@
+// Copyright (C) 2024 Albin Johansson (GNU General Public License v3.0)
+
+#pragma once
+
+#include <cstddef>  // size_t
+
+#include "tactile/base/document/layer_view.hpp"
+#include "tactile/base/io/save/ir.hpp"
+#include "tactile/base/prelude.hpp"
+#include "tactile/core/document/ir_meta_view.hpp"
+
+namespace tactile::core {
+
+/**
+ * A layer view of an intermediate representation.
+ */
+class IrLayerView final : public ILayerView
+{
+ public:
+  /**
+   * Creates a layer view.
+   *
+   * \param map          The map that contains the layer, cannot be null.
+   * \param layer        The viewed layer, cannot be null.
+   * \param parent_layer The parent layer, if any.
+   * \param global_index The global index of the layer, see \c get_global_index.
+   */
+  IrLayerView(const ir::Map* map,
+              const ir::Layer* layer,
+              const ILayerView* parent_layer,
+              std::size_t global_index);
+
+  [[nodiscard]]
+  auto accept(IDocumentVisitor& visitor) const -> std::expected<void, ErrorCode> override;
+
+  void write_tile_bytes(ByteStream& byte_stream) const override;
+
+  [[nodiscard]]
+  auto get_parent_layer() const -> const ILayerView* override;
+
+  [[nodiscard]]
+  auto get_id() const -> LayerID override;
+
+  [[nodiscard]]
+  auto get_type() const -> LayerType override;
+
+  [[nodiscard]]
+  auto get_opacity() const -> float override;
+
+  [[nodiscard]]
+  auto is_visible() const -> bool override;
+
+  [[nodiscard]]
+  auto get_global_index() const -> std::size_t override;
+
+  [[nodiscard]]
+  auto layer_count() const -> std::size_t override;
+
+  [[nodiscard]]
+  auto object_count() const -> std::size_t override;
+
+  [[nodiscard]]
+  auto get_tile(const Index2D& index) const -> std::optional<TileID> override;
+
+  [[nodiscard]]
+  auto get_tile_position_in_tileset(TileID tile_id) const -> std::optional<Index2D> override;
+
+  [[nodiscard]]
+  auto is_tile_animated(const Index2D& position) const -> bool override;
+
+  [[nodiscard]]
+  auto get_tile_encoding() const -> TileEncoding override;
+
+  [[nodiscard]]
+  auto get_tile_compression() const -> std::optional<CompressionFormatId> override;
+
+  [[nodiscard]]
+  auto get_compression_level() const -> std::optional<int> override;
+
+  [[nodiscard]]
+  auto get_extent() const -> std::optional<Extent2D> override;
+
+  [[nodiscard]]
+  auto get_meta() const -> const IMetaView& override;
+
+ private:
+  const ir::Map* mMap;
+  const ir::Layer* mLayer;
+  const ILayerView* mParentLayer;
+  std::size_t mGlobalIndex;
+  IrMetaView mMeta;
+
+  [[nodiscard]]
+  auto _find_tileset(TileID tile_id) const -> const ir::TilesetRef*;
+};
+
+/**
+ * Returns the number of layers in a layer hierarchy, including the root layer.
+ *
+ * \param layer The root layer.
+ *
+ * \return
+ * A layer count.
+ */
+[[nodiscard]]
+auto count_ir_layers(const ir::Layer& layer) -> std::size_t;
+
+}  // namespace tactile::core
@@ -0,0 +1,78 @@
+// Copyright (C) 2024 Albin Johansson (GNU General Public License v3.0)
+
+#pragma once
+
+#include <filesystem>  // path
+
+#include "tactile/base/document/map_view.hpp"
+#include "tactile/base/io/save/ir.hpp"
+#include "tactile/base/prelude.hpp"
+#include "tactile/core/document/ir_meta_view.hpp"
+
+namespace tactile::core {
+
+/**
+ * A map view of an intermediate representation.
+ *
+ * \details
+ * Unlike \c MapViewImpl, this view doesn't depend on any document state, so
+ * it may be used on other threads, e.g., to save snapshots of documents in the
+ * background.
+ */
+class IrMapView final : public IMapView
+{
+ public:
+  /**
+   * Creates a view of a map.
+   *
+   * \param map  The viewed map, cannot be null.
+   * \param path The reported map file path, may be null.
+   */
+  IrMapView(const ir::Map* map, const std::filesystem::path* path);
+
+  [[nodiscard]]
+  auto accept(IDocumentVisitor& visitor) const -> std::expected<void, ErrorCode> override;
+
+  [[nodiscard]]
+  auto get_path() const -> const std::filesystem::path* override;
+
+  [[nodiscard]]
+  auto get_tile_size() const -> Int2 override;
+
+  [[nodiscard]]
+  auto get_extent() const -> Extent2D override;
+
+  [[nodiscard]]
+  auto get_next_layer_id() const -> LayerID override;
+
+  [[nodiscard]]
+  auto get_next_object_id() const -> ObjectID override;
+
+  [[nodiscard]]
+  auto get_tile_encoding() const -> TileEncoding override;
+
+  [[nodiscard]]
+  auto get_tile_compression() const -> std::optional<CompressionFormatId> override;
+
+  [[nodiscard]]
+  auto get_compression_level() const -> std::optional<int> override;
+
+  [[nodiscard]]
+  auto layer_count() const -> std::size_t override;
+
+  [[nodiscard]]
+  auto tileset_count() const -> std::size_t override;
+
+  [[nodiscard]]
+  auto component_count() const -> std::size_t override;
+
+  [[nodiscard]]
+  auto get_meta() const -> const IMetaView& override;
+
+ private:
+  const ir::Map* mMap;
+  const std::filesystem::path* mPath;
+  IrMetaView mMeta;
+};
+
+}  // namespace tactile::core
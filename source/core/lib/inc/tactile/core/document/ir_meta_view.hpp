@@ -0,0 +1,38 @@
+// Copyright (C) 2024 Albin Johansson (GNU General Public License v3.0)
+
+#pragma once
+
+#include "tactile/base/document/meta_view.hpp"
+#include "tactile/base/io/save/ir.hpp"
+#include "tactile/base/prelude.hpp"
+
+namespace tactile::core {
+
+/**
+ * A metadata view of an intermediate representation.
+ */
+class IrMetaView final : public IMetaView
+{
+ public:
+  /**
+   * Creates a view.
+   *
+   * \param meta The viewed metadata, cannot be null.
+   */
+  explicit IrMetaView(const ir::Metadata* meta);
+
+  [[nodiscard]]
+  auto get_name() const -> std::string_view override;
+
+  [[nodiscard]]
+  auto get_property(std::size_t index) const
+      -> std::pair<const std::string&, const Attribute&> override;
+
+  [[nodiscard]]
+  auto property_count() const -> std::size_t override;
+
+ private:
+  const ir::Metadata* mMeta;
+};
+
+}  // namespace tactile::core
@@ -0,0 +1,71 @@
+// Copyright (C) 2024 Albin Johansson (GNU General Public License v3.0)
+
+#pragma once
+
+#include "tactile/base/document/object_view.hpp"
+#include "tactile/base/io/save/ir.hpp"
+#include "tactile/base/prelude.hpp"
+#include "tactile/core/document/ir_meta_view.hpp"
+
+namespace tactile::core {
+
+/**
+ * An object view of an intermediate representation.
+ */
+class IrObjectView final : public IObjectView
+{
+ public:
+  /**
+   * Creates a view of an object in an object layer.
+   *
+   * \param object       The viewed object, cannot be null.
+   * \param parent_layer The host layer view.
+   */
+  IrObjectView(const ir::Object* object, const ILayerView* parent_layer);
+
+  /**
+   * Creates a view of an object in a tile definition.
+   *
+   * \param object      The viewed object, cannot be null.
+   * \param parent_tile The host tile view.
+   */
+  IrObjectView(const ir::Object* object, const ITileView* parent_tile);
+
+  [[nodiscard]]
+  auto accept(IDocumentVisitor& visitor) const -> std::expected<void, ErrorCode> override;
+
+  [[nodiscard]]
+  auto get_parent_layer() const -> const ILayerView* override;
+
+  [[nodiscard]]
+  auto get_parent_tile() const -> const ITileView* override;
+
+  [[nodiscard]]
+  auto get_type() const -> ObjectType override;
+
+  [[nodiscard]]
+  auto get_id() const -> ObjectID override;
+
+  [[nodiscard]]
+  auto get_position() const -> Float2 override;
+
+  [[nodiscard]]
+  auto get_size() const -> Float2 override;
+
+  [[nodiscard]]
+  auto get_tag() const -> std::string_view override;
+
+  [[nodiscard]]
+  auto is_visible() const -> bool override;
+
+  [[nodiscard]]
+  auto get_meta() const -> const IMetaView& override;
+
+ private:
+  const ir::Object* mObject;
+  const ILayerView* mParentLayer;
+  const ITileView* mParentTile;
+  IrMetaView mMeta;
+};
+
+}  // namespace tactile::core
@@ -0,0 +1,55 @@
+// Copyright (C) 2024 Albin Johansson (GNU General Public License v3.0)
+
+#pragma once
+
+#include "tactile/base/document/tile_view.hpp"
+#include "tactile/base/document/tileset_view.hpp"
+#include "tactile/base/io/save/ir.hpp"
+#include "tactile/base/prelude.hpp"
+#include "tactile/core/document/ir_meta_view.hpp"
+
+namespace tactile::core {
+
+/**
+ * A tile view of an intermediate representation.
+ */
+class IrTileView final : public ITileView
+{
+ public:
+  /**
+   * Creates a tile view.
+   *
+   * \param tile         The viewed tile definition, cannot be null.
+   * \param tileset_view A view of the parent tileset, cannot be null.
+   */
+  IrTileView(const ir::Tile* tile, const ITilesetView* tileset_view);
+
+  [[nodiscard]]
+  auto accept(IDocumentVisitor& visitor) const -> std::expected<void, ErrorCode> override;
+
+  [[nodiscard]]
+  auto get_parent_tileset() const -> const ITilesetView& override;
+
+  [[nodiscard]]
+  auto get_index() const -> TileIndex override;
+
+  [[nodiscard]]
+  auto object_count() const -> std::size_t override;
+
+  [[nodiscard]]
+  auto animation_frame_count() const -> std::size_t override;
+
+  [[nodiscard]]
+  auto get_animation_frame(std::size_t index) const
+      -> std::pair<TileIndex, std::chrono::milliseconds> override;
+
+  [[nodiscard]]
+  auto get_meta() const -> const IMetaView& override;
+
+ private:
+  const ir::Tile* mTile;
+  const ITilesetView* mTilesetView;
+  IrMetaView mMeta;
+};
+
+}  // namespace tactile::core
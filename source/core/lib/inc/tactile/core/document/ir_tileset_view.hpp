@@ -0,0 +1,60 @@
+// Copyright (C) 2024 Albin Johansson (GNU General Public License v3.0)
+
+#pragma once
+
+#include "tactile/base/document/tileset_view.hpp"
+#include "tactile/base/io/save/ir.hpp"
+#include "tactile/base/prelude.hpp"
+#include "tactile/core/document/ir_meta_view.hpp"
+
+namespace tactile::core {
+
+/**
+ * A tileset view of an intermediate representation.
+ */
+class IrTilesetView final : public ITilesetView
+{
+ public:
+  /**
+   * Creates a view of a tileset used in a map.
+   *
+   * \param tileset_ref The viewed tileset reference, cannot be null.
+   */
+  explicit IrTilesetView(const ir::TilesetRef* tileset_ref);
+
+  [[nodiscard]]
+  auto accept(IDocumentVisitor& visitor) const -> std::expected<void, ErrorCode> override;
+
+  [[nodiscard]]
+  auto get_first_tile_id() const -> TileID override;
+
+  [[nodiscard]]
+  auto tile_count() const -> std::size_t override;
+
+  [[nodiscard]]
+  auto tile_definition_count() const -> std::size_t override;
+
+  [[nodiscard]]
+  auto column_count() const -> std::size_t override;
+
+  [[nodiscard]]
+  auto get_tile_size() const -> Int2 override;
+
+  [[nodiscard]]
+  auto get_image_size() const -> Int2 override;
+
+  [[nodiscard]]
+  auto get_image_path() const -> const std::filesystem::path& override;
+
+  [[nodiscard]]
+  auto get_meta() const -> const IMetaView& override;
+
+  [[nodiscard]]
+  auto get_filename() const -> std::string override;
+
+ private:
+  const ir::TilesetRef* mTilesetRef;
+  IrMetaView mMeta;
+};
+
+}  // namespace tactile::core
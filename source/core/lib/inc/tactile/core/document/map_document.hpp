@@ -2,6 +2,7 @@
 
 #pragma once
 
+#include <cstdint>   // uint8_t
 #include <expected>  // expected
 #include <memory>    // unique_ptr
 
@@ -14,6 +15,9 @@
 namespace tactile::core {
 
 struct MapSpec;
+class UndoPayloadStore;
+class TextureCache;
+enum class TextureLoadMode : std::uint8_t;
 
 /**
  * Represents a single map document.
@@ -38,6 +42,31 @@ class MapDocument final : public IDocument
   /**
    * Creates a map document from an intermediate representation.
    *
+   * \details
+   * Textures are shared with other documents that use the same texture cache.
+   * The texture cache must outlive the document. In deferred texture load mode,
+   * the document can be shown before all tileset textures have been loaded, and
+   * placeholder textures are replaced by \c update as textures become available.
+   *
+   * \param texture_cache The cache used to load textures.
+   * \param ir_map        The intermediate map representation.
+   * \param load_mode     Whether to wait for tileset textures to be loaded.
+   *
+   * \return
+   * A map document if successful; an error code otherwise.
+   */
+  [[nodiscard]]
+  static auto make(TextureCache& texture_cache,
+                   const ir::Map& ir_map,
+                   TextureLoadMode load_mode) -> std::expected<MapDocument, ErrorCode>;
+
+  /**
+   * Creates a map document from an intermediate representation.
+   *
+   * \details
+   * The document uses a private texture cache, so textures aren't shared with
+   * other documents. The renderer must outlive the document.
+   *
    * \param renderer The renderer used to load textures.
    * \param ir_map   The intermediate map representation.
    *
@@ -83,6 +112,21 @@ class MapDocument final : public IDocument
   [[nodiscard]]
   auto get_uuid() const -> const UUID& override;
 
+  /**
+   * Returns the store used by commands to keep large snapshots of the map.
+   *
+   * \return
+   * An undo payload store.
+   */
+  [[nodiscard]]
+  auto get_undo_payload_store() -> UndoPayloadStore&;
+
+  /**
+   * \copydoc get_undo_payload_store
+   */
+  [[nodiscard]]
+  auto get_undo_payload_store() const -> const UndoPayloadStore&;
+
  private:
   struct Data;
   std::unique_ptr<Data> mData;
@@ -2,6 +2,8 @@
 
 #pragma once
 
+#include <filesystem>  // path
+
 #include "tactile/base/document/map_view.hpp"
 #include "tactile/base/prelude.hpp"
 #include "tactile/core/document/meta_view_impl.hpp"
@@ -23,8 +25,9 @@ class MapViewImpl final : public IMapView
    * Creates a view of a map.
    *
    * \param document The associated map document.
+   * \param path     The reported map file path, the document path is used if null.
    */
-  MapViewImpl(const MapDocument* document);
+  MapViewImpl(const MapDocument* document, const std::filesystem::path* path = nullptr);
 
   [[nodiscard]]
   auto accept(IDocumentVisitor& visitor) const -> std::expected<void, ErrorCode> override;
@@ -67,6 +70,7 @@ class MapViewImpl final : public IMapView
 
  private:
   const MapDocument* mDocument;
+  const std::filesystem::path* mPath;
   MetaViewImpl mMeta;
 
   [[nodiscard]]
@@ -74,6 +74,17 @@ class Registry final
     return mRegistry.emplace_or_replace<T>(entity, std::forward<Args>(args)...);
   }
 
+  /**
+   * Removes a component from the registry itself (if it exists).
+   *
+   * \tparam T A component type.
+   */
+  template <typename T>
+  void erase()
+  {
+    mRegistry.ctx().erase<T>();
+  }
+
   /**
    * Removes a component from an entity (if it exists).
    *
@@ -2,30 +2,110 @@
 
 #pragma once
 
-#include <utility>  // forward
+#include <algorithm>      // find_if
+#include <cstddef>        // size_t
+#include <functional>     // invoke
+#include <memory>         // unique_ptr, make_unique
+#include <unordered_map>  // unordered_map
+#include <utility>        // forward, move
+#include <vector>         // vector
 
+#include <entt/core/type_info.hpp>
 #include <entt/signal/dispatcher.hpp>
 
 #include "tactile/base/prelude.hpp"
+#include "tactile/core/event/job_system.hpp"
 
 namespace tactile::core {
 
+/**
+ * An event coalescing policy that replaces pending events with newer events.
+ */
+struct KeepLastEvent final
+{
+  template <typename Event>
+  static void merge(Event& pending_event, Event&& event)
+  {
+    pending_event = std::move(event);
+  }
+};
+
+/**
+ * An event coalescing policy that accumulates a member of pending events.
+ *
+ * \tparam Member A pointer to the data member to sum, e.g., a position delta.
+ */
+template <auto Member>
+struct SumEventMember final
+{
+  template <typename Event>
+  static void merge(Event& pending_event, Event&& event)
+  {
+    std::invoke(Member, pending_event) += std::invoke(Member, event);
+  }
+};
+
+/**
+ * Provides statistics about the events handled in a single update.
+ */
+struct EventDispatchStats final
+{
+  /** The number of events pushed since the previous update. */
+  std::size_t pushed_count;
+
+  /** The number of pushed events that were merged into other pending events. */
+  std::size_t coalesced_count;
+
+  /** The number of events that were dispatched to listeners. */
+  std::size_t dispatched_count;
+
+  /** The number of jobs started by event handlers that haven't been completed. */
+  std::size_t pending_job_count;
+};
+
 /**
  * Provides the event handling API.
+ *
+ * \details
+ * Event handlers are either bound with \c bind, in which case they're run on the
+ * main thread, or with \c bind_job, in which case the bulk of their work is run
+ * on worker threads.
  */
 class EventDispatcher final
 {
  public:
+  TACTILE_DELETE_COPY(EventDispatcher);
+  TACTILE_DELETE_MOVE(EventDispatcher);
+
+  /**
+   * Creates an event dispatcher.
+   */
+  EventDispatcher();
+
   /**
-   * Flushes all pending events.
+   * Finishes any pending jobs, without running their completion functions.
+   */
+  ~EventDispatcher() noexcept;
+
+  /**
+   * Completes finished jobs and flushes all pending events.
+   *
+   * \details
+   * Events pushed by job completion functions are dispatched in the same update.
    */
   void update();
 
+  /**
+   * Blocks until all jobs started by event handlers have finished.
+   */
+  void wait_for_jobs();
+
   /**
    * Pushes an event to the event queue.
    *
    * \details
-   * Use the \c update function to issue enqueued events.
+   * Use the \c update function to issue enqueued events. Events of types that
+   * have been registered with \c coalesce may be merged with pending events.
    *
    * \tparam Event The event type.
    * \tparam Args  The event argument types.
@@ -35,7 +115,20 @@ class EventDispatcher final
   template <typename Event, typename... Args>
   void push(Args&&... args)
   {
-    if (!mDispatcher.sink<Event>().empty()) {
+    if (mDispatcher.sink<Event>().empty()) {
+      return;
+    }
+
+    ++mPendingStats.pushed_count;
+
+    const auto queue_iter = mCoalescedQueues.find(entt::type_hash<Event>::value());
+    if (queue_iter != mCoalescedQueues.end()) {
+      auto& queue = static_cast<CoalescedEventQueue<Event>&>(*queue_iter->second);
+      if (queue.push(Event {std::forward<Args>(args)...})) {
+        ++mPendingStats.coalesced_count;
+      }
+    }
+    else {
       mDispatcher.enqueue<Event>(std::forward<Args>(args)...);
     }
   }
@@ -71,8 +164,159 @@ class EventDispatcher final
     mDispatcher.sink<Event>().template connect<Slot>(std::forward<Args>(args)...);
   }
 
+  /**
+   * Binds a worker-eligible handler to an event.
+   *
+   * \details
+   * The handler is invoked on the main thread, where it should validate the
+   * event and copy any state it needs, and returns a job that does the actual
+   * work on a worker thread. The results of the job are applied by its
+   * completion function, which is run on the main thread during a later update.
+   * Handlers that have nothing to do may return an empty job. Handlers that only
+   * wait for an operation started elsewhere should return a \c DeferredJob instead.
+   *
+   * \tparam Event    The event type.
+   * \tparam Slot     The handler member function, with the signature \c Job(const Event&)
+   *                  or \c DeferredJob(const Event&).
+   * \tparam Instance The handler type.
+   *
+   * \param instance The handler instance, cannot be null.
+   *
+   * \see JobSystem
+   */
+  template <typename Event, auto Slot, typename Instance>
+  void bind_job(Instance* instance)
+  {
+    using binding_type = JobBinding<Event, Slot, Instance>;
+
+    auto binding = std::make_unique<binding_type>(instance, &mJobSystem);
+    mDispatcher.sink<Event>().template connect<&binding_type::on_event>(binding.get());
+
+    mJobBindings.push_back(std::move(binding));
+  }
+
+  /**
+   * Enables coalescing of pending events of a given type.
+   *
+   * \details
+   * Events pushed with the same key as a pending event are merged into the
+   * pending event according to the coalescing policy, instead of being
+   * dispatched separately. This is intended for high-frequency events where
+   * only the net effect matters, which would otherwise pile up during slow
+   * frames. Pending events are dispatched in the order they were first pushed.
+   *
+   * \tparam Event  The event type.
+   * \tparam Key    A pointer to the event data member that identifies related events.
+   * \tparam Policy The coalescing policy, e.g., \c KeepLastEvent or \c SumEventMember.
+   */
+  template <typename Event, auto Key, typename Policy = KeepLastEvent>
+  void coalesce()
+  {
+    mCoalescedQueues[entt::type_hash<Event>::value()] =
+        std::make_unique<CoalescedEventQueue<Event>>(
+            [](const Event& a, const Event& b) {
+              return std::invoke(Key, a) == std::invoke(Key, b);
+            },
+            [](Event& pending_event, Event&& event) {
+              Policy::merge(pending_event, std::move(event));
+            });
+  }
+
+  /**
+   * Returns statistics about the most recent update.
+   *
+   * \return
+   * The event statistics of the previous update.
+   */
+  [[nodiscard]]
+  auto get_stats() const -> const EventDispatchStats&;
+
  private:
-  entt::dispatcher mDispatcher {};
+  class ICoalescedEventQueue
+  {
+   public:
+    TACTILE_INTERFACE_CLASS(ICoalescedEventQueue);
+
+    virtual void flush(entt::dispatcher& dispatcher) = 0;
+  };
+
+  template <typename Event>
+  class CoalescedEventQueue final : public ICoalescedEventQueue
+  {
+   public:
+    using key_equal_type = bool (*)(const Event&, const Event&);
+    using merge_type = void (*)(Event&, Event&&);
+
+    CoalescedEventQueue(const key_equal_type key_equal, const merge_type merge)
+      : mKeyEqual {key_equal},
+        mMerge {merge}
+    {}
+
+    // Returns true if the event was merged into a pending event.
+    auto push(Event&& event) -> bool
+    {
+      const auto pending_iter =
+          std::ranges::find_if(mPendingEvents, [&](const Event& pending_event) {
+            return mKeyEqual(pending_event, event);
+          });
+
+      if (pending_iter != mPendingEvents.end()) {
+        mMerge(*pending_iter, std::move(event));
+        return true;
+      }
+
+      mPendingEvents.push_back(std::move(event));
+      return false;
+    }
+
+    void flush(entt::dispatcher& dispatcher) override
+    {
+      for (auto& event : mPendingEvents) {
+        dispatcher.enqueue(std::move(event));
+      }
+
+      mPendingEvents.clear();
+    }
+
+   private:
+    key_equal_type mKeyEqual;
+    merge_type mMerge;
+    std::vector<Event> mPendingEvents {};
+  };
+
+  class IJobBinding
+  {
+   public:
+    TACTILE_INTERFACE_CLASS(IJobBinding);
+  };
+
+  template <typename Event, auto Slot, typename Instance>
+  class JobBinding final : public IJobBinding
+  {
+   public:
+    JobBinding(Instance* instance, JobSystem* job_system)
+      : mInstance {instance},
+        mJobSystem {job_system}
+    {}
+
+    void on_event(const Event& event)
+    {
+      mJobSystem->submit(std::invoke(Slot, mInstance, event));
+    }
+
+   private:
+    Instance* mInstance;
+    JobSystem* mJobSystem;
+  };
+
+  entt::dispatcher mDispatcher;
+  std::unordered_map<entt::id_type, std::unique_ptr<ICoalescedEventQueue>> mCoalescedQueues;
+  std::vector<std::unique_ptr<IJobBinding>> mJobBindings;
+  EventDispatchStats mPendingStats;
+  EventDispatchStats mStats;
+
+  // Declared last, so that the remaining jobs finish before anything else is destroyed.
+  JobSystem mJobSystem;
 };
 
 }  // namespace tactile::core
@@ -2,17 +2,23 @@
 
 #pragma once
 
+#include <cstdint>     // uint64_t
 #include <filesystem>  // path
+#include <optional>    // optional
 #include <string>      // string
 
+#include "tactile/base/debug/error_code.hpp"
 #include "tactile/base/layer/layer_type.hpp"
 #include "tactile/base/layer/object_type.hpp"
 #include "tactile/base/meta/attribute.hpp"
+#include "tactile/base/numeric/index_2d.hpp"
 #include "tactile/base/numeric/vec.hpp"
+#include "tactile/base/util/tile_matrix.hpp"
 #include "tactile/core/entity/entity.hpp"
 #include "tactile/core/map/map_spec.hpp"
 #include "tactile/core/ui/fonts.hpp"
 #include "tactile/core/ui/theme.hpp"
+#include "tactile/core/util/uuid.hpp"
 
 namespace tactile::core {
 
@@ -136,6 +142,12 @@ struct ToggleAnimationDockEvent final
 struct ToggleLogDockEvent final
 {};
 
+/**
+ * Event for toggling the visibility of the profiler dock widget.
+ */
+struct ToggleProfilerDockEvent final
+{};
+
 /**
  * Event for changing the active editor theme.
  */
@@ -272,6 +284,21 @@ struct SaveAsEvent final
   std::filesystem::path path;
 };
 
+/**
+ * Event for when a map document has been saved in the background.
+ */
+struct MapSavedEvent final
+{
+  /** The UUID of the saved document. */
+  UUID document_uuid;
+
+  /** The path of the map file. */
+  std::filesystem::path path;
+
+  /** The reason that the map couldn't be saved, if it failed. */
+  std::optional<ErrorCode> error;
+};
+
 /**
  * Event for reopening the last closed file.
  */
@@ -431,6 +458,39 @@ struct SetLayerVisibleEvent final
   bool visible;
 };
 
+/**
+ * Event for stamping a pattern of tiles onto a tile layer in the active map.
+ */
+struct StampTilesEvent final
+{
+  /** The target tile layer. */
+  EntityID layer_entity;
+
+  /** The tool stroke identifier, events with the same identifier are merged. */
+  std::uint64_t stroke_id;
+
+  /** The position of the top-left tile in the pattern. */
+  Index2D position;
+
+  /** The tiles to stamp. */
+  TileMatrix pattern;
+};
+
+/**
+ * Event for erasing a tile in a tile layer in the active map.
+ */
+struct EraseTilesEvent final
+{
+  /** The target tile layer. */
+  EntityID layer_entity;
+
+  /** The tool stroke identifier, events with the same identifier are merged. */
+  std::uint64_t stroke_id;
+
+  /** The position of the tile to erase. */
+  Index2D position;
+};
+
 struct CreateObjectEvent final
 {
   EntityID layer_id;
@@ -538,6 +598,18 @@ struct ExportAsGodotSceneEvent final
   std::filesystem::path project_dir;
 };
 
+/**
+ * Event for when a map has been exported as a Godot scene in the background.
+ */
+struct GodotSceneExportedEvent final
+{
+  /** The base directory of the Godot project. */
+  std::filesystem::path project_dir;
+
+  /** The reason that the map couldn't be exported, if it failed. */
+  std::optional<ErrorCode> error;
+};
+
 /**
  * Event for opening the tileset creation dialog.
  */
@@ -8,10 +8,12 @@
 namespace tactile::core {
 
 class Model;
+class MapSaver;
 class EventDispatcher;
 
 struct SaveEvent;
 struct SaveAsEvent;
+struct MapSavedEvent;
 struct ReopenLastClosedFileEvent;
 struct ClearFileHistoryEvent;
 struct CloseEvent;
@@ -26,10 +28,11 @@ class FileEventHandler final
   /**
    * Creates an file event handler.
    *
-   * \param model   The associated model, cannot be null.
-   * \param runtime The associated runtime, cannot be null.
+   * \param model     The associated model, cannot be null.
+   * \param runtime   The associated runtime, cannot be null.
+   * \param map_saver The map saver used to save documents, cannot be null.
    */
-  FileEventHandler(Model* model, IRuntime* runtime);
+  FileEventHandler(Model* model, IRuntime* runtime, MapSaver* map_saver);
 
   /**
    * Installs the event handler to a given event dispatcher.
@@ -39,7 +42,11 @@ class FileEventHandler final
   void install(EventDispatcher& dispatcher);
 
   /**
-   * Saves the state of the active document to disk.
+   * Starts saving the state of the active document to disk.
+   *
+   * \details
+   * The document is saved in the background, and is considered to be clean as
+   * soon as the save has started.
    *
    * \param event The associated event.
    */
@@ -52,6 +59,13 @@ class FileEventHandler final
    */
   void on_save_as(const SaveAsEvent& event);
 
+  /**
+   * Reports the result of a background save.
+   *
+   * \param event The associated event.
+   */
+  void on_map_saved(const MapSavedEvent& event);
+
   /**
    * Reopens the most recently closed document.
    *
@@ -83,6 +97,7 @@ class FileEventHandler final
  private:
   Model* mModel;
   IRuntime* mRuntime;
+  MapSaver* mMapSaver;
 };
 
 }  // namespace tactile::core
@@ -0,0 +1,137 @@
+// Copyright (C) 2024 Albin Johansson (GNU General Public License v3.0)
+
+#pragma once
+
+#include <cstddef>     // size_t
+#include <functional>  // function
+#include <future>      // future
+#include <vector>      // vector
+
+#include "tactile/base/prelude.hpp"
+#include "tactile/core/util/worker_pool.hpp"
+
+namespace tactile::core {
+
+class EventDispatcher;
+
+/**
+ * A function that is run on the main thread once the associated job has finished.
+ *
+ * \details
+ * Completion functions are where the results of jobs are applied to documents,
+ * usually by submitting commands, and where completion events are pushed.
+ */
+using JobCompletion = std::function<void(EventDispatcher&)>;
+
+/**
+ * A function that is run on a worker thread.
+ *
+ * \details
+ * Jobs must not access registries or any other main thread state. Instead, any
+ * required data should be copied into the job when it's created, e.g., using
+ * \c make_map_snapshot. Jobs may return an empty completion function.
+ */
+using Job = std::function<JobCompletion()>;
+
+/**
+ * A completion function that is run once an operation started elsewhere has finished.
+ *
+ * \details
+ * Deferred jobs don't occupy a worker thread while waiting for their operation,
+ * e.g., an image that is decoded by the texture cache. Instead, the operation is
+ * polled on the main thread. Deferred jobs without a completion function are ignored.
+ */
+struct DeferredJob final
+{
+  /** Indicates whether the operation has finished, must not block. */
+  std::function<bool()> is_ready;
+
+  /** Blocks until the operation has finished. */
+  std::function<void()> wait;
+
+  /** The function that is run on the main thread once the operation has finished. */
+  JobCompletion completion;
+};
+
+/**
+ * Runs jobs on a pool of worker threads, and applies their results on the main thread.
+ *
+ * \note
+ * The \c submit, \c update, and \c wait functions must only be called from the
+ * main thread.
+ */
+class JobSystem final
+{
+ public:
+  TACTILE_DELETE_COPY(JobSystem);
+  TACTILE_DELETE_MOVE(JobSystem);
+
+  /**
+   * Creates a job system.
+   *
+   * \param worker_count The number of worker threads, at least one is used.
+   */
+  explicit JobSystem(std::size_t worker_count);
+
+  /**
+   * Finishes any pending jobs, without running their completion functions.
+   */
+  ~JobSystem() noexcept;
+
+  /**
+   * Schedules a job to be run on a worker thread.
+   *
+   * \param job The job to run, ignored if empty.
+   */
+  void submit(Job job);
+
+  /**
+   * Schedules a completion function to run once an operation has finished.
+   *
+   * \details
+   * Deferred jobs are completed in submission order along with other jobs.
+   *
+   * \param job The deferred job, ignored if it has no completion function.
+   */
+  void submit(DeferredJob job);
+
+  /**
+   * Runs the completion functions of the jobs that have finished since the last call.
+   *
+   * \details
+   * Completion functions are run in the order that the jobs were submitted,
+   * and jobs that finish out of order are held back until all earlier jobs have
+   * finished. Errors thrown by jobs are logged and otherwise ignored.
+   *
+   * \param dispatcher The event dispatcher provided to the completion functions.
+   */
+  void update(EventDispatcher& dispatcher);
+
+  /**
+   * Blocks until all pending jobs have finished.
+   */
+  void wait();
+
+  /**
+   * Returns the number of jobs that haven't been completed.
+   *
+   * \return
+   * The number of pending jobs.
+   */
+  [[nodiscard]]
+  auto pending_count() const -> std::size_t;
+
+ private:
+  struct PendingJob final
+  {
+    std::future<JobCompletion> result;  ///< Only valid for jobs run by workers.
+    DeferredJob deferred;               ///< Only used by deferred jobs.
+  };
+
+  std::vector<PendingJob> mPendingJobs;
+
+  // Declared last, so that the remaining jobs finish before anything else is destroyed.
+  WorkerPool mWorkerPool;
+};
+
+}  // namespace tactile::core
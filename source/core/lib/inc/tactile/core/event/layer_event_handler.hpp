@@ -17,6 +17,8 @@ struct MoveLayerDownEvent;
 struct RenameLayerEvent;
 struct SetLayerOpacityEvent;
 struct SetLayerVisibleEvent;
+struct StampTilesEvent;
+struct EraseTilesEvent;
 
 /**
  * Handles events related to map layers.
@@ -94,6 +96,20 @@ class LayerEventHandler final
    */
   void on_set_layer_visible(const SetLayerVisibleEvent& event);
 
+  /**
+   * Stamps tiles onto a tile layer in the active map.
+   *
+   * \param event The associated event.
+   */
+  void on_stamp_tiles(const StampTilesEvent& event);
+
+  /**
+   * Erases a tile in a tile layer in the active map.
+   *
+   * \param event The associated event.
+   */
+  void on_erase_tiles(const EraseTilesEvent& event);
+
  private:
   Model* mModel;
 };
@@ -2,17 +2,15 @@
 
 #pragma once
 
-#include <filesystem>  // path
-#include <optional>    // optional
-
-#include "tactile/base/io/save/save_format_id.hpp"
 #include "tactile/base/prelude.hpp"
 #include "tactile/base/runtime/runtime.hpp"
+#include "tactile/core/event/job_system.hpp"
 
 namespace tactile::core {
 
 class Model;
 class EventDispatcher;
+class TextureCache;
 
 namespace ui {
 class WidgetManager;
@@ -23,6 +21,7 @@ struct ShowOpenMapDialogEvent;
 struct ShowGodotExportDialogEvent;
 struct CreateMapEvent;
 struct ExportAsGodotSceneEvent;
+struct GodotSceneExportedEvent;
 
 /**
  * Handles events related to maps.
@@ -36,8 +35,12 @@ class MapEventHandler final
    * \param model          The associated model, cannot be null.
    * \param widget_manager The associated widget manager, cannot be null.
    * \param runtime        The associated runtim, cannot be null.
+   * \param texture_cache  The texture cache used by documents, cannot be null.
    */
-  MapEventHandler(Model* model, ui::WidgetManager* widget_manager, IRuntime* runtime);
+  MapEventHandler(Model* model,
+                  ui::WidgetManager* widget_manager,
+                  IRuntime* runtime,
+                  TextureCache* texture_cache);
 
   /**
    * Installs the event handler to a given event dispatcher.
@@ -69,16 +72,32 @@ class MapEventHandler final
    */
   void on_create_map(const CreateMapEvent& event);
 
-  void on_export_as_godot_scene(const ExportAsGodotSceneEvent& event) const;
+  /**
+   * Starts exporting the current map as a Godot scene.
+   *
+   * \details
+   * The map is copied on the main thread, and then exported on a worker thread.
+   *
+   * \param event The associated event.
+   *
+   * \return
+   * The export job, which is empty if the map can't be exported.
+   */
+  [[nodiscard]]
+  auto on_export_as_godot_scene(const ExportAsGodotSceneEvent& event) const -> Job;
+
+  /**
+   * Reports the outcome of a Godot scene export.
+   *
+   * \param event The associated event.
+   */
+  void on_godot_scene_exported(const GodotSceneExportedEvent& event);
 
  private:
   Model* mModel;
   ui::WidgetManager* mWidgetManager;
   IRuntime* mRuntime;
-
-  [[nodiscard]]
-  static auto _guess_save_format(const std::filesystem::path& path)
-      -> std::optional<SaveFormatId>;
+  TextureCache* mTextureCache;
 };
 
 }  // namespace tactile::core
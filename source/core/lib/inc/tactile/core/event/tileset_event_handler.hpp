@@ -2,13 +2,17 @@
 
 #pragma once
 
+#include "tactile/base/numeric/vec.hpp"
 #include "tactile/base/prelude.hpp"
-#include "tactile/base/render/renderer.hpp"
+#include "tactile/core/event/job_system.hpp"
+#include "tactile/core/util/uuid.hpp"
 
 namespace tactile::core {
 
 class Model;
 class EventDispatcher;
+class TextureCache;
+class PendingTexture;
 
 namespace ui {
 class WidgetManager;
@@ -27,10 +31,12 @@ class TilesetEventHandler final
    * Creates a tileset event handler.
    *
    * \param model          The associated model, cannot be null.
-   * \param renderer       The associated renderer, cannot be null.
+   * \param texture_cache  The texture cache used by documents, cannot be null.
    * \param widget_manager The associated widget manager, cannot be null.
    */
-  TilesetEventHandler(Model* model, IRenderer* renderer, ui::WidgetManager* widget_manager);
+  TilesetEventHandler(Model* model,
+                      TextureCache* texture_cache,
+                      ui::WidgetManager* widget_manager);
 
   /**
    * Installs the event handler to a given event dispatcher.
@@ -47,16 +53,29 @@ class TilesetEventHandler final
   void on_show_new_tileset_dialog(const ShowNewTilesetDialogEvent& event);
 
   /**
-   * Creates a new tileset.
+   * Creates a new tileset in the current map.
+   *
+   * \details
+   * The tileset image is decoded in the background, and the tileset is added
+   * once the image is ready, even if another document has been made current.
    *
    * \param event The associated event.
+   *
+   * \return
+   * The job that adds the tileset once the image is ready, which is empty if there
+   * is no map.
    */
-  void on_add_tileset(const AddTilesetEvent& event);
+  [[nodiscard]]
+  auto on_add_tileset(const AddTilesetEvent& event) -> DeferredJob;
 
  private:
   Model* mModel;
-  IRenderer* mRenderer;
+  TextureCache* mTextureCache;
   ui::WidgetManager* mWidgetManager;
+
+  void _finish_add_tileset(const UUID& document_uuid,
+                           const Int2& tile_size,
+                           PendingTexture pending_texture);
 };
 
 }  // namespace tactile::core
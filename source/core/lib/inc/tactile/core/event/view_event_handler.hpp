@@ -21,6 +21,7 @@ struct ToggleLayerDockEvent;
 struct ToggleTilesetDockEvent;
 struct ToggleAnimationDockEvent;
 struct ToggleLogDockEvent;
+struct ToggleProfilerDockEvent;
 struct SetThemeEvent;
 struct IncreaseFontSizeEvent;
 struct DecreaseFontSizeEvent;
@@ -101,6 +102,13 @@ class ViewEventHandler
    */
   void on_toggle_log_dock(const ToggleLogDockEvent& event);
 
+  /**
+   * Toggles the visibility of the profiler dock.
+   *
+   * \param event The associated event.
+   */
+  void on_toggle_profiler_dock(const ToggleProfilerDockEvent& event);
+
   /**
    * Changes the active editor theme.
    *
@@ -0,0 +1,99 @@
+// Copyright (C) 2024 Albin Johansson (GNU General Public License v3.0)
+
+#pragma once
+
+#include <expected>    // expected
+#include <filesystem>  // path
+#include <optional>    // optional
+
+#include "tactile/base/debug/error_code.hpp"
+#include "tactile/base/io/save/save_format_id.hpp"
+#include "tactile/base/prelude.hpp"
+#include "tactile/base/runtime/runtime.hpp"
+
+namespace tactile::core {
+
+class TextureCache;
+
+/** The major Godot version targeted by converted Godot scenes. */
+inline constexpr int kConverterGodotVersion = 3;
+
+/**
+ * Provides the parameters of a single map conversion.
+ */
+struct MapConversionSpec final
+{
+  /** The path to the source map file. */
+  std::filesystem::path input_path;
+
+  /**
+   * The path to the destination map file. Godot scenes are always saved as
+   * "map.tscn", so the parent directory is what matters for that format.
+   */
+  std::filesystem::path output_path;
+
+  /** The save format used by the destination map. */
+  SaveFormatId output_format;
+};
+
+/**
+ * Guesses the save format of a map file based on its file extension.
+ *
+ * \param path The path to a map file.
+ *
+ * \return
+ * A save format identifier if the extension is recognized; an empty optional
+ * otherwise.
+ */
+[[nodiscard]]
+auto guess_save_format(const std::filesystem::path& path) -> std::optional<SaveFormatId>;
+
+/**
+ * Indicates whether a file contains a map that can be converted.
+ *
+ * \details
+ * Tiled maps and external tilesets may share file extensions, e.g., ".json" and
+ * ".xml", so the root of Tiled files is inspected to tell them apart. The file is
+ * only scanned, not parsed, so this function doesn't validate the map itself.
+ *
+ * \param path The path to a file.
+ *
+ * \return
+ * True if the file is a map in a supported input save format; false otherwise.
+ */
+[[nodiscard]]
+auto is_convertible_map_file(const std::filesystem::path& path) -> bool;
+
+/**
+ * Returns the conventional file extension for a save format.
+ *
+ * \param format_id The save format to query.
+ *
+ * \return
+ * A file extension, including the leading period.
+ */
+[[nodiscard]]
+auto get_save_format_extension(SaveFormatId format_id) -> const char*;
+
+/**
+ * Loads a map and saves it using another save format.
+ *
+ * \details
+ * The map is loaded into a temporary map document, which is never added to a
+ * document manager. As such, this function doesn't touch any editor state and
+ * may be called from several threads at once, as long as the renderer used by
+ * the texture cache and the installed save formats are thread-safe.
+ *
+ * \param runtime       The runtime that provides the save formats.
+ * \param texture_cache The cache used to load tileset textures.
+ * \param spec          The conversion parameters.
+ *
+ * \return
+ * Nothing if successful; an error code otherwise.
+ */
+[[nodiscard]]
+auto convert_map(const IRuntime& runtime,
+                 TextureCache& texture_cache,
+                 const MapConversionSpec& spec) -> std::expected<void, ErrorCode>;
+
+}  // namespace tactile::core
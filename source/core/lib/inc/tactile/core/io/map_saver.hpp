@@ -0,0 +1,115 @@
+// Copyright (C) 2024 Albin Johansson (GNU General Public License v3.0)
+
+#pragma once
+
+#include <cstddef>     // size_t
+#include <expected>    // expected
+#include <filesystem>  // path
+#include <future>      // future
+#include <vector>      // vector
+
+#include "tactile/base/debug/error_code.hpp"
+#include "tactile/base/io/save/save_format.hpp"
+#include "tactile/base/prelude.hpp"
+#include "tactile/core/cmd/command_journal.hpp"
+#include "tactile/core/util/uuid.hpp"
+#include "tactile/core/util/worker_pool.hpp"
+
+namespace tactile {
+class IRuntime;
+}  // namespace tactile
+
+namespace tactile::core {
+
+class MapDocument;
+class EventDispatcher;
+
+/**
+ * Saves map documents on a background thread.
+ *
+ * \details
+ * Documents are copied to intermediate representations when a save is
+ * requested, which is cheap compared to the actual serialization, compression,
+ * and file I/O. The copies are then saved on a worker thread, so documents can
+ * be edited while they are being saved. Saves are run one at a time, in the
+ * order that they were requested, so the latest save of a file always wins.
+ */
+class MapSaver final
+{
+ public:
+  TACTILE_DELETE_COPY(MapSaver);
+  TACTILE_DELETE_MOVE(MapSaver);
+
+  /**
+   * Creates a map saver.
+   *
+   * \param runtime The runtime that provides the save formats, cannot be null.
+   */
+  explicit MapSaver(IRuntime* runtime);
+
+  /**
+   * Finishes any pending saves.
+   */
+  ~MapSaver() noexcept;
+
+  /**
+   * Starts saving a map document to its associated file.
+   *
+   * \details
+   * The document state is captured before this function returns. The provided
+   * journal records are written to the command journal of the map file once
+   * the map has been saved.
+   *
+   * \param document        The document to save, must have an associated path.
+   * \param options         The write options to use.
+   * \param journal_records The journal records of the applied commands.
+   * \param journal_budget  The maximum size of the command journal, in bytes.
+   *
+   * \return
+   * Nothing if the save was started; an error code otherwise.
+   */
+  [[nodiscard]]
+  auto save(const MapDocument& document,
+            const SaveFormatWriteOptions& options,
+            std::vector<CommandJournalRecord> journal_records,
+            std::size_t journal_budget) -> std::expected<void, ErrorCode>;
+
+  /**
+   * Emits a \c MapSavedEvent for each save that has finished since the last call.
+   *
+   * \param dispatcher The event dispatcher to use.
+   */
+  void update(EventDispatcher& dispatcher);
+
+  /**
+   * Blocks until all pending saves have finished.
+   */
+  void wait();
+
+  /**
+   * Indicates whether a document is being saved.
+   *
+   * \param document_uuid The UUID of the document to check.
+   *
+   * \return
+   * True if the document has a pending save; false otherwise.
+   */
+  [[nodiscard]]
+  auto is_saving(const UUID& document_uuid) const -> bool;
+
+ private:
+  struct PendingSave final
+  {
+    UUID document_uuid;
+    std::filesystem::path path;
+    std::future<std::expected<void, ErrorCode>> result;
+  };
+
+  IRuntime* mRuntime;
+  std::vector<PendingSave> mPendingSaves;
+
+  // Declared last, so that the remaining saves finish before anything else is destroyed.
+  WorkerPool mWorkerPool;
+};
+
+}  // namespace tactile::core
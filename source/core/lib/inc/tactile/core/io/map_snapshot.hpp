@@ -0,0 +1,31 @@
+// Copyright (C) 2024 Albin Johansson (GNU General Public License v3.0)
+
+#pragma once
+
+#include <expected>  // expected
+
+#include "tactile/base/debug/error_code.hpp"
+#include "tactile/base/document/map_view.hpp"
+#include "tactile/base/io/save/ir.hpp"
+#include "tactile/base/prelude.hpp"
+
+namespace tactile::core {
+
+/**
+ * Creates an intermediate representation of a map.
+ *
+ * \details
+ * The returned map is a deep copy that doesn't refer to any document state, so
+ * it can be saved on another thread using \c IrMapView while the document is
+ * being edited. Copying the map is much cheaper than saving it, since no
+ * encoding, compression, or file I/O is involved.
+ *
+ * \param map The map to copy.
+ *
+ * \return
+ * The map representation if successful; an error code otherwise.
+ */
+[[nodiscard]]
+auto make_map_snapshot(const IMapView& map) -> std::expected<ir::Map, ErrorCode>;
+
+}  // namespace tactile::core
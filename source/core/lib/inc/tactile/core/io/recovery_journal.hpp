@@ -0,0 +1,243 @@
+// Copyright (C) 2024 Albin Johansson (GNU General Public License v3.0)
+
+#pragma once
+
+#include <cstddef>     // size_t
+#include <expected>    // expected
+#include <filesystem>  // path
+#include <optional>    // optional
+#include <vector>      // vector
+
+#include "tactile/base/debug/error_code.hpp"
+#include "tactile/base/io/byte_stream.hpp"
+#include "tactile/base/io/save/save_format_id.hpp"
+#include "tactile/base/prelude.hpp"
+#include "tactile/core/cmd/command.hpp"
+#include "tactile/core/cmd/command_journal.hpp"
+
+namespace tactile::core {
+
+/**
+ * Describes the file that the changes in a recovery journal are based on.
+ */
+struct RecoveryJournalBase final
+{
+  /** The path to the base file, either a saved map file or a recovery snapshot. */
+  std::filesystem::path file_path;
+
+  /** The save format used by the base file. */
+  SaveFormatId format;
+
+  /** Identifies the version of the base file, used to detect modified files. */
+  CommandJournalKey key;
+
+  /** Whether the base file is a recovery snapshot owned by the journal. */
+  bool is_snapshot;
+
+  [[nodiscard]]
+  auto operator==(const RecoveryJournalBase&) const -> bool = default;
+};
+
+/**
+ * The contents of a recovery journal file.
+ */
+struct RecoveryJournalContent final
+{
+  /** The file that the changes are based on. */
+  RecoveryJournalBase base;
+
+  /** The path of the associated map document, if it had been saved. */
+  std::optional<std::filesystem::path> map_path;
+
+  /** The changes made after the base file was written, oldest first. */
+  std::vector<CommandJournalRecord> records;
+};
+
+/**
+ * A write-ahead journal of the changes made to a map document, used to recover
+ * unsaved changes after crashes.
+ *
+ * \details
+ * The journal observes the command stack of a document and records each
+ * executed or reverted command, which are appended to the journal file in small
+ * batches using \c flush. Recovering a document amounts to loading the base
+ * file and applying the recorded changes, so the entire map doesn't have to be
+ * written to disk for every change.
+ *
+ * Commands that can't be described by journal records invalidate the journal,
+ * since later records can't be applied without them. Invalid journals must be
+ * reset with a new base file, e.g., a snapshot of the entire document.
+ *
+ * Snapshots are written in the background. The changes recorded while a
+ * snapshot is written are kept separately, and become the initial records of
+ * the journal once it's based on the snapshot.
+ */
+class RecoveryJournal final : public ICommandObserver
+{
+ public:
+  TACTILE_DELETE_COPY(RecoveryJournal);
+  TACTILE_DELETE_MOVE(RecoveryJournal);
+
+  /**
+   * Creates a journal without a base file, which is invalid until reset.
+   *
+   * \param journal_path The path of the journal file.
+   */
+  explicit RecoveryJournal(std::filesystem::path journal_path);
+
+  ~RecoveryJournal() noexcept override = default;
+
+  void on_command_executed(const ICommand& command) override;
+
+  void on_command_reverted(const ICommand& command) override;
+
+  /**
+   * Starts a new journal on top of a base file.
+   *
+   * \details
+   * The journal file is replaced without any of the previous records, after
+   * which the previous base file is removed if it was a snapshot. The journal
+   * file is always valid on disk, even if this function is interrupted. Pending
+   * snapshots are abandoned, since they're based on the previous journal.
+   *
+   * \param base     The new base file.
+   * \param map_path The path of the associated map document, may be null.
+   *
+   * \return
+   * Nothing if successful; an error code otherwise.
+   */
+  [[nodiscard]]
+  auto reset(const RecoveryJournalBase& base, const std::filesystem::path* map_path)
+      -> std::expected<void, ErrorCode>;
+
+  /**
+   * Marks the start of a snapshot of the document, taken by the caller.
+   *
+   * \details
+   * Changes recorded after this call are also kept for the journal based on
+   * the snapshot, even if the current journal is invalid. Any previously
+   * started snapshot is abandoned.
+   */
+  void begin_snapshot();
+
+  /**
+   * Starts a new journal on top of the snapshot started by \c begin_snapshot.
+   *
+   * \details
+   * The new journal contains the changes recorded since the snapshot was
+   * started, and is only valid if all of them could be recorded.
+   *
+   * \param base     The snapshot file.
+   * \param map_path The path of the associated map document, may be null.
+   *
+   * \return
+   * Nothing if successful; an error code otherwise, \c ErrorCode::kBadState if
+   * the snapshot was abandoned, e.g., by a call to \c reset.
+   */
+  [[nodiscard]]
+  auto finish_snapshot(const RecoveryJournalBase& base, const std::filesystem::path* map_path)
+      -> std::expected<void, ErrorCode>;
+
+  /**
+   * Abandons the snapshot started by \c begin_snapshot, if there is one.
+   */
+  void cancel_snapshot();
+
+  /**
+   * Indicates whether a snapshot has been started, but not yet finished.
+   *
+   * \return
+   * True if there is a pending snapshot; false otherwise.
+   */
+  [[nodiscard]]
+  auto is_snapshot_pending() const -> bool;
+
+  /**
+   * Appends any pending records to the journal file.
+   *
+   * \return
+   * Nothing if successful; an error code otherwise.
+   */
+  [[nodiscard]]
+  auto flush() -> std::expected<void, ErrorCode>;
+
+  /**
+   * Removes the journal file and the base file, if it is a snapshot.
+   */
+  void discard();
+
+  /**
+   * Indicates whether new changes are being recorded.
+   *
+   * \return
+   * True if the journal has a base file and hasn't been invalidated; false otherwise.
+   */
+  [[nodiscard]]
+  auto is_valid() const -> bool;
+
+  /**
+   * Indicates whether any changes have been recorded since the last reset.
+   *
+   * \return
+   * True if there are recorded changes; false otherwise.
+   */
+  [[nodiscard]]
+  auto has_records() const -> bool;
+
+  /**
+   * Returns the size of the recorded changes, including pending records.
+   *
+   * \return
+   * A size in bytes.
+   */
+  [[nodiscard]]
+  auto record_size() const -> std::size_t;
+
+  /**
+   * Returns the current base file, if there is one.
+   *
+   * \return
+   * A pointer to the base file; a null pointer if there is none.
+   */
+  [[nodiscard]]
+  auto get_base() const -> const RecoveryJournalBase*;
+
+ private:
+  struct PendingSnapshot final
+  {
+    ByteStream records;
+    bool is_valid;
+  };
+
+  std::filesystem::path m_journal_path;
+  std::optional<RecoveryJournalBase> m_base {};
+  ByteStream m_pending_records {};
+  std::size_t m_flushed_size {0};
+  bool m_is_valid {false};
+  std::optional<PendingSnapshot> m_pending_snapshot {};
+
+  void _record(const ICommand& command, bool reverted);
+
+  [[nodiscard]]
+  auto _replace(const RecoveryJournalBase& base,
+                const std::filesystem::path* map_path,
+                ByteSpan records) -> std::expected<void, ErrorCode>;
+};
+
+/**
+ * Reads a recovery journal file.
+ *
+ * \details
+ * Journal files may end with an incomplete record if the editor crashed while
+ * a record was written, such records are ignored.
+ *
+ * \param journal_path The path of the journal file.
+ *
+ * \return
+ * The journal contents if successful; an error code otherwise.
+ */
+[[nodiscard]]
+auto read_recovery_journal(const std::filesystem::path& journal_path)
+    -> std::expected<RecoveryJournalContent, ErrorCode>;
+
+}  // namespace tactile::core
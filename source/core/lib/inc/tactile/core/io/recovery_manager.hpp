@@ -0,0 +1,153 @@
+// Copyright (C) 2024 Albin Johansson (GNU General Public License v3.0)
+
+#pragma once
+
+#include <chrono>         // steady_clock
+#include <cstddef>        // size_t
+#include <expected>       // expected
+#include <filesystem>     // path
+#include <memory>         // unique_ptr
+#include <optional>       // optional
+#include <unordered_map>  // unordered_map
+
+#include "tactile/base/debug/error_code.hpp"
+#include "tactile/base/prelude.hpp"
+#include "tactile/core/event/job_system.hpp"
+#include "tactile/core/io/recovery_journal.hpp"
+#include "tactile/core/platform/file_lock.hpp"
+#include "tactile/core/util/uuid.hpp"
+
+namespace tactile {
+class IRuntime;
+}  // namespace tactile
+
+namespace tactile::core {
+
+class Model;
+class MapSaver;
+class MapDocument;
+class CommandStack;
+class TextureCache;
+class EventDispatcher;
+
+/**
+ * Manages the recovery journals of open map documents, and restores documents
+ * from journals left behind by editor sessions that didn't exit normally.
+ *
+ * \details
+ * Changes made to documents are appended to their journals every few seconds.
+ * Documents that haven't been saved, or that have been changed by commands
+ * that aren't supported by the journals, are periodically written to snapshot
+ * files that new journals are based on. Large journals are also compacted into
+ * snapshots. Snapshots are written on a worker thread, and the journals are
+ * switched over to them once they have been written.
+ *
+ * Each editor instance stores its journals in a separate session directory,
+ * which is locked for as long as the instance is running. This prevents other
+ * instances from recovering documents from the journals of a running instance.
+ */
+class RecoveryManager final
+{
+ public:
+  TACTILE_DELETE_COPY(RecoveryManager);
+  TACTILE_DELETE_MOVE(RecoveryManager);
+
+  /**
+   * Creates a recovery manager.
+   *
+   * \param model         The associated model, cannot be null.
+   * \param runtime       The associated runtime, cannot be null.
+   * \param texture_cache The texture cache used by recovered documents, cannot be null.
+   * \param map_saver     The map saver used to save documents, cannot be null.
+   */
+  RecoveryManager(Model* model,
+                  IRuntime* runtime,
+                  TextureCache* texture_cache,
+                  const MapSaver* map_saver);
+
+  /**
+   * Detaches the journals from the document histories.
+   *
+   * \details
+   * Pending snapshots are finished, but the journals aren't based on them.
+   */
+  ~RecoveryManager() noexcept;
+
+  /**
+   * Restores documents from recovery journals written by previous sessions.
+   *
+   * \details
+   * Recovered documents are opened with the recovered changes as undoable
+   * commands, and the associated journal files are removed. Journals that
+   * can't be recovered, e.g., due to disabled save formats, are kept so that
+   * they can be recovered by later sessions. Sessions that are still running
+   * are skipped.
+   *
+   * \return
+   * The number of recovered documents.
+   */
+  auto recover_documents() -> std::size_t;
+
+  /**
+   * Updates the journals of the open documents, should be called every frame.
+   *
+   * \param dispatcher The event dispatcher provided to snapshot completions.
+   */
+  void update(EventDispatcher& dispatcher);
+
+  /**
+   * Removes the journals of all open documents, along with the session directory.
+   *
+   * \details
+   * This should be called when the editor exits normally. Pending snapshots are
+   * finished before the session directory is removed.
+   */
+  void discard_journals();
+
+ private:
+  using Clock = std::chrono::steady_clock;
+
+  struct DocumentJournal final
+  {
+    std::unique_ptr<RecoveryJournal> journal;
+    std::size_t snapshot_count;
+    Clock::time_point last_snapshot_time;
+    bool is_base_outdated;
+  };
+
+  Model* mModel;
+  IRuntime* mRuntime;
+  TextureCache* mTextureCache;
+  const MapSaver* mMapSaver;
+  std::optional<std::filesystem::path> mRecoveryRootDir;
+  std::optional<std::filesystem::path> mRecoveryDir;
+  std::optional<FileLock> mSessionLock;
+  std::unordered_map<UUID, DocumentJournal> mJournals;
+  Clock::time_point mLastFlushTime;
+
+  // Declared last, so that pending snapshots finish before anything else is destroyed.
+  JobSystem mJobSystem;
+
+  void _update_journal(const UUID& document_uuid,
+                       const MapDocument& document,
+                       const CommandStack& history,
+                       DocumentJournal& journal);
+
+  [[nodiscard]]
+  auto _start_snapshot(const UUID& document_uuid,
+                       const MapDocument& document,
+                       DocumentJournal& journal) -> std::expected<void, ErrorCode>;
+
+  void _finish_snapshot(const UUID& document_uuid,
+                        const std::filesystem::path& snapshot_path,
+                        const std::expected<RecoveryJournalBase, ErrorCode>& snapshot_base);
+
+  [[nodiscard]]
+  auto _recover_session(const std::filesystem::path& session_dir) -> std::size_t;
+
+  [[nodiscard]]
+  auto _recover_document(const std::filesystem::path& journal_path)
+      -> std::expected<void, ErrorCode>;
+};
+
+}  // namespace tactile::core
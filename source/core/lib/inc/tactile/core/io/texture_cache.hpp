@@ -0,0 +1,289 @@
+// Copyright (C) 2024 Albin Johansson (GNU General Public License v3.0)
+
+#pragma once
+
+#include <cstddef>        // size_t
+#include <cstdint>        // uint8_t, uint64_t
+#include <expected>       // expected
+#include <filesystem>     // path
+#include <future>         // future
+#include <mutex>          // mutex
+#include <optional>       // optional
+#include <string>         // string
+#include <string_view>    // string_view
+#include <unordered_map>  // unordered_map
+#include <vector>         // vector
+
+#include "tactile/base/debug/error_code.hpp"
+#include "tactile/base/id.hpp"
+#include "tactile/base/meta/color.hpp"
+#include "tactile/base/prelude.hpp"
+#include "tactile/base/render/image_data.hpp"
+#include "tactile/base/render/renderer.hpp"
+#include "tactile/core/io/texture.hpp"
+#include "tactile/core/util/worker_pool.hpp"
+
+namespace tactile {
+struct ImageCacheKey;
+}  // namespace tactile
+
+namespace tactile::core {
+
+class TextureCache;
+
+/**
+ * Context component that references the texture cache used by a registry.
+ *
+ * \details
+ * Each \c CTexture component in a registry with this context component holds a
+ * reference to a texture in the cache. The reference is released when the
+ * owning tileset is destroyed.
+ */
+struct CTextureCacheRef final
+{
+  /** The associated texture cache. */
+  TextureCache* cache;
+};
+
+/**
+ * A handle to a texture image that is being decoded on a worker thread.
+ *
+ * \see TextureCache::acquire_async
+ */
+class PendingTexture final
+{
+ public:
+  /**
+   * Returns the path to the image file.
+   *
+   * \return
+   * An image file path.
+   */
+  [[nodiscard]]
+  auto get_path() const -> const std::filesystem::path&;
+
+  /**
+   * Indicates whether the image has been decoded, i.e., whether acquiring the
+   * texture would only need to upload it.
+   *
+   * \return
+   * True if the decoding has finished; false otherwise.
+   */
+  [[nodiscard]]
+  auto is_ready() const -> bool;
+
+  /**
+   * Blocks until the image has been decoded.
+   *
+   * \details
+   * This function may be called from any thread, e.g., by a job that acquires
+   * the texture on the main thread once it's ready.
+   */
+  void wait() const;
+
+ private:
+  friend class TextureCache;
+
+  struct DecodeResult final
+  {
+    std::string file_key;
+    std::optional<std::size_t> content_hash;
+    std::optional<TextureID> identical_texture;
+    std::optional<ImageData> image;
+  };
+
+  std::filesystem::path mPath;
+  std::future<std::expected<DecodeResult, ErrorCode>> mResult;
+
+  PendingTexture(std::filesystem::path path,
+                 std::future<std::expected<DecodeResult, ErrorCode>> result);
+};
+
+/**
+ * Determines how textures are loaded when creating tilesets.
+ */
+enum class TextureLoadMode : std::uint8_t
+{
+  /** Wait for textures to be loaded. */
+  kBlocking,
+
+  /** Use placeholder textures while textures are loaded in the background. */
+  kDeferred,
+};
+
+/**
+ * A component for entities with a texture that is still being loaded.
+ *
+ * \details
+ * The \c CTexture component of such entities is a placeholder with a null
+ * handle, but with the expected texture size. The placeholder is replaced with
+ * the real texture once it's available.
+ */
+struct CPendingTexture final
+{
+  /** The texture that is being loaded. */
+  PendingTexture texture;
+
+  /** The color used to render the texture until it has been loaded. */
+  UColor placeholder_color;
+};
+
+/**
+ * Manages textures shared between tilesets and documents.
+ *
+ * \details
+ * Textures are keyed by the canonical path, last write time, and size of the
+ * image file. Image files that aren't in the cache are also compared by content
+ * hash, so that identical copies of an image are only uploaded once. Since
+ * hashes may collide, files with matching hashes are also compared byte by
+ * byte before a texture is shared. Textures
+ * are reference counted, and are unloaded when the last reference is released.
+ * Images can be decoded on a pool of worker threads using \c acquire_async,
+ * in which case only the texture upload happens on the calling thread. Decoded
+ * images can also be cached on disk, in an optional cache directory, so that
+ * later sessions can skip decoding altogether.
+ *
+ * \note
+ * This class is thread-safe, provided that the renderer accepts texture uploads
+ * from the threads that acquire textures (usually only the render thread). No
+ * file I/O or texture uploads happen while the internal lock is held. The
+ * associated renderer must outlive the cache.
+ */
+class TextureCache final
+{
+ public:
+  TACTILE_DELETE_COPY(TextureCache);
+  TACTILE_DELETE_MOVE(TextureCache);
+
+  /**
+   * Creates an empty texture cache.
+   *
+   * \param renderer        The renderer used to load textures, cannot be null.
+   * \param image_cache_dir The directory where decoded images are cached between
+   *                        sessions, decoded images aren't stored if empty.
+   */
+  explicit TextureCache(IRenderer* renderer,
+                        std::optional<std::filesystem::path> image_cache_dir = std::nullopt);
+
+  /**
+   * Unloads all textures that remain in the cache.
+   */
+  ~TextureCache() noexcept;
+
+  /**
+   * Acquires a reference to the texture loaded from a given image file.
+   *
+   * \details
+   * The texture is loaded if there is no matching texture in the cache. Each
+   * successful call must be matched by a call to \c release.
+   *
+   * \param path The path to the image file.
+   *
+   * \return
+   * The texture if successful; an error code otherwise.
+   */
+  [[nodiscard]]
+  auto acquire(const std::filesystem::path& path) -> std::expected<CTexture, ErrorCode>;
+
+  /**
+   * Starts decoding the image used by a texture on a worker thread.
+   *
+   * \details
+   * Decoding is skipped for images that are already in the cache. Use this
+   * function to decode several images concurrently, and then acquire each
+   * texture using the returned handles.
+   *
+   * \param path The path to the image file.
+   *
+   * \return
+   * A handle to the pending texture.
+   */
+  [[nodiscard]]
+  auto acquire_async(const std::filesystem::path& path) -> PendingTexture;
+
+  /**
+   * Acquires a reference to a texture decoded by \c acquire_async.
+   *
+   * \details
+   * This function waits until the image has been decoded, and then uploads it
+   * to the renderer if there is no matching texture in the cache. Each
+   * successful call must be matched by a call to \c release.
+   *
+   * \param pending_texture The handle to the pending texture.
+   *
+   * \return
+   * The texture if successful; an error code otherwise.
+   */
+  [[nodiscard]]
+  auto acquire(PendingTexture pending_texture) -> std::expected<CTexture, ErrorCode>;
+
+  /**
+   * Releases a reference to a texture.
+   *
+   * \details
+   * The texture is unloaded if this was the last reference. This function has
+   * no effect if the texture isn't managed by the cache.
+   *
+   * \param texture_id The identifier of the texture to release.
+   */
+  void release(TextureID texture_id);
+
+  /**
+   * Returns the number of references to a texture.
+   *
+   * \param texture_id The identifier of the texture to look for.
+   *
+   * \return
+   * The reference count, which is zero for textures not in the cache.
+   */
+  [[nodiscard]]
+  auto use_count(TextureID texture_id) const -> std::size_t;
+
+  /**
+   * Returns the number of textures in the cache.
+   *
+   * \return
+   * The number of loaded textures.
+   */
+  [[nodiscard]]
+  auto size() const -> std::size_t;
+
+ private:
+  struct Entry final
+  {
+    CTexture texture;
+    std::size_t use_count;
+    std::size_t content_hash;
+    std::uint64_t file_size;
+    std::filesystem::path source_path;
+    std::vector<std::string> file_keys;
+  };
+
+  using DecodeResult = PendingTexture::DecodeResult;
+
+  IRenderer* mRenderer;
+  std::optional<std::filesystem::path> mImageCacheDir;
+  mutable std::mutex mMutex;
+  std::unordered_map<TextureID, Entry> mEntries;
+  std::unordered_map<std::string, TextureID> mFileKeys;
+  std::unordered_map<std::size_t, TextureID> mContentHashes;
+
+  // Declared last, so that the workers finish before the other members are destroyed.
+  WorkerPool mWorkerPool;
+
+  [[nodiscard]]
+  auto _decode(const std::filesystem::path& path, bool skip_cached_images) const
+      -> std::expected<DecodeResult, ErrorCode>;
+
+  [[nodiscard]]
+  auto _find_identical_texture(std::string_view file_content,
+                               const ImageCacheKey& cache_key) const
+      -> std::optional<TextureID>;
+
+  [[nodiscard]]
+  auto _acquire(const std::filesystem::path& path,
+                std::expected<DecodeResult, ErrorCode> decode_result)
+      -> std::expected<CTexture, ErrorCode>;
+};
+
+}  // namespace tactile::core
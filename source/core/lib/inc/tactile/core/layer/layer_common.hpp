@@ -2,6 +2,8 @@
 
 #pragma once
 
+#include <cstddef>  // size_t
+
 #include "tactile/base/id.hpp"
 #include "tactile/base/io/save/ir.hpp"
 #include "tactile/base/prelude.hpp"
@@ -49,4 +51,24 @@ void destroy_layer(Registry& registry, EntityID layer_entity);
 auto copy_layer(Registry& registry, EntityID source_layer_entity, LayerID& next_layer_id)
     -> EntityID;
 
+/**
+ * Returns an estimate of the amount of memory used by a layer.
+ *
+ * \details
+ * The estimate includes the tile data of tile layers, the objects in object
+ * layers, and all nested layers in group layers. Allocator overhead and
+ * strings such as names and properties are only roughly accounted for.
+ *
+ * \param registry     The associated registry.
+ * \param layer_entity The target layer.
+ *
+ * \return
+ * An estimated memory usage, in bytes.
+ *
+ * \pre The specified entity must be a valid layer.
+ */
+[[nodiscard]]
+auto estimate_layer_memory_usage(const Registry& registry, EntityID layer_entity)
+    -> std::size_t;
+
 }  // namespace tactile::core
@@ -0,0 +1,137 @@
+// Copyright (C) 2024 Albin Johansson (GNU General Public License v3.0)
+
+#pragma once
+
+#include <cstdint>        // uint64_t
+#include <unordered_map>  // unordered_map
+#include <vector>         // vector
+
+#include "tactile/base/numeric/vec.hpp"
+#include "tactile/base/prelude.hpp"
+#include "tactile/core/entity/entity.hpp"
+
+namespace tactile::core {
+
+class Registry;
+
+/** The default size of the cells in object indices. */
+inline constexpr float kDefaultObjectIndexCellSize = 256.0f;
+
+/**
+ * Describes an object in an object index.
+ */
+struct ObjectIndexEntry final
+{
+  /** The packed coordinates of the cell that the object is stored in. */
+  std::uint64_t cell_key;
+
+  /** The position of the object in the layer, relative to the other objects. */
+  std::uint64_t sequence;
+};
+
+/**
+ * A component that provides a spatial index of the objects in an object layer.
+ *
+ * \details
+ * The index is a uniform grid, where each object is stored in the cell that
+ * contains its position. Objects that are larger than a cell are stored in a
+ * separate list, so that every object is stored exactly once. This means that
+ * region queries only need to look at the cells that overlap the region
+ * (extended by one cell towards the origin), along with the large objects.
+ */
+struct CObjectIndex final
+{
+  /** The size of each (square) grid cell. */
+  float cell_size;
+
+  /** The objects stored in each cell, keyed by packed cell coordinates. */
+  std::unordered_map<std::uint64_t, std::vector<EntityID>> cells;
+
+  /** The objects that are too large to be stored in a single cell. */
+  std::vector<EntityID> large_objects;
+
+  /** The entries of the indexed objects. */
+  std::unordered_map<EntityID, ObjectIndexEntry> entries;
+
+  /** The sequence number given to the next added object. */
+  std::uint64_t next_sequence;
+};
+
+/**
+ * Adds an object to the spatial index of an object layer.
+ *
+ * \details
+ * The object is assumed to be the last object in the layer, i.e., it should
+ * be added to the index after it has been appended to the layer.
+ *
+ * \param registry     The associated registry.
+ * \param layer_entity The target object layer.
+ * \param object_id    The object to add.
+ *
+ * \pre The specified layer must feature a \c CObjectIndex component.
+ * \pre The specified entity must be a valid object.
+ */
+void add_object_to_index(Registry& registry, EntityID layer_entity, EntityID object_id);
+
+/**
+ * Removes an object from the spatial index of an object layer.
+ *
+ * \details
+ * This function has no effect if the object isn't in the index.
+ *
+ * \param registry     The associated registry.
+ * \param layer_entity The target object layer.
+ * \param object_id    The object to remove.
+ *
+ * \pre The specified layer must feature a \c CObjectIndex component.
+ */
+void remove_object_from_index(Registry& registry, EntityID layer_entity, EntityID object_id);
+
+/**
+ * Updates the spatial index entry of an object after its bounds changed.
+ *
+ * \details
+ * The object layer that contains the object is determined automatically. This
+ * function has no effect if the object isn't indexed by any object layer.
+ *
+ * \param registry  The associated registry.
+ * \param object_id The object that was moved or resized.
+ *
+ * \pre The specified entity must be a valid object.
+ */
+void update_object_in_index(Registry& registry, EntityID object_id);
+
+/**
+ * Rebuilds the spatial index of an object layer from scratch.
+ *
+ * \param registry     The associated registry.
+ * \param layer_entity The target object layer.
+ *
+ * \pre The specified entity must be a valid object layer.
+ */
+void rebuild_object_index(Registry& registry, EntityID layer_entity);
+
+/**
+ * Collects the objects in an object layer that intersect a given region.
+ *
+ * \details
+ * The found objects are provided in the order that they're stored in the
+ * layer, which is the order in which they're rendered. If the layer doesn't
+ * feature a spatial index, all objects in the layer are tested against the
+ * region.
+ *
+ * \param registry     The associated registry.
+ * \param layer_entity The target object layer.
+ * \param region_begin The top-left corner of the region (inclusive).
+ * \param region_end   The bottom-right corner of the region (inclusive).
+ * \param[out] objects The vector to which the found objects are appended.
+ *
+ * \pre The specified entity must be a valid object layer.
+ */
+void query_objects(const Registry& registry,
+                   EntityID layer_entity,
+                   const Float2& region_begin,
+                   const Float2& region_end,
+                   std::vector<EntityID>& objects);
+
+}  // namespace tactile::core
@@ -17,6 +17,9 @@ class Registry;
  * - \c CLayer \n
  * - \c CObjectLayer
  *
+ * Object layers created with \c make_object_layer also feature a \c CObjectIndex
+ * component, but it isn't required by this function.
+ *
  * \param registry The associated registry.
  * \param entity   The entity to check.
  *
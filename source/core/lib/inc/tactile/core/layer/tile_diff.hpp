@@ -0,0 +1,161 @@
+// Copyright (C) 2024 Albin Johansson (GNU General Public License v3.0)
+
+#pragma once
+
+#include <cstddef>  // size_t
+#include <cstdint>  // uint32_t
+#include <span>     // span
+#include <vector>   // vector
+
+#include "tactile/base/id.hpp"
+#include "tactile/base/numeric/index_2d.hpp"
+#include "tactile/base/prelude.hpp"
+#include "tactile/core/entity/entity.hpp"
+
+namespace tactile::core {
+
+class Registry;
+
+/**
+ * Represents a horizontal run of tiles that were changed in the same way.
+ */
+struct TileDiffRun final
+{
+  /** The position of the first (leftmost) tile in the run. */
+  Index2D position;
+
+  /** The number of tiles in the run. */
+  std::uint32_t length;
+
+  /** The previous tile identifier of all tiles in the run. */
+  TileID old_tile;
+
+  /** The new tile identifier of all tiles in the run. */
+  TileID new_tile;
+
+  [[nodiscard]]
+  auto operator==(const TileDiffRun&) const -> bool = default;
+};
+
+/**
+ * Represents a run-length encoded sequence of tile changes in a tile layer.
+ *
+ * \details
+ * Consecutive changes of adjacent tiles in the same row are merged into runs,
+ * which makes the diffs of typical tool usage, e.g. erasing lines of tiles,
+ * very compact. The same tile may be changed several times in a diff, changes
+ * are applied in order and reverted in reverse order.
+ */
+class TileDiff final
+{
+ public:
+  /**
+   * Records a tile change.
+   *
+   * \details
+   * Changes where the old and new tile identifiers are equal are ignored.
+   *
+   * \param position The position of the changed tile.
+   * \param old_tile The previous tile identifier.
+   * \param new_tile The new tile identifier.
+   */
+  void record(const Index2D& position, TileID old_tile, TileID new_tile);
+
+  /**
+   * Appends the changes of another diff to this diff.
+   *
+   * \param other The diff to append, the changes of which must have been
+   *              applied after the changes in this diff.
+   */
+  void append(const TileDiff& other);
+
+  /**
+   * Records a run of tile changes.
+   *
+   * \details
+   * Empty runs, and runs where the old and new tile identifiers are equal, are
+   * ignored. This is useful for restoring diffs from their runs.
+   *
+   * \param run The run of changes to record.
+   */
+  void record_run(const TileDiffRun& run);
+
+  /**
+   * Writes the new tile identifiers of all changes to a tile layer.
+   *
+   * \param registry     The associated registry.
+   * \param layer_entity The target tile layer.
+   *
+   * \pre The specified entity must be a valid tile layer.
+   */
+  void apply(Registry& registry, EntityID layer_entity) const;
+
+  /**
+   * Writes the previous tile identifiers of all changes to a tile layer.
+   *
+   * \param registry     The associated registry.
+   * \param layer_entity The target tile layer.
+   *
+   * \pre The specified entity must be a valid tile layer.
+   */
+  void revert(Registry& registry, EntityID layer_entity) const;
+
+  /**
+   * Creates a diff that reverts the changes in this diff.
+   *
+   * \details
+   * Applying the inverse diff is equivalent to reverting this diff.
+   *
+   * \return
+   * The inverse diff.
+   */
+  [[nodiscard]]
+  auto make_inverse() const -> TileDiff;
+
+  /**
+   * Releases any excess memory used by the diff.
+   */
+  void shrink_to_fit();
+
+  /**
+   * Returns the recorded runs of changes, in the order they were recorded.
+   *
+   * \return
+   * A view of the recorded runs.
+   */
+  [[nodiscard]]
+  auto get_runs() const noexcept -> std::span<const TileDiffRun>;
+
+  /**
+   * Returns the total number of changed tiles in the diff.
+   *
+   * \return
+   * A tile count.
+   */
+  [[nodiscard]]
+  auto tile_count() const noexcept -> std::size_t;
+
+  /**
+   * Returns the amount of memory allocated for the recorded runs.
+   *
+   * \return
+   * A memory usage, in bytes.
+   */
+  [[nodiscard]]
+  auto get_memory_usage() const noexcept -> std::size_t;
+
+  /**
+   * Indicates whether the diff contains no changes.
+   *
+   * \return
+   * True if the diff is empty; false otherwise.
+   */
+  [[nodiscard]]
+  auto empty() const noexcept -> bool;
+
+ private:
+  std::vector<TileDiffRun> m_runs {};
+  std::size_t m_tile_count {0};
+};
+
+}  // namespace tactile::core
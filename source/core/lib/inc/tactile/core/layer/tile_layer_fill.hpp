@@ -0,0 +1,116 @@
+// Copyright (C) 2024 Albin Johansson (GNU General Public License v3.0)
+
+#pragma once
+
+#include <span>    // span
+#include <vector>  // vector
+
+#include "tactile/base/id.hpp"
+#include "tactile/base/numeric/index_2d.hpp"
+#include "tactile/base/prelude.hpp"
+#include "tactile/core/entity/entity.hpp"
+
+namespace tactile::core {
+
+class Registry;
+
+/**
+ * Represents a horizontal run of tiles in a tile layer.
+ */
+struct TileSpan final
+{
+  /** The row index of the span. */
+  Index2D::value_type row;
+
+  /** The inclusive first column of the span. */
+  Index2D::value_type begin_col;
+
+  /** The exclusive last column of the span. */
+  Index2D::value_type end_col;
+
+  [[nodiscard]]
+  auto operator==(const TileSpan&) const -> bool = default;
+};
+
+/**
+ * Represents a rectangular region of tiles in a tile layer.
+ */
+struct TileRegion final
+{
+  /** The inclusive first (top-left) tile position. */
+  Index2D begin;
+
+  /** The exclusive last (bottom-right) tile position. */
+  Index2D end;
+};
+
+/**
+ * Replaces the connected region of equal tiles at a given position in a tile layer.
+ *
+ * \details
+ * This function implements the "bucket" tool, using a scanline algorithm that
+ * works on whole rows of tiles at a time. Pending spans are tracked using an
+ * explicit stack, so memory usage is proportional to the number of spans at
+ * the boundary of the filled region, instead of the number of filled tiles.
+ * Tiles are considered to be connected to their four direct neighbors.
+ *
+ * \param registry     The associated registry.
+ * \param layer_entity The target tile layer.
+ * \param origin       The position of the first tile to replace.
+ * \param replacement  The new tile identifier.
+ *
+ * \return
+ * The spans of tiles that were changed, which all previously featured the tile
+ * at the origin position. The spans are empty if nothing was changed.
+ *
+ * \pre The specified entity must be a valid tile layer.
+ */
+auto flood_fill_tile_layer(Registry& registry,
+                           EntityID layer_entity,
+                           const Index2D& origin,
+                           TileID replacement) -> std::vector<TileSpan>;
+
+/**
+ * Replaces the connected region of equal tiles within a region of a tile layer.
+ *
+ * \details
+ * This function behaves like the unlimited variant, but tiles outside of the
+ * specified region are neither changed nor used to connect tiles inside of it.
+ * The region is clamped to the layer extent.
+ *
+ * \param registry     The associated registry.
+ * \param layer_entity The target tile layer.
+ * \param origin       The position of the first tile to replace.
+ * \param replacement  The new tile identifier.
+ * \param region       The region that limits the fill.
+ *
+ * \return
+ * The spans of tiles that were changed.
+ *
+ * \pre The specified entity must be a valid tile layer.
+ */
+auto flood_fill_tile_layer(Registry& registry,
+                           EntityID layer_entity,
+                           const Index2D& origin,
+                           TileID replacement,
+                           const TileRegion& region) -> std::vector<TileSpan>;
+
+/**
+ * Assigns the same tile identifier to all tiles in a collection of spans.
+ *
+ * \details
+ * Spans that are outside of the layer extent are clamped or ignored.
+ *
+ * \param registry     The associated registry.
+ * \param layer_entity The target tile layer.
+ * \param spans        The spans of tiles to update.
+ * \param tile_id      The new tile identifier.
+ *
+ * \pre The specified entity must be a valid tile layer.
+ */
+void set_layer_tile_spans(Registry& registry,
+                          EntityID layer_entity,
+                          std::span<const TileSpan> spans,
+                          TileID tile_id);
+
+}  // namespace tactile::core
@@ -2,6 +2,7 @@
 
 #pragma once
 
+#include <mutex>        // mutex
 #include <string_view>  // string_view
 
 #include "tactile/base/prelude.hpp"
@@ -11,6 +12,9 @@ namespace tactile::core {
 
 /**
  * A log sink that simply forwards messages to the terminal.
+ *
+ * \details
+ * Messages logged from different threads are never interleaved.
  */
 class TerminalLogSink final : public ILogSink
 {
@@ -48,6 +52,7 @@ class TerminalLogSink final : public ILogSink
   static auto get_fg_ansi_color(LogLevel level) -> std::string_view;
 
  private:
+  std::mutex mMutex {};
   bool mUseAnsiColors {false};
 };
 
@@ -2,7 +2,7 @@
 
 #pragma once
 
-#include <cstdint>   // int32_t
+#include <cstdint>   // int32_t, uint8_t
 #include <expected>  // expected
 #include <optional>  // optional
 #include <vector>    // vector
@@ -17,7 +17,6 @@
 #include "tactile/base/numeric/extent_2d.hpp"
 #include "tactile/base/numeric/vec.hpp"
 #include "tactile/base/prelude.hpp"
-#include "tactile/base/render/renderer.hpp"
 #include "tactile/core/entity/entity.hpp"
 
 namespace tactile::core {
@@ -25,6 +24,8 @@ namespace tactile::core {
 struct MapSpec;
 struct TilesetSpec;
 class Registry;
+class TextureCache;
+enum class TextureLoadMode : std::uint8_t;
 
 /**
  * A component featured by all maps.
@@ -134,16 +135,25 @@ auto make_map(Registry& registry, const MapSpec& spec) -> EntityID;
 /**
  * Creates a map based on an intermediate representation.
  *
- * \param registry The associated registry.
- * \param renderer The renderer used to load textures.
- * \param ir_map   The intermediate map representation.
+ * \details
+ * The tileset images are decoded concurrently on worker threads, and then
+ * uploaded on the calling thread. In deferred texture load mode, tilesets whose
+ * images are still being decoded use placeholder textures, see
+ * \c update_tileset_textures.
+ *
+ * \param registry      The associated registry.
+ * \param texture_cache The cache used to load textures.
+ * \param ir_map        The intermediate map representation.
+ * \param load_mode     Whether to wait for tileset textures to be loaded.
  *
  * \return
  * A map entity identifier if successful; an error code otherwise.
  */
 [[nodiscard]]
-auto make_map(Registry& registry, IRenderer& renderer, const ir::Map& ir_map)
-    -> std::expected<EntityID, ErrorCode>;
+auto make_map(Registry& registry,
+              TextureCache& texture_cache,
+              const ir::Map& ir_map,
+              TextureLoadMode load_mode) -> std::expected<EntityID, ErrorCode>;
 
 /**
  * Destroys a map.
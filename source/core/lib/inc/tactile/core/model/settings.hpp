@@ -25,12 +25,24 @@ struct Settings final
   /** The maximum number of changes to track in a document. */
   std::size_t command_capacity;
 
+  /** The maximum estimated memory usage of the changes tracked in a document, in bytes. */
+  std::size_t command_memory_budget;
+
+  /** The amount of undo snapshot data kept in memory per document, in bytes. */
+  std::size_t undo_spill_threshold;
+
+  /** The maximum size of the command journal stored for each saved map, in bytes. */
+  std::size_t undo_journal_budget;
+
   /** The font used in the UI. */
   ui::FontID font;
 
   /** The UI font size. */
   float font_size;
 
+  /** Whether the tile animations in a map should be kept in sync by a shared clock. */
+  bool sync_tile_animations : 1;
+
   /** Whether verbose events (e.g., some mouse events) should be logged. */
   bool log_verbose_events : 1;
 };
@@ -74,6 +74,15 @@ class FileDialog final
    */
   [[nodiscard]]
   static auto save_image() -> std::optional<std::filesystem::path>;
+
+  /**
+   * Shows a file dialog that can be used for selecting trace file paths.
+   *
+   * \return
+   * A trace file path if successful; an empty optional otherwise.
+   */
+  [[nodiscard]]
+  static auto save_trace() -> std::optional<std::filesystem::path>;
 };
 
 }  // namespace tactile::core
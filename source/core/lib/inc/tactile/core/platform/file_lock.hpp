@@ -0,0 +1,60 @@
+// Copyright (C) 2024 Albin Johansson (GNU General Public License v3.0)
+
+#pragma once
+
+#include <cstdint>     // intptr_t
+#include <expected>    // expected
+#include <filesystem>  // path
+
+#include "tactile/base/debug/error_code.hpp"
+#include "tactile/base/prelude.hpp"
+
+namespace tactile::core {
+
+/**
+ * Represents an exclusive advisory lock of a file, held until destroyed.
+ *
+ * \details
+ * Locks are used to claim files shared between editor instances, e.g., the
+ * recovery journals of a running editor. Locks are released by the operating
+ * system when the owning process exits, including when it crashes. The lock
+ * file itself is left behind, and may be locked again by another process.
+ */
+class FileLock final
+{
+ public:
+  TACTILE_DELETE_COPY(FileLock);
+
+  /**
+   * Attempts to lock a file, without blocking.
+   *
+   * \param path The path to the lock file, which is created if it doesn't exist.
+   *
+   * \return
+   * The lock if successful; an error code otherwise, \c ErrorCode::kBadState if
+   * the file is already locked.
+   */
+  [[nodiscard]]
+  static auto try_lock(const std::filesystem::path& path)
+      -> std::expected<FileLock, ErrorCode>;
+
+  FileLock(FileLock&& other) noexcept;
+
+  auto operator=(FileLock&& other) noexcept -> FileLock&;
+
+  ~FileLock() noexcept;
+
+  /**
+   * Releases the lock, if it's still held.
+   */
+  void unlock() noexcept;
+
+ private:
+  static constexpr std::intptr_t kInvalidHandle = -1;
+
+  std::intptr_t mHandle {kInvalidHandle};
+
+  explicit FileLock(std::intptr_t handle) noexcept;
+};
+
+}  // namespace tactile::core
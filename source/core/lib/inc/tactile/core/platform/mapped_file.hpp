@@ -0,0 +1,64 @@
+// Copyright (C) 2024 Albin Johansson (GNU General Public License v3.0)
+
+#pragma once
+
+#include <cstddef>     // size_t
+#include <cstdint>     // uint8_t
+#include <expected>    // expected
+#include <filesystem>  // path
+#include <span>        // span
+
+#include "tactile/base/debug/error_code.hpp"
+#include "tactile/base/prelude.hpp"
+
+namespace tactile::core {
+
+/**
+ * Represents a read-only memory mapping of an entire file.
+ *
+ * \details
+ * This is useful for large files that are read once, since the content is
+ * paged in directly from the file system cache, without intermediate copies.
+ * The file must not be modified while it's mapped.
+ */
+class MappedFile final
+{
+ public:
+  TACTILE_DELETE_COPY(MappedFile);
+
+  /**
+   * Maps a file into memory.
+   *
+   * \param path The path to the file.
+   *
+   * \return
+   * The mapped file if successful; an error code otherwise.
+   */
+  [[nodiscard]]
+  static auto open(const std::filesystem::path& path) -> std::expected<MappedFile, ErrorCode>;
+
+  MappedFile(MappedFile&& other) noexcept;
+
+  auto operator=(MappedFile&& other) noexcept -> MappedFile&;
+
+  ~MappedFile() noexcept;
+
+  /**
+   * Returns the content of the file.
+   *
+   * \return
+   * A view of the mapped bytes, which is empty for empty files.
+   */
+  [[nodiscard]]
+  auto get_bytes() const noexcept -> std::span<const std::uint8_t>;
+
+ private:
+  const std::uint8_t* mData {nullptr};
+  std::size_t mSize {0};
+
+  MappedFile(const std::uint8_t* data, std::size_t size) noexcept;
+
+  void _unmap() noexcept;
+};
+
+}  // namespace tactile::core
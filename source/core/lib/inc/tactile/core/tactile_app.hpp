@@ -20,6 +20,9 @@
 #include "tactile/core/event/tileset_event_handler.hpp"
 #include "tactile/core/event/view_event_handler.hpp"
 #include "tactile/core/event/viewport_event_handler.hpp"
+#include "tactile/core/io/map_saver.hpp"
+#include "tactile/core/io/recovery_manager.hpp"
+#include "tactile/core/io/texture_cache.hpp"
 #include "tactile/core/model/model.hpp"
 #include "tactile/core/model/settings.hpp"
 #include "tactile/core/ui/i18n/language.hpp"
@@ -61,9 +64,15 @@ class TactileApp final : public IEngineApp
   /** The language that will be used throughout the session. */
   std::optional<ui::Language> m_language;
 
+  /** The textures shared by all open documents, must outlive the model. */
+  std::optional<TextureCache> m_texture_cache;
+
   /** The core document model. */
   std::optional<Model> m_model;
 
+  /** Saves documents in the background, must outlive the event handlers. */
+  std::optional<MapSaver> m_map_saver;
+
   /** The UI manager. */
   ui::WidgetManager m_widget_manager;
 
@@ -99,6 +108,9 @@ class TactileApp final : public IEngineApp
 
   /** Delegate for viewport events. */
   std::optional<ViewportEventHandler> m_viewport_event_handler;
+
+  /** Journals changes to open documents, so that they can be recovered after crashes. */
+  std::optional<RecoveryManager> m_recovery_manager;
 };
 
 }  // namespace tactile::core
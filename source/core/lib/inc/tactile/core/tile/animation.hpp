@@ -2,8 +2,10 @@
 
 #pragma once
 
+#include <chrono>    // milliseconds
 #include <cstddef>   // size_t
 #include <expected>  // expected
+#include <optional>  // optional
 
 #include "tactile/base/debug/error_code.hpp"
 #include "tactile/core/entity/entity.hpp"
@@ -11,15 +13,118 @@
 namespace tactile::core {
 
 struct AnimationFrame;
+struct CAnimation;
 class Registry;
 
 /**
  * Updates the state of all animations in a registry.
  *
+ * \details
+ * Only animations with a frame that has ended are visited, see
+ * \c CAnimationSchedule. The affected tiles are recorded in the schedule.
+ * If the registry features a \c CAnimationClock, only the clock is updated.
+ *
  * \param registry The associated registry.
+ *
+ * \complexity O(k log n), where k is the number of frame changes and n is the
+ *             number of animations.
  */
 void update_animations(Registry& registry);
 
+/**
+ * Makes all animations in a registry use a global animation clock.
+ *
+ * \details
+ * The clock starts at zero, and is advanced by \c update_animations. This
+ * function has no effect if the registry already features a clock.
+ *
+ * \param registry The associated registry.
+ */
+void enable_animation_clock(Registry& registry);
+
+/**
+ * Makes all animations in a registry use their own animation state again.
+ *
+ * \details
+ * Animations continue from the frames they were showing before the clock was
+ * enabled. This function has no effect if the registry doesn't feature a clock.
+ *
+ * \param registry The associated registry.
+ */
+void disable_animation_clock(Registry& registry);
+
+/**
+ * Sets the time of the global animation clock.
+ *
+ * \details
+ * This is useful for rendering animations at a given point in time, e.g., in
+ * combination with \c pause_animation_clock.
+ *
+ * \param registry The associated registry.
+ * \param time     The new clock time.
+ *
+ * \pre The registry must feature a \c CAnimationClock context component.
+ */
+void set_animation_clock_time(Registry& registry, std::chrono::milliseconds time);
+
+/**
+ * Stops or resumes the global animation clock.
+ *
+ * \param registry The associated registry.
+ * \param paused   True to stop the clock; false to resume it.
+ *
+ * \pre The registry must feature a \c CAnimationClock context component.
+ */
+void pause_animation_clock(Registry& registry, bool paused);
+
+/**
+ * Returns the frame of an animation that is shown at a given clock time.
+ *
+ * \param animation  The animation to query.
+ * \param clock_time The animation clock time.
+ *
+ * \return
+ * A frame index.
+ *
+ * \complexity O(log n), where n is the number of frames.
+ */
+[[nodiscard]]
+auto get_animation_frame_index(const CAnimation& animation,
+                               std::chrono::milliseconds clock_time) -> std::size_t;
+
+/**
+ * Returns the clock time at which an animation changes frame next.
+ *
+ * \param animation  The animation to query.
+ * \param clock_time The animation clock time.
+ *
+ * \return
+ * A clock time later than the given one; nothing if the animation never changes
+ * frame, i.e., if it has no duration.
+ *
+ * \complexity O(log n), where n is the number of frames.
+ */
+[[nodiscard]]
+auto get_next_animation_frame_time(const CAnimation& animation,
+                                   std::chrono::milliseconds clock_time)
+    -> std::optional<std::chrono::milliseconds>;
+
+/**
+ * Returns the current frame of an animation.
+ *
+ * \details
+ * The frame is derived from the global animation clock, if there is one.
+ *
+ * \param registry  The associated registry.
+ * \param animation The animation to query.
+ *
+ * \return
+ * A frame index.
+ */
+[[nodiscard]]
+auto get_current_animation_frame_index(const Registry& registry, const CAnimation& animation)
+    -> std::size_t;
+
 /**
  * Adds an animation frame to a given tile.
  *
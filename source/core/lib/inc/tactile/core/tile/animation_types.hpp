@@ -4,9 +4,11 @@
 
 #include <chrono>   // milliseconds, steady_clock
 #include <cstddef>  // size_t
+#include <cstdint>  // uint64_t
 #include <vector>   // vector
 
 #include "tactile/base/id.hpp"
+#include "tactile/core/entity/entity.hpp"
 
 namespace tactile::core {
 
@@ -35,6 +37,71 @@ struct CAnimation final
 
   /** The sequence of frames the animation cycles through. */
   std::vector<AnimationFrame> frames;
+
+  /**
+   * The end time of each frame, relative to the start of the animation, i.e.,
+   * the prefix sums of the frame durations.
+   */
+  std::vector<std::chrono::milliseconds> frame_end_times;
+};
+
+/**
+ * Context component for a global clock that drives all tile animations.
+ *
+ * \details
+ * When a registry features this component, the current frame of each
+ * animation is a pure function of the clock time, rather than being stored in
+ * the \c CAnimation components. As a result, all animations stay in sync, and
+ * a given clock time always yields the same frames.
+ *
+ * \see get_animation_frame_index
+ */
+struct CAnimationClock final
+{
+  /** The point in time that corresponds to a clock time of zero. */
+  std::chrono::steady_clock::time_point epoch;
+
+  /** The current clock time. */
+  std::chrono::milliseconds time;
+
+  /** Indicates whether the clock is stopped. */
+  bool paused;
+};
+
+/**
+ * Represents a scheduled frame change of a tile animation.
+ */
+struct AnimationScheduleEntry final
+{
+  /** The time at which the current frame of the animation ends. */
+  std::chrono::steady_clock::time_point due_time;
+
+  /** The tile entity that features the animation. */
+  EntityID tile_entity;
+};
+
+/**
+ * Context component that tracks when tile animations change frames.
+ *
+ * \details
+ * Animations are updated by popping due entries from a min-heap, so that
+ * animations that don't change frames aren't visited at all. Entries are never
+ * removed eagerly; entries that no longer match the animation state, e.g.,
+ * after an animation was modified, are simply discarded when popped.
+ *
+ * The tiles that changed frames during the latest update are recorded, so that
+ * caches of tile appearances can refresh only those tiles.
+ */
+struct CAnimationSchedule final
+{
+  /** A min-heap of frame changes, ordered by due time. */
+  std::vector<AnimationScheduleEntry> queue;
+
+  /** The tile entities whose frame changed during the latest update. */
+  std::vector<EntityID> changed_tiles;
+
+  /** Incremented by each update that changes at least one animation frame. */
+  std::uint64_t version;
 };
 
 }  // namespace tactile::core
@@ -0,0 +1,165 @@
+// Copyright (C) 2024 Albin Johansson (GNU General Public License v3.0)
+
+#pragma once
+
+#include <chrono>         // milliseconds
+#include <cstddef>        // size_t
+#include <cstdint>        // uint32_t, uint64_t
+#include <limits>         // numeric_limits
+#include <unordered_map>  // unordered_map
+#include <vector>         // vector
+
+#include "tactile/base/id.hpp"
+#include "tactile/base/meta/color.hpp"
+#include "tactile/base/numeric/extent_2d.hpp"
+#include "tactile/base/numeric/vec.hpp"
+#include "tactile/base/prelude.hpp"
+#include "tactile/core/entity/entity.hpp"
+#include "tactile/core/tile/tileset_types.hpp"
+
+namespace tactile::core {
+
+class Registry;
+
+/** Used by tiles that aren't animated. */
+inline constexpr std::uint32_t kNoAnimationSlot = std::numeric_limits<std::uint32_t>::max();
+
+/**
+ * Provides the information needed to render a single global tile identifier.
+ */
+struct TileRenderInfo final
+{
+  /** The texture that contains the tile, null for unused tile identifiers. */
+  void* texture_handle;
+
+  /** The top-left texture coordinate of the current tile appearance. */
+  Float2 uv_pos;
+
+  /** The size of the tile in texture coordinates. */
+  Float2 uv_size;
+
+  /** The index of the associated animation slot, if any. */
+  std::uint32_t animation_slot;
+
+  /** The color used while the texture is loading, fully transparent if unused. */
+  UColor placeholder_color;
+};
+
+/**
+ * Maps the tile identifiers of a tileset to entries in a tile render cache.
+ */
+struct TileRenderRange final
+{
+  /** The tile identifiers of the associated tileset. */
+  TileRange tile_range;
+
+  /** The index of the entry of the first tile identifier in the render cache. */
+  std::size_t first_index;
+};
+
+/**
+ * Tracks an animated tile in a tile render cache.
+ */
+struct TileAnimationSlot final
+{
+  /** The global identifier of the animated tile. */
+  TileID tile_id;
+
+  /** The index of the render information of the animated tile. */
+  std::size_t info_index;
+
+  /** The tile entity that features the animation. */
+  EntityID tile_entity;
+
+  /** The number of columns in the parent tileset. */
+  Extent2D::value_type tileset_columns;
+
+  /** The animation frame index that the cached appearance is based on. */
+  std::size_t frame_index;
+};
+
+/**
+ * Represents an upcoming frame change of an animated tile in a tile render cache.
+ */
+struct TileAnimationChange final
+{
+  /** The animation clock time at which the frame changes. */
+  std::chrono::milliseconds time;
+
+  /** The index of the affected slot in the tile render cache. */
+  std::size_t slot_index;
+};
+
+/**
+ * Context component that provides a flat tile lookup table for renderers.
+ *
+ * \details
+ * This component is derived from the tilesets in a map, and is used to avoid
+ * tileset lookups for each rendered tile. The entries of each tileset are
+ * stored contiguously, so the size of the table is proportional to the number
+ * of tiles, regardless of the tile identifiers used by the tilesets. The table
+ * is only rebuilt when the \c CTileCache version changes, i.e., when tilesets
+ * or animations are added or removed. Animated tiles are refreshed separately, using the tiles
+ * recorded in the \c CAnimationSchedule context component, or the time of the
+ * \c CAnimationClock context component if there is one. In the latter case,
+ * only the tiles with frame changes that are due according to the clock time
+ * are visited.
+ */
+struct CTileRenderCache final
+{
+  /** The render information for each tile, grouped by tileset. */
+  std::vector<TileRenderInfo> tiles;
+
+  /** The tile identifier ranges featured in the table, sorted by first tile identifier. */
+  std::vector<TileRenderRange> ranges;
+
+  /** The animated tiles featured in the table. */
+  std::vector<TileAnimationSlot> animations;
+
+  /** Maps animated tile entities to indices of slots in \c animations. */
+  std::unordered_map<EntityID, std::size_t> animation_slot_indices;
+
+  /** The version of the tile cache that the table was built from. */
+  std::uint64_t tile_cache_version;
+
+  /** The version of the animation schedule that the animated tiles are based on. */
+  std::uint64_t animation_version;
+
+  /** The animation clock time that the animated tiles are based on, if there is a clock. */
+  std::chrono::milliseconds animation_clock_time;
+
+  /** Min-heap of upcoming frame changes, ordered by time. Only used with a clock. */
+  std::vector<TileAnimationChange> animation_changes;
+};
+
+/**
+ * Updates the tile render cache in a registry.
+ *
+ * \details
+ * The table is rebuilt if the associated tilesets have changed since the last
+ * update. Otherwise, only the appearances of tiles with animations that changed
+ * frames since the last update are refreshed.
+ *
+ * \param registry The associated registry.
+ *
+ * \pre The registry must feature \c CTileCache and \c CTileRenderCache context
+ *      components.
+ */
+void update_tile_render_cache(Registry& registry);
+
+/**
+ * Returns the render information associated with a tile.
+ *
+ * \param render_cache The tile render cache to query.
+ * \param tile_id      The global tile identifier to look for.
+ *
+ * \return
+ * A pointer to the render information if found; a null pointer otherwise.
+ *
+ * \complexity O(log n), where n is the number of tilesets.
+ */
+[[nodiscard]]
+auto find_tile_render_info(const CTileRenderCache& render_cache, TileID tile_id)
+    -> const TileRenderInfo*;
+
+}  // namespace tactile::core
@@ -2,12 +2,13 @@
 
 #pragma once
 
+#include <cstddef>   // size_t
+#include <cstdint>   // uint8_t
 #include <expected>  // expected
 #include <optional>  // optional
 
 #include "tactile/base/debug/error_code.hpp"
 #include "tactile/base/id.hpp"
-#include "tactile/base/render/renderer.hpp"
 #include "tactile/core/entity/entity.hpp"
 
 namespace tactile {
@@ -22,6 +23,9 @@ struct CTexture;
 struct TilesetSpec;
 struct TileRange;
 class Registry;
+class TextureCache;
+class PendingTexture;
+enum class TextureLoadMode : std::uint8_t;
 
 /**
  * Indicates whether an entity is a tileset.
@@ -59,6 +63,9 @@ auto is_tileset_instance(const Registry& registry, EntityID entity) -> bool;
  *
  * \note
  * The associated texture must have been loaded before calling this function.
+ * If the registry features a \c CTextureCacheRef context component, then the
+ * texture must have been acquired from that cache, and the tileset takes over
+ * the acquired reference.
  *
  * \param registry The associated registry.
  * \param spec     The tileset specification.
@@ -72,20 +79,74 @@ auto make_tileset(Registry& registry, const TilesetSpec& spec) -> EntityID;
 /**
  * Creates a tileset instance from an intermediate representation.
  *
+ * \details
+ * The tileset texture is acquired from the provided texture cache, and the
+ * registry is associated with the cache using a \c CTextureCacheRef context
+ * component, so that the texture is released when the tileset is destroyed.
+ *
  * \param registry       The associated registry.
- * \param renderer       The renderer to use for loading textures.
+ * \param texture_cache  The cache used to load textures.
  * \param ir_tileset_ref The intermediate tileset representation.
  *
  * \return
  * A tileset entity identifier if successful; an error code otherwise.
  *
  * \pre The registry must feature a \c CTileCache context component.
+ * \pre The registry must not be associated with another texture cache.
  */
 [[nodiscard]]
 auto make_tileset(Registry& registry,
-                  IRenderer& renderer,
+                  TextureCache& texture_cache,
                   const ir::TilesetRef& ir_tileset_ref) -> std::expected<EntityID, ErrorCode>;
 
+/**
+ * Creates a tileset instance from an intermediate representation, using a
+ * texture that is being decoded by a texture cache.
+ *
+ * \details
+ * This overload is useful for decoding the textures of several tilesets
+ * concurrently, see \c TextureCache::acquire_async. In deferred mode, the
+ * tileset uses a placeholder texture if the image hasn't been decoded yet (and
+ * the IR provides the image size). Such tilesets feature a \c CPendingTexture
+ * component until \c update_tileset_textures swaps in the real texture.
+ *
+ * \param registry        The associated registry.
+ * \param texture_cache   The cache used to load textures.
+ * \param ir_tileset_ref  The intermediate tileset representation.
+ * \param pending_texture The pending tileset texture, obtained from the texture cache.
+ * \param load_mode       Whether to wait for the texture to be loaded.
+ *
+ * \return
+ * A tileset entity identifier if successful; an error code otherwise.
+ *
+ * \pre The registry must feature a \c CTileCache context component.
+ * \pre The registry must not be associated with another texture cache.
+ */
+[[nodiscard]]
+auto make_tileset(Registry& registry,
+                  TextureCache& texture_cache,
+                  const ir::TilesetRef& ir_tileset_ref,
+                  PendingTexture pending_texture,
+                  TextureLoadMode load_mode) -> std::expected<EntityID, ErrorCode>;
+
+/**
+ * Replaces placeholder tileset textures with the real textures that have been
+ * loaded since the last call.
+ *
+ * \details
+ * This function should be called once per frame by documents that feature
+ * tilesets created in deferred texture load mode. Tilesets whose texture
+ * couldn't be loaded keep their placeholder textures.
+ *
+ * \param registry The associated registry.
+ *
+ * \return
+ * The number of tileset textures that are still being loaded.
+ *
+ * \pre The registry must feature a \c CTileCache context component.
+ */
+auto update_tileset_textures(Registry& registry) -> std::size_t;
+
 /**
  * Initializes a tileset "instance".
  *
@@ -102,7 +163,7 @@ auto make_tileset(Registry& registry,
  * in the interval [10, 110).
  *
  * \details
- * All tiles associated with the tileset will be registered in the \c CTileCache
+ * The tile range of the tileset will be registered in the \c CTileCache
  * context component of the provided registry.
  *
  * \note
@@ -142,9 +203,13 @@ auto make_tileset_instance(Registry& registry, const TilesetSpec& spec, TileID f
  * Destroys a tileset and all of its associated tiles.
  *
  * \details
- * If the specified tileset features a \c CTilesetInstance component, then all
- * associated tiles will be unregistered from the \c CTileCache context
- * component in the provided registry.
+ * If the specified tileset features a \c CTilesetInstance component, then its
+ * tile range will be unregistered from the \c CTileCache context component in
+ * the provided registry.
+ *
+ * \details
+ * If the registry features a \c CTextureCacheRef context component, then the
+ * reference to the tileset texture is released.
  *
  * \param registry       The associated registry.
  * \param tileset_entity The tileset to destroy.
@@ -169,6 +234,46 @@ void destroy_tileset(Registry& registry, EntityID tileset_entity);
 [[nodiscard]]
 auto copy_tileset(Registry& registry, EntityID tileset_entity) -> EntityID;
 
+/**
+ * Returns the entity associated with a tile in a tileset, if there is one.
+ *
+ * \details
+ * Tiles without any associated data are usually not represented by entities,
+ * in which case this function returns an invalid entity.
+ *
+ * \param registry       The associated registry.
+ * \param tileset_entity The tileset that contains the tile.
+ * \param tile_index     The index of the tile to query.
+ *
+ * \return
+ * A tile entity if the tile has been materialized; an invalid entity otherwise.
+ *
+ * \pre The specified entity must be a valid tileset.
+ */
+[[nodiscard]]
+auto find_tile(const Registry& registry, EntityID tileset_entity, TileIndex tile_index)
+    -> EntityID;
+
+/**
+ * Returns the entity associated with a tile in a tileset, creating it if needed.
+ *
+ * \details
+ * This function should be used before attaching data to a tile, such as
+ * properties, animation frames, or objects.
+ *
+ * \param registry       The associated registry.
+ * \param tileset_entity The tileset that contains the tile.
+ * \param tile_index     The index of the tile to materialize.
+ *
+ * \return
+ * A tile entity if the tile index is valid; an invalid entity otherwise.
+ *
+ * \pre The specified entity must be a valid tileset.
+ */
+[[nodiscard]]
+auto get_or_make_tile(Registry& registry, EntityID tileset_entity, TileIndex tile_index)
+    -> EntityID;
+
 /**
  * Returns the appearance of a tile in a tileset.
  *
@@ -196,7 +301,7 @@ auto get_tile_appearance(const Registry& registry,
 /**
  * Returns the tileset entity that features a given tile.
  *
- * \complexity O(1).
+ * \complexity O(log n), where n is the number of tileset instances.
  *
  * \pre The registry must feature a \c CTileCache context component.
  *
@@ -226,6 +331,8 @@ auto get_tile_index(const Registry& registry, TileID tile_id) -> std::optional<T
 /**
  * Indicates whether the tiles in a tile range are available for use.
  *
+ * \pre The registry must feature a \c CTileCache context component.
+ *
  * \param registry The associated registry.
  * \param range    The tile range to check.
  *
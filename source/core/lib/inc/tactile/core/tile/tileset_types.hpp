@@ -2,9 +2,10 @@
 
 #pragma once
 
-#include <cstdint>        // int32_t
+#include <cstddef>        // size_t
+#include <cstdint>        // int32_t, uint64_t
 #include <unordered_map>  // unordered_map
-#include <vector>  // vector
+#include <vector>         // vector
 
 #include "tactile/base/id.hpp"
 #include "tactile/base/numeric/vec.hpp"
@@ -38,13 +39,33 @@ struct TilesetSpec final
   CTexture texture;
 };
 
+/**
+ * Associates a range of tile identifiers with a tileset.
+ */
+struct TilesetRange final
+{
+  /** The tile identifiers claimed by the tileset. */
+  TileRange tile_range;
+
+  /** The associated tileset. */
+  EntityID tileset_entity;
+};
+
 /**
  * Context component used to map tile identifiers to tilesets.
+ *
+ * \details
+ * Tileset instances claim disjoint tile ranges, so the mapping is stored as an
+ * interval table with one entry per tileset instance, which makes lookups
+ * O(log n) with respect to the number of tilesets.
  */
 struct CTileCache final
 {
-  /** Maps tile identifiers to the associated tilesets. */
-  std::unordered_map<TileID, EntityID> tileset_mapping;
+  /** The tile ranges of all tileset instances, sorted by first tile identifier. */
+  std::vector<TilesetRange> tileset_ranges;
+
+  /** Incremented whenever tilesets or tile animations are added or removed. */
+  std::uint64_t version;
 };
 
 /**
@@ -61,8 +82,18 @@ struct CTileset final
   /** The size of the tileset. */
   Extent2D extent;
 
-  /** Tracks the associated tiles. Indexed using \c TileIndex values. */
-  std::vector<EntityID> tiles;
+  /** The total number of tiles in the tileset. */
+  std::size_t tile_count;
+
+  /**
+   * The tiles that are represented by entities, keyed by tile index.
+   *
+   * \details
+   * Tiles are implicit by default, and are only materialized as entities when
+   * they need to store data, such as metadata, animations, or objects. Use
+   * \c find_tile and \c get_or_make_tile to access tile entities.
+   */
+  std::unordered_map<TileIndex, EntityID> tiles;
 };
 
 /**
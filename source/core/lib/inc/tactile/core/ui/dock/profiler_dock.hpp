@@ -0,0 +1,51 @@
+// Copyright (C) 2024 Albin Johansson (GNU General Public License v3.0)
+
+#pragma once
+
+#include "tactile/base/container/buffer.hpp"
+#include "tactile/base/prelude.hpp"
+
+namespace tactile::core {
+class EventDispatcher;
+}  // namespace tactile::core
+
+namespace tactile::core::ui {
+
+class Language;
+
+/**
+ * Represents the dock widget that shows the frame time history of profiler zones,
+ * along with event dispatch statistics.
+ */
+class ProfilerDock final
+{
+ public:
+  /**
+   * Pushes the profiler dock to the widget stack, if it's open.
+   *
+   * \param language   The current language.
+   * \param dispatcher The event dispatcher, used to show event statistics.
+   */
+  void push(const Language& language, const EventDispatcher& dispatcher);
+
+  /**
+   * Opens the profiler dock if it's closed, and vice versa.
+   */
+  void toggle();
+
+  /**
+   * Indicates whether the profiler dock is open.
+   *
+   * \return
+   * True if the dock is open; false otherwise.
+   */
+  [[nodiscard]]
+  auto is_open() const -> bool;
+
+ private:
+  using LabelBuffer = Buffer<char, 128>;
+
+  bool m_is_open {false};
+};
+
+}  // namespace tactile::core::ui
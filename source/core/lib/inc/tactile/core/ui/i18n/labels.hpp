@@ -57,6 +57,16 @@ enum class NounLabel : std::size_t
   kDefault,
   kVersion,
   kProjectDir,
+  kHistory,
+  kEvents,
+  kPushedEvents,
+  kCoalescedEvents,
+  kDispatchedEvents,
+  kPendingJobs,
+  kFrame,
+  kZones,
+  kAverage,
+  kMaximum,
 
   // Window names.
   kDocumentDock,
@@ -66,6 +76,7 @@ enum class NounLabel : std::size_t
   kComponentDock,
   kAnimationDock,
   kLogDock,
+  kProfilerDock,
   kStyleEditorWidget,
   kGodotExportDialog,
 
@@ -142,6 +153,7 @@ enum class ActionLabel : std::size_t
   kPanRight,
   kHighlightActiveLayer,
   kToggleUi,
+  kToggleProfiler,
   kStampTool,
   kEraserTool,
   kBucketTool,
@@ -169,6 +181,8 @@ enum class ActionLabel : std::size_t
   kOpenStyleEditor,
   kOpenDemoWindow,
   kOpenStorageDir,
+  kStartTraceCapture,
+  kSaveTraceCapture,
   kTileLayerItem,
   kObjectLayerItem,
   kGroupLayerItem,
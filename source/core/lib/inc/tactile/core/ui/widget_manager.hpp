@@ -13,6 +13,7 @@
 #include "tactile/core/ui/dock/document_dock.hpp"
 #include "tactile/core/ui/dock/layer_dock.hpp"
 #include "tactile/core/ui/dock/log_dock.hpp"
+#include "tactile/core/ui/dock/profiler_dock.hpp"
 #include "tactile/core/ui/dock/property_dock.hpp"
 #include "tactile/core/ui/dock/tileset_dock.hpp"
 #include "tactile/core/ui/menu_bar.hpp"
@@ -56,6 +57,15 @@ class WidgetManager final
   [[nodiscard]]
   auto get_new_map_dialog() -> NewMapDialog&;
 
+  /**
+   * Returns the profiler dock widget.
+   *
+   * \return
+   * The associated profiler dock.
+   */
+  [[nodiscard]]
+  auto get_profiler_dock() -> ProfilerDock&;
+
   [[nodiscard]]
   auto get_godot_export_dialog() -> GodotExportDialog&;
 
@@ -95,6 +105,7 @@ class WidgetManager final
   PropertyDock mPropertyDock {};
   ComponentDock mComponentDock {};
   LogDock mLogDock {};
+  ProfilerDock mProfilerDock {};
   NewMapDialog mNewMapDialog {};
   NewTilesetDialog mNewTilesetDialog {};
   NewPropertyDialog mNewPropertyDialog {};
@@ -0,0 +1,96 @@
+// Copyright (C) 2024 Albin Johansson (GNU General Public License v3.0)
+
+#pragma once
+
+#include <concepts>            // invocable
+#include <condition_variable>  // condition_variable_any
+#include <cstddef>             // size_t
+#include <deque>               // deque
+#include <functional>          // function
+#include <future>              // future, packaged_task
+#include <memory>              // make_shared
+#include <mutex>               // mutex
+#include <stop_token>          // stop_token
+#include <thread>              // jthread
+#include <type_traits>         // invoke_result_t, decay_t
+#include <utility>             // forward
+#include <vector>              // vector
+
+#include "tactile/base/prelude.hpp"
+
+namespace tactile::core {
+
+/**
+ * A fixed-size pool of worker threads that run submitted tasks in FIFO order.
+ *
+ * \details
+ * Tasks that are still queued when the pool is destroyed are run before the
+ * worker threads are joined, so futures obtained from \c submit are always
+ * eventually satisfied.
+ *
+ * \note
+ * This class is thread-safe.
+ */
+class WorkerPool final
+{
+ public:
+  TACTILE_DELETE_COPY(WorkerPool);
+  TACTILE_DELETE_MOVE(WorkerPool);
+
+  /**
+   * Creates a worker pool.
+   *
+   * \param worker_count The number of worker threads, at least one is used.
+   */
+  explicit WorkerPool(std::size_t worker_count);
+
+  /**
+   * Runs the remaining tasks and joins the worker threads.
+   */
+  ~WorkerPool() noexcept;
+
+  /**
+   * Schedules a task to be run on a worker thread.
+   *
+   * \param task The task to run.
+   *
+   * \return
+   * A future for the result of the task.
+   */
+  template <std::invocable T>
+  [[nodiscard]]
+  auto submit(T&& task) -> std::future<std::invoke_result_t<std::decay_t<T>>>
+  {
+    using result_type = std::invoke_result_t<std::decay_t<T>>;
+
+    // Packaged tasks are move-only, but queued tasks must be copyable.
+    auto packaged_task =
+        std::make_shared<std::packaged_task<result_type()>>(std::forward<T>(task));
+    auto future = packaged_task->get_future();
+
+    _enqueue([packaged_task] { (*packaged_task)(); });
+
+    return future;
+  }
+
+  /**
+   * Returns the number of worker threads.
+   *
+   * \return
+   * The worker count.
+   */
+  [[nodiscard]]
+  auto worker_count() const noexcept -> std::size_t;
+
+ private:
+  std::mutex mMutex;
+  std::condition_variable_any mTaskCondition;
+  std::deque<std::function<void()>> mTasks;
+  std::vector<std::jthread> mWorkers;
+
+  void _enqueue(std::function<void()> task);
+
+  void _run(const std::stop_token& stop_token);
+};
+
+}  // namespace tactile::core
@@ -0,0 +1,394 @@
+// Copyright (C) 2024 Albin Johansson (GNU General Public License v3.0)
+
+#include "tactile/core/cmd/command_journal.hpp"
+
+#include <algorithm>      // reverse
+#include <cstring>        // memcpy
+#include <format>         // format
+#include <ios>            // streamsize
+#include <limits>         // numeric_limits
+#include <ostream>        // ostream
+#include <system_error>   // error_code
+#include <unordered_map>  // unordered_map
+#include <utility>        // move
+
+#include "tactile/base/io/atomic_file.hpp"
+#include "tactile/base/io/byte_stream.hpp"
+#include "tactile/base/io/file_io.hpp"
+#include "tactile/base/io/varint.hpp"
+#include "tactile/base/util/hash.hpp"
+#include "tactile/core/cmd/command_stack.hpp"
+#include "tactile/core/cmd/layer/tile_diff_command.hpp"
+#include "tactile/core/debug/profiler.hpp"
+#include "tactile/core/document/map_document.hpp"
+#include "tactile/core/entity/registry.hpp"
+#include "tactile/core/layer/layer_types.hpp"
+#include "tactile/core/layer/tile_layer.hpp"
+#include "tactile/core/log/logger.hpp"
+#include "tactile/core/platform/filesystem.hpp"
+
+namespace tactile::core {
+namespace {
+
+inline constexpr std::uint32_t kJournalMagic = 0x4C4E4A54;  // "TJNL"
+inline constexpr std::uint32_t kJournalVersion = 1;
+
+struct JournalHeader final
+{
+  std::uint32_t magic;
+  std::uint32_t version;
+  std::uint64_t file_size;
+  std::int64_t write_time;
+  std::uint64_t record_count;
+};
+
+template <typename T>
+[[nodiscard]]
+auto _read_value(const ByteSpan bytes, std::size_t& offset) -> std::optional<T>
+{
+  if constexpr (std::numeric_limits<T>::is_signed) {
+    const auto value = read_signed_varint(bytes, offset);
+    if (!value.has_value() || *value < std::numeric_limits<T>::min() ||
+        *value > std::numeric_limits<T>::max()) {
+      return std::nullopt;
+    }
+
+    return static_cast<T>(*value);
+  }
+  else {
+    const auto value = read_varint(bytes, offset);
+    if (!value.has_value() || *value > std::numeric_limits<T>::max()) {
+      return std::nullopt;
+    }
+
+    return static_cast<T>(*value);
+  }
+}
+
+}  // namespace
+
+void encode_command_journal_record(const CommandJournalRecord& record, ByteStream& stream)
+{
+  const auto runs = record.diff.get_runs();
+
+  write_signed_varint(stream, record.layer_id);
+  write_varint(stream, runs.size());
+
+  for (const auto& run : runs) {
+    write_varint(stream, run.position.x);
+    write_varint(stream, run.position.y);
+    write_varint(stream, run.length);
+    write_signed_varint(stream, run.old_tile);
+    write_signed_varint(stream, run.new_tile);
+  }
+}
+
+auto decode_command_journal_record(const ByteSpan bytes, std::size_t& offset)
+    -> std::optional<CommandJournalRecord>
+{
+  const auto layer_id = _read_value<LayerID>(bytes, offset);
+  const auto run_count = _read_value<std::size_t>(bytes, offset);
+
+  if (!layer_id.has_value() || !run_count.has_value()) {
+    return std::nullopt;
+  }
+
+  CommandJournalRecord record {
+    .layer_id = *layer_id,
+    .diff = TileDiff {},
+  };
+
+  for (std::size_t run_index = 0; run_index < *run_count; ++run_index) {
+    const auto x = _read_value<Index2D::value_type>(bytes, offset);
+    const auto y = _read_value<Index2D::value_type>(bytes, offset);
+    const auto length = _read_value<std::uint32_t>(bytes, offset);
+    const auto old_tile = _read_value<TileID>(bytes, offset);
+    const auto new_tile = _read_value<TileID>(bytes, offset);
+
+    if (!x.has_value() || !y.has_value() || !length.has_value() ||
+        !old_tile.has_value() || !new_tile.has_value()) {
+      return std::nullopt;
+    }
+
+    record.diff.record_run(TileDiffRun {
+      .position = Index2D {.x = *x, .y = *y},
+      .length = *length,
+      .old_tile = *old_tile,
+      .new_tile = *new_tile,
+    });
+  }
+
+  return record;
+}
+
+auto make_command_journal_key(const std::filesystem::path& map_path)
+    -> std::expected<CommandJournalKey, ErrorCode>
+{
+  std::error_code error_code {};
+
+  const auto file_size = std::filesystem::file_size(map_path, error_code);
+  if (error_code) {
+    return std::unexpected {ErrorCode::kNoSuchFile};
+  }
+
+  const auto write_time = std::filesystem::last_write_time(map_path, error_code);
+  if (error_code) {
+    return std::unexpected {ErrorCode::kNoSuchFile};
+  }
+
+  return CommandJournalKey {
+    .file_size = static_cast<std::uint64_t>(file_size),
+    .write_time = static_cast<std::int64_t>(write_time.time_since_epoch().count()),
+  };
+}
+
+auto get_command_journal_path(const std::filesystem::path& map_path)
+    -> std::expected<std::filesystem::path, ErrorCode>
+{
+  const auto storage_dir = get_persistent_storage_directory();
+  if (!storage_dir.has_value()) {
+    return std::unexpected {storage_dir.error()};
+  }
+
+  std::error_code error_code {};
+  const auto absolute_map_path = std::filesystem::absolute(map_path, error_code);
+  if (error_code) {
+    return std::unexpected {ErrorCode::kBadParam};
+  }
+
+  const auto path_hash = hash_combine(absolute_map_path.lexically_normal().generic_string());
+  return *storage_dir / "journals" / std::format("{:016x}.journal", path_hash);
+}
+
+auto write_command_journal(const std::filesystem::path& journal_path,
+                           const CommandJournalKey& key,
+                           const std::span<const CommandJournalRecord> records,
+                           const std::size_t byte_budget)
+    -> std::expected<std::size_t, ErrorCode>
+{
+  TACTILE_PROFILE_ZONE("write_command_journal");
+
+  // The newest records are kept if the journal would exceed the budget.
+  std::vector<ByteStream> encoded_records {};
+  std::size_t journal_size = sizeof(JournalHeader);
+
+  for (auto iter = records.rbegin(); iter != records.rend(); ++iter) {
+    ByteStream encoded_record {};
+    encode_command_journal_record(*iter, encoded_record);
+
+    if (journal_size + encoded_record.size() > byte_budget) {
+      break;
+    }
+
+    journal_size += encoded_record.size();
+    encoded_records.push_back(std::move(encoded_record));
+  }
+
+  std::error_code error_code {};
+  std::filesystem::create_directories(journal_path.parent_path(), error_code);
+  if (error_code) {
+    return std::unexpected {ErrorCode::kBadFileStream};
+  }
+
+  const JournalHeader header {
+    .magic = kJournalMagic,
+    .version = kJournalVersion,
+    .file_size = key.file_size,
+    .write_time = key.write_time,
+    .record_count = encoded_records.size(),
+  };
+
+  const auto write_result = write_file_atomically(journal_path, [&](std::ostream& stream) {
+    stream.write(reinterpret_cast<const char*>(&header), sizeof header);
+
+    for (auto iter = encoded_records.rbegin(); iter != encoded_records.rend(); ++iter) {
+      stream.write(reinterpret_cast<const char*>(iter->data()),
+                   static_cast<std::streamsize>(iter->size()));
+    }
+  });
+
+  if (!write_result.has_value()) {
+    return std::unexpected {write_result.error()};
+  }
+
+  return encoded_records.size();
+}
+
+auto read_command_journal(const std::filesystem::path& journal_path,
+                          const CommandJournalKey& key)
+    -> std::expected<std::vector<CommandJournalRecord>, ErrorCode>
+{
+  TACTILE_PROFILE_ZONE("read_command_journal");
+
+  const auto file_content = read_binary_file(journal_path);
+  if (!file_content.has_value()) {
+    return std::unexpected {ErrorCode::kNoSuchFile};
+  }
+
+  const auto bytes = make_byte_span(*file_content);
+  if (bytes.size() < sizeof(JournalHeader)) {
+    return std::unexpected {ErrorCode::kParseError};
+  }
+
+  JournalHeader header {};
+  std::memcpy(&header, bytes.data(), sizeof header);
+
+  if (header.magic != kJournalMagic || header.version != kJournalVersion) {
+    return std::unexpected {ErrorCode::kParseError};
+  }
+
+  // The map file has been changed since the journal was written.
+  if (header.file_size != key.file_size || header.write_time != key.write_time) {
+    return std::unexpected {ErrorCode::kBadState};
+  }
+
+  // Every record is at least two bytes, which guards against corrupt record counts.
+  if (header.record_count > bytes.size() / 2) {
+    return std::unexpected {ErrorCode::kParseError};
+  }
+
+  std::vector<CommandJournalRecord> records {};
+  records.reserve(header.record_count);
+
+  std::size_t offset = sizeof header;
+  for (std::uint64_t record_index = 0; record_index < header.record_count; ++record_index) {
+    auto record = decode_command_journal_record(bytes, offset);
+    if (!record.has_value()) {
+      return std::unexpected {ErrorCode::kParseError};
+    }
+
+    records.push_back(std::move(*record));
+  }
+
+  if (offset != bytes.size()) {
+    return std::unexpected {ErrorCode::kParseError};
+  }
+
+  return records;
+}
+
+auto collect_command_journal_records(const CommandStack& history)
+    -> std::vector<CommandJournalRecord>
+{
+  // Older commands can't be reverted without the newer ones, so we stop at the
+  // first command that can't be journaled.
+  const auto applied_commands = history.get_applied_commands();
+
+  std::vector<CommandJournalRecord> records {};
+  for (auto iter = applied_commands.rbegin(); iter != applied_commands.rend(); ++iter) {
+    CommandJournalRecord record {};
+    if (!(*iter)->write_journal_record(record)) {
+      break;
+    }
+
+    records.push_back(std::move(record));
+  }
+
+  std::ranges::reverse(records);
+  return records;
+}
+
+auto save_command_journal(const std::filesystem::path& map_path,
+                          const std::span<const CommandJournalRecord> records,
+                          const std::size_t byte_budget)
+    -> std::expected<std::size_t, ErrorCode>
+{
+  const auto journal_path = get_command_journal_path(map_path);
+  if (!journal_path.has_value()) {
+    return std::unexpected {journal_path.error()};
+  }
+
+  if (records.empty()) {
+    std::error_code error_code {};
+    std::filesystem::remove(*journal_path, error_code);
+    return 0;
+  }
+
+  const auto key = make_command_journal_key(map_path);
+  if (!key.has_value()) {
+    return std::unexpected {key.error()};
+  }
+
+  return write_command_journal(*journal_path, *key, records, byte_budget);
+}
+
+auto restore_command_journal(MapDocument& document, CommandStack& history)
+    -> std::expected<std::size_t, ErrorCode>
+{
+  const auto* map_path = document.get_path();
+  if (!map_path) {
+    return std::unexpected {ErrorCode::kBadState};
+  }
+
+  const auto journal_path = get_command_journal_path(*map_path);
+  if (!journal_path.has_value()) {
+    return std::unexpected {journal_path.error()};
+  }
+
+  std::error_code error_code {};
+  if (!std::filesystem::exists(*journal_path, error_code)) {
+    return 0;
+  }
+
+  const auto key = make_command_journal_key(*map_path);
+  if (!key.has_value()) {
+    return std::unexpected {key.error()};
+  }
+
+  auto records = read_command_journal(*journal_path, *key);
+  if (!records.has_value()) {
+    return std::unexpected {records.error()};
+  }
+
+  const auto restored_count =
+      add_command_journal_records(document, history, std::move(*records), false);
+  if (restored_count.has_value()) {
+    history.mark_as_clean();
+  }
+
+  return restored_count;
+}
+
+auto add_command_journal_records(MapDocument& document,
+                                 CommandStack& history,
+                                 std::vector<CommandJournalRecord> records,
+                                 const bool execute) -> std::expected<std::size_t, ErrorCode>
+{
+  const auto& registry = document.get_registry();
+
+  std::unordered_map<LayerID, EntityID> tile_layers {};
+  for (const auto& [layer_entity, layer] : registry.each<CLayer>()) {
+    if (layer.persistent_id.has_value() && is_tile_layer(registry, layer_entity)) {
+      tile_layers.try_emplace(*layer.persistent_id, layer_entity);
+    }
+  }
+
+  // All records are validated before any commands are added.
+  std::vector<EntityID> layer_entities {};
+  layer_entities.reserve(records.size());
+
+  for (const auto& record : records) {
+    const auto layer_iter = tile_layers.find(record.layer_id);
+    if (layer_iter == tile_layers.end()) {
+      TACTILE_LOG_WARN("Command journal refers to unknown tile layer {}", record.layer_id);
+      return std::unexpected {ErrorCode::kBadState};
+    }
+
+    layer_entities.push_back(layer_iter->second);
+  }
+
+  for (std::size_t index = 0; index < records.size(); ++index) {
+    auto& diff = records[index].diff;
+
+    if (execute) {
+      history.push<TileDiffCommand>(&document, layer_entities[index], std::move(diff));
+    }
+    else {
+      history.store<TileDiffCommand>(&document, layer_entities[index], std::move(diff));
+    }
+  }
+
+  return records.size();
+}
+
+}  // namespace tactile::core
@@ -6,8 +6,9 @@
 
 namespace tactile::core {
 
-CommandStack::CommandStack(const std::size_t capacity)
-  : m_capacity {capacity}
+CommandStack::CommandStack(const std::size_t capacity, const std::size_t memory_budget)
+  : m_capacity {capacity},
+    m_memory_budget {memory_budget}
 {}
 
 void CommandStack::mark_as_clean()
@@ -24,16 +25,39 @@ void CommandStack::undo()
 {
   TACTILE_ASSERT(can_undo());
 
-  m_commands.at(m_current_index.value())->undo();
+  const auto command_index = m_current_index.value();
+
+  const auto& cmd = m_commands.at(command_index).command;
+  cmd->undo();
+
+  if (m_observer) {
+    m_observer->on_command_reverted(*cmd);
+  }
+
   _reset_or_decrease_current_index();
+
+  // Reverted commands may keep more data alive, e.g. layers that were created.
+  _update_memory_usage(command_index);
+  _enforce_memory_budget();
 }
 
 void CommandStack::redo()
 {
   TACTILE_ASSERT(can_redo());
 
-  m_commands.at(_get_next_command_index())->redo();
+  const auto command_index = _get_next_command_index();
+
+  const auto& cmd = m_commands.at(command_index).command;
+  cmd->redo();
+
+  if (m_observer) {
+    m_observer->on_command_executed(*cmd);
+  }
+
   _increase_current_index();
+
+  _update_memory_usage(command_index);
+  _enforce_memory_budget();
 }
 
 void CommandStack::_store(std::unique_ptr<ICommand> cmd)
@@ -45,7 +69,14 @@ void CommandStack::_store(std::unique_ptr<ICommand> cmd)
   _remove_commands_after_current_index();
   _increase_current_index();
 
-  m_commands.push_back(std::move(cmd));
+  if (m_observer) {
+    m_observer->on_command_executed(*cmd);
+  }
+
+  m_commands.push_back(StoredCommand {.command = std::move(cmd), .memory_usage = 0});
+
+  _update_memory_usage(m_commands.size() - 1);
+  _enforce_memory_budget();
 }
 
 void CommandStack::set_capacity(const std::size_t capacity)
@@ -61,6 +92,17 @@ void CommandStack::set_capacity(const std::size_t capacity)
   }
 }
 
+void CommandStack::set_memory_budget(const std::size_t memory_budget)
+{
+  m_memory_budget = memory_budget;
+  _enforce_memory_budget();
+}
+
+void CommandStack::set_observer(ICommandObserver* observer)
+{
+  m_observer = observer;
+}
+
 auto CommandStack::is_clean() const -> bool
 {
   return m_commands.empty() || (m_clean_index == m_current_index);
@@ -87,6 +129,31 @@ auto CommandStack::capacity() const -> std::size_t
   return m_capacity;
 }
 
+auto CommandStack::memory_budget() const -> std::size_t
+{
+  return m_memory_budget;
+}
+
+auto CommandStack::memory_usage() const -> std::size_t
+{
+  return m_memory_usage;
+}
+
+auto CommandStack::get_applied_commands() const -> std::vector<const ICommand*>
+{
+  std::vector<const ICommand*> commands {};
+
+  if (m_current_index.has_value()) {
+    commands.reserve(*m_current_index + 1);
+
+    for (std::size_t index = 0; index <= *m_current_index; ++index) {
+      commands.push_back(m_commands[index].command.get());
+    }
+  }
+
+  return commands;
+}
+
 auto CommandStack::index() const -> std::optional<std::size_t>
 {
   return m_current_index;
@@ -101,7 +168,8 @@ void CommandStack::_remove_oldest_command()
 {
   TACTILE_ASSERT(!m_commands.empty());
 
-  m_commands.front()->dispose();
+  m_memory_usage -= m_commands.front().memory_usage;
+  m_commands.front().command->dispose();
   m_commands.pop_front();
   _reset_or_decrease_current_index();
   _reset_or_decrease_clean_index();
@@ -119,11 +187,50 @@ void CommandStack::_remove_commands_after_current_index()
 
   const auto command_count = m_commands.size();
   for (auto cmd_index = start_index; cmd_index < command_count; ++cmd_index) {
-    m_commands.back()->dispose();
+    m_memory_usage -= m_commands.back().memory_usage;
+    m_commands.back().command->dispose();
     m_commands.pop_back();
   }
 }
 
+void CommandStack::_update_memory_usage(const std::size_t index)
+{
+  // The estimates may change when commands are merged, executed, or reverted.
+  auto& stored_command = m_commands.at(index);
+  const auto memory_usage = stored_command.command->get_memory_usage();
+
+  m_memory_usage = m_memory_usage - stored_command.memory_usage + memory_usage;
+  stored_command.memory_usage = memory_usage;
+}
+
+void CommandStack::_enforce_memory_budget()
+{
+  while (m_memory_usage > m_memory_budget && m_commands.size() > 1) {
+    // The oldest command can only be removed if it's applied, otherwise the
+    // remaining commands would be redone without its changes.
+    if (m_current_index.has_value()) {
+      _remove_oldest_command();
+    }
+    else {
+      _remove_newest_command();
+    }
+  }
+}
+
+void CommandStack::_remove_newest_command()
+{
+  TACTILE_ASSERT(!m_commands.empty());
+  TACTILE_ASSERT(m_current_index < m_commands.size() - 1);
+
+  if (m_clean_index == m_commands.size() - 1) {
+    m_clean_index.reset();
+  }
+
+  m_memory_usage -= m_commands.back().memory_usage;
+  m_commands.back().command->dispose();
+  m_commands.pop_back();
+}
+
 void CommandStack::_reset_or_decrease_clean_index()
 {
   if (m_clean_index.has_value()) {
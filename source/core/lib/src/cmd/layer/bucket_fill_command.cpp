@@ -0,0 +1,104 @@
+// Copyright (C) 2024 Albin Johansson (GNU General Public License v3.0)
+
+#include "tactile/core/cmd/layer/bucket_fill_command.hpp"
+
+#include <cstddef>  // size_t
+#include <cstdint>  // uint32_t
+
+#include "tactile/core/cmd/command_journal.hpp"
+#include "tactile/core/debug/validation.hpp"
+#include "tactile/core/document/map_document.hpp"
+#include "tactile/core/entity/registry.hpp"
+#include "tactile/core/layer/layer_types.hpp"
+#include "tactile/core/layer/tile_layer.hpp"
+#include "tactile/core/log/logger.hpp"
+
+namespace tactile::core {
+
+BucketFillCommand::BucketFillCommand(MapDocument* document,
+                                     const EntityID layer_id,
+                                     const Index2D& origin,
+                                     const TileID tile_id,
+                                     const std::optional<TileRegion>& region)
+  : m_document {require_not_null(document, "null document")},
+    m_layer_id {layer_id},
+    m_origin {origin},
+    m_new_tile_id {tile_id},
+    m_region {region},
+    m_old_tile_id {},
+    m_changed_spans {}
+{}
+
+void BucketFillCommand::undo()
+{
+  if (!m_old_tile_id.has_value()) {
+    return;
+  }
+
+  TACTILE_LOG_TRACE("Reverting bucket fill in layer {}", entity_to_string(m_layer_id));
+
+  auto& registry = m_document->get_registry();
+  set_layer_tile_spans(registry, m_layer_id, m_changed_spans, *m_old_tile_id);
+}
+
+void BucketFillCommand::redo()
+{
+  TACTILE_LOG_TRACE("Bucket filling layer {} at {} with tile {}",
+                    entity_to_string(m_layer_id),
+                    m_origin,
+                    m_new_tile_id);
+
+  auto& registry = m_document->get_registry();
+
+  // The fill is only computed once, later applications just repeat the result.
+  if (m_old_tile_id.has_value()) {
+    set_layer_tile_spans(registry, m_layer_id, m_changed_spans, m_new_tile_id);
+    return;
+  }
+
+  m_old_tile_id = get_layer_tile(registry, m_layer_id, m_origin);
+  if (!m_old_tile_id.has_value()) {
+    return;
+  }
+
+  m_changed_spans =
+      m_region.has_value()
+          ? flood_fill_tile_layer(registry, m_layer_id, m_origin, m_new_tile_id, *m_region)
+          : flood_fill_tile_layer(registry, m_layer_id, m_origin, m_new_tile_id);
+  m_changed_spans.shrink_to_fit();
+}
+
+auto BucketFillCommand::get_memory_usage() const -> std::size_t
+{
+  return m_changed_spans.capacity() * sizeof(TileSpan);
+}
+
+auto BucketFillCommand::write_journal_record(CommandJournalRecord& record) const -> bool
+{
+  if (!m_old_tile_id.has_value()) {
+    return false;
+  }
+
+  const auto& registry = m_document->get_registry();
+
+  const auto& layer = registry.get<CLayer>(m_layer_id);
+  if (!layer.persistent_id.has_value()) {
+    return false;
+  }
+
+  record.layer_id = *layer.persistent_id;
+  record.diff = TileDiff {};
+
+  for (const auto& span : m_changed_spans) {
+    record.diff.record_run(TileDiffRun {
+      .position = Index2D {.x = span.begin_col, .y = span.row},
+      .length = static_cast<std::uint32_t>(span.end_col - span.begin_col),
+      .old_tile = *m_old_tile_id,
+      .new_tile = m_new_tile_id,
+    });
+  }
+
+  return true;
+}
+
+}  // namespace tactile::core
@@ -2,6 +2,8 @@
 
 #include "tactile/core/cmd/layer/create_layer_command.hpp"
 
+#include <cstddef>  // size_t
+
 #include "tactile/core/debug/validation.hpp"
 #include "tactile/core/document/document_info.hpp"
 #include "tactile/core/document/map_document.hpp"
@@ -71,4 +73,15 @@ void CreateLayerCommand::dispose()
   }
 }
 
+auto CreateLayerCommand::get_memory_usage() const -> std::size_t
+{
+  // The layer is only kept alive by the command when the command is reverted.
+  if (!m_layer_was_added && m_layer_id != kInvalidEntity) {
+    const auto& registry = m_document->get_registry();
+    return estimate_layer_memory_usage(registry, m_layer_id);
+  }
+
+  return 0;
+}
+
 }  // namespace tactile::core
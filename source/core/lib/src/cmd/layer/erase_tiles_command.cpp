@@ -0,0 +1,92 @@
+// Copyright (C) 2024 Albin Johansson (GNU General Public License v3.0)
+
+#include "tactile/core/cmd/layer/erase_tiles_command.hpp"
+
+#include <cstddef>  // size_t
+
+#include "tactile/core/cmd/command_journal.hpp"
+#include "tactile/core/debug/validation.hpp"
+#include "tactile/core/document/map_document.hpp"
+#include "tactile/core/entity/registry.hpp"
+#include "tactile/core/layer/layer_types.hpp"
+#include "tactile/core/layer/tile_layer.hpp"
+#include "tactile/core/log/logger.hpp"
+
+namespace tactile::core {
+
+EraseTilesCommand::EraseTilesCommand(MapDocument* document,
+                                     const EntityID layer_id,
+                                     const std::uint64_t stroke_id,
+                                     const Index2D& position)
+  : m_document {require_not_null(document, "null document")},
+    m_layer_id {layer_id},
+    m_stroke_id {stroke_id},
+    m_position {position},
+    m_recorded_diff {false},
+    m_diff {}
+{}
+
+void EraseTilesCommand::undo()
+{
+  TACTILE_LOG_TRACE("Reverting eraser stroke {} in layer {}",
+                    m_stroke_id,
+                    entity_to_string(m_layer_id));
+
+  auto& registry = m_document->get_registry();
+  m_diff.revert(registry, m_layer_id);
+}
+
+void EraseTilesCommand::redo()
+{
+  auto& registry = m_document->get_registry();
+
+  if (!m_recorded_diff) {
+    if (const auto old_tile = get_layer_tile(registry, m_layer_id, m_position)) {
+      m_diff.record(m_position, *old_tile, kEmptyTile);
+    }
+
+    m_recorded_diff = true;
+  }
+
+  m_diff.apply(registry, m_layer_id);
+}
+
+auto EraseTilesCommand::merge_with(const ICommand* cmd) -> bool
+{
+  const auto* other = dynamic_cast<const EraseTilesCommand*>(cmd);
+
+  if (!other || m_document != other->m_document || m_layer_id != other->m_layer_id ||
+      m_stroke_id != other->m_stroke_id || !other->m_recorded_diff) {
+    return false;
+  }
+
+  m_diff.append(other->m_diff);
+
+  return true;
+}
+
+auto EraseTilesCommand::get_memory_usage() const -> std::size_t
+{
+  return m_diff.get_memory_usage();
+}
+
+auto EraseTilesCommand::write_journal_record(CommandJournalRecord& record) const -> bool
+{
+  if (!m_recorded_diff) {
+    return false;
+  }
+
+  const auto& registry = m_document->get_registry();
+
+  const auto& layer = registry.get<CLayer>(m_layer_id);
+  if (!layer.persistent_id.has_value()) {
+    return false;
+  }
+
+  record.layer_id = *layer.persistent_id;
+  record.diff = m_diff;
+
+  return true;
+}
+
+}  // namespace tactile::core
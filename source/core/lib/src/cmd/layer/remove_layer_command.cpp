@@ -2,22 +2,37 @@
 
 #include "tactile/core/cmd/layer/remove_layer_command.hpp"
 
+#include <cstddef>  // size_t
+#include <utility>  // move
+
+#include "tactile/base/io/tile_io.hpp"
+#include "tactile/core/cmd/undo_payload_store.hpp"
+#include "tactile/core/debug/exception.hpp"
 #include "tactile/core/debug/validation.hpp"
 #include "tactile/core/document/document_info.hpp"
 #include "tactile/core/document/map_document.hpp"
 #include "tactile/core/entity/registry.hpp"
 #include "tactile/core/layer/group_layer.hpp"
 #include "tactile/core/layer/layer_common.hpp"
+#include "tactile/core/layer/layer_types.hpp"
+#include "tactile/core/layer/tile_layer.hpp"
 #include "tactile/core/log/logger.hpp"
 #include "tactile/core/map/map.hpp"
 
 namespace tactile::core {
+namespace {
+
+// Smaller tile layers are cheap to keep around as is.
+inline constexpr std::size_t kMinOffloadedTileCount = 64 * 64;
+
+}  // namespace
 
 RemoveLayerCommand::RemoveLayerCommand(MapDocument* document, const EntityID layer_id)
   : m_document {require_not_null(document, "null document")},
     m_layer_id {layer_id},
     m_parent_layer_id {kInvalidEntity},
-    m_layer_was_removed {false}
+    m_layer_was_removed {false},
+    m_offloaded_tiles {}
 {}
 
 void RemoveLayerCommand::undo()
@@ -28,6 +43,8 @@ void RemoveLayerCommand::undo()
   const auto map_id = registry.get<CDocumentInfo>().root;
   auto& map = registry.get<CMap>(map_id);
 
+  _restore_tiles();
+
   map.active_layer = m_parent_layer_id;
   append_layer_to_map(registry, map_id, m_layer_id);
 
@@ -46,11 +63,15 @@ void RemoveLayerCommand::redo()
 
   remove_layer_from_map(registry, map_id, m_layer_id).value();
   m_layer_was_removed = true;
+
+  _offload_tiles(m_layer_id);
 }
 
 void RemoveLayerCommand::dispose()
 {
   if (m_layer_was_removed && m_layer_id != kInvalidEntity) {
+    _release_offloaded_tiles();
+
     auto& registry = m_document->get_registry();
     destroy_layer(registry, m_layer_id);
 
@@ -58,4 +79,91 @@ void RemoveLayerCommand::dispose()
   }
 }
 
+auto RemoveLayerCommand::get_memory_usage() const -> std::size_t
+{
+  // The removed layer is kept alive by the command until it is disposed.
+  if (m_layer_was_removed && m_layer_id != kInvalidEntity) {
+    const auto& registry = m_document->get_registry();
+    const auto& payload_store = m_document->get_undo_payload_store();
+
+    auto memory_usage = estimate_layer_memory_usage(registry, m_layer_id);
+    for (const auto& offloaded_tiles : m_offloaded_tiles) {
+      memory_usage += payload_store.get_resident_size(offloaded_tiles.payload_id);
+    }
+
+    return memory_usage;
+  }
+
+  return 0;
+}
+
+void RemoveLayerCommand::_offload_tiles(const EntityID layer_id)
+{
+  auto& registry = m_document->get_registry();
+
+  if (const auto* group_layer = registry.find<CGroupLayer>(layer_id)) {
+    for (const auto nested_layer_id : group_layer->layers) {
+      _offload_tiles(nested_layer_id);
+    }
+
+    return;
+  }
+
+  auto* dense_tile_layer = registry.find<CDenseTileLayer>(layer_id);
+  if (!dense_tile_layer) {
+    return;
+  }
+
+  const auto& extent = registry.get<CTileLayer>(layer_id).extent;
+  if (extent.rows * extent.cols < kMinOffloadedTileCount) {
+    return;
+  }
+
+  auto& payload_store = m_document->get_undo_payload_store();
+
+  const auto tile_bytes = serialize_tile_layer(registry, layer_id);
+  const auto payload_id = payload_store.store(tile_bytes);
+
+  m_offloaded_tiles.push_back(OffloadedTiles {layer_id, payload_id});
+  dense_tile_layer->tiles = TileMatrix {};
+}
+
+void RemoveLayerCommand::_restore_tiles()
+{
+  auto& registry = m_document->get_registry();
+  auto& payload_store = m_document->get_undo_payload_store();
+
+  for (const auto& [layer_id, payload_id] : m_offloaded_tiles) {
+    const auto tile_bytes = payload_store.load(payload_id);
+    if (!tile_bytes.has_value()) {
+      TACTILE_LOG_ERROR("Could not load tiles of layer {}: {}",
+                        entity_to_string(layer_id),
+                        to_string(tile_bytes.error()));
+      throw Exception {"could not restore tile layer"};
+    }
+
+    const auto& extent = registry.get<CTileLayer>(layer_id).extent;
+    auto tiles = parse_raw_tile_matrix(*tile_bytes, extent, TileIdFormat::kTactile);
+    if (!tiles.has_value()) {
+      throw Exception {"could not restore tile layer"};
+    }
+
+    registry.get<CDenseTileLayer>(layer_id).tiles = std::move(*tiles);
+    payload_store.release(payload_id);
+  }
+
+  m_offloaded_tiles.clear();
+}
+
+void RemoveLayerCommand::_release_offloaded_tiles()
+{
+  auto& payload_store = m_document->get_undo_payload_store();
+
+  for (const auto& offloaded_tiles : m_offloaded_tiles) {
+    payload_store.release(offloaded_tiles.payload_id);
+  }
+
+  m_offloaded_tiles.clear();
+}
+
 }  // namespace tactile::core
@@ -0,0 +1,117 @@
+// Copyright (C) 2024 Albin Johansson (GNU General Public License v3.0)
+
+#include "tactile/core/cmd/layer/stamp_tiles_command.hpp"
+
+#include <cstddef>  // size_t
+#include <utility>  // move
+
+#include "tactile/core/cmd/command_journal.hpp"
+#include "tactile/core/debug/validation.hpp"
+#include "tactile/core/document/map_document.hpp"
+#include "tactile/core/entity/registry.hpp"
+#include "tactile/core/layer/layer_types.hpp"
+#include "tactile/core/layer/tile_layer.hpp"
+#include "tactile/core/log/logger.hpp"
+
+namespace tactile::core {
+
+StampTilesCommand::StampTilesCommand(MapDocument* document,
+                                     const EntityID layer_id,
+                                     const std::uint64_t stroke_id,
+                                     const Index2D& position,
+                                     TileMatrix pattern)
+  : m_document {require_not_null(document, "null document")},
+    m_layer_id {layer_id},
+    m_stroke_id {stroke_id},
+    m_position {position},
+    m_pattern {std::move(pattern)},
+    m_diff {}
+{}
+
+void StampTilesCommand::undo()
+{
+  TACTILE_LOG_TRACE("Reverting stamp stroke {} in layer {}",
+                    m_stroke_id,
+                    entity_to_string(m_layer_id));
+
+  auto& registry = m_document->get_registry();
+  m_diff.revert(registry, m_layer_id);
+}
+
+void StampTilesCommand::redo()
+{
+  auto& registry = m_document->get_registry();
+
+  // The diff is recorded from the pattern once, the pattern is discarded afterwards.
+  if (m_pattern.has_value()) {
+    const auto& pattern = *m_pattern;
+
+    for (std::size_t row = 0; row < pattern.size(); ++row) {
+      for (std::size_t col = 0; col < pattern[row].size(); ++col) {
+        const auto new_tile = pattern[row][col];
+        if (new_tile == kEmptyTile) {
+          continue;
+        }
+
+        const Index2D index {.x = m_position.x + col, .y = m_position.y + row};
+        if (const auto old_tile = get_layer_tile(registry, m_layer_id, index)) {
+          m_diff.record(index, *old_tile, new_tile);
+        }
+      }
+    }
+
+    m_pattern.reset();
+    m_diff.shrink_to_fit();
+  }
+
+  m_diff.apply(registry, m_layer_id);
+}
+
+auto StampTilesCommand::merge_with(const ICommand* cmd) -> bool
+{
+  const auto* other = dynamic_cast<const StampTilesCommand*>(cmd);
+
+  if (!other || m_document != other->m_document || m_layer_id != other->m_layer_id ||
+      m_stroke_id != other->m_stroke_id || other->m_pattern.has_value()) {
+    return false;
+  }
+
+  m_diff.append(other->m_diff);
+
+  return true;
+}
+
+auto StampTilesCommand::get_memory_usage() const -> std::size_t
+{
+  auto memory_usage = m_diff.get_memory_usage();
+
+  if (m_pattern.has_value()) {
+    for (const auto& row : *m_pattern) {
+      memory_usage += sizeof row + row.capacity() * sizeof(TileID);
+    }
+  }
+
+  return memory_usage;
+}
+
+auto StampTilesCommand::write_journal_record(CommandJournalRecord& record) const -> bool
+{
+  // The diff is recorded when the command is first executed.
+  if (m_pattern.has_value()) {
+    return false;
+  }
+
+  const auto& registry = m_document->get_registry();
+
+  const auto& layer = registry.get<CLayer>(m_layer_id);
+  if (!layer.persistent_id.has_value()) {
+    return false;
+  }
+
+  record.layer_id = *layer.persistent_id;
+  record.diff = m_diff;
+
+  return true;
+}
+
+}  // namespace tactile::core
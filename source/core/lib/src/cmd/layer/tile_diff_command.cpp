@@ -0,0 +1,61 @@
+// Copyright (C) 2024 Albin Johansson (GNU General Public License v3.0)
+
+#include "tactile/core/cmd/layer/tile_diff_command.hpp"
+
+#include <cstddef>  // size_t
+#include <utility>  // move
+
+#include "tactile/core/cmd/command_journal.hpp"
+#include "tactile/core/debug/validation.hpp"
+#include "tactile/core/document/map_document.hpp"
+#include "tactile/core/entity/registry.hpp"
+#include "tactile/core/layer/layer_types.hpp"
+#include "tactile/core/log/logger.hpp"
+
+namespace tactile::core {
+
+TileDiffCommand::TileDiffCommand(MapDocument* document,
+                                 const EntityID layer_id,
+                                 TileDiff diff)
+  : m_document {require_not_null(document, "null document")},
+    m_layer_id {layer_id},
+    m_diff {std::move(diff)}
+{}
+
+void TileDiffCommand::undo()
+{
+  TACTILE_LOG_TRACE("Reverting {} tile changes in layer {}",
+                    m_diff.tile_count(),
+                    entity_to_string(m_layer_id));
+
+  auto& registry = m_document->get_registry();
+  m_diff.revert(registry, m_layer_id);
+}
+
+void TileDiffCommand::redo()
+{
+  auto& registry = m_document->get_registry();
+  m_diff.apply(registry, m_layer_id);
+}
+
+auto TileDiffCommand::get_memory_usage() const -> std::size_t
+{
+  return m_diff.get_memory_usage();
+}
+
+auto TileDiffCommand::write_journal_record(CommandJournalRecord& record) const -> bool
+{
+  const auto& registry = m_document->get_registry();
+
+  const auto& layer = registry.get<CLayer>(m_layer_id);
+  if (!layer.persistent_id.has_value()) {
+    return false;
+  }
+
+  record.layer_id = *layer.persistent_id;
+  record.diff = m_diff;
+
+  return true;
+}
+
+}  // namespace tactile::core
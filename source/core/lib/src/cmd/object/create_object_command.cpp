@@ -8,6 +8,7 @@
 #include "tactile/core/entity/registry.hpp"
 #include "tactile/core/layer/layer_types.hpp"
 #include "tactile/core/layer/object.hpp"
+#include "tactile/core/layer/object_index.hpp"
 #include "tactile/core/log/logger.hpp"
 #include "tactile/core/map/map.hpp"
 
@@ -34,6 +35,7 @@ void CreateObjectCommand::undo()
 
   auto& object_layer = registry.get<CObjectLayer>(m_layer_id);
   std::erase(object_layer.objects, m_object_id);
+  remove_object_from_index(registry, m_layer_id, m_object_id);
 
   m_object_was_added = false;
 }
@@ -55,6 +57,7 @@ void CreateObjectCommand::redo()
 
   auto& object_layer = registry.get<CObjectLayer>(m_layer_id);
   object_layer.objects.push_back(m_object_id);
+  add_object_to_index(registry, m_layer_id, m_object_id);
 
   TACTILE_LOG_TRACE("Created object {}", entity_to_string(m_object_id));
   m_object_was_added = true;
@@ -8,6 +8,7 @@
 #include "tactile/base/numeric/vec_format.hpp"
 #include "tactile/core/debug/validation.hpp"
 #include "tactile/core/entity/registry.hpp"
+#include "tactile/core/layer/object_index.hpp"
 #include "tactile/core/layer/layer_types.hpp"
 #include "tactile/core/log/logger.hpp"
 
@@ -29,6 +30,8 @@ void MoveObjectCommand::undo()
 
   auto& object = registry.get<CObject>(m_object_id);
   object.position = m_old_position;
+
+  update_object_in_index(registry, m_object_id);
 }
 
 void MoveObjectCommand::redo()
@@ -38,6 +41,8 @@ void MoveObjectCommand::redo()
 
   auto& object = registry.get<CObject>(m_object_id);
   m_old_position = std::exchange(object.position, m_new_position);
+
+  update_object_in_index(registry, m_object_id);
 }
 
 }  // namespace tactile::core
@@ -7,6 +7,7 @@
 #include "tactile/core/entity/registry.hpp"
 #include "tactile/core/layer/layer_types.hpp"
 #include "tactile/core/layer/object.hpp"
+#include "tactile/core/layer/object_index.hpp"
 #include "tactile/core/log/logger.hpp"
 
 namespace tactile::core {
@@ -27,6 +28,7 @@ void RemoveObjectCommand::undo()
 
   auto& object_layer = registry.get<CObjectLayer>(m_layer_id);
   object_layer.objects.push_back(m_object_id);
+  add_object_to_index(registry, m_layer_id, m_object_id);
 
   m_object_was_removed = false;
 }
@@ -38,6 +40,7 @@ void RemoveObjectCommand::redo()
 
   auto& object_layer = registry.get<CObjectLayer>(m_layer_id);
   std::erase(object_layer.objects, m_object_id);
+  remove_object_from_index(registry, m_layer_id, m_object_id);
 
   m_object_was_removed = true;
 }
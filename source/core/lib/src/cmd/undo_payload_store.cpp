@@ -0,0 +1,428 @@
+// Copyright (C) 2024 Albin Johansson (GNU General Public License v3.0)
+
+#include "tactile/core/cmd/undo_payload_store.hpp"
+
+#include <cstring>       // memcpy, memcmp
+#include <string>        // string
+#include <string_view>   // string_view
+#include <system_error>  // error_code
+#include <utility>       // move
+#include <vector>        // vector
+
+#include "tactile/base/io/atomic_file.hpp"
+#include "tactile/base/io/compress/compression_format.hpp"
+#include "tactile/base/io/file_io.hpp"
+#include "tactile/base/io/varint.hpp"
+#include "tactile/core/debug/profiler.hpp"
+#include "tactile/core/log/logger.hpp"
+#include "tactile/core/util/uuid.hpp"
+
+namespace tactile::core {
+namespace {
+
+// Smaller payloads are cheap to keep around, so they're not worth compressing.
+inline constexpr std::size_t kMinCompressedPayloadSize = 1'024;
+
+// The built-in codec works on 32-bit words, which matches the tile identifier size.
+inline constexpr std::size_t kWordSize = 4;
+
+// Shorter runs are stored as literals, since a run token is at least five bytes.
+inline constexpr std::size_t kMinRunLength = 3;
+
+// The name prefix of the spill directories.
+inline constexpr std::string_view kSpillDirectoryPrefix = "undo-";
+
+// The name of the lock files that are held by the stores that own spill directories.
+inline constexpr std::string_view kSpillLockName = "spill.lock";
+
+[[nodiscard]]
+auto _get_spill_root_directory(std::error_code& error_code) -> std::filesystem::path
+{
+  const auto temp_directory = std::filesystem::temp_directory_path(error_code);
+  return !error_code ? temp_directory / "tactile" : std::filesystem::path {};
+}
+
+void _write_literals(ByteStream& stream,
+                     const ByteSpan bytes,
+                     const std::size_t first_word,
+                     const std::size_t word_count)
+{
+  if (word_count > 0) {
+    write_varint(stream, word_count << 1);
+
+    const auto literals = bytes.subspan(first_word * kWordSize, word_count * kWordSize);
+    stream.insert(stream.end(), literals.begin(), literals.end());
+  }
+}
+
+// Encodes a byte sequence as runs of repeated words and sequences of literal words.
+// Each token starts with a varint header, where the lowest bit indicates a run and
+// the remaining bits store the word count. Trailing bytes are stored verbatim.
+[[nodiscard]]
+auto _encode_word_runs(const ByteSpan bytes) -> ByteStream
+{
+  ByteStream stream {};
+  stream.reserve(bytes.size() / 8);
+
+  const auto word_count = bytes.size() / kWordSize;
+  const auto word_equals = [&](const std::size_t a, const std::size_t b) {
+    return std::memcmp(&bytes[a * kWordSize], &bytes[b * kWordSize], kWordSize) == 0;
+  };
+
+  std::size_t literal_begin = 0;
+  std::size_t word_index = 0;
+
+  while (word_index < word_count) {
+    auto run_end = word_index + 1;
+    while (run_end < word_count && word_equals(run_end, word_index)) {
+      ++run_end;
+    }
+
+    if (run_end - word_index >= kMinRunLength) {
+      _write_literals(stream, bytes, literal_begin, word_index - literal_begin);
+
+      write_varint(stream, ((run_end - word_index) << 1) | 1);
+
+      const auto word = bytes.subspan(word_index * kWordSize, kWordSize);
+      stream.insert(stream.end(), word.begin(), word.end());
+
+      literal_begin = run_end;
+    }
+
+    word_index = run_end;
+  }
+
+  _write_literals(stream, bytes, literal_begin, word_count - literal_begin);
+
+  const auto tail = bytes.subspan(word_count * kWordSize);
+  stream.insert(stream.end(), tail.begin(), tail.end());
+
+  return stream;
+}
+
+[[nodiscard]]
+auto _decode_word_runs(const ByteSpan stream, const std::size_t raw_size)
+    -> std::expected<ByteStream, ErrorCode>
+{
+  ByteStream bytes {};
+  bytes.reserve(raw_size);
+
+  const auto word_count = raw_size / kWordSize;
+
+  std::size_t decoded_word_count = 0;
+  std::size_t offset = 0;
+
+  while (decoded_word_count < word_count) {
+    const auto header = read_varint(stream, offset);
+    if (!header.has_value()) {
+      return std::unexpected {ErrorCode::kCouldNotDecompress};
+    }
+
+    const auto count = *header >> 1;
+    if (count == 0 || count > word_count - decoded_word_count) {
+      return std::unexpected {ErrorCode::kCouldNotDecompress};
+    }
+
+    const auto is_run = (*header & 1) != 0;
+    const auto token_size = is_run ? kWordSize : count * kWordSize;
+
+    if (token_size > stream.size() - offset) {
+      return std::unexpected {ErrorCode::kCouldNotDecompress};
+    }
+
+    const auto token = stream.subspan(offset, token_size);
+    if (is_run) {
+      for (std::size_t index = 0; index < count; ++index) {
+        bytes.insert(bytes.end(), token.begin(), token.end());
+      }
+    }
+    else {
+      bytes.insert(bytes.end(), token.begin(), token.end());
+    }
+
+    offset += token_size;
+    decoded_word_count += count;
+  }
+
+  const auto tail = stream.subspan(offset);
+  if (tail.size() != raw_size % kWordSize) {
+    return std::unexpected {ErrorCode::kCouldNotDecompress};
+  }
+
+  bytes.insert(bytes.end(), tail.begin(), tail.end());
+  return bytes;
+}
+
+}  // namespace
+
+UndoPayloadStore::~UndoPayloadStore() noexcept
+{
+  if (!m_spill_directory.empty()) {
+    // The lock is released first, since locked files can't be removed on Windows.
+    m_spill_lock.reset();
+
+    std::error_code error_code {};
+    std::filesystem::remove_all(m_spill_directory, error_code);
+  }
+}
+
+auto UndoPayloadStore::store(const ByteSpan bytes) -> UndoPayloadId
+{
+  TACTILE_PROFILE_ZONE("UndoPayloadStore::store");
+
+  Payload payload {
+    .encoding = PayloadEncoding::kRaw,
+    .compression_format = nullptr,
+    .raw_size = bytes.size(),
+    .bytes = ByteStream {},
+    .is_spilled = false,
+  };
+
+  if (bytes.size() >= kMinCompressedPayloadSize) {
+    if (m_compression_format != nullptr) {
+      if (auto compressed = m_compression_format->compress(bytes);
+          compressed.has_value() && compressed->size() < bytes.size()) {
+        payload.encoding = PayloadEncoding::kCompressionFormat;
+        payload.compression_format = m_compression_format;
+        payload.bytes = std::move(*compressed);
+      }
+    }
+
+    if (payload.encoding == PayloadEncoding::kRaw) {
+      if (auto encoded = _encode_word_runs(bytes); encoded.size() < bytes.size()) {
+        payload.encoding = PayloadEncoding::kBuiltin;
+        payload.bytes = std::move(encoded);
+      }
+    }
+  }
+
+  if (payload.encoding == PayloadEncoding::kRaw) {
+    payload.bytes.assign(bytes.begin(), bytes.end());
+  }
+
+  payload.bytes.shrink_to_fit();
+  m_resident_size += payload.bytes.size();
+
+  const auto id = m_next_id++;
+  m_payloads.emplace(id, std::move(payload));
+
+  _spill_payloads();
+
+  return id;
+}
+
+auto UndoPayloadStore::load(const UndoPayloadId id) const
+    -> std::expected<ByteStream, ErrorCode>
+{
+  TACTILE_PROFILE_ZONE("UndoPayloadStore::load");
+
+  const auto iter = m_payloads.find(id);
+  if (iter == m_payloads.end()) {
+    return std::unexpected {ErrorCode::kBadParam};
+  }
+
+  const auto& payload = iter->second;
+
+  ByteStream spilled_bytes {};
+  if (payload.is_spilled) {
+    const auto file_content = read_binary_file(_get_spill_path(id));
+    if (!file_content.has_value()) {
+      return std::unexpected {ErrorCode::kBadFileStream};
+    }
+
+    spilled_bytes.assign(file_content->begin(), file_content->end());
+  }
+
+  const ByteSpan bytes = payload.is_spilled ? spilled_bytes : payload.bytes;
+
+  switch (payload.encoding) {
+    case PayloadEncoding::kRaw: {
+      if (bytes.size() != payload.raw_size) {
+        return std::unexpected {ErrorCode::kBadState};
+      }
+
+      return ByteStream {bytes.begin(), bytes.end()};
+    }
+    case PayloadEncoding::kBuiltin: {
+      return _decode_word_runs(bytes, payload.raw_size);
+    }
+    case PayloadEncoding::kCompressionFormat: {
+      auto decompressed = payload.compression_format->decompress(bytes);
+      if (decompressed.has_value() && decompressed->size() != payload.raw_size) {
+        return std::unexpected {ErrorCode::kCouldNotDecompress};
+      }
+
+      return decompressed;
+    }
+  }
+
+  return std::unexpected {ErrorCode::kBadState};
+}
+
+void UndoPayloadStore::release(const UndoPayloadId id)
+{
+  const auto iter = m_payloads.find(id);
+  if (iter == m_payloads.end()) {
+    return;
+  }
+
+  if (iter->second.is_spilled) {
+    std::error_code error_code {};
+    std::filesystem::remove(_get_spill_path(id), error_code);
+  }
+  else {
+    m_resident_size -= iter->second.bytes.size();
+  }
+
+  m_payloads.erase(iter);
+}
+
+void UndoPayloadStore::set_compression_format(const ICompressionFormat* format)
+{
+  m_compression_format = format;
+}
+
+void UndoPayloadStore::set_spill_threshold(const std::size_t byte_count)
+{
+  m_spill_threshold = byte_count;
+  _spill_payloads();
+}
+
+auto UndoPayloadStore::get_resident_size(const UndoPayloadId id) const -> std::size_t
+{
+  const auto iter = m_payloads.find(id);
+  if (iter == m_payloads.end()) {
+    return 0;
+  }
+
+  return iter->second.bytes.size();
+}
+
+auto UndoPayloadStore::get_resident_size() const -> std::size_t
+{
+  return m_resident_size;
+}
+
+auto UndoPayloadStore::payload_count() const -> std::size_t
+{
+  return m_payloads.size();
+}
+
+void UndoPayloadStore::_spill_payloads()
+{
+  if (m_resident_size <= m_spill_threshold) {
+    return;
+  }
+
+  TACTILE_PROFILE_ZONE("UndoPayloadStore::_spill_payloads");
+
+  if (m_spill_directory.empty()) {
+    std::error_code error_code {};
+
+    const auto spill_directory_name =
+        std::string {kSpillDirectoryPrefix} + to_string(UUID::generate());
+    auto spill_directory = _get_spill_root_directory(error_code) / spill_directory_name;
+
+    if (!error_code) {
+      std::filesystem::create_directories(spill_directory, error_code);
+    }
+
+    if (error_code) {
+      TACTILE_LOG_WARN("Could not create undo spill directory: {}", error_code.message());
+      return;
+    }
+
+    auto spill_lock = FileLock::try_lock(spill_directory / kSpillLockName);
+    if (!spill_lock.has_value()) {
+      TACTILE_LOG_WARN("Could not lock undo spill directory: {}",
+                       to_string(spill_lock.error()));
+      std::filesystem::remove_all(spill_directory, error_code);
+      return;
+    }
+
+    m_spill_directory = std::move(spill_directory);
+    m_spill_lock.emplace(std::move(*spill_lock));
+  }
+
+  // Payload identifiers are increasing, so the oldest payloads are spilled first.
+  for (auto& [id, payload] : m_payloads) {
+    if (m_resident_size <= m_spill_threshold) {
+      break;
+    }
+
+    if (payload.is_spilled) {
+      continue;
+    }
+
+    // The atomic writer reports errors that are only detected when the file is
+    // flushed or closed, e.g., when the disk is full, before the memory is released.
+    const AtomicWriteOptions write_options {.sync_directory = false};
+    const auto write_result =
+        write_file_atomically(_get_spill_path(id), payload.bytes, write_options);
+    if (!write_result.has_value()) {
+      TACTILE_LOG_WARN("Could not spill undo payload {} to disk: {}",
+                       id,
+                       to_string(write_result.error()));
+      return;
+    }
+
+    m_resident_size -= payload.bytes.size();
+
+    payload.is_spilled = true;
+    payload.bytes = ByteStream {};
+  }
+}
+
+auto UndoPayloadStore::_get_spill_path(const UndoPayloadId id) const -> std::filesystem::path
+{
+  return m_spill_directory / (std::to_string(id) + ".bin");
+}
+
+auto remove_stale_undo_spill_directories() -> std::size_t
+{
+  std::error_code error_code {};
+
+  const auto root_directory = _get_spill_root_directory(error_code);
+  if (error_code) {
+    return 0;
+  }
+
+  std::vector<std::filesystem::path> spill_directories {};
+
+  for (const auto& entry : std::filesystem::directory_iterator {root_directory, error_code}) {
+    if (entry.is_directory(error_code) &&
+        entry.path().filename().string().starts_with(kSpillDirectoryPrefix)) {
+      spill_directories.push_back(entry.path());
+    }
+  }
+
+  std::size_t removed_count {0};
+
+  for (const auto& spill_directory : spill_directories) {
+    // Directories without lock files might not have been locked by their stores yet.
+    const auto lock_path = spill_directory / kSpillLockName;
+    if (!std::filesystem::exists(lock_path, error_code)) {
+      continue;
+    }
+
+    auto spill_lock = FileLock::try_lock(lock_path);
+    if (!spill_lock.has_value()) {
+      continue;
+    }
+
+    // The lock is released first, since locked files can't be removed on Windows.
+    spill_lock->unlock();
+
+    if (std::filesystem::remove_all(spill_directory, error_code) > 0) {
+      ++removed_count;
+    }
+  }
+
+  if (removed_count > 0) {
+    TACTILE_LOG_DEBUG("Removed {} stale undo spill director(ies)", removed_count);
+  }
+
+  return removed_count;
+}
+
+}  // namespace tactile::core
@@ -0,0 +1,124 @@
+// Copyright (C) 2024 Albin Johansson (GNU General Public License v3.0)
+
+#include "tactile/core/debug/chrome_trace.hpp"
+
+#include <cstdint>    // uint32_t
+#include <exception>  // exception
+#include <format>     // format_to
+#include <iterator>   // ostreambuf_iterator
+#include <set>        // set
+
+#include "tactile/base/io/atomic_file.hpp"
+#include "tactile/core/debug/profiler.hpp"
+#include "tactile/core/log/logger.hpp"
+
+namespace tactile::core {
+namespace {
+
+void _write_escaped_string(std::ostream& stream, const char* str)
+{
+  stream << '"';
+
+  for (const auto* ch = str; *ch != '\0'; ++ch) {
+    switch (*ch) {
+      case '"':  stream << "\\\""; break;
+      case '\\': stream << "\\\\"; break;
+      case '\n': stream << "\\n"; break;
+      case '\t': stream << "\\t"; break;
+      default:
+        if (static_cast<unsigned char>(*ch) < 0x20) {
+          std::format_to(std::ostreambuf_iterator<char> {stream},
+                         "\\u{:04x}",
+                         static_cast<unsigned>(*ch));
+        }
+        else {
+          stream << *ch;
+        }
+    }
+  }
+
+  stream << '"';
+}
+
+void _write_zone_event(std::ostream& stream, const ProfileZoneEvent& event)
+{
+  stream << R"({"name":)";
+  _write_escaped_string(stream, event.name ? event.name : "?");
+
+  // Timestamps and durations are specified in microseconds.
+  std::format_to(std::ostreambuf_iterator<char> {stream},
+                 R"(,"cat":"tactile","ph":"X","ts":{:.3f},"dur":{:.3f},"pid":1,"tid":{},)"
+                 R"("args":{{"depth":{}}}}})",
+                 static_cast<double>(event.start_ns) / 1'000.0,
+                 static_cast<double>(event.duration_ns) / 1'000.0,
+                 event.thread_index,
+                 event.depth);
+}
+
+void _write_thread_name_event(std::ostream& stream, const std::uint32_t thread_index)
+{
+  std::format_to(std::ostreambuf_iterator<char> {stream},
+                 R"({{"name":"thread_name","ph":"M","pid":1,"tid":{},)"
+                 R"("args":{{"name":"Thread {}"}}}})",
+                 thread_index,
+                 thread_index);
+}
+
+}  // namespace
+
+void write_chrome_trace(std::ostream& stream, const std::span<const ProfileZoneEvent> events)
+{
+  std::set<std::uint32_t> thread_indices {};
+
+  stream << R"({"displayTimeUnit":"ms","traceEvents":[)";
+
+  auto is_first = true;
+  for (const auto& event : events) {
+    if (!is_first) {
+      stream << ",\n";
+    }
+
+    _write_zone_event(stream, event);
+    thread_indices.insert(event.thread_index);
+    is_first = false;
+  }
+
+  for (const auto thread_index : thread_indices) {
+    if (!is_first) {
+      stream << ",\n";
+    }
+
+    _write_thread_name_event(stream, thread_index);
+    is_first = false;
+  }
+
+  stream << "]}\n";
+}
+
+auto save_chrome_trace(const std::filesystem::path& path,
+                       const std::span<const ProfileZoneEvent> events)
+    -> std::expected<void, ErrorCode>
+{
+  TACTILE_LOG_DEBUG("Saving trace with {} events to {}", events.size(), path.string());
+
+  try {
+    // Traces are written atomically, so a failed save never leaves a truncated trace.
+    const auto write_result = write_file_atomically(path, [events](std::ostream& stream) {
+      write_chrome_trace(stream, events);
+    });
+
+    if (!write_result.has_value()) {
+      TACTILE_LOG_ERROR("Could not write trace file: {}", to_string(write_result.error()));
+      return std::unexpected {write_result.error()};
+    }
+
+    return {};
+  }
+  catch (const std::exception& error) {
+    TACTILE_LOG_ERROR("Trace save error: {}", error.what());
+  }
+
+  return std::unexpected {ErrorCode::kWriteError};
+}
+
+}  // namespace tactile::core
@@ -0,0 +1,429 @@
+// Copyright (C) 2024 Albin Johansson (GNU General Public License v3.0)
+
+#include "tactile/core/debug/profiler.hpp"
+
+#include <algorithm>   // max, min
+#include <atomic>      // atomic, atomic_bool, atomic_thread_fence, memory_order
+#include <chrono>      // steady_clock, nanoseconds, duration_cast
+#include <cstddef>     // ptrdiff_t
+#include <exception>   // exception
+#include <functional>  // less
+#include <map>         // map
+#include <memory>      // shared_ptr, make_shared
+#include <mutex>       // mutex, scoped_lock
+#include <utility>     // move, exchange
+
+namespace tactile::core {
+namespace {
+
+inline constexpr std::uint64_t kEventCapacity {kProfilerEventCapacity};
+
+/**
+ * A slot in a thread event buffer.
+ *
+ * \details
+ * The slot members are atomic, since slots may be overwritten by the owning
+ * thread while they are being read by the profiler.
+ */
+struct EventSlot final
+{
+  std::atomic<const char*> name;
+  std::atomic<std::uint32_t> depth;
+  std::atomic<std::int64_t> start_ns;
+  std::atomic<std::int64_t> duration_ns;
+};
+
+/**
+ * A lock-free ring buffer of zone events, written by a single thread.
+ */
+struct ThreadEventBuffer final
+{
+  /** The event slots, with a fixed capacity. */
+  std::vector<EventSlot> slots = std::vector<EventSlot>(kProfilerEventCapacity);
+
+  /** The total number of events written to the buffer by the owning thread. */
+  std::atomic<std::uint64_t> write_count {0};
+
+  /** The total number of events read by the profiler, guarded by the profiler mutex. */
+  std::uint64_t read_count {0};
+
+  /** The index of the associated thread. */
+  std::uint32_t thread_index {0};
+};
+
+struct ActiveZone final
+{
+  const char* name;
+  std::int64_t start_ns;
+  bool is_recorded;
+};
+
+struct ThreadZoneState final
+{
+  std::shared_ptr<ThreadEventBuffer> buffer;
+  std::vector<ActiveZone> zone_stack;
+
+  /** Returns the buffer to the profiler when the owning thread exits. */
+  ~ThreadZoneState() noexcept;
+};
+
+struct ProfilerState final
+{
+  std::atomic_bool enabled {true};
+  std::chrono::steady_clock::time_point epoch {std::chrono::steady_clock::now()};
+
+  std::mutex mutex;
+  std::vector<std::shared_ptr<ThreadEventBuffer>> buffers;
+  std::vector<std::shared_ptr<ThreadEventBuffer>> free_buffers;
+  std::int64_t last_frame_ns {0};
+  std::uint64_t frame_count {0};
+  std::vector<float> frame_times_ms;
+  std::map<std::string, std::vector<float>, std::less<>> zone_times_ms;
+  std::vector<ProfileZoneEvent> frame_events;
+  std::vector<ProfileZoneEvent> captured_events;
+  bool is_capturing {false};
+};
+
+[[nodiscard]]
+auto _get_profiler_state() -> ProfilerState&
+{
+  static ProfilerState state {};
+  return state;
+}
+
+ThreadZoneState::~ThreadZoneState() noexcept
+{
+  if (!buffer) {
+    return;
+  }
+
+  try {
+    auto& state = _get_profiler_state();
+    const std::scoped_lock lock {state.mutex};
+
+    // The buffer is kept, since it may contain events that haven't been read yet.
+    state.free_buffers.push_back(std::move(buffer));
+  }
+  catch (const std::exception&) {
+    // The buffer is simply not reused.
+  }
+}
+
+[[nodiscard]]
+auto _get_time_ns(const ProfilerState& state) noexcept -> std::int64_t
+{
+  const auto elapsed = std::chrono::steady_clock::now() - state.epoch;
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count();
+}
+
+[[nodiscard]]
+auto _get_thread_zone_state(ProfilerState& state) -> ThreadZoneState&
+{
+  thread_local ThreadZoneState thread_state {};
+
+  if (!thread_state.buffer) {
+    const std::scoped_lock lock {state.mutex};
+
+    // Buffers of threads that have exited are reused, so that the number of buffers
+    // is bounded by the number of threads that are alive at the same time.
+    if (!state.free_buffers.empty()) {
+      thread_state.buffer = std::move(state.free_buffers.back());
+      state.free_buffers.pop_back();
+    }
+    else {
+      auto buffer = std::make_shared<ThreadEventBuffer>();
+      buffer->thread_index = static_cast<std::uint32_t>(state.buffers.size());
+      state.buffers.push_back(buffer);
+
+      thread_state.buffer = std::move(buffer);
+    }
+  }
+
+  return thread_state;
+}
+
+[[nodiscard]]
+constexpr auto _to_ms(const std::int64_t ns) noexcept -> float
+{
+  return static_cast<float>(static_cast<double>(ns) / 1'000'000.0);
+}
+
+/**
+ * Reads the events written to a buffer since the previous read.
+ *
+ * \details
+ * The owning thread might overwrite slots while they are being read, so the
+ * write count is checked again afterwards, and any events read from slots that
+ * may have been overwritten in the meantime are discarded.
+ */
+void _drain_events(ThreadEventBuffer& buffer, std::vector<ProfileZoneEvent>& events)
+{
+  const auto end_index = buffer.write_count.load(std::memory_order_acquire);
+  const auto begin_index =
+      std::max(buffer.read_count, end_index - std::min(end_index, kEventCapacity));
+
+  const auto first_event = events.size();
+
+  for (auto index = begin_index; index < end_index; ++index) {
+    const auto& slot = buffer.slots[index % kEventCapacity];
+    events.push_back(ProfileZoneEvent {
+      .name = slot.name.load(std::memory_order_relaxed),
+      .thread_index = buffer.thread_index,
+      .depth = slot.depth.load(std::memory_order_relaxed),
+      .start_ns = slot.start_ns.load(std::memory_order_relaxed),
+      .duration_ns = slot.duration_ns.load(std::memory_order_relaxed),
+    });
+  }
+
+  std::atomic_thread_fence(std::memory_order_acquire);
+
+  // The slot of the event with index N is reused by the event with index N + capacity,
+  // which might be in the process of being written.
+  const auto latest_index = buffer.write_count.load(std::memory_order_relaxed);
+  const auto first_valid_index =
+      latest_index + 1 > kEventCapacity ? latest_index + 1 - kEventCapacity : 0;
+
+  if (begin_index < first_valid_index) {
+    const auto invalid_count = std::min(first_valid_index, end_index) - begin_index;
+    events.erase(events.begin() + static_cast<std::ptrdiff_t>(first_event),
+                 events.begin() + static_cast<std::ptrdiff_t>(first_event + invalid_count));
+  }
+
+  buffer.read_count = end_index;
+}
+
+void _accumulate_events(ProfilerState& state,
+                        const std::vector<ProfileZoneEvent>& events,
+                        const std::size_t frame_slot)
+{
+  for (const auto& event : events) {
+    auto zone_iter = state.zone_times_ms.find(event.name);
+    if (zone_iter == state.zone_times_ms.end()) {
+      zone_iter = state.zone_times_ms
+                      .emplace(event.name, std::vector<float>(kProfilerFrameCapacity, 0.0f))
+                      .first;
+    }
+
+    zone_iter->second[frame_slot] += _to_ms(event.duration_ns);
+  }
+}
+
+void _capture_events(ProfilerState& state, const std::vector<ProfileZoneEvent>& events)
+{
+  const auto remaining_capacity = kProfilerCaptureCapacity - state.captured_events.size();
+  const auto count = std::min(events.size(), remaining_capacity);
+
+  state.captured_events.insert(state.captured_events.end(),
+                               events.begin(),
+                               events.begin() + static_cast<std::ptrdiff_t>(count));
+}
+
+[[nodiscard]]
+auto _unroll_history(const std::vector<float>& ring,
+                     const std::uint64_t frame_count) -> std::vector<float>
+{
+  const auto stored_count = std::min(frame_count, std::uint64_t {kProfilerFrameCapacity});
+  const auto first_frame = frame_count - stored_count;
+
+  std::vector<float> values {};
+  values.reserve(stored_count);
+
+  for (auto frame = first_frame; frame < frame_count; ++frame) {
+    values.push_back(ring[frame % kProfilerFrameCapacity]);
+  }
+
+  return values;
+}
+
+}  // namespace
+
+ProfileZone::ProfileZone(const char* name) noexcept
+{
+  begin_profile_zone(name);
+}
+
+ProfileZone::~ProfileZone() noexcept
+{
+  end_profile_zone();
+}
+
+void set_profiler_enabled(const bool enabled) noexcept
+{
+  _get_profiler_state().enabled.store(enabled);
+}
+
+auto is_profiler_enabled() noexcept -> bool
+{
+  return _get_profiler_state().enabled.load();
+}
+
+void begin_profile_zone(const char* name) noexcept
+{
+  try {
+    auto& state = _get_profiler_state();
+    auto& thread_state = _get_thread_zone_state(state);
+
+    const auto is_recorded = state.enabled.load(std::memory_order_relaxed);
+    thread_state.zone_stack.push_back(ActiveZone {
+      .name = name ? name : "?",
+      .start_ns = is_recorded ? _get_time_ns(state) : 0,
+      .is_recorded = is_recorded,
+    });
+  }
+  catch (const std::exception&) {
+    // Zones are silently dropped if we run out of memory.
+  }
+}
+
+void end_profile_zone() noexcept
+{
+  auto& state = _get_profiler_state();
+
+  ThreadZoneState* thread_state {};
+  try {
+    thread_state = &_get_thread_zone_state(state);
+  }
+  catch (const std::exception&) {
+    return;
+  }
+
+  auto& zone_stack = thread_state->zone_stack;
+  if (zone_stack.empty()) {
+    return;
+  }
+
+  const auto zone = zone_stack.back();
+  zone_stack.pop_back();
+
+  if (!zone.is_recorded) {
+    return;
+  }
+
+  const auto end_ns = _get_time_ns(state);
+  auto& buffer = *thread_state->buffer;
+
+  const auto index = buffer.write_count.load(std::memory_order_relaxed);
+  auto& slot = buffer.slots[index % kEventCapacity];
+
+  // Ensures that readers that observe any of the slot writes also observe the previous
+  // write count, so that they can detect that the slot is being overwritten.
+  std::atomic_thread_fence(std::memory_order_release);
+
+  slot.name.store(zone.name, std::memory_order_relaxed);
+  slot.depth.store(static_cast<std::uint32_t>(zone_stack.size()), std::memory_order_relaxed);
+  slot.start_ns.store(zone.start_ns, std::memory_order_relaxed);
+  slot.duration_ns.store(end_ns - zone.start_ns, std::memory_order_relaxed);
+
+  buffer.write_count.store(index + 1, std::memory_order_release);
+}
+
+void mark_profiler_frame()
+{
+  auto& state = _get_profiler_state();
+  const auto now_ns = _get_time_ns(state);
+
+  const std::scoped_lock lock {state.mutex};
+
+  if (state.frame_times_ms.empty()) {
+    state.frame_times_ms.resize(kProfilerFrameCapacity, 0.0f);
+  }
+
+  const auto frame_slot = static_cast<std::size_t>(state.frame_count % kProfilerFrameCapacity);
+
+  for (auto& [zone_name, zone_times] : state.zone_times_ms) {
+    zone_times[frame_slot] = 0.0f;
+  }
+
+  state.frame_events.clear();
+  for (const auto& buffer : state.buffers) {
+    _drain_events(*buffer, state.frame_events);
+  }
+
+  _accumulate_events(state, state.frame_events, frame_slot);
+
+  if (state.is_capturing) {
+    _capture_events(state, state.frame_events);
+  }
+
+  state.frame_times_ms[frame_slot] =
+      state.frame_count > 0 ? _to_ms(now_ns - state.last_frame_ns) : 0.0f;
+
+  state.last_frame_ns = now_ns;
+  ++state.frame_count;
+}
+
+auto get_profiler_frame_stats() -> ProfilerFrameStats
+{
+  auto& state = _get_profiler_state();
+  const std::scoped_lock lock {state.mutex};
+
+  ProfilerFrameStats stats {};
+  if (state.frame_count == 0) {
+    return stats;
+  }
+
+  stats.frame_times_ms = _unroll_history(state.frame_times_ms, state.frame_count);
+  stats.zones.reserve(state.zone_times_ms.size());
+
+  for (const auto& [zone_name, zone_times] : state.zone_times_ms) {
+    auto& zone_stats = stats.zones.emplace_back();
+    zone_stats.name = zone_name;
+    zone_stats.frame_times_ms = _unroll_history(zone_times, state.frame_count);
+    zone_stats.average_ms = 0.0f;
+    zone_stats.max_ms = 0.0f;
+
+    for (const auto frame_time : zone_stats.frame_times_ms) {
+      zone_stats.average_ms += frame_time;
+      zone_stats.max_ms = std::max(zone_stats.max_ms, frame_time);
+    }
+
+    zone_stats.average_ms /= static_cast<float>(zone_stats.frame_times_ms.size());
+  }
+
+  return stats;
+}
+
+void reset_profiler()
+{
+  auto& state = _get_profiler_state();
+  const std::scoped_lock lock {state.mutex};
+
+  for (const auto& buffer : state.buffers) {
+    buffer->read_count = buffer->write_count.load(std::memory_order_acquire);
+  }
+
+  state.last_frame_ns = 0;
+  state.frame_count = 0;
+  state.frame_times_ms.clear();
+  state.zone_times_ms.clear();
+  state.captured_events.clear();
+  state.is_capturing = false;
+}
+
+void start_profiler_capture()
+{
+  auto& state = _get_profiler_state();
+  const std::scoped_lock lock {state.mutex};
+
+  state.captured_events.clear();
+  state.is_capturing = true;
+}
+
+auto stop_profiler_capture() -> std::vector<ProfileZoneEvent>
+{
+  auto& state = _get_profiler_state();
+  const std::scoped_lock lock {state.mutex};
+
+  state.is_capturing = false;
+  return std::exchange(state.captured_events, std::vector<ProfileZoneEvent> {});
+}
+
+auto is_profiler_capturing() -> bool
+{
+  auto& state = _get_profiler_state();
+  const std::scoped_lock lock {state.mutex};
+
+  return state.is_capturing;
+}
+
+}  // namespace tactile::core
@@ -2,15 +2,21 @@
 
 #include "tactile/core/document/document_manager.hpp"
 
-#include <utility>  // move
+#include <chrono>    // milliseconds
+#include <optional>  // optional
+#include <utility>   // move
 
 #include "tactile/base/container/lookup.hpp"
 #include "tactile/base/document/document.hpp"
+#include "tactile/core/cmd/undo_payload_store.hpp"
 #include "tactile/core/document/document_info.hpp"
 #include "tactile/core/document/map_document.hpp"
 #include "tactile/core/entity/registry.hpp"
+#include "tactile/core/io/texture_cache.hpp"
 #include "tactile/core/log/logger.hpp"
 #include "tactile/core/map/map.hpp"
+#include "tactile/core/tile/animation.hpp"
+#include "tactile/core/tile/animation_types.hpp"
 
 namespace tactile::core {
 
@@ -22,6 +28,9 @@ auto DocumentManager::create_and_open_map(const MapSpec& spec)
     return std::unexpected {document.error()};
   }
 
+  _configure_undo_payload_store(document->get_undo_payload_store());
+  _configure_animation_clock(*document);
+
   const auto document_uuid = document->get_uuid();
 
   auto [iter, did_insert] =
@@ -35,21 +44,26 @@ auto DocumentManager::create_and_open_map(const MapSpec& spec)
   }
 
   mOpenDocuments.push_back(document_uuid);
-  mHistories.try_emplace(document_uuid, mCommandCapacity);
+  mHistories.try_emplace(document_uuid, mCommandCapacity, mCommandMemoryBudget);
 
-  mActiveDocument = document_uuid;
+  _set_active_document(document_uuid);
 
   return document_uuid;
 }
 
-auto DocumentManager::create_and_open_map(IRenderer& renderer, const ir::Map& ir_map)
+auto DocumentManager::create_and_open_map(TextureCache& texture_cache,
+                                          const ir::Map& ir_map)
     -> std::expected<UUID, ErrorCode>
 {
-  auto document = MapDocument::make(renderer, ir_map);
+  // Maps are shown immediately, using placeholders until tileset textures are loaded.
+  auto document = MapDocument::make(texture_cache, ir_map, TextureLoadMode::kDeferred);
   if (!document.has_value()) {
     return std::unexpected {document.error()};
   }
 
+  _configure_undo_payload_store(document->get_undo_payload_store());
+  _configure_animation_clock(*document);
+
   const auto document_uuid = document->get_uuid();
 
   auto [iter, did_insert] =
@@ -63,9 +77,9 @@ auto DocumentManager::create_and_open_map(IRenderer& renderer, const ir::Map& ir
   }
 
   mOpenDocuments.push_back(document_uuid);
-  mHistories.try_emplace(document_uuid, mCommandCapacity);
+  mHistories.try_emplace(document_uuid, mCommandCapacity, mCommandMemoryBudget);
 
-  mActiveDocument = document_uuid;
+  _set_active_document(document_uuid);
 
   return document_uuid;
 }
@@ -118,6 +132,61 @@ auto DocumentManager::command_capacity() const -> std::size_t
   return mCommandCapacity;
 }
 
+void DocumentManager::set_command_memory_budget(const std::size_t memory_budget)
+{
+  TACTILE_LOG_DEBUG("Setting command memory budget to {} bytes", memory_budget);
+  mCommandMemoryBudget = memory_budget;
+
+  for (auto& [document_uuid, command_stack] : mHistories) {
+    command_stack.set_memory_budget(mCommandMemoryBudget);
+  }
+}
+
+auto DocumentManager::command_memory_budget() const -> std::size_t
+{
+  return mCommandMemoryBudget;
+}
+
+void DocumentManager::set_undo_compression_format(const ICompressionFormat* format)
+{
+  mUndoCompressionFormat = format;
+
+  for (auto& [document_uuid, document] : mDocuments) {
+    if (auto* map_document = dynamic_cast<MapDocument*>(document.get())) {
+      _configure_undo_payload_store(map_document->get_undo_payload_store());
+    }
+  }
+}
+
+void DocumentManager::set_undo_spill_threshold(const std::size_t byte_count)
+{
+  TACTILE_LOG_DEBUG("Setting undo spill threshold to {} bytes", byte_count);
+  mUndoSpillThreshold = byte_count;
+
+  for (auto& [document_uuid, document] : mDocuments) {
+    if (auto* map_document = dynamic_cast<MapDocument*>(document.get())) {
+      _configure_undo_payload_store(map_document->get_undo_payload_store());
+    }
+  }
+}
+
+void DocumentManager::set_tile_animation_sync(const bool enabled)
+{
+  TACTILE_LOG_DEBUG("{} tile animation sync", enabled ? "Enabling" : "Disabling");
+  mTileAnimationSync = enabled;
+
+  for (auto& [document_uuid, document] : mDocuments) {
+    if (auto* map_document = dynamic_cast<MapDocument*>(document.get())) {
+      _configure_animation_clock(*map_document);
+    }
+  }
+}
+
+auto DocumentManager::tile_animation_sync() const -> bool
+{
+  return mTileAnimationSync;
+}
+
 auto DocumentManager::get_history(const UUID& uuid) -> CommandStack&
 {
   return lookup_in(mHistories, uuid);
@@ -140,4 +209,50 @@ auto DocumentManager::is_map_active() const -> bool
   return false;
 }
 
+void DocumentManager::_configure_undo_payload_store(UndoPayloadStore& store) const
+{
+  store.set_compression_format(mUndoCompressionFormat);
+  store.set_spill_threshold(mUndoSpillThreshold);
+}
+
+void DocumentManager::_configure_animation_clock(MapDocument& document) const
+{
+  auto& registry = document.get_registry();
+
+  if (!mTileAnimationSync) {
+    disable_animation_clock(registry);
+    return;
+  }
+
+  enable_animation_clock(registry);
+
+  // Clocks of inactive maps are stopped, since their animations aren't visible.
+  pause_animation_clock(registry, document.get_uuid() != mActiveDocument);
+}
+
+void DocumentManager::_set_active_document(const UUID& document_uuid)
+{
+  std::optional<std::chrono::milliseconds> clock_time {};
+
+  if (!mActiveDocument.is_null()) {
+    auto& registry = get_document(mActiveDocument).get_registry();
+    if (const auto* clock = registry.find<CAnimationClock>()) {
+      pause_animation_clock(registry, true);
+      clock_time = clock->time;
+    }
+  }
+
+  mActiveDocument = document_uuid;
+
+  auto& registry = get_document(mActiveDocument).get_registry();
+  if (registry.has<CAnimationClock>()) {
+    // The new map continues from the time of the previous map.
+    if (clock_time.has_value()) {
+      set_animation_clock_time(registry, *clock_time);
+    }
+
+    pause_animation_clock(registry, false);
+  }
+}
+
 }  // namespace tactile::core
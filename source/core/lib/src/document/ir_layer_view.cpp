@@ -0,0 +1,197 @@
+// Copyright (C) 2024 Albin Johansson (GNU General Public License v3.0)
+
+#include "tactile/core/document/ir_layer_view.hpp"
+
+#include "tactile/base/document/document_visitor.hpp"
+#include "tactile/base/io/tile_io.hpp"
+#include "tactile/core/debug/validation.hpp"
+#include "tactile/core/document/ir_object_view.hpp"
+
+namespace tactile::core {
+
+IrLayerView::IrLayerView(const ir::Map* map,
+                         const ir::Layer* layer,
+                         const ILayerView* parent_layer,
+                         const std::size_t global_index)
+  : mMap {require_not_null(map, "null map")},
+    mLayer {require_not_null(layer, "null layer")},
+    mParentLayer {parent_layer},
+    mGlobalIndex {global_index},
+    mMeta {&mLayer->meta}
+{}
+
+auto IrLayerView::accept(IDocumentVisitor& visitor) const -> std::expected<void, ErrorCode>
+{
+  if (const auto layer_result = visitor.visit(*this); !layer_result.has_value()) {
+    return std::unexpected {layer_result.error()};
+  }
+
+  auto sublayer_index = mGlobalIndex + 1;
+  for (const auto& sublayer : mLayer->layers) {
+    const IrLayerView sublayer_view {mMap, &sublayer, this, sublayer_index};
+    if (const auto sublayer_result = sublayer_view.accept(visitor);
+        !sublayer_result.has_value()) {
+      return std::unexpected {sublayer_result.error()};
+    }
+
+    sublayer_index += count_ir_layers(sublayer);
+  }
+
+  for (const auto& object : mLayer->objects) {
+    const IrObjectView object_view {&object, this};
+    if (const auto object_result = object_view.accept(visitor); !object_result.has_value()) {
+      return std::unexpected {object_result.error()};
+    }
+  }
+
+  return {};
+}
+
+void IrLayerView::write_tile_bytes(ByteStream& byte_stream) const
+{
+  if (mLayer->type == LayerType::kTileLayer) {
+    byte_stream = to_byte_stream(mLayer->tiles);
+  }
+}
+
+auto IrLayerView::get_parent_layer() const -> const ILayerView*
+{
+  return mParentLayer;
+}
+
+auto IrLayerView::get_id() const -> LayerID
+{
+  return mLayer->id;
+}
+
+auto IrLayerView::get_type() const -> LayerType
+{
+  return mLayer->type;
+}
+
+auto IrLayerView::get_opacity() const -> float
+{
+  return mLayer->opacity;
+}
+
+auto IrLayerView::is_visible() const -> bool
+{
+  return mLayer->visible;
+}
+
+auto IrLayerView::get_global_index() const -> std::size_t
+{
+  return mGlobalIndex;
+}
+
+auto IrLayerView::layer_count() const -> std::size_t
+{
+  return mLayer->layers.size();
+}
+
+auto IrLayerView::object_count() const -> std::size_t
+{
+  return mLayer->objects.size();
+}
+
+auto IrLayerView::get_tile(const Index2D& index) const -> std::optional<TileID>
+{
+  if (mLayer->type != LayerType::kTileLayer || !mLayer->extent.contains(index)) {
+    return std::nullopt;
+  }
+
+  return mLayer->tiles[index.y][index.x];
+}
+
+auto IrLayerView::get_tile_position_in_tileset(const TileID tile_id) const
+    -> std::optional<Index2D>
+{
+  const auto* tileset_ref = _find_tileset(tile_id);
+  if (!tileset_ref) {
+    return std::nullopt;
+  }
+
+  const auto tile_index = tile_id - tileset_ref->first_tile_id;
+  const auto column_count = tileset_ref->tileset.column_count;
+
+  return Index2D::from_1d(static_cast<Index2D::value_type>(tile_index),
+                          static_cast<Index2D::value_type>(column_count));
+}
+
+auto IrLayerView::is_tile_animated(const Index2D& position) const -> bool
+{
+  const auto tile_id = get_tile(position).value();
+  if (tile_id == kEmptyTile) {
+    return false;
+  }
+
+  const auto* tileset_ref = _find_tileset(tile_id);
+  if (!tileset_ref) {
+    return false;
+  }
+
+  const auto tile_index = tile_id - tileset_ref->first_tile_id;
+  for (const auto& tile : tileset_ref->tileset.tiles) {
+    if (tile.index == tile_index) {
+      return !tile.animation.empty();
+    }
+  }
+
+  return false;
+}
+
+auto IrLayerView::get_tile_encoding() const -> TileEncoding
+{
+  return mMap->tile_format.encoding;
+}
+
+auto IrLayerView::get_tile_compression() const -> std::optional<CompressionFormatId>
+{
+  return mMap->tile_format.compression;
+}
+
+auto IrLayerView::get_compression_level() const -> std::optional<int>
+{
+  return mMap->tile_format.compression_level;
+}
+
+auto IrLayerView::get_extent() const -> std::optional<Extent2D>
+{
+  if (mLayer->type != LayerType::kTileLayer) {
+    return std::nullopt;
+  }
+
+  return mLayer->extent;
+}
+
+auto IrLayerView::get_meta() const -> const IMetaView&
+{
+  return mMeta;
+}
+
+auto IrLayerView::_find_tileset(const TileID tile_id) const -> const ir::TilesetRef*
+{
+  for (const auto& tileset_ref : mMap->tilesets) {
+    const auto first_tile_id = tileset_ref.first_tile_id;
+    const auto tile_count = tileset_ref.tileset.tile_count;
+
+    if (tile_id >= first_tile_id && tile_id - first_tile_id < tile_count) {
+      return &tileset_ref;
+    }
+  }
+
+  return nullptr;
+}
+
+auto count_ir_layers(const ir::Layer& layer) -> std::size_t
+{
+  std::size_t count = 1;
+
+  for (const auto& sublayer : layer.layers) {
+    count += count_ir_layers(sublayer);
+  }
+
+  return count;
+}
+
+}  // namespace tactile::core
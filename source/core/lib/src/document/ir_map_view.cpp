@@ -0,0 +1,113 @@
+// Copyright (C) 2024 Albin Johansson (GNU General Public License v3.0)
+
+#include "tactile/core/document/ir_map_view.hpp"
+
+#include "tactile/base/document/document_visitor.hpp"
+#include "tactile/core/debug/validation.hpp"
+#include "tactile/core/document/ir_layer_view.hpp"
+#include "tactile/core/document/ir_tileset_view.hpp"
+
+namespace tactile::core {
+
+IrMapView::IrMapView(const ir::Map* map, const std::filesystem::path* path)
+  : mMap {require_not_null(map, "null map")},
+    mPath {path},
+    mMeta {&mMap->meta}
+{}
+
+auto IrMapView::accept(IDocumentVisitor& visitor) const -> std::expected<void, ErrorCode>
+{
+  if (const auto map_result = visitor.visit(*this); !map_result.has_value()) {
+    return std::unexpected {map_result.error()};
+  }
+
+  for (const auto& tileset_ref : mMap->tilesets) {
+    const IrTilesetView tileset_view {&tileset_ref};
+    if (const auto tileset_result = tileset_view.accept(visitor);
+        !tileset_result.has_value()) {
+      return std::unexpected {tileset_result.error()};
+    }
+  }
+
+  std::size_t layer_index = 0;
+  for (const auto& layer : mMap->layers) {
+    const IrLayerView layer_view {mMap, &layer, nullptr, layer_index};
+    if (const auto layer_result = layer_view.accept(visitor); !layer_result.has_value()) {
+      return std::unexpected {layer_result.error()};
+    }
+
+    layer_index += count_ir_layers(layer);
+  }
+
+  // TODO iterate component definitions
+
+  return {};
+}
+
+auto IrMapView::get_path() const -> const std::filesystem::path*
+{
+  return mPath;
+}
+
+auto IrMapView::get_tile_size() const -> Int2
+{
+  return mMap->tile_size;
+}
+
+auto IrMapView::get_extent() const -> Extent2D
+{
+  return mMap->extent;
+}
+
+auto IrMapView::get_next_layer_id() const -> LayerID
+{
+  return mMap->next_layer_id;
+}
+
+auto IrMapView::get_next_object_id() const -> ObjectID
+{
+  return mMap->next_object_id;
+}
+
+auto IrMapView::get_tile_encoding() const -> TileEncoding
+{
+  return mMap->tile_format.encoding;
+}
+
+auto IrMapView::get_tile_compression() const -> std::optional<CompressionFormatId>
+{
+  return mMap->tile_format.compression;
+}
+
+auto IrMapView::get_compression_level() const -> std::optional<int>
+{
+  return mMap->tile_format.compression_level;
+}
+
+auto IrMapView::layer_count() const -> std::size_t
+{
+  std::size_t count = 0;
+
+  for (const auto& layer : mMap->layers) {
+    count += count_ir_layers(layer);
+  }
+
+  return count;
+}
+
+auto IrMapView::tileset_count() const -> std::size_t
+{
+  return mMap->tilesets.size();
+}
+
+auto IrMapView::component_count() const -> std::size_t
+{
+  return mMap->components.size();
+}
+
+auto IrMapView::get_meta() const -> const IMetaView&
+{
+  return mMeta;
+}
+
+}  // namespace tactile::core
@@ -0,0 +1,35 @@
+// Copyright (C) 2024 Albin Johansson (GNU General Public License v3.0)
+
+#include "tactile/core/document/ir_meta_view.hpp"
+
+#include "tactile/core/debug/exception.hpp"
+#include "tactile/core/debug/validation.hpp"
+
+namespace tactile::core {
+
+IrMetaView::IrMetaView(const ir::Metadata* meta)
+  : mMeta {require_not_null(meta, "null metadata")}
+{}
+
+auto IrMetaView::get_name() const -> std::string_view
+{
+  return mMeta->name;
+}
+
+auto IrMetaView::get_property(const std::size_t index) const
+    -> std::pair<const std::string&, const Attribute&>
+{
+  if (index >= mMeta->properties.size()) {
+    throw Exception {"bad property index"};
+  }
+
+  const auto& property = mMeta->properties[index];
+  return {property.name, property.value};
+}
+
+auto IrMetaView::property_count() const -> std::size_t
+{
+  return mMeta->properties.size();
+}
+
+}  // namespace tactile::core
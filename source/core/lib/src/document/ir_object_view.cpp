@@ -0,0 +1,74 @@
+// Copyright (C) 2024 Albin Johansson (GNU General Public License v3.0)
+
+#include "tactile/core/document/ir_object_view.hpp"
+
+#include "tactile/base/document/document_visitor.hpp"
+#include "tactile/core/debug/validation.hpp"
+
+namespace tactile::core {
+
+IrObjectView::IrObjectView(const ir::Object* object, const ILayerView* parent_layer)
+  : mObject {require_not_null(object, "null object")},
+    mParentLayer {require_not_null(parent_layer, "null layer view")},
+    mParentTile {nullptr},
+    mMeta {&mObject->meta}
+{}
+
+IrObjectView::IrObjectView(const ir::Object* object, const ITileView* parent_tile)
+  : mObject {require_not_null(object, "null object")},
+    mParentLayer {nullptr},
+    mParentTile {require_not_null(parent_tile, "null tile view")},
+    mMeta {&mObject->meta}
+{}
+
+auto IrObjectView::accept(IDocumentVisitor& visitor) const -> std::expected<void, ErrorCode>
+{
+  return visitor.visit(*this);
+}
+
+auto IrObjectView::get_parent_layer() const -> const ILayerView*
+{
+  return mParentLayer;
+}
+
+auto IrObjectView::get_parent_tile() const -> const ITileView*
+{
+  return mParentTile;
+}
+
+auto IrObjectView::get_type() const -> ObjectType
+{
+  return mObject->type;
+}
+
+auto IrObjectView::get_id() const -> ObjectID
+{
+  return mObject->id;
+}
+
+auto IrObjectView::get_position() const -> Float2
+{
+  return mObject->position;
+}
+
+auto IrObjectView::get_size() const -> Float2
+{
+  return mObject->size;
+}
+
+auto IrObjectView::get_tag() const -> std::string_view
+{
+  return mObject->tag;
+}
+
+auto IrObjectView::is_visible() const -> bool
+{
+  return mObject->visible;
+}
+
+auto IrObjectView::get_meta() const -> const IMetaView&
+{
+  return mMeta;
+}
+
+}  // namespace tactile::core
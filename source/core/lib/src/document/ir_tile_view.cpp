@@ -0,0 +1,65 @@
+// Copyright (C) 2024 Albin Johansson (GNU General Public License v3.0)
+
+#include "tactile/core/document/ir_tile_view.hpp"
+
+#include "tactile/base/document/document_visitor.hpp"
+#include "tactile/core/debug/validation.hpp"
+#include "tactile/core/document/ir_object_view.hpp"
+
+namespace tactile::core {
+
+IrTileView::IrTileView(const ir::Tile* tile, const ITilesetView* tileset_view)
+  : mTile {require_not_null(tile, "null tile")},
+    mTilesetView {require_not_null(tileset_view, "null tileset view")},
+    mMeta {&mTile->meta}
+{}
+
+auto IrTileView::accept(IDocumentVisitor& visitor) const -> std::expected<void, ErrorCode>
+{
+  if (const auto tile_result = visitor.visit(*this); !tile_result.has_value()) {
+    return std::unexpected {tile_result.error()};
+  }
+
+  for (const auto& object : mTile->objects) {
+    const IrObjectView object_view {&object, this};
+    if (const auto object_result = object_view.accept(visitor); !object_result.has_value()) {
+      return std::unexpected {object_result.error()};
+    }
+  }
+
+  return {};
+}
+
+auto IrTileView::get_parent_tileset() const -> const ITilesetView&
+{
+  return *mTilesetView;
+}
+
+auto IrTileView::get_index() const -> TileIndex
+{
+  return mTile->index;
+}
+
+auto IrTileView::object_count() const -> std::size_t
+{
+  return mTile->objects.size();
+}
+
+auto IrTileView::animation_frame_count() const -> std::size_t
+{
+  return mTile->animation.size();
+}
+
+auto IrTileView::get_animation_frame(const std::size_t index) const
+    -> std::pair<TileIndex, std::chrono::milliseconds>
+{
+  const auto& frame = mTile->animation.at(index);
+  return {frame.tile_index, frame.duration};
+}
+
+auto IrTileView::get_meta() const -> const IMetaView&
+{
+  return mMeta;
+}
+
+}  // namespace tactile::core
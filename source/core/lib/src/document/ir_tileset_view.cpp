@@ -0,0 +1,78 @@
+// Copyright (C) 2024 Albin Johansson (GNU General Public License v3.0)
+
+#include "tactile/core/document/ir_tileset_view.hpp"
+
+#include "tactile/base/document/document_visitor.hpp"
+#include "tactile/base/numeric/saturate_cast.hpp"
+#include "tactile/core/debug/validation.hpp"
+#include "tactile/core/document/ir_tile_view.hpp"
+
+namespace tactile::core {
+
+IrTilesetView::IrTilesetView(const ir::TilesetRef* tileset_ref)
+  : mTilesetRef {require_not_null(tileset_ref, "null tileset")},
+    mMeta {&mTilesetRef->tileset.meta}
+{}
+
+auto IrTilesetView::accept(IDocumentVisitor& visitor) const -> std::expected<void, ErrorCode>
+{
+  if (const auto tileset_result = visitor.visit(*this); !tileset_result.has_value()) {
+    return std::unexpected {tileset_result.error()};
+  }
+
+  for (const auto& tile : mTilesetRef->tileset.tiles) {
+    const IrTileView tile_view {&tile, this};
+    if (const auto tile_result = tile_view.accept(visitor); !tile_result.has_value()) {
+      return std::unexpected {tile_result.error()};
+    }
+  }
+
+  return {};
+}
+
+auto IrTilesetView::get_first_tile_id() const -> TileID
+{
+  return mTilesetRef->first_tile_id;
+}
+
+auto IrTilesetView::tile_count() const -> std::size_t
+{
+  return saturate_cast<std::size_t>(mTilesetRef->tileset.tile_count);
+}
+
+auto IrTilesetView::tile_definition_count() const -> std::size_t
+{
+  return mTilesetRef->tileset.tiles.size();
+}
+
+auto IrTilesetView::column_count() const -> std::size_t
+{
+  return saturate_cast<std::size_t>(mTilesetRef->tileset.column_count);
+}
+
+auto IrTilesetView::get_tile_size() const -> Int2
+{
+  return mTilesetRef->tileset.tile_size;
+}
+
+auto IrTilesetView::get_image_size() const -> Int2
+{
+  return mTilesetRef->tileset.image_size;
+}
+
+auto IrTilesetView::get_image_path() const -> const std::filesystem::path&
+{
+  return mTilesetRef->tileset.image_path;
+}
+
+auto IrTilesetView::get_meta() const -> const IMetaView&
+{
+  return mMeta;
+}
+
+auto IrTilesetView::get_filename() const -> std::string
+{
+  return get_image_path().stem().string();
+}
+
+}  // namespace tactile::core
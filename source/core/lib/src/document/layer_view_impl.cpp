@@ -196,13 +196,12 @@ auto LayerViewImpl::is_tile_animated(const Index2D& position) const -> bool
     return false;
   }
 
-  const auto& tileset = registry.get<CTileset>(tileset_id);
   const auto& tileset_instance = registry.get<CTilesetInstance>(tileset_id);
 
   const auto tile_index = tile_id - tileset_instance.tile_range.first_id;
-  const auto tile_entity = tileset.tiles.at(static_cast<std::size_t>(tile_index));
+  const auto tile_entity = find_tile(registry, tileset_id, tile_index);
 
-  return registry.has<CAnimation>(tile_entity);
+  return tile_entity != kInvalidEntity && registry.has<CAnimation>(tile_entity);
 }
 
 auto LayerViewImpl::get_tile_encoding() const -> TileEncoding
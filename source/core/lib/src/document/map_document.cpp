@@ -2,16 +2,23 @@
 
 #include "tactile/core/document/map_document.hpp"
 
+#include <memory>    // unique_ptr, make_unique
 #include <optional>  // optional
 #include <utility>   // move
 
 #include "tactile/base/io/save/ir.hpp"
+#include "tactile/core/cmd/undo_payload_store.hpp"
 #include "tactile/core/document/document_info.hpp"
 #include "tactile/core/document/map_view_impl.hpp"
 #include "tactile/core/entity/registry.hpp"
+#include "tactile/core/io/texture.hpp"
+#include "tactile/core/io/texture_cache.hpp"
 #include "tactile/core/log/logger.hpp"
 #include "tactile/core/map/map.hpp"
 #include "tactile/core/map/map_spec.hpp"
+#include "tactile/core/tile/animation.hpp"
+#include "tactile/core/tile/tile_render_cache.hpp"
+#include "tactile/core/tile/tileset.hpp"
 #include "tactile/core/tile/tileset_types.hpp"
 #include "tactile/core/ui/viewport.hpp"
 #include "tactile/core/util/uuid.hpp"
@@ -20,22 +27,40 @@ namespace tactile::core {
 
 struct MapDocument::Data final
 {
+  std::unique_ptr<TextureCache> owned_texture_cache;
   UUID uuid;
   Registry registry;
   EntityID map_entity;
   std::optional<std::filesystem::path> path;
   SaveFormatId format;
+  UndoPayloadStore undo_payload_store;
 
   Data()
-    : uuid {UUID::generate()},
+    : owned_texture_cache {},
+      uuid {UUID::generate()},
       registry {},
       map_entity {kInvalidEntity},
       path {std::nullopt},
-      format {SaveFormatId::kTactileYaml}
+      format {SaveFormatId::kTactileYaml},
+      undo_payload_store {}
   {
     registry.add<CTileCache>();
+    registry.add<CTileRenderCache>();
     registry.add<CDocumentInfo>();
   }
+
+  TACTILE_DELETE_COPY(Data);
+  TACTILE_DELETE_MOVE(Data);
+
+  ~Data() noexcept
+  {
+    // Each texture component holds a reference to a texture in the cache.
+    if (const auto* cache_ref = registry.find<CTextureCacheRef>()) {
+      for (const auto& [entity, texture] : registry.each<CTexture>()) {
+        cache_ref->cache->release(texture.id);
+      }
+    }
+  }
 };
 
 MapDocument::MapDocument()
@@ -63,13 +88,16 @@ auto MapDocument::make(const MapSpec& spec) -> std::expected<MapDocument, ErrorC
   return document;
 }
 
-auto MapDocument::make(IRenderer& renderer, const ir::Map& ir_map)
+auto MapDocument::make(TextureCache& texture_cache,
+                       const ir::Map& ir_map,
+                       const TextureLoadMode load_mode)
     -> std::expected<MapDocument, ErrorCode>
 {
   MapDocument document {};
   auto& registry = document.mData->registry;
+  registry.add<CTextureCacheRef>(&texture_cache);
 
-  const auto map_id = make_map(registry, renderer, ir_map);
+  const auto map_id = make_map(registry, texture_cache, ir_map, load_mode);
   if (!map_id.has_value()) {
     TACTILE_LOG_ERROR("Could not create map document: {}", to_string(map_id.error()));
     return std::unexpected {map_id.error()};
@@ -86,6 +114,19 @@ auto MapDocument::make(IRenderer& renderer, const ir::Map& ir_map)
   return document;
 }
 
+auto MapDocument::make(IRenderer& renderer, const ir::Map& ir_map)
+    -> std::expected<MapDocument, ErrorCode>
+{
+  auto texture_cache = std::make_unique<TextureCache>(&renderer);
+
+  auto document = make(*texture_cache, ir_map, TextureLoadMode::kBlocking);
+  if (document.has_value()) {
+    document->mData->owned_texture_cache = std::move(texture_cache);
+  }
+
+  return document;
+}
+
 TACTILE_DEFINE_MOVE(MapDocument);
 
 MapDocument::~MapDocument() noexcept = default;
@@ -97,7 +138,13 @@ auto MapDocument::accept(IDocumentVisitor& visitor) const -> std::expected<void,
 }
 
 void MapDocument::update()
-{}
+{
+  auto& registry = mData->registry;
+
+  update_tileset_textures(registry);
+  update_animations(registry);
+  update_tile_render_cache(registry);
+}
 
 void MapDocument::set_path(std::filesystem::path path)
 {
@@ -157,4 +204,14 @@ auto MapDocument::get_uuid() const -> const UUID&
   return mData->uuid;
 }
 
+auto MapDocument::get_undo_payload_store() -> UndoPayloadStore&
+{
+  return mData->undo_payload_store;
+}
+
+auto MapDocument::get_undo_payload_store() const -> const UndoPayloadStore&
+{
+  return mData->undo_payload_store;
+}
+
 }  // namespace tactile::core
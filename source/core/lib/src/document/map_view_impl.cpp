@@ -15,8 +15,9 @@
 
 namespace tactile::core {
 
-MapViewImpl::MapViewImpl(const MapDocument* document)
+MapViewImpl::MapViewImpl(const MapDocument* document, const std::filesystem::path* path)
   : mDocument {require_not_null(document, "null document")},
+    mPath {path},
     mMeta {mDocument, mDocument->get_registry().get<CDocumentInfo>().root}
 {}
 
@@ -53,7 +54,7 @@ auto MapViewImpl::accept(IDocumentVisitor& visitor) const -> std::expected<void,
 
 auto MapViewImpl::get_path() const -> const std::filesystem::path*
 {
-  return mDocument->get_path();
+  return mPath ? mPath : mDocument->get_path();
 }
 
 auto MapViewImpl::get_tile_size() const -> Int2
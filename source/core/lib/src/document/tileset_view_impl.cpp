@@ -2,7 +2,10 @@
 
 #include "tactile/core/document/tileset_view_impl.hpp"
 
-#include <algorithm>  // count_if
+#include <algorithm>  // count_if, sort
+#include <ranges>     // values
+#include <utility>    // pair
+#include <vector>     // vector
 
 #include "tactile/base/document/document_visitor.hpp"
 #include "tactile/base/numeric/saturate_cast.hpp"
@@ -31,7 +34,12 @@ auto TilesetViewImpl::accept(IDocumentVisitor& visitor) const -> std::expected<v
   const auto& registry = mDocument->get_registry();
   const auto& tileset = registry.get<CTileset>(mTilesetId);
 
-  for (const auto tile_id : tileset.tiles) {
+  // Tiles are visited in index order, so that saved files are deterministic.
+  std::vector<std::pair<TileIndex, EntityID>> tiles {tileset.tiles.begin(),
+                                                     tileset.tiles.end()};
+  std::ranges::sort(tiles);
+
+  for (const auto& [tile_index, tile_id] : tiles) {
     if (is_tile_plain(registry, tile_id)) {
       continue;
     }
@@ -58,7 +66,7 @@ auto TilesetViewImpl::tile_count() const -> std::size_t
   const auto& registry = mDocument->get_registry();
   const auto& tileset = registry.get<CTileset>(mTilesetId);
 
-  return tileset.tiles.size();
+  return tileset.tile_count;
 }
 
 auto TilesetViewImpl::tile_definition_count() const -> std::size_t
@@ -67,7 +75,7 @@ auto TilesetViewImpl::tile_definition_count() const -> std::size_t
   const auto& tileset = registry.get<CTileset>(mTilesetId);
 
   return saturate_cast<std::size_t>(std::ranges::count_if(
-      tileset.tiles,
+      tileset.tiles | std::views::values,
       [&registry](const EntityID tile_id) { return !is_tile_plain(registry, tile_id); }));
 }
 
@@ -7,6 +7,7 @@
 
 #include "tactile/base/engine/engine_app.hpp"
 #include "tactile/base/render/renderer.hpp"
+#include "tactile/core/debug/profiler.hpp"
 #include "tactile/core/debug/validation.hpp"
 #include "tactile/core/log/logger.hpp"
 
@@ -23,16 +24,22 @@ void Engine::run()
 
   bool running = true;
   while (running) {
-    running = _poll_events();
+    {
+      TACTILE_PROFILE_ZONE("Engine::run");
 
-    _check_framebuffer_scale();
+      running = _poll_events();
 
-    mApp->on_update();
+      _check_framebuffer_scale();
 
-    if (mRenderer->begin_frame()) {
-      mApp->on_render();
-      mRenderer->end_frame();
+      mApp->on_update();
+
+      if (mRenderer->begin_frame()) {
+        mApp->on_render();
+        mRenderer->end_frame();
+      }
     }
+
+    mark_profiler_frame();
   }
 
   mApp->on_shutdown();
@@ -40,6 +47,8 @@ void Engine::run()
 
 auto Engine::_poll_events() -> bool
 {
+  TACTILE_PROFILE_ZONE("Engine::poll_events");
+
   auto keep_running = true;
 
   SDL_Event event {};
@@ -2,11 +2,58 @@
 
 #include "tactile/core/event/event_dispatcher.hpp"
 
+#include <cstddef>  // size_t
+
+#include "tactile/core/debug/profiler.hpp"
+
 namespace tactile::core {
+namespace {
+
+// Jobs are mostly I/O bound, and the texture cache has its own pool for decoding images.
+constexpr std::size_t kJobWorkerCount = 2;
+
+}  // namespace
+
+EventDispatcher::EventDispatcher()
+  : mDispatcher {},
+    mCoalescedQueues {},
+    mJobBindings {},
+    mPendingStats {},
+    mStats {},
+    mJobSystem {kJobWorkerCount}
+{}
+
+EventDispatcher::~EventDispatcher() noexcept = default;
 
 void EventDispatcher::update()
 {
+  TACTILE_PROFILE_ZONE("EventDispatcher::update");
+
+  mJobSystem.update(*this);
+
+  for (const auto& [event_type, queue] : mCoalescedQueues) {
+    queue->flush(mDispatcher);
+  }
+
+  // Events pushed by listeners during the update are included in the next update.
+  auto stats = mPendingStats;
+  stats.dispatched_count = mDispatcher.size();
+  mPendingStats = EventDispatchStats {};
+
   mDispatcher.update();
+
+  stats.pending_job_count = mJobSystem.pending_count();
+  mStats = stats;
+}
+
+void EventDispatcher::wait_for_jobs()
+{
+  mJobSystem.wait();
+}
+
+auto EventDispatcher::get_stats() const -> const EventDispatchStats&
+{
+  return mStats;
 }
 
 }  // namespace tactile::core
@@ -2,20 +2,25 @@
 
 #include "tactile/core/event/file_event_handler.hpp"
 
+#include <algorithm>  // find
+
 #include "tactile/base/io/save/save_format.hpp"
 #include "tactile/base/runtime/runtime.hpp"
+#include "tactile/core/cmd/command_journal.hpp"
+#include "tactile/core/debug/profiler.hpp"
 #include "tactile/core/debug/validation.hpp"
-#include "tactile/core/document/map_view_impl.hpp"
 #include "tactile/core/event/event_dispatcher.hpp"
 #include "tactile/core/event/events.hpp"
+#include "tactile/core/io/map_saver.hpp"
 #include "tactile/core/log/logger.hpp"
 #include "tactile/core/model/model.hpp"
 
 namespace tactile::core {
 
-FileEventHandler::FileEventHandler(Model* model, IRuntime* runtime)
+FileEventHandler::FileEventHandler(Model* model, IRuntime* runtime, MapSaver* map_saver)
   : mModel {require_not_null(model, "null model")},
-    mRuntime {require_not_null(runtime, "null runtime")}
+    mRuntime {require_not_null(runtime, "null runtime")},
+    mMapSaver {require_not_null(map_saver, "null map saver")}
 {}
 
 void FileEventHandler::install(EventDispatcher& dispatcher)
@@ -25,6 +30,7 @@ void FileEventHandler::install(EventDispatcher& dispatcher)
   // clang-format off
   dispatcher.bind<SaveEvent, &Self::on_save>(this);
   dispatcher.bind<SaveAsEvent, &Self::on_save_as>(this);
+  dispatcher.bind<MapSavedEvent, &Self::on_map_saved>(this);
   dispatcher.bind<ReopenLastClosedFileEvent, &Self::on_reopen_last_closed_file>(this);
   dispatcher.bind<ClearFileHistoryEvent, &Self::on_clear_file_history>(this);
   dispatcher.bind<CloseEvent, &Self::on_close>(this);
@@ -48,13 +54,7 @@ void FileEventHandler::on_save(const SaveEvent& event)
     return;
   }
 
-  const auto* save_format = mRuntime->get_save_format(document->get_format());
-  if (!save_format) {
-    TACTILE_LOG_ERROR("Could not find suitable save format");
-    return;
-  }
-
-  const MapViewImpl map_view {document};
+  TACTILE_PROFILE_ZONE("FileEventHandler::save_map");
 
   // TODO
   const SaveFormatWriteOptions options {
@@ -64,10 +64,20 @@ void FileEventHandler::on_save(const SaveEvent& event)
     .fold_tile_layer_data = false,
   };
 
-  const auto save_result = save_format->save_map(map_view, options);
+  auto& history = mModel->get_document_manager().get_history(document->get_uuid());
+  const auto journal_budget = mModel->get_settings().undo_journal_budget;
+
+  const auto save_result = mMapSaver->save(*document,
+                                           options,
+                                           collect_command_journal_records(history),
+                                           journal_budget);
   if (!save_result.has_value()) {
     TACTILE_LOG_ERROR("Could not save map: {}", to_string(save_result.error()));
+    return;
   }
+
+  // The saved state has been captured, so later changes are unsaved changes.
+  history.mark_as_clean();
 }
 
 void FileEventHandler::on_save_as(const SaveAsEvent& event)
@@ -84,6 +94,26 @@ void FileEventHandler::on_save_as(const SaveAsEvent& event)
   on_save(SaveEvent {});
 }
 
+void FileEventHandler::on_map_saved(const MapSavedEvent& event)
+{
+  TACTILE_LOG_TRACE("MapSavedEvent(path: {})", event.path.string());
+
+  if (!event.error.has_value()) {
+    TACTILE_LOG_DEBUG("Saved map to {}", event.path.string());
+    return;
+  }
+
+  TACTILE_LOG_ERROR("Could not save map: {}", to_string(*event.error));
+
+  // The document was marked as clean when the save started, which no longer holds.
+  auto& document_manager = mModel->get_document_manager();
+  const auto& open_documents = document_manager.get_open_documents();
+
+  if (std::ranges::find(open_documents, event.document_uuid) != open_documents.end()) {
+    document_manager.get_history(event.document_uuid).reset_clean_index();
+  }
+}
+
 void FileEventHandler::on_reopen_last_closed_file(const ReopenLastClosedFileEvent& event)
 {
   TACTILE_LOG_TRACE("ReopenLastClosedFileEvent");
@@ -0,0 +1,96 @@
+// Copyright (C) 2024 Albin Johansson (GNU General Public License v3.0)
+
+#include "tactile/core/event/job_system.hpp"
+
+#include <algorithm>  // find_if
+#include <chrono>     // seconds
+#include <exception>  // exception
+#include <future>     // future_status
+#include <iterator>   // make_move_iterator
+#include <utility>    // move
+
+#include "tactile/core/debug/profiler.hpp"
+#include "tactile/core/log/logger.hpp"
+
+namespace tactile::core {
+
+JobSystem::JobSystem(const std::size_t worker_count)
+  : mPendingJobs {},
+    mWorkerPool {worker_count}
+{}
+
+JobSystem::~JobSystem() noexcept = default;
+
+void JobSystem::submit(Job job)
+{
+  if (job) {
+    mPendingJobs.push_back(PendingJob {
+      .result = mWorkerPool.submit(std::move(job)),
+      .deferred = {},
+    });
+  }
+}
+
+void JobSystem::submit(DeferredJob job)
+{
+  if (job.completion) {
+    mPendingJobs.push_back(PendingJob {
+      .result = {},
+      .deferred = std::move(job),
+    });
+  }
+}
+
+void JobSystem::update(EventDispatcher& dispatcher)
+{
+  TACTILE_PROFILE_ZONE("JobSystem::update");
+
+  const auto finished_end = std::ranges::find_if(mPendingJobs, [](const PendingJob& job) {
+    if (job.result.valid()) {
+      return job.result.wait_for(std::chrono::seconds::zero()) != std::future_status::ready;
+    }
+
+    return job.deferred.is_ready && !job.deferred.is_ready();
+  });
+
+  // Completion functions may submit new jobs, so the finished jobs are removed first.
+  std::vector<PendingJob> finished_jobs(
+      std::make_move_iterator(mPendingJobs.begin()),
+      std::make_move_iterator(finished_end));
+  mPendingJobs.erase(mPendingJobs.begin(), finished_end);
+
+  for (auto& finished_job : finished_jobs) {
+    JobCompletion completion {};
+
+    try {
+      completion = finished_job.result.valid() ? finished_job.result.get()
+                                               : std::move(finished_job.deferred.completion);
+    }
+    catch (const std::exception& error) {
+      TACTILE_LOG_ERROR("Unexpected exception in job: {}", error.what());
+    }
+
+    if (completion) {
+      completion(dispatcher);
+    }
+  }
+}
+
+void JobSystem::wait()
+{
+  for (const auto& pending_job : mPendingJobs) {
+    if (pending_job.result.valid()) {
+      pending_job.result.wait();
+    }
+    else if (pending_job.deferred.wait) {
+      pending_job.deferred.wait();
+    }
+  }
+}
+
+auto JobSystem::pending_count() const -> std::size_t
+{
+  return mPendingJobs.size();
+}
+
+}  // namespace tactile::core
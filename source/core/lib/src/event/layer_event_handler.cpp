@@ -6,11 +6,13 @@
 
 #include "tactile/core/cmd/layer/create_layer_command.hpp"
 #include "tactile/core/cmd/layer/duplicate_layer_command.hpp"
+#include "tactile/core/cmd/layer/erase_tiles_command.hpp"
 #include "tactile/core/cmd/layer/move_layer_down_command.hpp"
 #include "tactile/core/cmd/layer/move_layer_up_command.hpp"
 #include "tactile/core/cmd/layer/remove_layer_command.hpp"
 #include "tactile/core/cmd/layer/set_layer_opacity_command.hpp"
 #include "tactile/core/cmd/layer/set_layer_visibility_command.hpp"
+#include "tactile/core/cmd/layer/stamp_tiles_command.hpp"
 #include "tactile/core/debug/validation.hpp"
 #include "tactile/core/event/event_dispatcher.hpp"
 #include "tactile/core/event/events.hpp"
@@ -34,6 +36,8 @@ void LayerEventHandler::install(EventDispatcher& dispatcher)
   dispatcher.bind<RenameLayerEvent, &Self::on_rename_layer>(this);
   dispatcher.bind<SetLayerOpacityEvent, &Self::on_set_layer_opacity>(this);
   dispatcher.bind<SetLayerVisibleEvent, &Self::on_set_layer_visible>(this);
+  dispatcher.bind<StampTilesEvent, &Self::on_stamp_tiles>(this);
+  dispatcher.bind<EraseTilesEvent, &Self::on_erase_tiles>(this);
 }
 
 void LayerEventHandler::on_create_layer(const CreateLayerEvent& event)
@@ -84,4 +88,25 @@ void LayerEventHandler::on_set_layer_visible(const SetLayerVisibleEvent& event)
   mModel->push_map_command<SetLayerVisibilityCommand>(event.layer_entity, event.visible);
 }
 
+void LayerEventHandler::on_stamp_tiles(const StampTilesEvent& event)
+{
+  TACTILE_LOG_TRACE("StampTilesEvent(stroke: {}, position: {})",
+                    event.stroke_id,
+                    event.position);
+  mModel->push_map_command<StampTilesCommand>(event.layer_entity,
+                                              event.stroke_id,
+                                              event.position,
+                                              event.pattern);
+}
+
+void LayerEventHandler::on_erase_tiles(const EraseTilesEvent& event)
+{
+  TACTILE_LOG_TRACE("EraseTilesEvent(stroke: {}, position: {})",
+                    event.stroke_id,
+                    event.position);
+  mModel->push_map_command<EraseTilesCommand>(event.layer_entity,
+                                              event.stroke_id,
+                                              event.position);
+}
+
 }  // namespace tactile::core
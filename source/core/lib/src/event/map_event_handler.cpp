@@ -2,17 +2,26 @@
 
 #include "tactile/core/event/map_event_handler.hpp"
 
-#include <utility>  // move
+#include <filesystem>  // path
+#include <optional>    // optional
+#include <utility>     // move
 
 #include <magic_enum.hpp>
 
 #include "tactile/base/io/save/save_format.hpp"
 #include "tactile/base/numeric/vec_format.hpp"
 #include "tactile/base/runtime/runtime.hpp"
+#include "tactile/core/cmd/command_journal.hpp"
+#include "tactile/core/debug/profiler.hpp"
 #include "tactile/core/debug/validation.hpp"
+#include "tactile/core/document/ir_map_view.hpp"
+#include "tactile/core/document/map_document.hpp"
 #include "tactile/core/document/map_view_impl.hpp"
 #include "tactile/core/event/event_dispatcher.hpp"
 #include "tactile/core/event/events.hpp"
+#include "tactile/core/io/map_converter.hpp"
+#include "tactile/core/io/map_snapshot.hpp"
+#include "tactile/core/io/texture_cache.hpp"
 #include "tactile/core/log/logger.hpp"
 #include "tactile/core/model/model.hpp"
 #include "tactile/core/platform/file_dialog.hpp"
@@ -22,10 +31,12 @@ namespace tactile::core {
 
 MapEventHandler::MapEventHandler(Model* model,
                                  ui::WidgetManager* widget_manager,
-                                 IRuntime* runtime)
+                                 IRuntime* runtime,
+                                 TextureCache* texture_cache)
   : mModel {require_not_null(model, "null model")},
     mWidgetManager {require_not_null(widget_manager, "null widget manager")},
-    mRuntime {require_not_null(runtime, "null runtime")}
+    mRuntime {require_not_null(runtime, "null runtime")},
+    mTextureCache {require_not_null(texture_cache, "null texture cache")}
 {}
 
 void MapEventHandler::install(EventDispatcher& dispatcher)
@@ -37,7 +48,8 @@ void MapEventHandler::install(EventDispatcher& dispatcher)
   dispatcher.bind<ShowOpenMapDialogEvent, &Self::on_show_open_map_dialog>(this);
   dispatcher.bind<ShowGodotExportDialogEvent, &Self::on_show_godot_export_dialog>(this);
   dispatcher.bind<CreateMapEvent, &Self::on_create_map>(this);
-  dispatcher.bind<ExportAsGodotSceneEvent, &Self::on_export_as_godot_scene>(this);
+  dispatcher.bind_job<ExportAsGodotSceneEvent, &Self::on_export_as_godot_scene>(this);
+  dispatcher.bind<GodotSceneExportedEvent, &Self::on_godot_scene_exported>(this);
   // TODO ResizeMapEvent
   // TODO FixTilesInMapEvent
   // TODO InspectMapEvent? (or InspectContextEvent?)
@@ -62,7 +74,9 @@ void MapEventHandler::on_show_open_map_dialog(const ShowOpenMapDialogEvent&)
   }
 
   TACTILE_LOG_TRACE("Trying to load map {}", map_path->string());
-  const auto format_id = _guess_save_format(*map_path);
+  TACTILE_PROFILE_ZONE("MapEventHandler::load_map");
+
+  const auto format_id = guess_save_format(*map_path);
   if (!format_id.has_value()) {
     TACTILE_LOG_ERROR("Unknown save format for extension '{}'",
                       map_path->extension().string());
@@ -89,15 +103,28 @@ void MapEventHandler::on_show_open_map_dialog(const ShowOpenMapDialogEvent&)
 
   auto& document_manager = mModel->get_document_manager();
 
-  const auto document_uuid =
-      document_manager.create_and_open_map(*mRuntime->get_renderer(), *ir_map);
+  const auto document_uuid = document_manager.create_and_open_map(*mTextureCache, *ir_map);
   if (!document_uuid.has_value()) {
     TACTILE_LOG_ERROR("Could not create map document: {}", to_string(document_uuid.error()));
     return;
   }
 
   auto& document = document_manager.get_document(*document_uuid);
+  document.set_path(*map_path);
   document.set_format(*format_id);
+
+  if (auto* map_document = dynamic_cast<MapDocument*>(&document)) {
+    auto& history = document_manager.get_history(*document_uuid);
+
+    const auto journal_result = restore_command_journal(*map_document, history);
+    if (journal_result.has_value()) {
+      TACTILE_LOG_DEBUG("Restored {} commands from command journal", *journal_result);
+    }
+    else {
+      TACTILE_LOG_WARN("Could not restore command journal: {}",
+                       to_string(journal_result.error()));
+    }
+  }
 }
 
 void MapEventHandler::on_show_godot_export_dialog(const ShowGodotExportDialogEvent&)
@@ -120,27 +147,37 @@ void MapEventHandler::on_create_map(const CreateMapEvent& event)
   }
 }
 
-void MapEventHandler::on_export_as_godot_scene(const ExportAsGodotSceneEvent& event) const
+auto MapEventHandler::on_export_as_godot_scene(const ExportAsGodotSceneEvent& event) const
+    -> Job
 {
-  TACTILE_LOG_TRACE("ExportMapEvent");
+  TACTILE_LOG_TRACE("ExportAsGodotSceneEvent(version: {}, project dir: {})",
+                    event.version,
+                    event.project_dir.string());
 
   const auto* save_format = mRuntime->get_save_format(SaveFormatId::kGodotTscn);
   if (!save_format) {
     TACTILE_LOG_ERROR("Godot plugin is not enabled");
-    return;
+    return {};
   }
 
   const auto* document = dynamic_cast<const MapDocument*>(mModel->get_current_document());
   if (!document) {
     TACTILE_LOG_ERROR("No current document");
-    return;
+    return {};
+  }
+
+  // The worker thread can't access the registry, so it exports a copy of the map instead.
+  auto ir_map = make_map_snapshot(MapViewImpl {document});
+  if (!ir_map.has_value()) {
+    TACTILE_LOG_ERROR("Could not copy map: {}", to_string(ir_map.error()));
+    return {};
   }
 
   SaveFormatExtraSettings extra_settings {};
   extra_settings["version"] = Attribute {event.version};
   extra_settings["ellipse_polygon_vertices"] = Attribute {32};
 
-  const SaveFormatWriteOptions options {
+  SaveFormatWriteOptions options {
     .extra = std::move(extra_settings),
     .base_dir = event.project_dir,
     .use_external_tilesets = false,
@@ -148,32 +185,41 @@ void MapEventHandler::on_export_as_godot_scene(const ExportAsGodotSceneEvent& ev
     .fold_tile_layer_data = false,
   };
 
-  const MapViewImpl map_view {document};
-  const auto save_result = save_format->save_map(map_view, options);
-
-  if (!save_result.has_value()) {
-    TACTILE_LOG_ERROR("Could not export Godot scene: {}", to_string(save_result.error()));
+  std::optional<std::filesystem::path> map_path {};
+  if (const auto* document_path = document->get_path()) {
+    map_path = *document_path;
   }
+
+  return [save_format,
+          map = std::move(*ir_map),
+          map_path = std::move(map_path),
+          options = std::move(options)]() -> JobCompletion {
+    TACTILE_PROFILE_ZONE("MapEventHandler::export_as_godot_scene");
+
+    const IrMapView map_view {&map, map_path.has_value() ? &*map_path : nullptr};
+    const auto save_result = save_format->save_map(map_view, options);
+
+    std::optional<ErrorCode> error {};
+    if (!save_result.has_value()) {
+      error = save_result.error();
+    }
+
+    return [project_dir = options.base_dir, error](EventDispatcher& dispatcher) {
+      dispatcher.push<GodotSceneExportedEvent>(project_dir, error);
+    };
+  };
 }
 
-auto MapEventHandler::_guess_save_format(const std::filesystem::path& path)
-    -> std::optional<SaveFormatId>
+void MapEventHandler::on_godot_scene_exported(const GodotSceneExportedEvent& event)
 {
-  const auto extension = path.extension();
+  TACTILE_LOG_TRACE("GodotSceneExportedEvent(project dir: {})", event.project_dir.string());
 
-  if (extension == ".yaml" || extension == ".yml") {
-    return SaveFormatId::kTactileYaml;
+  if (event.error.has_value()) {
+    TACTILE_LOG_ERROR("Could not export Godot scene: {}", to_string(*event.error));
   }
-
-  if (extension == ".tmj" || extension == ".json") {
-    return SaveFormatId::kTiledTmj;
-  }
-
-  if (extension == ".tmx" || extension == ".xml") {
-    return SaveFormatId::kTiledTmx;
+  else {
+    TACTILE_LOG_DEBUG("Exported Godot scene to {}", event.project_dir.string());
   }
-
-  return std::nullopt;
 }
 
 }  // namespace tactile::core
@@ -27,6 +27,9 @@ void ObjectEventHandler::install(EventDispatcher& dispatcher)
   dispatcher.bind<MoveObjectEvent, &Self::on_move_object>(this);
   dispatcher.bind<SetObjectTagEvent, &Self::on_set_object_tag>(this);
   dispatcher.bind<SetObjectVisibleEvent, &Self::on_set_object_visible>(this);
+
+  // Objects are moved to absolute positions, so only the latest position matters.
+  dispatcher.coalesce<MoveObjectEvent, &MoveObjectEvent::object_id>();
 }
 
 void ObjectEventHandler::on_create_object(const CreateObjectEvent& event) const
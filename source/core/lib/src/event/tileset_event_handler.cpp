@@ -2,13 +2,18 @@
 
 #include "tactile/core/event/tileset_event_handler.hpp"
 
+#include <algorithm>  // find
+#include <memory>     // make_shared
+#include <utility>    // move
+
 #include "tactile/base/numeric/vec_format.hpp"
-#include "tactile/base/render/renderer.hpp"
-#include "tactile/base/render/texture.hpp"
 #include "tactile/core/cmd/tile/add_tileset_command.hpp"
 #include "tactile/core/debug/validation.hpp"
+#include "tactile/core/document/map_document.hpp"
+#include "tactile/core/entity/registry.hpp"
 #include "tactile/core/event/event_dispatcher.hpp"
 #include "tactile/core/event/events.hpp"
+#include "tactile/core/io/texture_cache.hpp"
 #include "tactile/core/log/logger.hpp"
 #include "tactile/core/model/model.hpp"
 #include "tactile/core/ui/widget_manager.hpp"
@@ -16,10 +21,10 @@
 namespace tactile::core {
 
 TilesetEventHandler::TilesetEventHandler(Model* model,
-                                         IRenderer* renderer,
+                                         TextureCache* texture_cache,
                                          ui::WidgetManager* widget_manager)
   : mModel {require_not_null(model, "null model")},
-    mRenderer {require_not_null(renderer, "null renderer")},
+    mTextureCache {require_not_null(texture_cache, "null texture cache")},
     mWidgetManager {require_not_null(widget_manager, "null widget manager")}
 {}
 
@@ -28,7 +33,7 @@ void TilesetEventHandler::install(EventDispatcher& dispatcher)
   using Self = TilesetEventHandler;
 
   dispatcher.bind<ShowNewTilesetDialogEvent, &Self::on_show_new_tileset_dialog>(this);
-  dispatcher.bind<AddTilesetEvent, &Self::on_add_tileset>(this);
+  dispatcher.bind_job<AddTilesetEvent, &Self::on_add_tileset>(this);
 
   // TODO RemoveTilesetEvent
   // TODO RenameTilesetEvent
@@ -49,36 +54,73 @@ void TilesetEventHandler::on_show_new_tileset_dialog(const ShowNewTilesetDialogE
   mWidgetManager->get_new_tileset_dialog().open();
 }
 
-void TilesetEventHandler::on_add_tileset(const AddTilesetEvent& event)
+auto TilesetEventHandler::on_add_tileset(const AddTilesetEvent& event) -> DeferredJob
 {
   TACTILE_LOG_TRACE("AddTilesetEvent(path: {}, tile size: {})",
                     event.texture_path.string(),
                     event.tile_size);
 
-  const auto texture_id = mRenderer->load_texture(event.texture_path);
-  if (!texture_id.has_value()) {
-    TACTILE_LOG_ERROR("Could not load tileset texture: {}", to_string(texture_id.error()));
+  const auto* document = dynamic_cast<const MapDocument*>(mModel->get_current_document());
+  if (!document) {
+    TACTILE_LOG_ERROR("Tilesets can only be added to maps");
+    return {};
+  }
+
+  // Pending textures are move-only, but job functions must be copyable.
+  auto pending_texture =
+      std::make_shared<PendingTexture>(mTextureCache->acquire_async(event.texture_path));
+
+  const auto document_uuid = document->get_uuid();
+  const auto tile_size = event.tile_size;
+
+  // The image is decoded by the texture cache workers, so there's no need to occupy a job
+  // worker while waiting for it.
+  return DeferredJob {
+    .is_ready = [pending_texture] { return pending_texture->is_ready(); },
+    .wait = [pending_texture] { pending_texture->wait(); },
+    .completion = [this, document_uuid, tile_size, pending_texture](EventDispatcher&) {
+      _finish_add_tileset(document_uuid, tile_size, std::move(*pending_texture));
+    },
+  };
+}
+
+void TilesetEventHandler::_finish_add_tileset(const UUID& document_uuid,
+                                              const Int2& tile_size,
+                                              PendingTexture pending_texture)
+{
+  auto& document_manager = mModel->get_document_manager();
+
+  const auto& open_documents = document_manager.get_open_documents();
+  if (std::ranges::find(open_documents, document_uuid) == open_documents.end()) {
+    TACTILE_LOG_DEBUG("Skipped tileset for closed document");
+    return;
+  }
+
+  auto* document = dynamic_cast<MapDocument*>(&document_manager.get_document(document_uuid));
+  if (!document) {
     return;
   }
 
-  const auto* texture = mRenderer->find_texture(*texture_id);
-  if (!texture) {
-    TACTILE_LOG_ERROR("Could not find tileset texture");
+  // The image has already been decoded, so this only uploads the texture.
+  auto texture = mTextureCache->acquire(std::move(pending_texture));
+  if (!texture.has_value()) {
+    TACTILE_LOG_ERROR("Could not load tileset texture: {}", to_string(texture.error()));
     return;
   }
 
-  const auto texture_size = texture->get_size();
-
-  mModel->push_map_command<AddTilesetCommand>(TilesetSpec {
-    .tile_size = event.tile_size,
-    .texture =
-        CTexture {
-          .raw_handle = texture->get_handle(),
-          .id = *texture_id,
-          .size = Int2 {texture_size.width, texture_size.height},
-          .path = texture->get_path(),
-        },
-  });
+  // The tileset takes over the texture reference, which is released along with the tileset.
+  auto& registry = document->get_registry();
+  if (!registry.has<CTextureCacheRef>()) {
+    registry.add<CTextureCacheRef>(mTextureCache);
+  }
+
+  TilesetSpec spec {
+    .tile_size = tile_size,
+    .texture = std::move(*texture),
+  };
+
+  auto& history = document_manager.get_history(document_uuid);
+  history.push<AddTilesetCommand>(document, std::move(spec));
 }
 
 }  // namespace tactile::core
@@ -36,6 +36,7 @@ void ViewEventHandler::install(EventDispatcher& dispatcher)
   dispatcher.bind<ToggleTilesetDockEvent, &Self::on_toggle_tileset_dock>(this);
   dispatcher.bind<ToggleAnimationDockEvent, &Self::on_toggle_animation_dock>(this);
   dispatcher.bind<ToggleLogDockEvent, &Self::on_toggle_log_dock>(this);
+  dispatcher.bind<ToggleProfilerDockEvent, &Self::on_toggle_profiler_dock>(this);
   dispatcher.bind<SetThemeEvent, &Self::on_set_theme>(this);
   dispatcher.bind<IncreaseFontSizeEvent, &Self::on_increase_font_size>(this);
   dispatcher.bind<DecreaseFontSizeEvent, &Self::on_decrease_font_size>(this);
@@ -91,6 +92,12 @@ void ViewEventHandler::on_toggle_log_dock(const ToggleLogDockEvent&)
   // TODO
 }
 
+void ViewEventHandler::on_toggle_profiler_dock(const ToggleProfilerDockEvent&)
+{
+  TACTILE_LOG_TRACE("ToggleProfilerDockEvent");
+  mWidgetManager->get_profiler_dock().toggle();
+}
+
 void ViewEventHandler::on_set_theme(const SetThemeEvent&)
 {
   TACTILE_LOG_TRACE("SetThemeEvent");
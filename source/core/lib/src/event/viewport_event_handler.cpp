@@ -39,6 +39,13 @@ void ViewportEventHandler::install(EventDispatcher& dispatcher)
   dispatcher.bind<PanViewportDownEvent, &Self::on_pan_viewport_down>(this);
   dispatcher.bind<PanViewportLeftEvent, &Self::on_pan_viewport_left>(this);
   dispatcher.bind<PanViewportRightEvent, &Self::on_pan_viewport_right>(this);
+
+  // These are pushed every frame while panning or resizing, only the net effect matters.
+  // Note, summed offsets are clamped once, which only differs at the viewport limits.
+  dispatcher.coalesce<OffsetViewportEvent,
+                      &OffsetViewportEvent::viewport_entity,
+                      SumEventMember<&OffsetViewportEvent::delta>>();
+  dispatcher.coalesce<UpdateViewportSizeEvent, &UpdateViewportSizeEvent::viewport_entity>();
   // clang-format on
 }
 
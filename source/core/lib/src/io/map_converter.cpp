@@ -0,0 +1,279 @@
+// Copyright (C) 2024 Albin Johansson (GNU General Public License v3.0)
+
+#include "tactile/core/io/map_converter.hpp"
+
+#include <cstddef>       // size_t
+#include <string_view>   // string_view
+#include <system_error>  // error_code
+#include <utility>       // move
+
+#include "tactile/base/io/file_io.hpp"
+#include "tactile/base/io/save/save_format.hpp"
+#include "tactile/core/debug/profiler.hpp"
+#include "tactile/core/document/map_document.hpp"
+#include "tactile/core/document/map_view_impl.hpp"
+#include "tactile/core/io/texture_cache.hpp"
+#include "tactile/core/log/logger.hpp"
+
+namespace tactile::core {
+namespace {
+
+[[nodiscard]]
+auto _get_write_options(const MapConversionSpec& spec) -> SaveFormatWriteOptions
+{
+  SaveFormatExtraSettings extra_settings {};
+
+  if (spec.output_format == SaveFormatId::kGodotTscn) {
+    extra_settings["version"] = Attribute {kConverterGodotVersion};
+    extra_settings["ellipse_polygon_vertices"] = Attribute {32};
+  }
+
+  return SaveFormatWriteOptions {
+    .extra = std::move(extra_settings),
+    .base_dir = spec.output_path.parent_path(),
+    .use_external_tilesets = false,
+    .use_indentation = true,
+    .fold_tile_layer_data = false,
+  };
+}
+
+[[nodiscard]]
+auto _find_json_string_end(const std::string_view json, std::size_t pos) -> std::size_t
+{
+  for (; pos < json.size(); ++pos) {
+    if (json[pos] == '\\') {
+      ++pos;
+    }
+    else if (json[pos] == '"') {
+      return pos;
+    }
+  }
+
+  return std::string_view::npos;
+}
+
+/**
+ * Returns the value of a string property of the root object in a JSON document.
+ *
+ * \details
+ * Nested objects and arrays are skipped, so this is much cheaper than parsing the
+ * document. Escape sequences in the returned value are not processed.
+ */
+[[nodiscard]]
+auto _find_json_root_string(const std::string_view json, const std::string_view key)
+    -> std::optional<std::string_view>
+{
+  const auto root_begin = json.find_first_not_of(" \t\r\n");
+  if (root_begin == std::string_view::npos || json[root_begin] != '{') {
+    return std::nullopt;
+  }
+
+  std::size_t depth = 0;
+  std::string_view last_string {};
+
+  for (auto pos = root_begin; pos < json.size(); ++pos) {
+    const auto ch = json[pos];
+
+    if (ch == '"') {
+      const auto string_end = _find_json_string_end(json, pos + 1);
+      if (string_end == std::string_view::npos) {
+        return std::nullopt;
+      }
+
+      last_string = json.substr(pos + 1, string_end - pos - 1);
+      pos = string_end;
+    }
+    else if (ch == '{' || ch == '[') {
+      ++depth;
+    }
+    else if (ch == '}' || ch == ']') {
+      if (--depth == 0) {
+        break;
+      }
+    }
+    else if (ch == ':' && depth == 1 && last_string == key) {
+      const auto value_begin = json.find_first_not_of(" \t\r\n", pos + 1);
+      if (value_begin == std::string_view::npos || json[value_begin] != '"') {
+        return std::nullopt;
+      }
+
+      const auto value_end = _find_json_string_end(json, value_begin + 1);
+      if (value_end == std::string_view::npos) {
+        return std::nullopt;
+      }
+
+      return json.substr(value_begin + 1, value_end - value_begin - 1);
+    }
+  }
+
+  return std::nullopt;
+}
+
+/**
+ * Returns the name of the root element in an XML document.
+ *
+ * \details
+ * The XML declaration, processing instructions, comments, and document type
+ * declarations that precede the root element are skipped.
+ */
+[[nodiscard]]
+auto _find_xml_root_name(const std::string_view xml) -> std::optional<std::string_view>
+{
+  auto pos = xml.find('<');
+
+  while (pos != std::string_view::npos) {
+    const auto tag = xml.substr(pos + 1);
+
+    if (tag.starts_with('?')) {
+      pos = xml.find("?>", pos);
+    }
+    else if (tag.starts_with("!--")) {
+      pos = xml.find("-->", pos);
+    }
+    else if (tag.starts_with('!')) {
+      pos = xml.find('>', pos);
+    }
+    else {
+      return tag.substr(0, tag.find_first_of(" \t\r\n/>"));
+    }
+
+    if (pos != std::string_view::npos) {
+      pos = xml.find('<', pos);
+    }
+  }
+
+  return std::nullopt;
+}
+
+}  // namespace
+
+auto guess_save_format(const std::filesystem::path& path) -> std::optional<SaveFormatId>
+{
+  const auto extension = path.extension();
+
+  if (extension == ".yaml" || extension == ".yml") {
+    return SaveFormatId::kTactileYaml;
+  }
+
+  if (extension == ".tmj" || extension == ".json") {
+    return SaveFormatId::kTiledTmj;
+  }
+
+  if (extension == ".tmx" || extension == ".xml") {
+    return SaveFormatId::kTiledTmx;
+  }
+
+  if (extension == ".tscn" || extension == ".escn") {
+    return SaveFormatId::kGodotTscn;
+  }
+
+  return std::nullopt;
+}
+
+auto is_convertible_map_file(const std::filesystem::path& path) -> bool
+{
+  const auto format_id = guess_save_format(path);
+  if (!format_id.has_value()) {
+    return false;
+  }
+
+  switch (*format_id) {
+    case SaveFormatId::kTactileYaml: return true;
+    case SaveFormatId::kGodotTscn:   return false;
+    case SaveFormatId::kTiledTmj:    [[fallthrough]];
+    case SaveFormatId::kTiledTmx:    break;
+  }
+
+  const auto content = read_binary_file(path);
+  if (!content.has_value()) {
+    return false;
+  }
+
+  // Maps and external tilesets are told apart by the root element or object type.
+  const auto root_kind = (*format_id == SaveFormatId::kTiledTmj)
+                             ? _find_json_root_string(*content, "type")
+                             : _find_xml_root_name(*content);
+
+  return root_kind == "map";
+}
+
+auto get_save_format_extension(const SaveFormatId format_id) -> const char*
+{
+  switch (format_id) {
+    case SaveFormatId::kTactileYaml: return ".yaml";
+    case SaveFormatId::kTiledTmj:    return ".tmj";
+    case SaveFormatId::kTiledTmx:    return ".tmx";
+    case SaveFormatId::kGodotTscn:   return ".tscn";
+  }
+
+  return "";
+}
+
+auto convert_map(const IRuntime& runtime,
+                 TextureCache& texture_cache,
+                 const MapConversionSpec& spec) -> std::expected<void, ErrorCode>
+{
+  TACTILE_PROFILE_ZONE("convert_map");
+  TACTILE_LOG_DEBUG("Converting {} to {}",
+                    spec.input_path.string(),
+                    spec.output_path.string());
+
+  const auto input_format_id = guess_save_format(spec.input_path);
+  if (!input_format_id.has_value()) {
+    TACTILE_LOG_ERROR("Unknown save format for extension '{}'",
+                      spec.input_path.extension().string());
+    return std::unexpected {ErrorCode::kNotSupported};
+  }
+
+  const auto* input_format = runtime.get_save_format(*input_format_id);
+  const auto* output_format = runtime.get_save_format(spec.output_format);
+  if (!input_format || !output_format) {
+    TACTILE_LOG_ERROR("Found no suitable installed save format");
+    return std::unexpected {ErrorCode::kNotSupported};
+  }
+
+  const SaveFormatReadOptions read_options {
+    .base_dir = spec.input_path.parent_path(),
+    .strict_mode = false,
+  };
+
+  const auto ir_map = input_format->load_map(spec.input_path, read_options);
+  if (!ir_map.has_value()) {
+    TACTILE_LOG_ERROR("Could not load map {}: {}",
+                      spec.input_path.string(),
+                      to_string(ir_map.error()));
+    return std::unexpected {ir_map.error()};
+  }
+
+  auto document = MapDocument::make(texture_cache, *ir_map, TextureLoadMode::kBlocking);
+  if (!document.has_value()) {
+    TACTILE_LOG_ERROR("Could not create map document: {}", to_string(document.error()));
+    return std::unexpected {document.error()};
+  }
+
+  const auto write_options = _get_write_options(spec);
+
+  std::error_code error_code {};
+  std::filesystem::create_directories(write_options.base_dir, error_code);
+  if (error_code) {
+    TACTILE_LOG_ERROR("Could not create output directory {}: {}",
+                      write_options.base_dir.string(),
+                      error_code.message());
+    return std::unexpected {ErrorCode::kBadFileStream};
+  }
+
+  document->set_path(spec.output_path);
+
+  const MapViewImpl map_view {&document.value()};
+  const auto save_result = output_format->save_map(map_view, write_options);
+  if (!save_result.has_value()) {
+    TACTILE_LOG_ERROR("Could not save map {}: {}",
+                      spec.output_path.string(),
+                      to_string(save_result.error()));
+    return std::unexpected {save_result.error()};
+  }
+
+  return {};
+}
+
+}  // namespace tactile::core
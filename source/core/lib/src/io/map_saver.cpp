@@ -0,0 +1,122 @@
+// Copyright (C) 2024 Albin Johansson (GNU General Public License v3.0)
+
+#include "tactile/core/io/map_saver.hpp"
+
+#include <algorithm>  // any_of, erase_if
+#include <chrono>     // seconds
+#include <future>     // future_status
+#include <optional>   // optional, nullopt
+#include <utility>    // move
+
+#include "tactile/base/runtime/runtime.hpp"
+#include "tactile/core/debug/profiler.hpp"
+#include "tactile/core/debug/validation.hpp"
+#include "tactile/core/document/ir_map_view.hpp"
+#include "tactile/core/document/map_document.hpp"
+#include "tactile/core/document/map_view_impl.hpp"
+#include "tactile/core/event/event_dispatcher.hpp"
+#include "tactile/core/event/events.hpp"
+#include "tactile/core/io/map_snapshot.hpp"
+#include "tactile/core/log/logger.hpp"
+
+namespace tactile::core {
+
+MapSaver::MapSaver(IRuntime* runtime)
+  : mRuntime {require_not_null(runtime, "null runtime")},
+    mPendingSaves {},
+    mWorkerPool {1}
+{}
+
+MapSaver::~MapSaver() noexcept = default;
+
+auto MapSaver::save(const MapDocument& document,
+                    const SaveFormatWriteOptions& options,
+                    std::vector<CommandJournalRecord> journal_records,
+                    const std::size_t journal_budget) -> std::expected<void, ErrorCode>
+{
+  TACTILE_PROFILE_ZONE("MapSaver::save");
+
+  const auto* map_path = document.get_path();
+  if (!map_path) {
+    return std::unexpected {ErrorCode::kBadState};
+  }
+
+  const auto* save_format = mRuntime->get_save_format(document.get_format());
+  if (!save_format) {
+    return std::unexpected {ErrorCode::kNotSupported};
+  }
+
+  auto ir_map = make_map_snapshot(MapViewImpl {&document});
+  if (!ir_map.has_value()) {
+    return std::unexpected {ir_map.error()};
+  }
+
+  auto result = mWorkerPool.submit([save_format,
+                                    map = std::move(*ir_map),
+                                    path = *map_path,
+                                    options,
+                                    records = std::move(journal_records),
+                                    journal_budget]() -> std::expected<void, ErrorCode> {
+    TACTILE_PROFILE_ZONE("MapSaver::save_map");
+
+    const IrMapView map_view {&map, &path};
+    if (const auto save_result = save_format->save_map(map_view, options);
+        !save_result.has_value()) {
+      return std::unexpected {save_result.error()};
+    }
+
+    // The map has already been saved at this point, so journal errors are not fatal.
+    const auto journal_result = save_command_journal(path, records, journal_budget);
+    if (journal_result.has_value()) {
+      TACTILE_LOG_DEBUG("Stored {} commands in command journal", *journal_result);
+    }
+    else {
+      TACTILE_LOG_WARN("Could not store command journal: {}",
+                       to_string(journal_result.error()));
+    }
+
+    return {};
+  });
+
+  mPendingSaves.push_back(PendingSave {
+    .document_uuid = document.get_uuid(),
+    .path = *map_path,
+    .result = std::move(result),
+  });
+
+  return {};
+}
+
+void MapSaver::update(EventDispatcher& dispatcher)
+{
+  std::erase_if(mPendingSaves, [&dispatcher](PendingSave& pending_save) {
+    if (pending_save.result.wait_for(std::chrono::seconds::zero()) !=
+        std::future_status::ready) {
+      return false;
+    }
+
+    const auto save_result = pending_save.result.get();
+    dispatcher.push<MapSavedEvent>(
+        pending_save.document_uuid,
+        std::move(pending_save.path),
+        save_result.has_value() ? std::nullopt : std::optional {save_result.error()});
+
+    return true;
+  });
+}
+
+void MapSaver::wait()
+{
+  for (const auto& pending_save : mPendingSaves) {
+    pending_save.result.wait();
+  }
+}
+
+auto MapSaver::is_saving(const UUID& document_uuid) const -> bool
+{
+  return std::ranges::any_of(mPendingSaves, [&](const PendingSave& pending_save) {
+    return pending_save.document_uuid == document_uuid;
+  });
+}
+
+}  // namespace tactile::core
@@ -0,0 +1,270 @@
+// Copyright (C) 2024 Albin Johansson (GNU General Public License v3.0)
+
+#include "tactile/core/io/map_snapshot.hpp"
+
+#include <cstddef>  // size_t
+#include <utility>  // move
+#include <vector>   // vector
+
+#include "tactile/base/document/document_visitor.hpp"
+#include "tactile/base/document/layer_view.hpp"
+#include "tactile/base/document/meta_view.hpp"
+#include "tactile/base/document/object_view.hpp"
+#include "tactile/base/document/tile_view.hpp"
+#include "tactile/base/document/tileset_view.hpp"
+#include "tactile/base/io/byte_stream.hpp"
+#include "tactile/base/io/tile_io.hpp"
+#include "tactile/base/numeric/saturate_cast.hpp"
+#include "tactile/core/debug/profiler.hpp"
+
+namespace tactile::core {
+namespace {
+
+[[nodiscard]]
+auto _copy_meta(const IMetaView& meta) -> ir::Metadata
+{
+  ir::Metadata ir_meta {};
+  ir_meta.name = meta.get_name();
+
+  const auto property_count = meta.property_count();
+  ir_meta.properties.reserve(property_count);
+
+  for (std::size_t index = 0; index < property_count; ++index) {
+    const auto& [name, value] = meta.get_property(index);
+    ir_meta.properties.push_back(ir::NamedAttribute {.name = name, .value = value});
+  }
+
+  return ir_meta;
+}
+
+[[nodiscard]]
+auto _copy_object(const IObjectView& object) -> ir::Object
+{
+  return ir::Object {
+    .meta = _copy_meta(object.get_meta()),
+    .id = object.get_id(),
+    .type = object.get_type(),
+    .position = object.get_position(),
+    .size = object.get_size(),
+    .tag = std::string {object.get_tag()},
+    .visible = object.is_visible(),
+  };
+}
+
+class MapSnapshotVisitor final : public IDocumentVisitor
+{
+ public:
+  [[nodiscard]]
+  auto visit(const IComponentView&) -> std::expected<void, ErrorCode> override
+  {
+    return {};
+  }
+
+  [[nodiscard]]
+  auto visit(const IMapView& map) -> std::expected<void, ErrorCode> override
+  {
+    mMap.meta = _copy_meta(map.get_meta());
+    mMap.extent = map.get_extent();
+    mMap.tile_size = map.get_tile_size();
+    mMap.next_layer_id = map.get_next_layer_id();
+    mMap.next_object_id = map.get_next_object_id();
+    mMap.tile_format = ir::TileFormat {
+      .encoding = map.get_tile_encoding(),
+      .compression = map.get_tile_compression(),
+      .compression_level = map.get_compression_level(),
+    };
+
+    // Layers are never moved once added, since the layer vectors are reserved
+    // up front (the map layer count includes nested layers). This keeps the
+    // pointers in the layer table valid.
+    mMap.tilesets.reserve(map.tileset_count());
+    mMap.layers.reserve(map.layer_count());
+    mLayers.reserve(map.layer_count());
+
+    return {};
+  }
+
+  [[nodiscard]]
+  auto visit(const ILayerView& layer) -> std::expected<void, ErrorCode> override
+  {
+    auto* parent_layers = &mMap.layers;
+
+    if (const auto* parent_layer = layer.get_parent_layer()) {
+      auto* ir_parent_layer = _find_layer(parent_layer->get_global_index());
+      if (!ir_parent_layer) {
+        return std::unexpected {ErrorCode::kBadState};
+      }
+
+      parent_layers = &ir_parent_layer->layers;
+    }
+
+    ir::Layer ir_layer {};
+    ir_layer.meta = _copy_meta(layer.get_meta());
+    ir_layer.id = layer.get_id();
+    ir_layer.type = layer.get_type();
+    ir_layer.opacity = layer.get_opacity();
+    ir_layer.visible = layer.is_visible();
+    ir_layer.layers.reserve(layer.layer_count());
+    ir_layer.objects.reserve(layer.object_count());
+
+    if (ir_layer.type == LayerType::kTileLayer) {
+      ir_layer.extent = layer.get_extent().value_or(Extent2D {});
+
+      // The raw tile bytes are much faster to copy than individual tiles.
+      layer.write_tile_bytes(mTileBytes);
+
+      auto tiles = parse_raw_tile_matrix(mTileBytes, ir_layer.extent, TileIdFormat::kTactile);
+      if (!tiles.has_value()) {
+        return std::unexpected {ErrorCode::kBadState};
+      }
+
+      ir_layer.tiles = std::move(*tiles);
+    }
+
+    auto& new_layer = parent_layers->emplace_back(std::move(ir_layer));
+
+    const auto global_index = layer.get_global_index();
+    if (mLayers.size() <= global_index) {
+      mLayers.resize(global_index + 1, nullptr);
+    }
+
+    mLayers[global_index] = &new_layer;
+    return {};
+  }
+
+  [[nodiscard]]
+  auto visit(const IObjectView& object) -> std::expected<void, ErrorCode> override
+  {
+    std::vector<ir::Object>* objects = nullptr;
+
+    if (const auto* parent_layer = object.get_parent_layer()) {
+      if (auto* ir_layer = _find_layer(parent_layer->get_global_index())) {
+        objects = &ir_layer->objects;
+      }
+    }
+    else if (const auto* parent_tile = object.get_parent_tile()) {
+      if (auto* ir_tile = _find_tile(*parent_tile)) {
+        objects = &ir_tile->objects;
+      }
+    }
+
+    if (!objects) {
+      return std::unexpected {ErrorCode::kBadState};
+    }
+
+    objects->push_back(_copy_object(object));
+    return {};
+  }
+
+  [[nodiscard]]
+  auto visit(const ITilesetView& tileset) -> std::expected<void, ErrorCode> override
+  {
+    ir::TilesetRef tileset_ref {};
+    tileset_ref.first_tile_id = tileset.get_first_tile_id();
+
+    auto& ir_tileset = tileset_ref.tileset;
+    ir_tileset.meta = _copy_meta(tileset.get_meta());
+    ir_tileset.tile_size = tileset.get_tile_size();
+    ir_tileset.tile_count = saturate_cast<std::ptrdiff_t>(tileset.tile_count());
+    ir_tileset.column_count = saturate_cast<std::ptrdiff_t>(tileset.column_count());
+    ir_tileset.image_size = tileset.get_image_size();
+    ir_tileset.image_path = tileset.get_image_path();
+    ir_tileset.tiles.reserve(tileset.tile_definition_count());
+    ir_tileset.is_embedded = false;  // Not exposed by tileset views.
+
+    mMap.tilesets.push_back(std::move(tileset_ref));
+    return {};
+  }
+
+  [[nodiscard]]
+  auto visit(const ITileView& tile) -> std::expected<void, ErrorCode> override
+  {
+    auto* ir_tileset = _find_tileset(tile.get_parent_tileset());
+    if (!ir_tileset) {
+      return std::unexpected {ErrorCode::kBadState};
+    }
+
+    ir::Tile ir_tile {};
+    ir_tile.meta = _copy_meta(tile.get_meta());
+    ir_tile.index = tile.get_index();
+    ir_tile.objects.reserve(tile.object_count());
+
+    const auto frame_count = tile.animation_frame_count();
+    ir_tile.animation.reserve(frame_count);
+
+    for (std::size_t frame_index = 0; frame_index < frame_count; ++frame_index) {
+      const auto [tile_index, duration] = tile.get_animation_frame(frame_index);
+      ir_tile.animation.push_back(
+          ir::AnimationFrame {.tile_index = tile_index, .duration = duration});
+    }
+
+    ir_tileset->tiles.push_back(std::move(ir_tile));
+    return {};
+  }
+
+  [[nodiscard]]
+  auto get_map() -> ir::Map&
+  {
+    return mMap;
+  }
+
+ private:
+  ir::Map mMap {};
+  std::vector<ir::Layer*> mLayers {};
+  ByteStream mTileBytes {};
+
+  [[nodiscard]]
+  auto _find_layer(const std::size_t global_index) -> ir::Layer*
+  {
+    return global_index < mLayers.size() ? mLayers[global_index] : nullptr;
+  }
+
+  [[nodiscard]]
+  auto _find_tileset(const ITilesetView& tileset) -> ir::Tileset*
+  {
+    const auto first_tile_id = tileset.get_first_tile_id();
+
+    for (auto& tileset_ref : mMap.tilesets) {
+      if (tileset_ref.first_tile_id == first_tile_id) {
+        return &tileset_ref.tileset;
+      }
+    }
+
+    return nullptr;
+  }
+
+  [[nodiscard]]
+  auto _find_tile(const ITileView& tile) -> ir::Tile*
+  {
+    auto* ir_tileset = _find_tileset(tile.get_parent_tileset());
+    if (!ir_tileset) {
+      return nullptr;
+    }
+
+    // Objects are visited right after their tiles, so we start from the back.
+    const auto tile_index = tile.get_index();
+    for (auto iter = ir_tileset->tiles.rbegin(); iter != ir_tileset->tiles.rend(); ++iter) {
+      if (iter->index == tile_index) {
+        return &*iter;
+      }
+    }
+
+    return nullptr;
+  }
+};
+
+}  // namespace
+
+auto make_map_snapshot(const IMapView& map) -> std::expected<ir::Map, ErrorCode>
+{
+  TACTILE_PROFILE_ZONE("make_map_snapshot");
+
+  MapSnapshotVisitor visitor {};
+  if (const auto visit_result = map.accept(visitor); !visit_result.has_value()) {
+    return std::unexpected {visit_result.error()};
+  }
+
+  return std::move(visitor.get_map());
+}
+
+}  // namespace tactile::core
@@ -0,0 +1,370 @@
+// Copyright (C) 2024 Albin Johansson (GNU General Public License v3.0)
+
+#include "tactile/core/io/recovery_journal.hpp"
+
+#include <cstdint>       // uint8_t, uint32_t, uint64_t
+#include <cstring>       // memcpy
+#include <fstream>       // ofstream
+#include <ios>           // ios, streamsize
+#include <limits>        // numeric_limits
+#include <string>        // u8string
+#include <system_error>  // error_code
+#include <utility>       // move
+
+#include <magic_enum.hpp>
+
+#include "tactile/base/io/atomic_file.hpp"
+#include "tactile/base/io/file_io.hpp"
+#include "tactile/base/io/varint.hpp"
+#include "tactile/core/debug/profiler.hpp"
+#include "tactile/core/log/logger.hpp"
+
+namespace tactile::core {
+namespace {
+
+inline constexpr std::uint32_t kRecoveryJournalMagic = 0x4C415754;  // "TWAL"
+inline constexpr std::uint64_t kRecoveryJournalVersion = 1;
+
+void _write_path(ByteStream& stream, const std::filesystem::path& path)
+{
+  const auto path_string = path.u8string();
+  write_varint(stream, path_string.size());
+
+  for (const auto ch : path_string) {
+    stream.push_back(static_cast<std::uint8_t>(ch));
+  }
+}
+
+[[nodiscard]]
+auto _read_path(const ByteSpan bytes, std::size_t& offset)
+    -> std::optional<std::filesystem::path>
+{
+  const auto length = read_varint(bytes, offset);
+  if (!length.has_value() || *length > bytes.size() - offset) {
+    return std::nullopt;
+  }
+
+  std::u8string path_string {};
+  path_string.reserve(*length);
+
+  for (std::size_t index = 0; index < *length; ++index) {
+    path_string.push_back(static_cast<char8_t>(bytes[offset + index]));
+  }
+
+  offset += *length;
+  return std::filesystem::path {path_string};
+}
+
+[[nodiscard]]
+auto _make_header(const RecoveryJournalBase& base, const std::filesystem::path* map_path)
+    -> ByteStream
+{
+  ByteStream header(sizeof kRecoveryJournalMagic);
+  std::memcpy(header.data(), &kRecoveryJournalMagic, sizeof kRecoveryJournalMagic);
+
+  write_varint(header, kRecoveryJournalVersion);
+  write_varint(header, static_cast<std::uint64_t>(base.format));
+  write_varint(header, base.key.file_size);
+  write_signed_varint(header, base.key.write_time);
+  write_varint(header, base.is_snapshot ? 1 : 0);
+  _write_path(header, base.file_path);
+
+  write_varint(header, map_path ? 1 : 0);
+  if (map_path) {
+    _write_path(header, *map_path);
+  }
+
+  return header;
+}
+
+[[nodiscard]]
+auto _append_file(const std::filesystem::path& path, const ByteSpan bytes)
+    -> std::expected<void, ErrorCode>
+{
+  std::ofstream stream {path, std::ios::out | std::ios::binary | std::ios::app};
+  if (!stream.good()) {
+    return std::unexpected {ErrorCode::kBadFileStream};
+  }
+
+  stream.write(reinterpret_cast<const char*>(bytes.data()),
+               static_cast<std::streamsize>(bytes.size()));
+  stream.flush();
+
+  if (!stream.good()) {
+    return std::unexpected {ErrorCode::kWriteError};
+  }
+
+  return {};
+}
+
+}  // namespace
+
+RecoveryJournal::RecoveryJournal(std::filesystem::path journal_path)
+  : m_journal_path {std::move(journal_path)}
+{}
+
+void RecoveryJournal::on_command_executed(const ICommand& command)
+{
+  _record(command, false);
+}
+
+void RecoveryJournal::on_command_reverted(const ICommand& command)
+{
+  _record(command, true);
+}
+
+auto RecoveryJournal::reset(const RecoveryJournalBase& base,
+                            const std::filesystem::path* map_path)
+    -> std::expected<void, ErrorCode>
+{
+  TACTILE_PROFILE_ZONE("RecoveryJournal::reset");
+
+  if (const auto replace_result = _replace(base, map_path, ByteSpan {});
+      !replace_result.has_value()) {
+    return replace_result;
+  }
+
+  m_is_valid = true;
+  m_pending_snapshot.reset();
+
+  return {};
+}
+
+void RecoveryJournal::begin_snapshot()
+{
+  m_pending_snapshot = PendingSnapshot {.records = {}, .is_valid = true};
+}
+
+auto RecoveryJournal::finish_snapshot(const RecoveryJournalBase& base,
+                                      const std::filesystem::path* map_path)
+    -> std::expected<void, ErrorCode>
+{
+  TACTILE_PROFILE_ZONE("RecoveryJournal::finish_snapshot");
+
+  if (!m_pending_snapshot.has_value()) {
+    return std::unexpected {ErrorCode::kBadState};
+  }
+
+  auto snapshot = std::move(*m_pending_snapshot);
+  m_pending_snapshot.reset();
+
+  if (const auto replace_result = _replace(base, map_path, snapshot.records);
+      !replace_result.has_value()) {
+    return replace_result;
+  }
+
+  m_flushed_size = snapshot.records.size();
+  m_is_valid = snapshot.is_valid;
+
+  return {};
+}
+
+void RecoveryJournal::cancel_snapshot()
+{
+  m_pending_snapshot.reset();
+}
+
+auto RecoveryJournal::is_snapshot_pending() const -> bool
+{
+  return m_pending_snapshot.has_value();
+}
+
+auto RecoveryJournal::flush() -> std::expected<void, ErrorCode>
+{
+  if (!m_base.has_value() || m_pending_records.empty()) {
+    return {};
+  }
+
+  TACTILE_PROFILE_ZONE("RecoveryJournal::flush");
+
+  const auto write_result = _append_file(m_journal_path, m_pending_records);
+  if (!write_result.has_value()) {
+    return std::unexpected {write_result.error()};
+  }
+
+  m_flushed_size += m_pending_records.size();
+  m_pending_records.clear();
+
+  return {};
+}
+
+void RecoveryJournal::discard()
+{
+  std::error_code error_code {};
+  std::filesystem::remove(m_journal_path, error_code);
+
+  if (m_base.has_value() && m_base->is_snapshot) {
+    std::filesystem::remove(m_base->file_path, error_code);
+  }
+
+  m_base.reset();
+  m_pending_records.clear();
+  m_flushed_size = 0;
+  m_is_valid = false;
+  m_pending_snapshot.reset();
+}
+
+auto RecoveryJournal::is_valid() const -> bool
+{
+  return m_is_valid;
+}
+
+auto RecoveryJournal::has_records() const -> bool
+{
+  return m_flushed_size > 0 || !m_pending_records.empty();
+}
+
+auto RecoveryJournal::record_size() const -> std::size_t
+{
+  return m_flushed_size + m_pending_records.size();
+}
+
+auto RecoveryJournal::get_base() const -> const RecoveryJournalBase*
+{
+  return m_base.has_value() ? &m_base.value() : nullptr;
+}
+
+void RecoveryJournal::_record(const ICommand& command, const bool reverted)
+{
+  const auto records_snapshot = m_pending_snapshot.has_value() && m_pending_snapshot->is_valid;
+  if (!m_is_valid && !records_snapshot) {
+    return;
+  }
+
+  CommandJournalRecord record {};
+  if (!command.write_journal_record(record)) {
+    // Pending records are kept, since they describe valid changes to the base file.
+    TACTILE_LOG_DEBUG("Recovery journal {} requires a new base file",
+                      m_journal_path.filename().string());
+    m_is_valid = false;
+
+    if (m_pending_snapshot.has_value()) {
+      m_pending_snapshot->is_valid = false;
+    }
+
+    return;
+  }
+
+  if (reverted) {
+    record.diff = record.diff.make_inverse();
+  }
+
+  if (m_is_valid) {
+    encode_command_journal_record(record, m_pending_records);
+  }
+
+  if (records_snapshot) {
+    encode_command_journal_record(record, m_pending_snapshot->records);
+  }
+}
+
+auto RecoveryJournal::_replace(const RecoveryJournalBase& base,
+                               const std::filesystem::path* map_path,
+                               const ByteSpan records) -> std::expected<void, ErrorCode>
+{
+  std::error_code error_code {};
+  std::filesystem::create_directories(m_journal_path.parent_path(), error_code);
+  if (error_code) {
+    return std::unexpected {ErrorCode::kBadFileStream};
+  }
+
+  // The old journal file is replaced atomically, so that there's always a usable
+  // journal on disk.
+  auto content = _make_header(base, map_path);
+  content.insert(content.end(), records.begin(), records.end());
+
+  if (const auto write_result = write_file_atomically(m_journal_path, content);
+      !write_result.has_value()) {
+    return std::unexpected {write_result.error()};
+  }
+
+  if (m_base.has_value() && m_base->is_snapshot && m_base->file_path != base.file_path) {
+    std::filesystem::remove(m_base->file_path, error_code);
+  }
+
+  m_base = base;
+  m_pending_records.clear();
+  m_flushed_size = 0;
+
+  return {};
+}
+
+auto read_recovery_journal(const std::filesystem::path& journal_path)
+    -> std::expected<RecoveryJournalContent, ErrorCode>
+{
+  TACTILE_PROFILE_ZONE("read_recovery_journal");
+
+  const auto file_content = read_binary_file(journal_path);
+  if (!file_content.has_value()) {
+    return std::unexpected {ErrorCode::kNoSuchFile};
+  }
+
+  const auto bytes = make_byte_span(*file_content);
+  if (bytes.size() < sizeof kRecoveryJournalMagic) {
+    return std::unexpected {ErrorCode::kParseError};
+  }
+
+  std::uint32_t magic {};
+  std::memcpy(&magic, bytes.data(), sizeof magic);
+
+  std::size_t offset = sizeof magic;
+  const auto version = read_varint(bytes, offset);
+
+  if (magic != kRecoveryJournalMagic || version != kRecoveryJournalVersion) {
+    return std::unexpected {ErrorCode::kParseError};
+  }
+
+  const auto format_value = read_varint(bytes, offset);
+  const auto file_size = read_varint(bytes, offset);
+  const auto write_time = read_signed_varint(bytes, offset);
+  const auto is_snapshot = read_varint(bytes, offset);
+  auto base_path = _read_path(bytes, offset);
+  const auto has_map_path = read_varint(bytes, offset);
+
+  if (!format_value.has_value() || !file_size.has_value() || !write_time.has_value() ||
+      !is_snapshot.has_value() || !base_path.has_value() || !has_map_path.has_value()) {
+    return std::unexpected {ErrorCode::kParseError};
+  }
+
+  const auto format =
+      (*format_value <= std::numeric_limits<std::uint8_t>::max())
+          ? magic_enum::enum_cast<SaveFormatId>(static_cast<std::uint8_t>(*format_value))
+          : std::nullopt;
+  if (!format.has_value()) {
+    return std::unexpected {ErrorCode::kParseError};
+  }
+
+  RecoveryJournalContent content {
+    .base =
+        RecoveryJournalBase {
+          .file_path = std::move(*base_path),
+          .format = *format,
+          .key = CommandJournalKey {.file_size = *file_size, .write_time = *write_time},
+          .is_snapshot = *is_snapshot != 0,
+        },
+    .map_path = std::nullopt,
+    .records = {},
+  };
+
+  if (*has_map_path != 0) {
+    content.map_path = _read_path(bytes, offset);
+    if (!content.map_path.has_value()) {
+      return std::unexpected {ErrorCode::kParseError};
+    }
+  }
+
+  while (offset < bytes.size()) {
+    auto record = decode_command_journal_record(bytes, offset);
+    if (!record.has_value()) {
+      TACTILE_LOG_WARN("Ignoring incomplete record in recovery journal {}",
+                       journal_path.filename().string());
+      break;
+    }
+
+    content.records.push_back(std::move(*record));
+  }
+
+  return content;
+}
+
+}  // namespace tactile::core
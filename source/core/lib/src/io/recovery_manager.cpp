@@ -0,0 +1,555 @@
+// Copyright (C) 2024 Albin Johansson (GNU General Public License v3.0)
+
+#include "tactile/core/io/recovery_manager.hpp"
+
+#include <format>        // format
+#include <string_view>   // string_view
+#include <system_error>  // error_code
+#include <utility>       // move
+#include <vector>        // vector
+
+#include "tactile/base/io/save/save_format.hpp"
+#include "tactile/base/runtime/runtime.hpp"
+#include "tactile/core/cmd/command_journal.hpp"
+#include "tactile/core/cmd/command_stack.hpp"
+#include "tactile/core/debug/profiler.hpp"
+#include "tactile/core/debug/validation.hpp"
+#include "tactile/core/document/ir_map_view.hpp"
+#include "tactile/core/document/map_document.hpp"
+#include "tactile/core/document/map_view_impl.hpp"
+#include "tactile/core/io/map_converter.hpp"
+#include "tactile/core/io/map_saver.hpp"
+#include "tactile/core/io/map_snapshot.hpp"
+#include "tactile/core/log/logger.hpp"
+#include "tactile/core/model/model.hpp"
+#include "tactile/core/platform/filesystem.hpp"
+
+namespace tactile::core {
+namespace {
+
+// Pending changes are written to disk at least this often, which limits the
+// amount of journaled changes that may be lost in a crash.
+inline constexpr auto kFlushInterval = std::chrono::seconds {2};
+
+// The minimum amount of time between snapshots of documents with changes that
+// can't be journaled, since snapshots of large maps are expensive.
+inline constexpr auto kSnapshotInterval = std::chrono::seconds {30};
+
+// Journals that grow beyond this size are compacted into snapshots.
+inline constexpr auto kCompactionThreshold = std::size_t {8} * 1'024 * 1'024;
+
+// The name of the lock files that are held by running editor instances.
+inline constexpr std::string_view kSessionLockName = "session.lock";
+
+[[nodiscard]]
+auto _get_recovery_directory() -> std::optional<std::filesystem::path>
+{
+  const auto storage_dir = get_persistent_storage_directory();
+  if (!storage_dir.has_value()) {
+    TACTILE_LOG_WARN("Crash recovery is unavailable: {}", to_string(storage_dir.error()));
+    return std::nullopt;
+  }
+
+  return *storage_dir / "recovery";
+}
+
+[[nodiscard]]
+auto _find_journals(const std::filesystem::path& dir) -> std::vector<std::filesystem::path>
+{
+  std::vector<std::filesystem::path> journal_paths {};
+
+  std::error_code error_code {};
+  for (const auto& entry : std::filesystem::directory_iterator {dir, error_code}) {
+    if (entry.path().extension() == ".journal") {
+      journal_paths.push_back(entry.path());
+    }
+  }
+
+  return journal_paths;
+}
+
+[[nodiscard]]
+auto _find_snapshot_format(const IRuntime& runtime, const SaveFormatId preferred_format)
+    -> std::optional<SaveFormatId>
+{
+  for (const auto format_id :
+       {preferred_format, SaveFormatId::kTiledTmj, SaveFormatId::kTiledTmx}) {
+    // Godot scenes can't be loaded, so they're not usable as snapshots.
+    if (format_id != SaveFormatId::kGodotTscn && runtime.get_save_format(format_id)) {
+      return format_id;
+    }
+  }
+
+  return std::nullopt;
+}
+
+[[nodiscard]]
+auto _is_permanent_recovery_error(const ErrorCode error) -> bool
+{
+  return error == ErrorCode::kParseError || error == ErrorCode::kBadState;
+}
+
+// Returns the directory that external files, e.g., tileset images, are relative to.
+[[nodiscard]]
+auto _get_base_directory(const std::filesystem::path* map_path,
+                         const std::filesystem::path& recovery_dir) -> std::filesystem::path
+{
+  return map_path ? map_path->parent_path() : recovery_dir;
+}
+
+}  // namespace
+
+RecoveryManager::RecoveryManager(Model* model,
+                                 IRuntime* runtime,
+                                 TextureCache* texture_cache,
+                                 const MapSaver* map_saver)
+  : mModel {require_not_null(model, "null model")},
+    mRuntime {require_not_null(runtime, "null runtime")},
+    mTextureCache {require_not_null(texture_cache, "null texture cache")},
+    mMapSaver {require_not_null(map_saver, "null map saver")},
+    mRecoveryRootDir {_get_recovery_directory()},
+    mRecoveryDir {},
+    mSessionLock {},
+    mJournals {},
+    mLastFlushTime {Clock::now()},
+    mJobSystem {1}
+{
+  if (!mRecoveryRootDir.has_value()) {
+    return;
+  }
+
+  const auto session_dir = *mRecoveryRootDir / std::format("{}", UUID::generate());
+
+  std::error_code error_code {};
+  std::filesystem::create_directories(session_dir, error_code);
+  if (error_code) {
+    TACTILE_LOG_WARN("Crash recovery is unavailable: could not create session directory");
+    return;
+  }
+
+  auto session_lock = FileLock::try_lock(session_dir / kSessionLockName);
+  if (!session_lock.has_value()) {
+    TACTILE_LOG_WARN("Crash recovery is unavailable: {}", to_string(session_lock.error()));
+    std::filesystem::remove_all(session_dir, error_code);
+    return;
+  }
+
+  mRecoveryDir = session_dir;
+  mSessionLock.emplace(std::move(*session_lock));
+}
+
+RecoveryManager::~RecoveryManager() noexcept
+{
+  auto& document_manager = mModel->get_document_manager();
+
+  for (const auto& document_uuid : document_manager.get_open_documents()) {
+    if (mJournals.contains(document_uuid)) {
+      document_manager.get_history(document_uuid).set_observer(nullptr);
+    }
+  }
+}
+
+auto RecoveryManager::recover_documents() -> std::size_t
+{
+  if (!mRecoveryDir.has_value()) {
+    return 0;
+  }
+
+  TACTILE_PROFILE_ZONE("RecoveryManager::recover_documents");
+
+  std::vector<std::filesystem::path> session_dirs {};
+
+  std::error_code error_code {};
+  for (const auto& entry :
+       std::filesystem::directory_iterator {*mRecoveryRootDir, error_code}) {
+    if (entry.is_directory(error_code) && entry.path() != *mRecoveryDir) {
+      session_dirs.push_back(entry.path());
+    }
+  }
+
+  std::size_t recovered_count {0};
+
+  for (const auto& session_dir : session_dirs) {
+    recovered_count += _recover_session(session_dir);
+  }
+
+  return recovered_count;
+}
+
+void RecoveryManager::update(EventDispatcher& dispatcher)
+{
+  if (!mRecoveryDir.has_value()) {
+    return;
+  }
+
+  TACTILE_PROFILE_ZONE("RecoveryManager::update");
+
+  // Finished snapshots are applied first, so that the journals below are up to date.
+  mJobSystem.update(dispatcher);
+
+  auto& document_manager = mModel->get_document_manager();
+
+  for (const auto& document_uuid : document_manager.get_open_documents()) {
+    const auto* document =
+        dynamic_cast<const MapDocument*>(&document_manager.get_document(document_uuid));
+    if (!document) {
+      continue;
+    }
+
+    auto& history = document_manager.get_history(document_uuid);
+
+    auto [journal_iter, inserted] = mJournals.try_emplace(document_uuid);
+    if (inserted) {
+      const auto journal_path = *mRecoveryDir / std::format("{}.journal", document_uuid);
+      journal_iter->second.journal = std::make_unique<RecoveryJournal>(journal_path);
+      history.set_observer(journal_iter->second.journal.get());
+    }
+
+    // Map files can't be used as journal bases while they're being written.
+    if (mMapSaver->is_saving(document_uuid)) {
+      journal_iter->second.is_base_outdated = true;
+      continue;
+    }
+
+    _update_journal(document_uuid, *document, history, journal_iter->second);
+  }
+
+  const auto now = Clock::now();
+  if (now - mLastFlushTime >= kFlushInterval) {
+    for (auto& [document_uuid, journal] : mJournals) {
+      if (const auto flush_result = journal.journal->flush(); !flush_result.has_value()) {
+        TACTILE_LOG_ERROR("Could not flush recovery journal: {}",
+                          to_string(flush_result.error()));
+      }
+    }
+
+    mLastFlushTime = now;
+  }
+}
+
+void RecoveryManager::discard_journals()
+{
+  // Snapshots may still be written to the session directory.
+  mJobSystem.wait();
+
+  for (auto& [document_uuid, journal] : mJournals) {
+    journal.journal->discard();
+  }
+
+  if (mRecoveryDir.has_value()) {
+    // The lock is released first, since locked files can't be removed on Windows.
+    mSessionLock->unlock();
+
+    std::error_code error_code {};
+    std::filesystem::remove_all(*mRecoveryDir, error_code);
+  }
+}
+
+void RecoveryManager::_update_journal(const UUID& document_uuid,
+                                      const MapDocument& document,
+                                      const CommandStack& history,
+                                      DocumentJournal& journal)
+{
+  auto& recovery_journal = *journal.journal;
+  const auto* map_path = document.get_path();
+
+  // Documents that match their map files use the map files as journal bases,
+  // which is much cheaper than writing snapshots.
+  if (map_path && history.is_clean()) {
+    const auto* base = recovery_journal.get_base();
+    const auto is_based_on_map_file =
+        base && !base->is_snapshot && base->file_path == *map_path;
+
+    if (is_based_on_map_file && !journal.is_base_outdated && recovery_journal.is_valid() &&
+        !recovery_journal.has_records()) {
+      return;
+    }
+
+    if (const auto key = make_command_journal_key(*map_path)) {
+      const RecoveryJournalBase map_base {
+        .file_path = *map_path,
+        .format = document.get_format(),
+        .key = *key,
+        .is_snapshot = false,
+      };
+
+      if (const auto reset_result = recovery_journal.reset(map_base, map_path)) {
+        journal.is_base_outdated = false;
+      }
+      else {
+        TACTILE_LOG_ERROR("Could not reset recovery journal: {}",
+                          to_string(reset_result.error()));
+      }
+
+      return;
+    }
+  }
+
+  // Only one snapshot is written at a time, later changes are kept by the journal.
+  if (recovery_journal.is_snapshot_pending()) {
+    return;
+  }
+
+  const auto now = Clock::now();
+
+  if (!recovery_journal.is_valid()) {
+    // Unchanged documents without map files have nothing worth recovering.
+    if (history.is_clean() || now - journal.last_snapshot_time < kSnapshotInterval) {
+      return;
+    }
+  }
+  else if (recovery_journal.record_size() < kCompactionThreshold) {
+    return;
+  }
+
+  if (const auto snapshot_result = _start_snapshot(document_uuid, document, journal);
+      !snapshot_result.has_value()) {
+    TACTILE_LOG_ERROR("Could not start recovery snapshot: {}",
+                      to_string(snapshot_result.error()));
+  }
+
+  // Failed snapshots are not retried immediately, to avoid stalling every frame.
+  journal.last_snapshot_time = now;
+}
+
+auto RecoveryManager::_start_snapshot(const UUID& document_uuid,
+                                      const MapDocument& document,
+                                      DocumentJournal& journal)
+    -> std::expected<void, ErrorCode>
+{
+  TACTILE_PROFILE_ZONE("RecoveryManager::start_snapshot");
+
+  const auto format_id = _find_snapshot_format(*mRuntime, document.get_format());
+  if (!format_id.has_value()) {
+    return std::unexpected {ErrorCode::kNotSupported};
+  }
+
+  // Only copying the map is done on the main thread, the rest is left to the worker.
+  auto ir_map = make_map_snapshot(MapViewImpl {&document});
+  if (!ir_map.has_value()) {
+    return std::unexpected {ir_map.error()};
+  }
+
+  ++journal.snapshot_count;
+  const auto snapshot_name = std::format("{}-{}{}",
+                                         document_uuid,
+                                         journal.snapshot_count,
+                                         get_save_format_extension(*format_id));
+  auto snapshot_path = *mRecoveryDir / snapshot_name;
+
+  TACTILE_LOG_DEBUG("Writing recovery snapshot {}", snapshot_path.filename().string());
+
+  const SaveFormatWriteOptions options {
+    .base_dir = _get_base_directory(document.get_path(), *mRecoveryDir),
+    .use_external_tilesets = false,
+    .use_indentation = false,
+    .fold_tile_layer_data = false,
+  };
+
+  // Changes made from this point on are kept by the journal until the snapshot
+  // has been written, after which they're stored on top of the snapshot.
+  journal.journal->begin_snapshot();
+
+  mJobSystem.submit([this,
+                     document_uuid,
+                     save_format = mRuntime->get_save_format(*format_id),
+                     format_id = *format_id,
+                     map = std::move(*ir_map),
+                     path = std::move(snapshot_path),
+                     options]() -> JobCompletion {
+    TACTILE_PROFILE_ZONE("RecoveryManager::write_snapshot");
+
+    auto snapshot_base = [&]() -> std::expected<RecoveryJournalBase, ErrorCode> {
+      std::error_code error_code {};
+      std::filesystem::create_directories(path.parent_path(), error_code);
+      if (error_code) {
+        return std::unexpected {ErrorCode::kBadFileStream};
+      }
+
+      const IrMapView map_view {&map, &path};
+      if (const auto save_result = save_format->save_map(map_view, options);
+          !save_result.has_value()) {
+        return std::unexpected {save_result.error()};
+      }
+
+      const auto key = make_command_journal_key(path);
+      if (!key.has_value()) {
+        return std::unexpected {key.error()};
+      }
+
+      return RecoveryJournalBase {
+        .file_path = path,
+        .format = format_id,
+        .key = *key,
+        .is_snapshot = true,
+      };
+    }();
+
+    return [this, document_uuid, path, snapshot_base](EventDispatcher&) {
+      _finish_snapshot(document_uuid, path, snapshot_base);
+    };
+  });
+
+  return {};
+}
+
+void RecoveryManager::_finish_snapshot(
+    const UUID& document_uuid,
+    const std::filesystem::path& snapshot_path,
+    const std::expected<RecoveryJournalBase, ErrorCode>& snapshot_base)
+{
+  TACTILE_PROFILE_ZONE("RecoveryManager::finish_snapshot");
+
+  auto& recovery_journal = *mJournals.at(document_uuid).journal;
+
+  if (snapshot_base.has_value()) {
+    const auto& document = mModel->get_document_manager().get_document(document_uuid);
+
+    // Snapshots are abandoned if their journals are reset in the meantime, e.g.,
+    // because the document was saved, in which case the snapshot isn't needed.
+    const auto finish_result =
+        recovery_journal.finish_snapshot(*snapshot_base, document.get_path());
+    if (finish_result.has_value()) {
+      return;
+    }
+
+    if (finish_result.error() != ErrorCode::kBadState) {
+      TACTILE_LOG_ERROR("Could not reset recovery journal: {}",
+                        to_string(finish_result.error()));
+    }
+  }
+  else {
+    TACTILE_LOG_ERROR("Could not write recovery snapshot: {}",
+                      to_string(snapshot_base.error()));
+  }
+
+  recovery_journal.cancel_snapshot();
+
+  std::error_code error_code {};
+  std::filesystem::remove(snapshot_path, error_code);
+}
+
+auto RecoveryManager::_recover_session(const std::filesystem::path& session_dir)
+    -> std::size_t
+{
+  // Sessions of running editor instances are locked, and must be left alone.
+  auto session_lock = FileLock::try_lock(session_dir / kSessionLockName);
+  if (!session_lock.has_value()) {
+    TACTILE_LOG_DEBUG("Skipping recovery session {}: {}",
+                      session_dir.filename().string(),
+                      to_string(session_lock.error()));
+    return 0;
+  }
+
+  std::size_t recovered_count {0};
+  std::size_t failed_count {0};
+
+  for (const auto& journal_path : _find_journals(session_dir)) {
+    TACTILE_LOG_INFO("Recovering document from {}", journal_path.filename().string());
+
+    const auto recover_result = _recover_document(journal_path);
+    if (recover_result.has_value()) {
+      ++recovered_count;
+      continue;
+    }
+
+    TACTILE_LOG_ERROR("Could not recover document: {}", to_string(recover_result.error()));
+
+    // Corrupt journals and journals with modified base files can never be recovered.
+    if (_is_permanent_recovery_error(recover_result.error())) {
+      std::error_code error_code {};
+      std::filesystem::remove(journal_path, error_code);
+    }
+    else {
+      ++failed_count;
+    }
+  }
+
+  // Sessions are kept until all of their journals have been recovered, so that
+  // journals can be recovered later, e.g., once the required save format has
+  // been enabled. Otherwise, leftover files such as unused snapshots are removed.
+  if (failed_count == 0) {
+    // The lock is released first, since locked files can't be removed on Windows.
+    session_lock->unlock();
+
+    std::error_code error_code {};
+    std::filesystem::remove_all(session_dir, error_code);
+  }
+
+  return recovered_count;
+}
+
+auto RecoveryManager::_recover_document(const std::filesystem::path& journal_path)
+    -> std::expected<void, ErrorCode>
+{
+  auto content = read_recovery_journal(journal_path);
+  if (!content.has_value()) {
+    return std::unexpected {content.error()};
+  }
+
+  const auto& base = content->base;
+
+  // Journals can't be applied to base files that have been modified since.
+  const auto key = make_command_journal_key(base.file_path);
+  if (!key.has_value()) {
+    return std::unexpected {key.error()};
+  }
+
+  if (*key != base.key) {
+    TACTILE_LOG_WARN("Recovery base file {} has been modified", base.file_path.string());
+    return std::unexpected {ErrorCode::kBadState};
+  }
+
+  const auto* save_format = mRuntime->get_save_format(base.format);
+  if (!save_format) {
+    return std::unexpected {ErrorCode::kNotSupported};
+  }
+
+  const auto* map_path = content->map_path.has_value() ? &content->map_path.value() : nullptr;
+
+  const SaveFormatReadOptions read_options {
+    .base_dir = _get_base_directory(map_path, journal_path.parent_path()),
+    .strict_mode = false,
+  };
+
+  const auto ir_map = save_format->load_map(base.file_path, read_options);
+  if (!ir_map.has_value()) {
+    return std::unexpected {ir_map.error()};
+  }
+
+  auto& document_manager = mModel->get_document_manager();
+
+  const auto document_uuid = document_manager.create_and_open_map(*mTextureCache, *ir_map);
+  if (!document_uuid.has_value()) {
+    return std::unexpected {document_uuid.error()};
+  }
+
+  auto& document = dynamic_cast<MapDocument&>(document_manager.get_document(*document_uuid));
+
+  if (map_path) {
+    document.set_path(*map_path);
+    document.set_format(guess_save_format(*map_path).value_or(base.format));
+  }
+
+  // The recovered changes are executed as commands, which leaves the document
+  // with unsaved changes that can be undone.
+  auto& history = document_manager.get_history(*document_uuid);
+  const auto record_count =
+      add_command_journal_records(document, history, std::move(content->records), true);
+  if (!record_count.has_value()) {
+    return std::unexpected {record_count.error()};
+  }
+
+  TACTILE_LOG_INFO("Recovered {} changes", *record_count);
+
+  // The recovered document gets a new journal, so the old files are no longer needed.
+  std::error_code error_code {};
+  std::filesystem::remove(journal_path, error_code);
+  if (base.is_snapshot) {
+    std::filesystem::remove(base.file_path, error_code);
+  }
+
+  return {};
+}
+
+}  // namespace tactile::core
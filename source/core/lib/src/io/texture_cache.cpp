@@ -0,0 +1,369 @@
+// Copyright (C) 2024 Albin Johansson (GNU General Public License v3.0)
+
+#include "tactile/core/io/texture_cache.hpp"
+
+#include <chrono>        // seconds
+#include <format>        // format
+#include <future>        // future_status
+#include <mutex>         // scoped_lock, unique_lock
+#include <optional>      // optional, nullopt
+#include <system_error>  // error_code
+#include <thread>        // thread
+#include <utility>       // move
+
+#include "tactile/base/io/file_io.hpp"
+#include "tactile/base/render/image_cache.hpp"
+#include "tactile/base/render/texture.hpp"
+#include "tactile/core/debug/validation.hpp"
+#include "tactile/core/log/logger.hpp"
+#include "tactile/core/platform/mapped_file.hpp"
+
+namespace tactile::core {
+namespace {
+
+[[nodiscard]]
+auto _get_file_key(const std::filesystem::path& path) -> std::optional<std::string>
+{
+  std::error_code error_code {};
+
+  const auto canonical_path = std::filesystem::canonical(path, error_code);
+  if (error_code) {
+    return std::nullopt;
+  }
+
+  const auto file_size = std::filesystem::file_size(canonical_path, error_code);
+  if (error_code) {
+    return std::nullopt;
+  }
+
+  const auto write_time = std::filesystem::last_write_time(canonical_path, error_code);
+  if (error_code) {
+    return std::nullopt;
+  }
+
+  return std::format("{}|{}|{}",
+                     canonical_path.string(),
+                     write_time.time_since_epoch().count(),
+                     file_size);
+}
+
+[[nodiscard]]
+auto _load_cached_image(const std::filesystem::path& cache_path, const ImageCacheKey& key)
+    -> std::optional<ImageData>
+{
+  const auto cache_file = MappedFile::open(cache_path);
+  if (!cache_file.has_value()) {
+    return std::nullopt;
+  }
+
+  return read_cached_image(cache_file->get_bytes(), key);
+}
+
+// Textures shared by different files should still refer to the requested file.
+[[nodiscard]]
+auto _with_path(CTexture texture, const std::filesystem::path& path) -> CTexture
+{
+  texture.path = path;
+  return texture;
+}
+
+}  // namespace
+
+PendingTexture::PendingTexture(std::filesystem::path path,
+                               std::future<std::expected<DecodeResult, ErrorCode>> result)
+  : mPath {std::move(path)},
+    mResult {std::move(result)}
+{}
+
+auto PendingTexture::get_path() const -> const std::filesystem::path&
+{
+  return mPath;
+}
+
+auto PendingTexture::is_ready() const -> bool
+{
+  return mResult.wait_for(std::chrono::seconds::zero()) == std::future_status::ready;
+}
+
+void PendingTexture::wait() const
+{
+  mResult.wait();
+}
+
+TextureCache::TextureCache(IRenderer* renderer,
+                           std::optional<std::filesystem::path> image_cache_dir)
+  : mRenderer {require_not_null(renderer, "null renderer")},
+    mImageCacheDir {std::move(image_cache_dir)},
+    mMutex {},
+    mEntries {},
+    mFileKeys {},
+    mContentHashes {},
+    mWorkerPool {std::thread::hardware_concurrency()}
+{}
+
+TextureCache::~TextureCache() noexcept
+{
+  for (const auto& [texture_id, entry] : mEntries) {
+    mRenderer->unload_texture(texture_id);
+  }
+}
+
+auto TextureCache::acquire(const std::filesystem::path& path)
+    -> std::expected<CTexture, ErrorCode>
+{
+  return _acquire(path, _decode(path, true));
+}
+
+auto TextureCache::acquire_async(const std::filesystem::path& path) -> PendingTexture
+{
+  auto result = mWorkerPool.submit([this, path] { return _decode(path, true); });
+  return PendingTexture {path, std::move(result)};
+}
+
+auto TextureCache::acquire(PendingTexture pending_texture)
+    -> std::expected<CTexture, ErrorCode>
+{
+  return _acquire(pending_texture.mPath, pending_texture.mResult.get());
+}
+
+auto TextureCache::_decode(const std::filesystem::path& path,
+                           const bool skip_cached_images) const
+    -> std::expected<DecodeResult, ErrorCode>
+{
+  auto file_key = _get_file_key(path);
+  if (!file_key.has_value()) {
+    TACTILE_LOG_ERROR("Could not find texture file '{}'", path.string());
+    return std::unexpected {ErrorCode::kNoSuchFile};
+  }
+
+  if (skip_cached_images) {
+    const std::scoped_lock lock {mMutex};
+    if (mFileKeys.contains(*file_key)) {
+      return DecodeResult {std::move(*file_key), std::nullopt, std::nullopt, std::nullopt};
+    }
+  }
+
+  const auto file_content = read_binary_file(path);
+  if (!file_content.has_value()) {
+    TACTILE_LOG_ERROR("Could not read texture file '{}'", path.string());
+    return std::unexpected {ErrorCode::kBadFileStream};
+  }
+
+  const auto cache_key = make_image_cache_key(*file_content);
+  const auto content_hash = static_cast<std::size_t>(cache_key.content_hash);
+
+  // The file may be an identical copy of an image that is already loaded.
+  if (skip_cached_images) {
+    if (const auto identical_texture = _find_identical_texture(*file_content, cache_key)) {
+      return DecodeResult {std::move(*file_key),
+                           content_hash,
+                           identical_texture,
+                           std::nullopt};
+    }
+  }
+
+  // Images decoded in previous sessions are reused, unless the renderer opts out.
+  const auto cache_tag = mRenderer->get_image_cache_tag();
+  const auto use_image_cache = mImageCacheDir.has_value() && !cache_tag.empty();
+
+  std::filesystem::path cache_path {};
+  if (use_image_cache) {
+    cache_path = get_image_cache_path(*mImageCacheDir, path, cache_tag);
+
+    if (auto cached_image = _load_cached_image(cache_path, cache_key)) {
+      TACTILE_LOG_TRACE("Loaded cached image '{}'", cache_path.string());
+      return DecodeResult {std::move(*file_key),
+                           content_hash,
+                           std::nullopt,
+                           std::move(*cached_image)};
+    }
+  }
+
+  auto image = mRenderer->decode_image(path);
+  if (!image.has_value()) {
+    TACTILE_LOG_ERROR("Could not decode texture file '{}': {}",
+                      path.string(),
+                      to_string(image.error()));
+    return std::unexpected {image.error()};
+  }
+
+  if (use_image_cache && !save_cached_image(cache_path, cache_key, *image)) {
+    TACTILE_LOG_WARN("Could not write image cache file '{}'", cache_path.string());
+  }
+
+  return DecodeResult {std::move(*file_key), content_hash, std::nullopt, std::move(*image)};
+}
+
+auto TextureCache::_find_identical_texture(const std::string_view file_content,
+                                           const ImageCacheKey& cache_key) const
+    -> std::optional<TextureID>
+{
+  TextureID texture_id {};
+  std::filesystem::path source_path {};
+
+  {
+    const std::scoped_lock lock {mMutex};
+
+    const auto hash_iter =
+        mContentHashes.find(static_cast<std::size_t>(cache_key.content_hash));
+    if (hash_iter == mContentHashes.end()) {
+      return std::nullopt;
+    }
+
+    const auto& entry = mEntries.at(hash_iter->second);
+    if (entry.file_size != cache_key.file_size) {
+      return std::nullopt;
+    }
+
+    texture_id = hash_iter->second;
+    source_path = entry.source_path;
+  }
+
+  // Hashes may collide, so the files are compared byte by byte (without the lock).
+  const auto source_content = read_binary_file(source_path);
+  if (!source_content.has_value() || *source_content != file_content) {
+    return std::nullopt;
+  }
+
+  return texture_id;
+}
+
+auto TextureCache::_acquire(const std::filesystem::path& path,
+                            std::expected<DecodeResult, ErrorCode> decode_result)
+    -> std::expected<CTexture, ErrorCode>
+{
+  if (!decode_result.has_value()) {
+    return std::unexpected {decode_result.error()};
+  }
+
+  auto& [file_key, content_hash, identical_texture, image] = *decode_result;
+
+  {
+    const std::scoped_lock lock {mMutex};
+
+    if (const auto key_iter = mFileKeys.find(file_key); key_iter != mFileKeys.end()) {
+      auto& entry = mEntries.at(key_iter->second);
+      ++entry.use_count;
+      return _with_path(entry.texture, path);
+    }
+
+    // The identical texture may have been released since it was compared with the file.
+    const auto entry_iter = identical_texture.has_value() ? mEntries.find(*identical_texture)
+                                                          : mEntries.end();
+    if (entry_iter != mEntries.end() && entry_iter->second.content_hash == content_hash) {
+      auto& entry = entry_iter->second;
+      ++entry.use_count;
+
+      mFileKeys.insert_or_assign(file_key, entry_iter->first);
+      entry.file_keys.push_back(std::move(file_key));
+
+      TACTILE_LOG_DEBUG("Reusing texture {} for '{}'", entry_iter->first.value, path.string());
+      return _with_path(entry.texture, path);
+    }
+  }
+
+  if (!image.has_value()) {
+    // The cached texture was released after the image was checked, so decode it after all.
+    return _acquire(path, _decode(path, false));
+  }
+
+  const auto texture_id = mRenderer->upload_texture(path, *image);
+  if (!texture_id.has_value()) {
+    TACTILE_LOG_ERROR("Could not upload texture '{}': {}",
+                      path.string(),
+                      to_string(texture_id.error()));
+    return std::unexpected {texture_id.error()};
+  }
+
+  const auto* texture = mRenderer->find_texture(*texture_id);
+  if (!texture) {
+    TACTILE_LOG_ERROR("Could not find loaded texture");
+    return std::unexpected {ErrorCode::kBadState};
+  }
+
+  const auto texture_size = texture->get_size();
+
+  CTexture texture_component {
+    .raw_handle = texture->get_handle(),
+    .id = *texture_id,
+    .size = Int2 {texture_size.width, texture_size.height},
+    .path = path,
+  };
+
+  std::error_code error_code {};
+  const auto file_size = std::filesystem::file_size(path, error_code);
+
+  std::unique_lock lock {mMutex};
+
+  // Another thread may have loaded the same file while the texture was uploaded.
+  if (const auto key_iter = mFileKeys.find(file_key); key_iter != mFileKeys.end()) {
+    auto& entry = mEntries.at(key_iter->second);
+    ++entry.use_count;
+
+    const auto shared_texture = _with_path(entry.texture, path);
+    lock.unlock();
+
+    mRenderer->unload_texture(*texture_id);
+    return shared_texture;
+  }
+
+  mFileKeys.insert_or_assign(file_key, *texture_id);
+  mContentHashes.try_emplace(*content_hash, *texture_id);
+  mEntries.insert_or_assign(*texture_id,
+                            Entry {
+                              .texture = texture_component,
+                              .use_count = 1,
+                              .content_hash = *content_hash,
+                              .file_size = file_size,
+                              .source_path = path,
+                              .file_keys = {std::move(file_key)},
+                            });
+
+  return texture_component;
+}
+
+void TextureCache::release(const TextureID texture_id)
+{
+  const std::scoped_lock lock {mMutex};
+
+  const auto entry_iter = mEntries.find(texture_id);
+  if (entry_iter == mEntries.end()) {
+    return;
+  }
+
+  auto& entry = entry_iter->second;
+  --entry.use_count;
+
+  if (entry.use_count == 0) {
+    for (const auto& file_key : entry.file_keys) {
+      mFileKeys.erase(file_key);
+    }
+
+    // Colliding hashes are only associated with the first texture that used them.
+    if (const auto hash_iter = mContentHashes.find(entry.content_hash);
+        hash_iter != mContentHashes.end() && hash_iter->second == texture_id) {
+      mContentHashes.erase(hash_iter);
+    }
+
+    mEntries.erase(entry_iter);
+
+    mRenderer->unload_texture(texture_id);
+    TACTILE_LOG_DEBUG("Unloaded texture {}", texture_id.value);
+  }
+}
+
+auto TextureCache::use_count(const TextureID texture_id) const -> std::size_t
+{
+  const std::scoped_lock lock {mMutex};
+
+  const auto entry_iter = mEntries.find(texture_id);
+  return entry_iter != mEntries.end() ? entry_iter->second.use_count : 0;
+}
+
+auto TextureCache::size() const -> std::size_t
+{
+  const std::scoped_lock lock {mMutex};
+  return mEntries.size();
+}
+
+}  // namespace tactile::core
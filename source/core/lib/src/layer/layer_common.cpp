@@ -2,6 +2,8 @@
 
 #include "tactile/core/layer/layer_common.hpp"
 
+#include <cstddef>  // size_t
+
 #include "tactile/base/io/save/ir.hpp"
 #include "tactile/core/debug/assert.hpp"
 #include "tactile/core/debug/exception.hpp"
@@ -9,11 +11,20 @@
 #include "tactile/core/layer/group_layer.hpp"
 #include "tactile/core/layer/layer.hpp"
 #include "tactile/core/layer/object.hpp"
+#include "tactile/core/layer/object_index.hpp"
 #include "tactile/core/layer/object_layer.hpp"
 #include "tactile/core/layer/tile_layer.hpp"
 #include "tactile/core/meta/meta.hpp"
 
 namespace tactile::core {
+namespace {
+
+// Assumes a red-black tree node with three pointers and a color, like the common
+// standard library implementations.
+inline constexpr std::size_t kSparseTileNodeSize =
+    sizeof(SparseTileMatrix::value_type) + 4 * sizeof(void*);
+
+}  // namespace
 
 auto make_layer(Registry& registry, const ir::Layer& ir_layer) -> EntityID
 {
@@ -42,6 +53,8 @@ auto make_layer(Registry& registry, const ir::Layer& ir_layer) -> EntityID
         object_layer.objects.push_back(make_object(registry, ir_object));
       }
 
+      rebuild_object_index(registry, layer_id);
+
       break;
     }
     case LayerType::kGroupLayer: {
@@ -127,6 +140,8 @@ auto copy_layer(Registry& registry, const EntityID source_layer_entity, LayerID&
       const auto new_object_id = copy_object(registry, source_object_id);
       new_object_layer.objects.push_back(new_object_id);
     }
+
+    rebuild_object_index(registry, new_layer_entity);
   }
   else if (is_group_layer(registry, source_layer_entity)) {
     const auto& source_group_layer = registry.get<CGroupLayer>(source_layer_entity);
@@ -148,4 +163,37 @@ auto copy_layer(Registry& registry, const EntityID source_layer_entity, LayerID&
   return new_layer_entity;
 }
 
+auto estimate_layer_memory_usage(const Registry& registry, const EntityID layer_entity)
+    -> std::size_t
+{
+  TACTILE_ASSERT(is_layer(registry, layer_entity));
+
+  std::size_t memory_usage = sizeof(CMeta) + sizeof(CLayer);
+
+  if (const auto* dense = registry.find<CDenseTileLayer>(layer_entity)) {
+    // The tile matrix may be empty even though the extent isn't, e.g., when the tiles
+    // have been offloaded. All rows are assumed to have the same length, which avoids
+    // visiting every row.
+    const auto row_count = dense->tiles.size();
+    const auto col_count = dense->tiles.empty() ? 0 : dense->tiles.front().size();
+    memory_usage += sizeof(CTileLayer) + row_count * sizeof(TileRow) +
+                    row_count * col_count * sizeof(TileID);
+  }
+  else if (const auto* sparse = registry.find<CSparseTileLayer>(layer_entity)) {
+    memory_usage += sizeof(CTileLayer) + sparse->tiles.size() * kSparseTileNodeSize;
+  }
+  else if (const auto* object_layer = registry.find<CObjectLayer>(layer_entity)) {
+    memory_usage += object_layer->objects.capacity() * sizeof(EntityID);
+    memory_usage += object_layer->objects.size() * (sizeof(CObject) + sizeof(CMeta));
+  }
+  else if (const auto* group_layer = registry.find<CGroupLayer>(layer_entity)) {
+    memory_usage += group_layer->layers.capacity() * sizeof(EntityID);
+    for (const auto nested_layer_id : group_layer->layers) {
+      memory_usage += estimate_layer_memory_usage(registry, nested_layer_id);
+    }
+  }
+
+  return memory_usage;
+}
+
 }  // namespace tactile::core
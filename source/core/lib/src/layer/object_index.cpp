@@ -0,0 +1,282 @@
+// Copyright (C) 2024 Albin Johansson (GNU General Public License v3.0)
+
+#include "tactile/core/layer/object_index.hpp"
+
+#include <algorithm>  // max, sort
+#include <cmath>      // floor
+#include <cstddef>    // size_t, ptrdiff_t
+#include <cstdint>    // int32_t, uint32_t, uint64_t
+#include <utility>    // pair
+
+#include "tactile/core/debug/assert.hpp"
+#include "tactile/core/entity/registry.hpp"
+#include "tactile/core/layer/layer_types.hpp"
+#include "tactile/core/layer/object.hpp"
+#include "tactile/core/layer/object_layer.hpp"
+
+namespace tactile::core {
+namespace {
+
+/** The cell key used by objects stored in the large object list. */
+constexpr std::uint64_t kLargeObjectCell = ~std::uint64_t {0};
+
+struct CellCoord final
+{
+  std::int32_t x;
+  std::int32_t y;
+};
+
+[[nodiscard]]
+auto _to_cell_coord(const Float2& position, const float cell_size) -> CellCoord
+{
+  return CellCoord {
+    .x = static_cast<std::int32_t>(std::floor(position.x() / cell_size)),
+    .y = static_cast<std::int32_t>(std::floor(position.y() / cell_size)),
+  };
+}
+
+[[nodiscard]]
+constexpr auto _to_cell_key(const CellCoord& coord) noexcept -> std::uint64_t
+{
+  return (static_cast<std::uint64_t>(static_cast<std::uint32_t>(coord.x)) << 32u) |
+         static_cast<std::uint64_t>(static_cast<std::uint32_t>(coord.y));
+}
+
+[[nodiscard]]
+constexpr auto _to_cell_coord(const std::uint64_t key) noexcept -> CellCoord
+{
+  return CellCoord {
+    .x = static_cast<std::int32_t>(static_cast<std::uint32_t>(key >> 32u)),
+    .y = static_cast<std::int32_t>(static_cast<std::uint32_t>(key & 0xFFFF'FFFFu)),
+  };
+}
+
+[[nodiscard]]
+auto _get_cell_key(const CObjectIndex& index, const CObject& object) -> std::uint64_t
+{
+  if (object.size.x() > index.cell_size || object.size.y() > index.cell_size) {
+    return kLargeObjectCell;
+  }
+
+  return _to_cell_key(_to_cell_coord(object.position, index.cell_size));
+}
+
+[[nodiscard]]
+auto _intersects(const CObject& object, const Float2& region_begin, const Float2& region_end)
+    -> bool
+{
+  const auto object_end = object.position + object.size;
+  return object.position.x() <= region_end.x() && object.position.y() <= region_end.y() &&
+         object_end.x() >= region_begin.x() && object_end.y() >= region_begin.y();
+}
+
+void _insert(CObjectIndex& index, const EntityID object_id, const ObjectIndexEntry& entry)
+{
+  if (entry.cell_key == kLargeObjectCell) {
+    index.large_objects.push_back(object_id);
+  }
+  else {
+    index.cells[entry.cell_key].push_back(object_id);
+  }
+
+  index.entries.insert_or_assign(object_id, entry);
+}
+
+void _erase(CObjectIndex& index, const EntityID object_id, const std::uint64_t cell_key)
+{
+  if (cell_key == kLargeObjectCell) {
+    std::erase(index.large_objects, object_id);
+  }
+  else if (const auto iter = index.cells.find(cell_key); iter != index.cells.end()) {
+    std::erase(iter->second, object_id);
+
+    if (iter->second.empty()) {
+      index.cells.erase(iter);
+    }
+  }
+
+  index.entries.erase(object_id);
+}
+
+void _collect_intersecting(const Registry& registry,
+                           const std::vector<EntityID>& candidates,
+                           const Float2& region_begin,
+                           const Float2& region_end,
+                           std::vector<EntityID>& objects)
+{
+  for (const auto object_id : candidates) {
+    const auto& object = registry.get<CObject>(object_id);
+    if (_intersects(object, region_begin, region_end)) {
+      objects.push_back(object_id);
+    }
+  }
+}
+
+void _query_index(const Registry& registry,
+                  const CObjectIndex& index,
+                  const Float2& region_begin,
+                  const Float2& region_end,
+                  std::vector<EntityID>& objects)
+{
+  // Objects in cells are at most one cell large, so objects stored in the cells just before
+  // the region may still intersect the region.
+  const auto cell_extension = Float2 {index.cell_size, index.cell_size};
+  const auto first_cell = _to_cell_coord(region_begin - cell_extension, index.cell_size);
+  const auto last_cell = _to_cell_coord(region_end, index.cell_size);
+
+  const auto cols = static_cast<std::size_t>(std::max(last_cell.x - first_cell.x + 1, 0));
+  const auto rows = static_cast<std::size_t>(std::max(last_cell.y - first_cell.y + 1, 0));
+
+  // Visit the occupied cells directly if there are fewer of them than cells in the region.
+  if (rows * cols > index.cells.size()) {
+    for (const auto& [cell_key, cell_objects] : index.cells) {
+      const auto cell = _to_cell_coord(cell_key);
+      if (cell.x >= first_cell.x && cell.x <= last_cell.x &&  //
+          cell.y >= first_cell.y && cell.y <= last_cell.y) {
+        _collect_intersecting(registry, cell_objects, region_begin, region_end, objects);
+      }
+    }
+  }
+  else {
+    for (auto y = first_cell.y; y <= last_cell.y; ++y) {
+      for (auto x = first_cell.x; x <= last_cell.x; ++x) {
+        const auto iter = index.cells.find(_to_cell_key(CellCoord {.x = x, .y = y}));
+        if (iter != index.cells.end()) {
+          _collect_intersecting(registry, iter->second, region_begin, region_end, objects);
+        }
+      }
+    }
+  }
+
+  _collect_intersecting(registry, index.large_objects, region_begin, region_end, objects);
+}
+
+// Sorts found objects by their position in the layer, since cells are visited in no
+// particular order.
+void _sort_by_sequence(const CObjectIndex& index,
+                       const std::vector<EntityID>::iterator begin,
+                       const std::vector<EntityID>::iterator end)
+{
+  std::vector<std::pair<std::uint64_t, EntityID>> sorted_objects {};
+  sorted_objects.reserve(static_cast<std::size_t>(end - begin));
+
+  for (auto iter = begin; iter != end; ++iter) {
+    sorted_objects.emplace_back(index.entries.at(*iter).sequence, *iter);
+  }
+
+  std::ranges::sort(sorted_objects);
+
+  auto iter = begin;
+  for (const auto& [sequence, object_id] : sorted_objects) {
+    *iter++ = object_id;
+  }
+}
+
+}  // namespace
+
+void add_object_to_index(Registry& registry,
+                         const EntityID layer_entity,
+                         const EntityID object_id)
+{
+  TACTILE_ASSERT(registry.has<CObjectIndex>(layer_entity));
+  TACTILE_ASSERT(is_object(registry, object_id));
+
+  auto& index = registry.get<CObjectIndex>(layer_entity);
+  const auto& object = registry.get<CObject>(object_id);
+
+  if (const auto iter = index.entries.find(object_id); iter != index.entries.end()) {
+    _erase(index, object_id, iter->second.cell_key);
+  }
+
+  const ObjectIndexEntry entry {
+    .cell_key = _get_cell_key(index, object),
+    .sequence = index.next_sequence++,
+  };
+
+  _insert(index, object_id, entry);
+}
+
+void remove_object_from_index(Registry& registry,
+                              const EntityID layer_entity,
+                              const EntityID object_id)
+{
+  TACTILE_ASSERT(registry.has<CObjectIndex>(layer_entity));
+  auto& index = registry.get<CObjectIndex>(layer_entity);
+
+  if (const auto iter = index.entries.find(object_id); iter != index.entries.end()) {
+    _erase(index, object_id, iter->second.cell_key);
+  }
+}
+
+void update_object_in_index(Registry& registry, const EntityID object_id)
+{
+  TACTILE_ASSERT(is_object(registry, object_id));
+  const auto& object = registry.get<CObject>(object_id);
+
+  for (auto [layer_entity, index] : registry.each<CObjectIndex>()) {
+    const auto iter = index.entries.find(object_id);
+    if (iter == index.entries.end()) {
+      continue;
+    }
+
+    const auto old_entry = iter->second;
+    const auto new_cell_key = _get_cell_key(index, object);
+
+    // Moved objects keep their position in the layer.
+    if (old_entry.cell_key != new_cell_key) {
+      _erase(index, object_id, old_entry.cell_key);
+      const ObjectIndexEntry new_entry {
+        .cell_key = new_cell_key,
+        .sequence = old_entry.sequence,
+      };
+
+      _insert(index, object_id, new_entry);
+    }
+
+    return;
+  }
+}
+
+void rebuild_object_index(Registry& registry, const EntityID layer_entity)
+{
+  TACTILE_ASSERT(is_object_layer(registry, layer_entity));
+  const auto& object_layer = registry.get<CObjectLayer>(layer_entity);
+
+  auto& index = registry.add<CObjectIndex>(layer_entity);
+  index.cell_size = kDefaultObjectIndexCellSize;
+  index.entries.reserve(object_layer.objects.size());
+  index.next_sequence = 0;
+
+  for (const auto object_id : object_layer.objects) {
+    const auto& object = registry.get<CObject>(object_id);
+    const ObjectIndexEntry entry {
+      .cell_key = _get_cell_key(index, object),
+      .sequence = index.next_sequence++,
+    };
+
+    _insert(index, object_id, entry);
+  }
+}
+
+void query_objects(const Registry& registry,
+                   const EntityID layer_entity,
+                   const Float2& region_begin,
+                   const Float2& region_end,
+                   std::vector<EntityID>& objects)
+{
+  TACTILE_ASSERT(is_object_layer(registry, layer_entity));
+
+  if (const auto* index = registry.find<CObjectIndex>(layer_entity)) {
+    const auto first_found = objects.size();
+    _query_index(registry, *index, region_begin, region_end, objects);
+
+    const auto found_begin = objects.begin() + static_cast<std::ptrdiff_t>(first_found);
+    _sort_by_sequence(*index, found_begin, objects.end());
+  }
+  else {
+    const auto& object_layer = registry.get<CObjectLayer>(layer_entity);
+    _collect_intersecting(registry, object_layer.objects, region_begin, region_end, objects);
+  }
+}
+
+}  // namespace tactile::core
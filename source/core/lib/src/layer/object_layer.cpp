@@ -7,6 +7,7 @@
 #include "tactile/core/layer/layer.hpp"
 #include "tactile/core/layer/layer_types.hpp"
 #include "tactile/core/layer/object.hpp"
+#include "tactile/core/layer/object_index.hpp"
 #include "tactile/core/meta/meta.hpp"
 
 namespace tactile::core {
@@ -23,6 +24,7 @@ auto make_object_layer(Registry& registry) -> EntityID
   const auto layer_entity = make_unspecialized_layer(registry);
 
   registry.add<CObjectLayer>(layer_entity);
+  rebuild_object_index(registry, layer_entity);
 
   TACTILE_ASSERT(is_object_layer(registry, layer_entity));
   return layer_entity;
@@ -0,0 +1,205 @@
+// Copyright (C) 2024 Albin Johansson (GNU General Public License v3.0)
+
+#include "tactile/core/layer/tile_diff.hpp"
+
+#include <algorithm>  // min, max, fill
+#include <cstddef>    // ptrdiff_t
+#include <ranges>     // views::reverse
+
+#include "tactile/base/util/tile_matrix.hpp"
+#include "tactile/core/debug/assert.hpp"
+#include "tactile/core/debug/exception.hpp"
+#include "tactile/core/entity/registry.hpp"
+#include "tactile/core/layer/layer_types.hpp"
+#include "tactile/core/layer/tile_layer.hpp"
+
+namespace tactile::core {
+namespace {
+
+// Writes the runs in the given order, using either the old or new tiles.
+template <typename Runs, typename TileGetter>
+void _write_runs(Registry& registry,
+                 const EntityID layer_entity,
+                 const Runs& runs,
+                 const TileGetter& get_tile)
+{
+  TACTILE_ASSERT(is_tile_layer(registry, layer_entity));
+
+  // The layer may have been resized since the changes were recorded.
+  const auto& extent = registry.get<CTileLayer>(layer_entity).extent;
+
+  if (auto* dense = registry.find<CDenseTileLayer>(layer_entity)) {
+    for (const auto& run : runs) {
+      if (run.position.y >= extent.rows) {
+        continue;
+      }
+
+      const auto begin_col = std::min(run.position.x, extent.cols);
+      const auto end_col = std::min(run.position.x + run.length, extent.cols);
+
+      auto& row = dense->tiles[run.position.y];
+      std::fill(row.begin() + static_cast<std::ptrdiff_t>(begin_col),
+                row.begin() + static_cast<std::ptrdiff_t>(std::max(begin_col, end_col)),
+                get_tile(run));
+    }
+  }
+  else if (auto* sparse = registry.find<CSparseTileLayer>(layer_entity)) {
+    for (const auto& run : runs) {
+      if (run.position.y >= extent.rows) {
+        continue;
+      }
+
+      const auto tile_id = get_tile(run);
+      const auto end_col = std::min(run.position.x + run.length, extent.cols);
+
+      for (auto col = run.position.x; col < end_col; ++col) {
+        const Index2D index {.x = col, .y = run.position.y};
+
+        if (tile_id == kEmptyTile) {
+          sparse->tiles.erase(index);
+        }
+        else {
+          sparse->tiles.insert_or_assign(index, tile_id);
+        }
+      }
+    }
+  }
+  else {
+    throw Exception {"invalid tile layer"};
+  }
+}
+
+}  // namespace
+
+void TileDiff::record(const Index2D& position, const TileID old_tile, const TileID new_tile)
+{
+  if (old_tile == new_tile) {
+    return;
+  }
+
+  ++m_tile_count;
+
+  if (!m_runs.empty()) {
+    auto& last_run = m_runs.back();
+
+    if (last_run.position.y == position.y &&
+        last_run.position.x + last_run.length == position.x &&
+        last_run.old_tile == old_tile && last_run.new_tile == new_tile) {
+      ++last_run.length;
+      return;
+    }
+  }
+
+  m_runs.push_back(TileDiffRun {
+    .position = position,
+    .length = 1,
+    .old_tile = old_tile,
+    .new_tile = new_tile,
+  });
+}
+
+void TileDiff::append(const TileDiff& other)
+{
+  auto other_runs = other.get_runs();
+  if (other_runs.empty()) {
+    return;
+  }
+
+  // The first run of the other diff may continue the last run of this diff.
+  if (!m_runs.empty()) {
+    auto& last_run = m_runs.back();
+    const auto& first_run = other_runs.front();
+
+    if (last_run.position.y == first_run.position.y &&
+        last_run.position.x + last_run.length == first_run.position.x &&
+        last_run.old_tile == first_run.old_tile && last_run.new_tile == first_run.new_tile) {
+      last_run.length += first_run.length;
+      other_runs = other_runs.subspan(1);
+    }
+  }
+
+  m_runs.insert(m_runs.end(), other_runs.begin(), other_runs.end());
+  m_tile_count += other.m_tile_count;
+}
+
+void TileDiff::record_run(const TileDiffRun& run)
+{
+  if (run.length == 0 || run.old_tile == run.new_tile) {
+    return;
+  }
+
+  m_tile_count += run.length;
+
+  if (!m_runs.empty()) {
+    auto& last_run = m_runs.back();
+
+    if (last_run.position.y == run.position.y &&
+        last_run.position.x + last_run.length == run.position.x &&
+        last_run.old_tile == run.old_tile && last_run.new_tile == run.new_tile) {
+      last_run.length += run.length;
+      return;
+    }
+  }
+
+  m_runs.push_back(run);
+}
+
+void TileDiff::apply(Registry& registry, const EntityID layer_entity) const
+{
+  _write_runs(registry, layer_entity, m_runs, [](const TileDiffRun& run) {
+    return run.new_tile;
+  });
+}
+
+void TileDiff::revert(Registry& registry, const EntityID layer_entity) const
+{
+  // Reverting in reverse order restores the original tiles of repeatedly changed tiles.
+  const auto reversed_runs = m_runs | std::views::reverse;
+  _write_runs(registry, layer_entity, reversed_runs, [](const TileDiffRun& run) {
+    return run.old_tile;
+  });
+}
+
+auto TileDiff::make_inverse() const -> TileDiff
+{
+  TileDiff inverse {};
+  inverse.m_runs.reserve(m_runs.size());
+
+  for (const auto& run : m_runs | std::views::reverse) {
+    inverse.record_run(TileDiffRun {
+      .position = run.position,
+      .length = run.length,
+      .old_tile = run.new_tile,
+      .new_tile = run.old_tile,
+    });
+  }
+
+  return inverse;
+}
+
+void TileDiff::shrink_to_fit()
+{
+  m_runs.shrink_to_fit();
+}
+
+auto TileDiff::get_runs() const noexcept -> std::span<const TileDiffRun>
+{
+  return m_runs;
+}
+
+auto TileDiff::tile_count() const noexcept -> std::size_t
+{
+  return m_tile_count;
+}
+
+auto TileDiff::get_memory_usage() const noexcept -> std::size_t
+{
+  return m_runs.capacity() * sizeof(TileDiffRun);
+}
+
+auto TileDiff::empty() const noexcept -> bool
+{
+  return m_runs.empty();
+}
+
+}  // namespace tactile::core
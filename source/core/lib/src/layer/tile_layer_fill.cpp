@@ -0,0 +1,282 @@
+// Copyright (C) 2024 Albin Johansson (GNU General Public License v3.0)
+
+#include "tactile/core/layer/tile_layer_fill.hpp"
+
+#include <algorithm>  // min, max, fill
+#include <cstddef>    // size_t, ptrdiff_t
+
+#include "tactile/base/util/tile_matrix.hpp"
+#include "tactile/core/debug/assert.hpp"
+#include "tactile/core/debug/exception.hpp"
+#include "tactile/core/debug/profiler.hpp"
+#include "tactile/core/entity/registry.hpp"
+#include "tactile/core/layer/layer_types.hpp"
+#include "tactile/core/layer/tile_layer.hpp"
+
+namespace tactile::core {
+namespace {
+
+// Signed coordinates, since the fill algorithm probes positions outside of the bounds.
+using Coord = std::ptrdiff_t;
+
+struct FillBounds final
+{
+  Coord min_x;
+  Coord min_y;
+  Coord max_x;  // Exclusive.
+  Coord max_y;  // Exclusive.
+
+  [[nodiscard]]
+  auto contains(const Coord x, const Coord y) const noexcept -> bool
+  {
+    return x >= min_x && x < max_x && y >= min_y && y < max_y;
+  }
+};
+
+// A span of tiles to scan for tiles to replace, derived from an adjacent row.
+struct PendingSpan final
+{
+  Coord first_x;  // Inclusive.
+  Coord last_x;   // Inclusive.
+  Coord y;
+  Coord dy;  // The direction from the parent row to this row.
+};
+
+class DenseTileAccessor final
+{
+ public:
+  explicit DenseTileAccessor(TileMatrix& tiles) noexcept
+    : m_tiles {tiles}
+  {}
+
+  [[nodiscard]]
+  auto get(const Coord x, const Coord y) const -> TileID
+  {
+    return m_tiles[static_cast<std::size_t>(y)][static_cast<std::size_t>(x)];
+  }
+
+  void set(const Coord x, const Coord y, const TileID tile_id)
+  {
+    m_tiles[static_cast<std::size_t>(y)][static_cast<std::size_t>(x)] = tile_id;
+  }
+
+ private:
+  TileMatrix& m_tiles;
+};
+
+class SparseTileAccessor final
+{
+ public:
+  explicit SparseTileAccessor(SparseTileMatrix& tiles) noexcept
+    : m_tiles {tiles}
+  {}
+
+  [[nodiscard]]
+  auto get(const Coord x, const Coord y) const -> TileID
+  {
+    const auto iter = m_tiles.find(_to_index(x, y));
+    return iter != m_tiles.end() ? iter->second : kEmptyTile;
+  }
+
+  void set(const Coord x, const Coord y, const TileID tile_id)
+  {
+    if (tile_id == kEmptyTile) {
+      m_tiles.erase(_to_index(x, y));
+    }
+    else {
+      m_tiles.insert_or_assign(_to_index(x, y), tile_id);
+    }
+  }
+
+ private:
+  SparseTileMatrix& m_tiles;
+
+  [[nodiscard]]
+  static auto _to_index(const Coord x, const Coord y) noexcept -> Index2D
+  {
+    return Index2D {.x = static_cast<Index2D::value_type>(x),
+                    .y = static_cast<Index2D::value_type>(y)};
+  }
+};
+
+// See "A Seed Fill Algorithm" by Paul Heckbert (Graphics Gems, 1990), this is
+// the span filling variant that avoids rescanning the parent row.
+template <typename Accessor>
+[[nodiscard]]
+auto _flood_fill(Accessor& tiles,
+                 const FillBounds& bounds,
+                 const Coord origin_x,
+                 const Coord origin_y,
+                 const TileID replacement) -> std::vector<TileSpan>
+{
+  std::vector<TileSpan> changed_spans {};
+
+  const auto target = tiles.get(origin_x, origin_y);
+  if (target == replacement) {
+    return changed_spans;
+  }
+
+  // Replaced tiles no longer match the target, so no tile is visited twice.
+  const auto should_fill = [&](const Coord x, const Coord y) {
+    return bounds.contains(x, y) && tiles.get(x, y) == target;
+  };
+
+  std::vector<PendingSpan> stack {};
+  stack.reserve(64);
+
+  stack.push_back(PendingSpan {origin_x, origin_x, origin_y, 1});
+  stack.push_back(PendingSpan {origin_x, origin_x, origin_y - 1, -1});
+
+  while (!stack.empty()) {
+    auto [x1, x2, y, dy] = stack.back();
+    stack.pop_back();
+
+    if (y < bounds.min_y || y >= bounds.max_y) {
+      continue;
+    }
+
+    auto x = x1;
+
+    // Extends the span to the left, which may leak around a corner of the parent row.
+    if (should_fill(x, y)) {
+      while (should_fill(x - 1, y)) {
+        tiles.set(x - 1, y, replacement);
+        --x;
+      }
+
+      if (x < x1) {
+        stack.push_back(PendingSpan {x, x1 - 1, y - dy, -dy});
+      }
+    }
+
+    while (x1 <= x2) {
+      while (should_fill(x1, y)) {
+        tiles.set(x1, y, replacement);
+        ++x1;
+      }
+
+      if (x1 > x) {
+        stack.push_back(PendingSpan {x, x1 - 1, y + dy, dy});
+        changed_spans.push_back(TileSpan {
+          .row = static_cast<Index2D::value_type>(y),
+          .begin_col = static_cast<Index2D::value_type>(x),
+          .end_col = static_cast<Index2D::value_type>(x1),
+        });
+      }
+
+      // Extends past the end of the parent span, which may leak around a corner.
+      if (x1 - 1 > x2) {
+        stack.push_back(PendingSpan {x2 + 1, x1 - 1, y - dy, -dy});
+      }
+
+      ++x1;
+      while (x1 < x2 && !should_fill(x1, y)) {
+        ++x1;
+      }
+
+      x = x1;
+    }
+  }
+
+  return changed_spans;
+}
+
+}  // namespace
+
+auto flood_fill_tile_layer(Registry& registry,
+                           const EntityID layer_entity,
+                           const Index2D& origin,
+                           const TileID replacement) -> std::vector<TileSpan>
+{
+  TACTILE_ASSERT(is_tile_layer(registry, layer_entity));
+  const auto& tile_layer = registry.get<CTileLayer>(layer_entity);
+
+  const TileRegion region {
+    .begin = Index2D {.x = 0, .y = 0},
+    .end = Index2D {.x = tile_layer.extent.cols, .y = tile_layer.extent.rows},
+  };
+
+  return flood_fill_tile_layer(registry, layer_entity, origin, replacement, region);
+}
+
+auto flood_fill_tile_layer(Registry& registry,
+                           const EntityID layer_entity,
+                           const Index2D& origin,
+                           const TileID replacement,
+                           const TileRegion& region) -> std::vector<TileSpan>
+{
+  TACTILE_PROFILE_ZONE("flood_fill_tile_layer");
+  TACTILE_ASSERT(is_tile_layer(registry, layer_entity));
+
+  const auto& tile_layer = registry.get<CTileLayer>(layer_entity);
+
+  const FillBounds bounds {
+    .min_x = static_cast<Coord>(region.begin.x),
+    .min_y = static_cast<Coord>(region.begin.y),
+    .max_x = static_cast<Coord>(std::min(region.end.x, tile_layer.extent.cols)),
+    .max_y = static_cast<Coord>(std::min(region.end.y, tile_layer.extent.rows)),
+  };
+
+  const auto origin_x = static_cast<Coord>(origin.x);
+  const auto origin_y = static_cast<Coord>(origin.y);
+
+  if (!bounds.contains(origin_x, origin_y)) {
+    return {};
+  }
+
+  if (auto* dense = registry.find<CDenseTileLayer>(layer_entity)) {
+    DenseTileAccessor tiles {dense->tiles};
+    return _flood_fill(tiles, bounds, origin_x, origin_y, replacement);
+  }
+
+  if (auto* sparse = registry.find<CSparseTileLayer>(layer_entity)) {
+    SparseTileAccessor tiles {sparse->tiles};
+    return _flood_fill(tiles, bounds, origin_x, origin_y, replacement);
+  }
+
+  throw Exception {"invalid tile layer"};
+}
+
+void set_layer_tile_spans(Registry& registry,
+                          const EntityID layer_entity,
+                          const std::span<const TileSpan> spans,
+                          const TileID tile_id)
+{
+  TACTILE_ASSERT(is_tile_layer(registry, layer_entity));
+  const auto& extent = registry.get<CTileLayer>(layer_entity).extent;
+
+  if (auto* dense = registry.find<CDenseTileLayer>(layer_entity)) {
+    for (const auto& span : spans) {
+      if (span.row >= extent.rows) {
+        continue;
+      }
+
+      auto& row = dense->tiles[span.row];
+      const auto begin_col = std::min(span.begin_col, extent.cols);
+      const auto end_col = std::min(span.end_col, extent.cols);
+
+      std::fill(row.begin() + static_cast<std::ptrdiff_t>(begin_col),
+                row.begin() + static_cast<std::ptrdiff_t>(std::max(begin_col, end_col)),
+                tile_id);
+    }
+  }
+  else if (auto* sparse = registry.find<CSparseTileLayer>(layer_entity)) {
+    SparseTileAccessor tiles {sparse->tiles};
+
+    for (const auto& span : spans) {
+      if (span.row >= extent.rows) {
+        continue;
+      }
+
+      const auto end_col = std::min(span.end_col, extent.cols);
+      for (auto col = span.begin_col; col < end_col; ++col) {
+        tiles.set(static_cast<Coord>(col), static_cast<Coord>(span.row), tile_id);
+      }
+    }
+  }
+  else {
+    throw Exception {"invalid tile layer"};
+  }
+}
+
+}  // namespace tactile::core
@@ -3,11 +3,14 @@
 #include "tactile/core/log/terminal_log_sink.hpp"
 
 #include <iostream>  // cout
+#include <mutex>     // scoped_lock
 
 namespace tactile::core {
 
 void TerminalLogSink::log(const LogMessage& msg)
 {
+  const std::scoped_lock lock {mMutex};
+
   if (mUseAnsiColors) {
     const auto fg_color = get_fg_ansi_color(msg.level);
     std::cout << fg_color;
@@ -30,6 +33,7 @@ void TerminalLogSink::log(const LogMessage& msg)
 
 void TerminalLogSink::flush()
 {
+  const std::scoped_lock lock {mMutex};
   std::cout.flush();
 }
 
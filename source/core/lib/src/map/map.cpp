@@ -2,10 +2,15 @@
 
 #include "tactile/core/map/map.hpp"
 
+#include <cstddef>  // size_t
+#include <utility>  // move
+#include <vector>   // vector
+
 #include "tactile/base/io/save/ir.hpp"
 #include "tactile/base/numeric/saturate_cast.hpp"
 #include "tactile/core/debug/assert.hpp"
 #include "tactile/core/entity/registry.hpp"
+#include "tactile/core/io/texture_cache.hpp"
 #include "tactile/core/layer/group_layer.hpp"
 #include "tactile/core/layer/layer.hpp"
 #include "tactile/core/layer/layer_common.hpp"
@@ -76,8 +81,10 @@ auto make_map(Registry& registry, const MapSpec& spec) -> EntityID
   return map_entity;
 }
 
-auto make_map(Registry& registry, IRenderer& renderer, const ir::Map& ir_map)
-    -> std::expected<EntityID, ErrorCode>
+auto make_map(Registry& registry,
+              TextureCache& texture_cache,
+              const ir::Map& ir_map,
+              const TextureLoadMode load_mode) -> std::expected<EntityID, ErrorCode>
 {
   const auto map_id = registry.make_entity();
 
@@ -114,9 +121,20 @@ auto make_map(Registry& registry, IRenderer& renderer, const ir::Map& ir_map)
 
   // TODO components
 
-  map.attached_tilesets.reserve(ir_map.tilesets.size());
+  // Decode all tileset images concurrently, only the texture uploads are sequential.
+  std::vector<PendingTexture> pending_textures {};
+  pending_textures.reserve(ir_map.tilesets.size());
   for (const auto& ir_tileset_ref : ir_map.tilesets) {
-    const auto tileset_id = make_tileset(registry, renderer, ir_tileset_ref);
+    pending_textures.push_back(texture_cache.acquire_async(ir_tileset_ref.tileset.image_path));
+  }
+
+  map.attached_tilesets.reserve(ir_map.tilesets.size());
+  for (std::size_t index = 0; index < ir_map.tilesets.size(); ++index) {
+    const auto tileset_id = make_tileset(registry,
+                                         texture_cache,
+                                         ir_map.tilesets[index],
+                                         std::move(pending_textures[index]),
+                                         load_mode);
 
     if (!tileset_id.has_value()) {
       return std::unexpected {tileset_id.error()};
@@ -174,7 +192,7 @@ auto add_tileset_to_map(Registry& registry,
   }
 
   const auto& tileset = registry.get<CTileset>(*tileset_id);
-  id_cache.next_tile_id += saturate_cast<TileID>(tileset.tiles.size());
+  id_cache.next_tile_id += saturate_cast<TileID>(tileset.tile_count);
 
   map.attached_tilesets.push_back(*tileset_id);
   map.active_tileset = *tileset_id;
@@ -12,6 +12,9 @@ Model::Model(Settings* settings, const ui::Language* language)
     mLanguage {require_not_null(language, "null language")}
 {
   mDocuments.set_command_capacity(mSettings->command_capacity);
+  mDocuments.set_command_memory_budget(mSettings->command_memory_budget);
+  mDocuments.set_undo_spill_threshold(mSettings->undo_spill_threshold);
+  mDocuments.set_tile_animation_sync(mSettings->sync_tile_animations);
 }
 
 auto Model::get_document_manager() -> DocumentManager&
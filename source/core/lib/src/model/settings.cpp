@@ -9,8 +9,12 @@ namespace {
 
 inline constexpr auto kLanguageDefault = ui::LanguageID::kAmericanEnglish;
 inline constexpr auto kCommandCapacityDefault = std::size_t {100};
+inline constexpr auto kCommandMemoryBudgetDefault = std::size_t {256} * 1'024 * 1'024;
+inline constexpr auto kUndoSpillThresholdDefault = std::size_t {64} * 1'024 * 1'024;
+inline constexpr auto kUndoJournalBudgetDefault = std::size_t {16} * 1'024 * 1'024;
 inline constexpr auto kFontDefault = ui::FontID::kDefault;
 inline constexpr auto kFontSizeDefault = 13.0f;
+inline constexpr auto kSyncTileAnimationsDefault = false;
 inline constexpr auto kLogVerboseEventsDefault = false;
 
 }  // namespace
@@ -20,8 +24,12 @@ auto get_default_settings() -> Settings
   return Settings {
     .language = kLanguageDefault,
     .command_capacity = kCommandCapacityDefault,
+    .command_memory_budget = kCommandMemoryBudgetDefault,
+    .undo_spill_threshold = kUndoSpillThresholdDefault,
+    .undo_journal_budget = kUndoJournalBudgetDefault,
     .font = kFontDefault,
     .font_size = kFontSizeDefault,
+    .sync_tile_animations = kSyncTileAnimationsDefault,
     .log_verbose_events = kLogVerboseEventsDefault,
   };
 }
@@ -11,6 +11,7 @@ namespace {
 
 inline constexpr const char* kMapPatternDescriptor = "Map files";
 inline constexpr const char* kImagePatternDescriptor = "Image files";
+inline constexpr const char* kTracePatternDescriptor = "Trace files";
 
 inline constexpr std::array kMapPatterns {
   "*.yaml",
@@ -27,6 +28,10 @@ inline constexpr std::array kImagePatterns {
   "*.jpeg",
 };
 
+inline constexpr std::array kTracePatterns {
+  "*.json",
+};
+
 }  // namespace
 
 auto FileDialog::open_folder() -> std::optional<std::filesystem::path>
@@ -102,4 +107,17 @@ auto FileDialog::save_image() -> std::optional<std::filesystem::path>
   return std::nullopt;
 }
 
+auto FileDialog::save_trace() -> std::optional<std::filesystem::path>
+{
+  if (const auto* path = tinyfd_saveFileDialog("Save Trace",
+                                               "trace.json",
+                                               std::ssize(kTracePatterns),
+                                               kTracePatterns.data(),
+                                               kTracePatternDescriptor)) {
+    return path;
+  }
+
+  return std::nullopt;
+}
+
 }  // namespace tactile::core
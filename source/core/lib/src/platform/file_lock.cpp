@@ -0,0 +1,112 @@
+// Copyright (C) 2024 Albin Johansson (GNU General Public License v3.0)
+
+#include "tactile/core/platform/file_lock.hpp"
+
+#include <utility>  // exchange
+
+#if TACTILE_OS_LINUX || TACTILE_OS_APPLE
+  #include <cerrno>      // errno, EWOULDBLOCK
+  #include <fcntl.h>     // open, O_RDWR, O_CREAT, O_CLOEXEC
+  #include <sys/file.h>  // flock, LOCK_EX, LOCK_NB
+  #include <unistd.h>    // close
+#endif
+
+#if TACTILE_OS_WINDOWS
+  #include <windows.h>
+#endif
+
+namespace tactile::core {
+
+#if TACTILE_OS_LINUX || TACTILE_OS_APPLE
+
+auto FileLock::try_lock(const std::filesystem::path& path)
+    -> std::expected<FileLock, ErrorCode>
+{
+  const auto fd = ::open(path.c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0644);
+  if (fd == -1) {
+    return std::unexpected {ErrorCode::kBadFileStream};
+  }
+
+  if (flock(fd, LOCK_EX | LOCK_NB) != 0) {
+    const auto is_locked = errno == EWOULDBLOCK;
+    close(fd);
+    return std::unexpected {is_locked ? ErrorCode::kBadState : ErrorCode::kBadFileStream};
+  }
+
+  return FileLock {static_cast<std::intptr_t>(fd)};
+}
+
+void FileLock::unlock() noexcept
+{
+  if (mHandle != kInvalidHandle) {
+    // Closing the file descriptor releases the lock.
+    close(static_cast<int>(mHandle));
+    mHandle = kInvalidHandle;
+  }
+}
+
+#elif TACTILE_OS_WINDOWS
+
+auto FileLock::try_lock(const std::filesystem::path& path)
+    -> std::expected<FileLock, ErrorCode>
+{
+  // Files opened without sharing can't be opened by other processes until closed.
+  HANDLE file = CreateFileW(path.c_str(),
+                            GENERIC_READ | GENERIC_WRITE,
+                            0,
+                            nullptr,
+                            OPEN_ALWAYS,
+                            FILE_ATTRIBUTE_NORMAL,
+                            nullptr);
+  if (file == INVALID_HANDLE_VALUE) {  // NOLINT
+    const auto is_locked = GetLastError() == ERROR_SHARING_VIOLATION;
+    return std::unexpected {is_locked ? ErrorCode::kBadState : ErrorCode::kBadFileStream};
+  }
+
+  return FileLock {reinterpret_cast<std::intptr_t>(file)};
+}
+
+void FileLock::unlock() noexcept
+{
+  if (mHandle != kInvalidHandle) {
+    CloseHandle(reinterpret_cast<HANDLE>(mHandle));
+    mHandle = kInvalidHandle;
+  }
+}
+
+#else
+
+auto FileLock::try_lock(const std::filesystem::path&) -> std::expected<FileLock, ErrorCode>
+{
+  return std::unexpected {ErrorCode::kNotSupported};
+}
+
+void FileLock::unlock() noexcept
+{}
+
+#endif
+
+FileLock::FileLock(const std::intptr_t handle) noexcept
+  : mHandle {handle}
+{}
+
+FileLock::FileLock(FileLock&& other) noexcept
+  : mHandle {std::exchange(other.mHandle, kInvalidHandle)}
+{}
+
+auto FileLock::operator=(FileLock&& other) noexcept -> FileLock&
+{
+  if (this != &other) {
+    unlock();
+    mHandle = std::exchange(other.mHandle, kInvalidHandle);
+  }
+
+  return *this;
+}
+
+FileLock::~FileLock() noexcept
+{
+  unlock();
+}
+
+}  // namespace tactile::core
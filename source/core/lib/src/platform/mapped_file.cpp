@@ -0,0 +1,162 @@
+// Copyright (C) 2024 Albin Johansson (GNU General Public License v3.0)
+
+#include "tactile/core/platform/mapped_file.hpp"
+
+#include <utility>  // exchange
+
+#if TACTILE_OS_LINUX || TACTILE_OS_APPLE
+  #include <fcntl.h>     // open, O_RDONLY
+  #include <sys/mman.h>  // mmap, munmap
+  #include <sys/stat.h>  // fstat
+  #include <unistd.h>    // close
+#endif
+
+#if TACTILE_OS_WINDOWS
+  #include <windows.h>
+#endif
+
+namespace tactile::core {
+
+#if TACTILE_OS_LINUX || TACTILE_OS_APPLE
+
+auto MappedFile::open(const std::filesystem::path& path)
+    -> std::expected<MappedFile, ErrorCode>
+{
+  const auto fd = ::open(path.c_str(), O_RDONLY);
+  if (fd == -1) {
+    return std::unexpected {ErrorCode::kNoSuchFile};
+  }
+
+  struct stat file_info {};
+  if (fstat(fd, &file_info) != 0) {
+    close(fd);
+    return std::unexpected {ErrorCode::kBadFileStream};
+  }
+
+  const auto size = static_cast<std::size_t>(file_info.st_size);
+  if (size == 0) {
+    close(fd);
+    return MappedFile {nullptr, 0};
+  }
+
+  auto* data = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+
+  // The mapping remains valid after the file descriptor is closed.
+  close(fd);
+
+  if (data == MAP_FAILED) {
+    return std::unexpected {ErrorCode::kBadFileStream};
+  }
+
+  return MappedFile {static_cast<const std::uint8_t*>(data), size};
+}
+
+void MappedFile::_unmap() noexcept
+{
+  if (mData) {
+    munmap(const_cast<std::uint8_t*>(mData), mSize);
+    mData = nullptr;
+    mSize = 0;
+  }
+}
+
+#elif TACTILE_OS_WINDOWS
+
+auto MappedFile::open(const std::filesystem::path& path)
+    -> std::expected<MappedFile, ErrorCode>
+{
+  HANDLE file = CreateFileW(path.c_str(),
+                            GENERIC_READ,
+                            FILE_SHARE_READ,
+                            nullptr,
+                            OPEN_EXISTING,
+                            FILE_ATTRIBUTE_NORMAL,
+                            nullptr);
+  if (file == INVALID_HANDLE_VALUE) {  // NOLINT
+    return std::unexpected {ErrorCode::kNoSuchFile};
+  }
+
+  LARGE_INTEGER file_size {};
+  if (!GetFileSizeEx(file, &file_size)) {
+    CloseHandle(file);
+    return std::unexpected {ErrorCode::kBadFileStream};
+  }
+
+  const auto size = static_cast<std::size_t>(file_size.QuadPart);
+  if (size == 0) {
+    CloseHandle(file);
+    return MappedFile {nullptr, 0};
+  }
+
+  HANDLE mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+  CloseHandle(file);
+
+  if (!mapping) {
+    return std::unexpected {ErrorCode::kBadFileStream};
+  }
+
+  // The view remains valid after the mapping handle is closed.
+  const auto* data = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+  CloseHandle(mapping);
+
+  if (!data) {
+    return std::unexpected {ErrorCode::kBadFileStream};
+  }
+
+  return MappedFile {static_cast<const std::uint8_t*>(data), size};
+}
+
+void MappedFile::_unmap() noexcept
+{
+  if (mData) {
+    UnmapViewOfFile(mData);
+    mData = nullptr;
+    mSize = 0;
+  }
+}
+
+#else
+
+auto MappedFile::open(const std::filesystem::path&) -> std::expected<MappedFile, ErrorCode>
+{
+  return std::unexpected {ErrorCode::kNotSupported};
+}
+
+void MappedFile::_unmap() noexcept
+{}
+
+#endif
+
+MappedFile::MappedFile(const std::uint8_t* data, const std::size_t size) noexcept
+  : mData {data},
+    mSize {size}
+{}
+
+MappedFile::MappedFile(MappedFile&& other) noexcept
+  : mData {std::exchange(other.mData, nullptr)},
+    mSize {std::exchange(other.mSize, 0)}
+{}
+
+auto MappedFile::operator=(MappedFile&& other) noexcept -> MappedFile&
+{
+  if (this != &other) {
+    _unmap();
+
+    mData = std::exchange(other.mData, nullptr);
+    mSize = std::exchange(other.mSize, 0);
+  }
+
+  return *this;
+}
+
+MappedFile::~MappedFile() noexcept
+{
+  _unmap();
+}
+
+auto MappedFile::get_bytes() const noexcept -> std::span<const std::uint8_t>
+{
+  return {mData, mSize};
+}
+
+}  // namespace tactile::core
@@ -2,16 +2,22 @@
 
 #include "tactile/core/tactile_app.hpp"
 
-#include <utility>  // move
+#include <filesystem>  // path
+#include <optional>    // optional
+#include <utility>     // move
 
 #include <imgui.h>
 
+#include "tactile/base/io/compress/compression_format_id.hpp"
 #include "tactile/base/render/renderer.hpp"
 #include "tactile/base/render/window.hpp"
 #include "tactile/base/runtime/runtime.hpp"
+#include "tactile/core/cmd/undo_payload_store.hpp"
+#include "tactile/core/debug/profiler.hpp"
 #include "tactile/core/debug/validation.hpp"
 #include "tactile/core/event/events.hpp"
 #include "tactile/core/log/logger.hpp"
+#include "tactile/core/platform/filesystem.hpp"
 #include "tactile/core/ui/common/style.hpp"
 #include "tactile/core/ui/i18n/language_parser.hpp"
 
@@ -23,7 +29,9 @@ TactileApp::TactileApp(IRuntime* runtime)
     m_renderer {require_not_null(runtime->get_renderer(), "null renderer")},
     m_settings {},
     m_language {},
+    m_texture_cache {},
     m_model {},
+    m_map_saver {},
     m_widget_manager {},
     m_event_dispatcher {},
     m_file_event_handler {},
@@ -35,7 +43,8 @@ TactileApp::TactileApp(IRuntime* runtime)
     m_object_event_handler {},
     m_component_event_handler {},
     m_property_event_handler {},
-    m_viewport_event_handler {}
+    m_viewport_event_handler {},
+    m_recovery_manager {}
 {}
 
 TactileApp::~TactileApp() noexcept = default;
@@ -62,15 +71,34 @@ void TactileApp::on_startup()
     throw Exception {"could not parse language file"};
   }
 
+  // Decoded images are cached in the persistent storage directory, not next to the
+  // source images, since the cache files can be much larger than the source images.
+  std::optional<std::filesystem::path> image_cache_dir {};
+  if (const auto storage_dir = get_persistent_storage_directory()) {
+    image_cache_dir = *storage_dir / "image_cache";
+  }
+
+  // Spilled undo data can't be used once the owning editor instance has exited.
+  remove_stale_undo_spill_directories();
+
+  auto& texture_cache = m_texture_cache.emplace(m_renderer, std::move(image_cache_dir));
   auto& model = m_model.emplace(&m_settings, &m_language.value());
 
-  auto& file_event_handler = m_file_event_handler.emplace(&model, m_runtime);
+  // Large undo snapshots use the registered Zstd codec if available, which is fast
+  // enough to not be noticeable. Otherwise, a built-in codec is used.
+  model.get_document_manager().set_undo_compression_format(
+      m_runtime->get_compression_format(CompressionFormatId::kZstd));
+
+  auto& map_saver = m_map_saver.emplace(m_runtime);
+
+  auto& file_event_handler = m_file_event_handler.emplace(&model, m_runtime, &map_saver);
   auto& edit_event_handler = m_edit_event_handler.emplace(&model);
   auto& view_event_handler =
       m_view_event_handler.emplace(&model, m_renderer, &m_widget_manager);
   auto& tileset_event_handler =
-      m_tileset_event_handler.emplace(&model, m_renderer, &m_widget_manager);
-  auto& map_event_handler = m_map_event_handler.emplace(&model, &m_widget_manager, m_runtime);
+      m_tileset_event_handler.emplace(&model, &texture_cache, &m_widget_manager);
+  auto& map_event_handler =
+      m_map_event_handler.emplace(&model, &m_widget_manager, m_runtime, &texture_cache);
   auto& layer_event_handler = m_layer_event_handler.emplace(&model);
   auto& object_event_handler = m_object_event_handler.emplace(&model);
   auto& component_event_handler = m_component_event_handler.emplace(&model, &m_widget_manager);
@@ -87,20 +115,54 @@ void TactileApp::on_startup()
   component_event_handler.install(m_event_dispatcher);
   property_event_handler.install(m_event_dispatcher);
   viewport_event_handler.install(m_event_dispatcher);
+
+  auto& recovery_manager =
+      m_recovery_manager.emplace(&model, m_runtime, &texture_cache, &map_saver);
+  if (const auto recovered_count = recovery_manager.recover_documents(); recovered_count > 0) {
+    TACTILE_LOG_INFO("Recovered {} document(s) from a previous session", recovered_count);
+  }
 }
 
 void TactileApp::on_shutdown()
 {
   m_window->hide();
+
+  // Jobs may still be writing files, e.g., exported Godot scenes.
+  m_event_dispatcher.wait_for_jobs();
+
+  // The journals are kept until pending saves have finished, in case they crash.
+  if (m_map_saver.has_value()) {
+    m_map_saver->wait();
+  }
+
+  // Journals are only kept if the editor doesn't exit normally.
+  if (m_recovery_manager.has_value()) {
+    m_recovery_manager->discard_journals();
+  }
 }
 
 void TactileApp::on_update()
 {
+  TACTILE_PROFILE_ZONE("TactileApp::on_update");
+
   m_event_dispatcher.update();
+
+  auto& document_manager = m_model->get_document_manager();
+  for (const auto& document_uuid : document_manager.get_open_documents()) {
+    document_manager.get_document(document_uuid).update();
+  }
+
+  m_recovery_manager->update(m_event_dispatcher);
+
+  // Finished saves are reported after the recovery journals have been updated,
+  // so that failed saves are handled before the journals are based on them.
+  m_map_saver->update(m_event_dispatcher);
 }
 
 void TactileApp::on_render()
 {
+  TACTILE_PROFILE_ZONE("TactileApp::on_render");
+
   m_widget_manager.push(*m_model, m_event_dispatcher);
 }
 
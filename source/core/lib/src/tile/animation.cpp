@@ -2,37 +2,218 @@
 
 #include "tactile/core/tile/animation.hpp"
 
+#include <algorithm>   // push_heap, pop_heap, upper_bound
+#include <functional>  // greater
+#include <iterator>    // distance
+
 #include "tactile/base/numeric/saturate_cast.hpp"
 #include "tactile/core/debug/assert.hpp"
 #include "tactile/core/entity/registry.hpp"
 #include "tactile/core/tile/animation_types.hpp"
 #include "tactile/core/tile/tile.hpp"
+#include "tactile/core/tile/tileset_types.hpp"
 
 namespace tactile::core {
 namespace {
 
-void _reset_animation(CAnimation& animation)
+[[nodiscard]]
+auto _get_due_time(const CAnimation& animation) -> std::chrono::steady_clock::time_point
+{
+  return animation.last_update + animation.frames.at(animation.frame_index).duration;
+}
+
+void _schedule_animation(CAnimationSchedule& schedule,
+                         const EntityID tile_entity,
+                         const CAnimation& animation)
+{
+  schedule.queue.push_back(AnimationScheduleEntry {
+    .due_time = _get_due_time(animation),
+    .tile_entity = tile_entity,
+  });
+
+  std::ranges::push_heap(schedule.queue, std::greater {}, &AnimationScheduleEntry::due_time);
+}
+
+void _update_frame_end_times(CAnimation& animation)
+{
+  animation.frame_end_times.clear();
+  animation.frame_end_times.reserve(animation.frames.size());
+
+  std::chrono::milliseconds end_time {0};
+  for (const auto& frame : animation.frames) {
+    end_time += frame.duration;
+    animation.frame_end_times.push_back(end_time);
+  }
+}
+
+void _reset_animation(Registry& registry, const EntityID tile_entity, CAnimation& animation)
 {
+  _update_frame_end_times(animation);
+
   animation.last_update = std::chrono::steady_clock::now();
   animation.frame_index = 0;
+
+  auto* schedule = registry.find<CAnimationSchedule>();
+  if (!schedule) {
+    schedule = &registry.add<CAnimationSchedule>();
+  }
+
+  // Any previous entry for the animation becomes stale, since the due time changes.
+  _schedule_animation(*schedule, tile_entity, animation);
+}
+
+void _invalidate_tile_cache(Registry& registry)
+{
+  // Tiles in tileset documents aren't tracked by a tile cache.
+  if (auto* tile_cache = registry.find<CTileCache>()) {
+    ++tile_cache->version;
+  }
 }
 
 }  // namespace
 
 void update_animations(Registry& registry)
 {
+  if (auto* clock = registry.find<CAnimationClock>()) {
+    if (!clock->paused) {
+      const auto elapsed = std::chrono::steady_clock::now() - clock->epoch;
+      clock->time = std::chrono::duration_cast<std::chrono::milliseconds>(elapsed);
+    }
+
+    return;
+  }
+
+  auto* schedule = registry.find<CAnimationSchedule>();
+  if (!schedule) {
+    return;
+  }
+
   const auto now = std::chrono::steady_clock::now();
 
-  for (auto [entity, animation] : registry.each<CAnimation>()) {
-    const auto& current_frame = animation.frames.at(animation.frame_index);
+  auto& queue = schedule->queue;
+  schedule->changed_tiles.clear();
 
-    if ((now - animation.last_update) >= current_frame.duration) {
-      const auto next_index = (animation.frame_index + 1) % animation.frames.size();
+  while (!queue.empty() && queue.front().due_time <= now) {
+    std::ranges::pop_heap(queue, std::greater {}, &AnimationScheduleEntry::due_time);
+    const auto entry = queue.back();
+    queue.pop_back();
 
-      animation.last_update = now;
-      animation.frame_index = next_index;
+    auto* animation = registry.find<CAnimation>(entry.tile_entity);
+    if (!animation || _get_due_time(*animation) != entry.due_time) {
+      continue;
     }
+
+    animation->frame_index = (animation->frame_index + 1) % animation->frames.size();
+    animation->last_update = now;
+
+    schedule->changed_tiles.push_back(entry.tile_entity);
   }
+
+  // Rescheduling is deferred, since frames without duration would otherwise be due again.
+  for (const auto tile_entity : schedule->changed_tiles) {
+    _schedule_animation(*schedule, tile_entity, registry.get<CAnimation>(tile_entity));
+  }
+
+  if (!schedule->changed_tiles.empty()) {
+    ++schedule->version;
+  }
+}
+
+void enable_animation_clock(Registry& registry)
+{
+  if (registry.has<CAnimationClock>()) {
+    return;
+  }
+
+  registry.add<CAnimationClock>(std::chrono::steady_clock::now(),
+                                std::chrono::milliseconds::zero(),
+                                false);
+
+  // Cached tile appearances are based on the per-tile animation state.
+  _invalidate_tile_cache(registry);
+}
+
+void disable_animation_clock(Registry& registry)
+{
+  if (!registry.has<CAnimationClock>()) {
+    return;
+  }
+
+  registry.erase<CAnimationClock>();
+
+  // Cached tile appearances are based on the clock time.
+  _invalidate_tile_cache(registry);
+}
+
+void set_animation_clock_time(Registry& registry, const std::chrono::milliseconds time)
+{
+  auto& clock = registry.get<CAnimationClock>();
+  clock.epoch = std::chrono::steady_clock::now() - time;
+  clock.time = time;
+}
+
+void pause_animation_clock(Registry& registry, const bool paused)
+{
+  auto& clock = registry.get<CAnimationClock>();
+
+  if (clock.paused && !paused) {
+    // Resumes from the time at which the clock was stopped.
+    clock.epoch = std::chrono::steady_clock::now() - clock.time;
+  }
+
+  clock.paused = paused;
+}
+
+auto get_animation_frame_index(const CAnimation& animation,
+                               const std::chrono::milliseconds clock_time) -> std::size_t
+{
+  TACTILE_ASSERT(animation.frame_end_times.size() == animation.frames.size());
+
+  if (animation.frame_end_times.empty()) {
+    return 0;
+  }
+
+  const auto total_duration = animation.frame_end_times.back();
+  if (total_duration <= std::chrono::milliseconds::zero()) {
+    return 0;
+  }
+
+  const auto animation_time = clock_time % total_duration;
+
+  // The current frame is the first one that ends after the animation time.
+  const auto iter = std::ranges::upper_bound(animation.frame_end_times, animation_time);
+  return static_cast<std::size_t>(std::distance(animation.frame_end_times.begin(), iter));
+}
+
+auto get_next_animation_frame_time(const CAnimation& animation,
+                                   const std::chrono::milliseconds clock_time)
+    -> std::optional<std::chrono::milliseconds>
+{
+  TACTILE_ASSERT(animation.frame_end_times.size() == animation.frames.size());
+
+  if (animation.frame_end_times.empty()) {
+    return std::nullopt;
+  }
+
+  const auto total_duration = animation.frame_end_times.back();
+  if (total_duration <= std::chrono::milliseconds::zero()) {
+    return std::nullopt;
+  }
+
+  const auto cycle_start = clock_time - clock_time % total_duration;
+  const auto frame_index = get_animation_frame_index(animation, clock_time);
+
+  return cycle_start + animation.frame_end_times[frame_index];
+}
+
+auto get_current_animation_frame_index(const Registry& registry, const CAnimation& animation)
+    -> std::size_t
+{
+  if (const auto* clock = registry.find<CAnimationClock>()) {
+    return get_animation_frame_index(animation, clock->time);
+  }
+
+  return animation.frame_index;
 }
 
 auto add_animation_frame(Registry& registry,
@@ -65,7 +246,8 @@ auto add_animation_frame(Registry& registry,
     return std::unexpected {ErrorCode::kBadParam};
   }
 
-  _reset_animation(animation);
+  _reset_animation(registry, tile_entity, animation);
+  _invalidate_tile_cache(registry);
 
   return {};
 }
@@ -90,9 +272,11 @@ auto remove_animation_frame(Registry& registry,
     registry.erase<CAnimation>(tile_entity);
   }
   else {
-    _reset_animation(animation);
+    _reset_animation(registry, tile_entity, animation);
   }
 
+  _invalidate_tile_cache(registry);
+
   return {};
 }
 
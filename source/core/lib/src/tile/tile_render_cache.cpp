@@ -0,0 +1,306 @@
+// Copyright (C) 2024 Albin Johansson (GNU General Public License v3.0)
+
+#include "tactile/core/tile/tile_render_cache.hpp"
+
+#include <algorithm>   // push_heap, pop_heap, upper_bound
+#include <functional>  // greater, less
+#include <iterator>    // prev
+
+#include "tactile/base/numeric/index_2d.hpp"
+#include "tactile/base/numeric/saturate_cast.hpp"
+#include "tactile/core/debug/assert.hpp"
+#include "tactile/core/entity/registry.hpp"
+#include "tactile/core/io/texture.hpp"
+#include "tactile/core/io/texture_cache.hpp"
+#include "tactile/core/log/logger.hpp"
+#include "tactile/core/tile/animation.hpp"
+#include "tactile/core/tile/animation_types.hpp"
+#include "tactile/core/tile/tileset_types.hpp"
+
+namespace tactile::core {
+namespace {
+
+[[nodiscard]]
+auto _get_uv_pos(const TileIndex tile_index,
+                 const Extent2D::value_type tileset_columns,
+                 const Float2& uv_tile_size) -> Float2
+{
+  const auto position_in_tileset =
+      Index2D::from_1d(static_cast<Extent2D::value_type>(tile_index), tileset_columns);
+  return to_float2(position_in_tileset) * uv_tile_size;
+}
+
+void _add_tileset(const Registry& registry,
+                  CTileRenderCache& render_cache,
+                  const EntityID tileset_id,
+                  const TileRange& tile_range)
+{
+  const auto& tileset = registry.get<CTileset>(tileset_id);
+  const auto& texture = registry.get<CTexture>(tileset_id);
+
+  // The entries are indexed relative to the first tile identifier, so that tilesets with
+  // large tile identifiers don't affect the size of the table.
+  const auto first_index = render_cache.tiles.size();
+  render_cache.ranges.push_back(TileRenderRange {
+    .tile_range = tile_range,
+    .first_index = first_index,
+  });
+
+  // Tilesets with pending textures are rendered using solid colors until loaded.
+  const auto* pending_texture = registry.find<CPendingTexture>(tileset_id);
+  const auto placeholder_color =
+      pending_texture ? pending_texture->placeholder_color : UColor {0, 0, 0, 0};
+
+  render_cache.tiles.reserve(first_index + saturate_cast<std::size_t>(tile_range.count));
+  for (TileIndex tile_index = 0; tile_index < tile_range.count; ++tile_index) {
+    render_cache.tiles.push_back(TileRenderInfo {
+      .texture_handle = texture.raw_handle,
+      .uv_pos = _get_uv_pos(tile_index, tileset.extent.cols, tileset.uv_tile_size),
+      .uv_size = tileset.uv_tile_size,
+      .animation_slot = kNoAnimationSlot,
+      .placeholder_color = placeholder_color,
+    });
+  }
+
+  // Only materialized tiles may be animated.
+  for (const auto& [tile_index, tile_entity] : tileset.tiles) {
+    const auto* animation = registry.find<CAnimation>(tile_entity);
+    if (animation == nullptr || tile_index >= tile_range.count) {
+      continue;
+    }
+
+    const auto info_index = first_index + static_cast<std::size_t>(tile_index);
+    auto& info = render_cache.tiles[info_index];
+
+    const auto frame_index = get_current_animation_frame_index(registry, *animation);
+    const auto& frame = animation->frames.at(frame_index);
+    info.uv_pos = _get_uv_pos(frame.tile_index, tileset.extent.cols, tileset.uv_tile_size);
+    info.animation_slot = saturate_cast<std::uint32_t>(render_cache.animations.size());
+
+    render_cache.animation_slot_indices.insert_or_assign(tile_entity,
+                                                         render_cache.animations.size());
+    render_cache.animations.push_back(TileAnimationSlot {
+      .tile_id = TileID {tile_range.first_id + tile_index},
+      .info_index = info_index,
+      .tile_entity = tile_entity,
+      .tileset_columns = tileset.extent.cols,
+      .frame_index = frame_index,
+    });
+  }
+}
+
+void _schedule_frame_change(CTileRenderCache& render_cache,
+                            const CAnimation& animation,
+                            const std::size_t slot_index,
+                            const std::chrono::milliseconds clock_time)
+{
+  const auto change_time = get_next_animation_frame_time(animation, clock_time);
+  if (!change_time.has_value()) {
+    return;
+  }
+
+  render_cache.animation_changes.push_back(TileAnimationChange {
+    .time = *change_time,
+    .slot_index = slot_index,
+  });
+
+  std::ranges::push_heap(render_cache.animation_changes,
+                         std::greater {},
+                         &TileAnimationChange::time);
+}
+
+void _schedule_frame_changes(const Registry& registry,
+                             CTileRenderCache& render_cache,
+                             const std::chrono::milliseconds clock_time)
+{
+  render_cache.animation_changes.clear();
+
+  for (std::size_t slot_index = 0; slot_index < render_cache.animations.size(); ++slot_index) {
+    const auto& slot = render_cache.animations[slot_index];
+    if (const auto* animation = registry.find<CAnimation>(slot.tile_entity)) {
+      _schedule_frame_change(render_cache, *animation, slot_index, clock_time);
+    }
+  }
+}
+
+void _rebuild_tile_render_cache(const Registry& registry, CTileRenderCache& render_cache)
+{
+  render_cache.tiles.clear();
+  render_cache.ranges.clear();
+  render_cache.animations.clear();
+  render_cache.animation_slot_indices.clear();
+  render_cache.animation_changes.clear();
+
+  // Only tilesets registered in the tile cache are included, i.e., not copies.
+  const auto& tile_cache = registry.get<CTileCache>();
+  for (const auto& [tile_range, tileset_id] : tile_cache.tileset_ranges) {
+    _add_tileset(registry, render_cache, tileset_id, tile_range);
+  }
+
+  if (const auto* clock = registry.find<CAnimationClock>()) {
+    _schedule_frame_changes(registry, render_cache, clock->time);
+  }
+
+  TACTILE_LOG_TRACE("Rebuilt tile render cache ({} tiles, {} animations)",
+                    render_cache.tiles.size(),
+                    render_cache.animations.size());
+}
+
+[[nodiscard]]
+auto _get_animation_version(const Registry& registry) -> std::uint64_t
+{
+  const auto* schedule = registry.find<CAnimationSchedule>();
+  return schedule ? schedule->version : 0;
+}
+
+void _set_animation_frame(CTileRenderCache& render_cache,
+                          TileAnimationSlot& slot,
+                          const CAnimation& animation,
+                          const std::size_t frame_index)
+{
+  if (frame_index == slot.frame_index) {
+    return;
+  }
+
+  slot.frame_index = frame_index;
+
+  auto& info = render_cache.tiles[slot.info_index];
+  const auto& frame = animation.frames.at(slot.frame_index);
+  info.uv_pos = _get_uv_pos(frame.tile_index, slot.tileset_columns, info.uv_size);
+}
+
+[[nodiscard]]
+auto _get_animation_clock_time(const Registry& registry) -> std::chrono::milliseconds
+{
+  const auto* clock = registry.find<CAnimationClock>();
+  return clock ? clock->time : std::chrono::milliseconds::zero();
+}
+
+void _update_animated_tile(const Registry& registry,
+                           CTileRenderCache& render_cache,
+                           TileAnimationSlot& slot)
+{
+  if (const auto* animation = registry.find<CAnimation>(slot.tile_entity)) {
+    _set_animation_frame(render_cache, slot, *animation, animation->frame_index);
+  }
+}
+
+void _update_clock_animated_tiles(const Registry& registry,
+                                  const CAnimationClock& clock,
+                                  CTileRenderCache& render_cache)
+{
+  // The frames are derived from the clock time, so they can't change unless it does.
+  if (clock.time == render_cache.animation_clock_time) {
+    return;
+  }
+
+  // The scheduled changes are only valid as long as the clock doesn't go backwards.
+  if (clock.time < render_cache.animation_clock_time) {
+    for (auto& slot : render_cache.animations) {
+      if (const auto* animation = registry.find<CAnimation>(slot.tile_entity)) {
+        const auto frame_index = get_animation_frame_index(*animation, clock.time);
+        _set_animation_frame(render_cache, slot, *animation, frame_index);
+      }
+    }
+
+    _schedule_frame_changes(registry, render_cache, clock.time);
+    render_cache.animation_clock_time = clock.time;
+    return;
+  }
+
+  auto& changes = render_cache.animation_changes;
+
+  // Rescheduled changes are always later than the clock time, so each slot is
+  // visited at most once, regardless of how far the clock has advanced.
+  while (!changes.empty() && changes.front().time <= clock.time) {
+    std::ranges::pop_heap(changes, std::greater {}, &TileAnimationChange::time);
+    const auto slot_index = changes.back().slot_index;
+    changes.pop_back();
+
+    auto& slot = render_cache.animations[slot_index];
+    if (const auto* animation = registry.find<CAnimation>(slot.tile_entity)) {
+      const auto frame_index = get_animation_frame_index(*animation, clock.time);
+      _set_animation_frame(render_cache, slot, *animation, frame_index);
+      _schedule_frame_change(render_cache, *animation, slot_index, clock.time);
+    }
+  }
+
+  render_cache.animation_clock_time = clock.time;
+}
+
+void _update_animated_tiles(const Registry& registry, CTileRenderCache& render_cache)
+{
+  if (const auto* clock = registry.find<CAnimationClock>()) {
+    _update_clock_animated_tiles(registry, *clock, render_cache);
+    return;
+  }
+
+  const auto* schedule = registry.find<CAnimationSchedule>();
+  if (!schedule || schedule->version == render_cache.animation_version) {
+    return;
+  }
+
+  // The recorded tiles are only sufficient if no animation update has been missed.
+  if (schedule->version == render_cache.animation_version + 1) {
+    for (const auto tile_entity : schedule->changed_tiles) {
+      const auto iter = render_cache.animation_slot_indices.find(tile_entity);
+      if (iter != render_cache.animation_slot_indices.end()) {
+        _update_animated_tile(registry, render_cache, render_cache.animations[iter->second]);
+      }
+    }
+  }
+  else {
+    for (auto& slot : render_cache.animations) {
+      _update_animated_tile(registry, render_cache, slot);
+    }
+  }
+
+  render_cache.animation_version = schedule->version;
+}
+
+}  // namespace
+
+void update_tile_render_cache(Registry& registry)
+{
+  TACTILE_ASSERT(registry.has<CTileCache>());
+  TACTILE_ASSERT(registry.has<CTileRenderCache>());
+
+  const auto& tile_cache = registry.get<CTileCache>();
+  auto& render_cache = registry.get<CTileRenderCache>();
+
+  if (render_cache.tile_cache_version != tile_cache.version) {
+    _rebuild_tile_render_cache(registry, render_cache);
+    render_cache.tile_cache_version = tile_cache.version;
+    render_cache.animation_version = _get_animation_version(registry);
+    render_cache.animation_clock_time = _get_animation_clock_time(registry);
+  }
+  else {
+    _update_animated_tiles(registry, render_cache);
+  }
+}
+
+auto find_tile_render_info(const CTileRenderCache& render_cache, const TileID tile_id)
+    -> const TileRenderInfo*
+{
+  const auto get_first_id = [](const TileRenderRange& range) {
+    return range.tile_range.first_id;
+  };
+
+  // Find the last range that starts at or before the tile identifier.
+  const auto range_iter =
+      std::ranges::upper_bound(render_cache.ranges, tile_id, std::less {}, get_first_id);
+  if (range_iter == render_cache.ranges.begin()) {
+    return nullptr;
+  }
+
+  const auto& [tile_range, first_index] = *std::prev(range_iter);
+
+  const auto tile_index = tile_id - tile_range.first_id;
+  if (tile_index >= tile_range.count) {
+    return nullptr;
+  }
+
+  return &render_cache.tiles[first_index + static_cast<std::size_t>(tile_index)];
+}
+
+}  // namespace tactile::core
@@ -2,7 +2,13 @@
 
 #include "tactile/core/tile/tileset.hpp"
 
-#include <utility>  // move
+#include <algorithm>   // upper_bound
+#include <cstddef>     // size_t
+#include <filesystem>  // path, hash_value
+#include <functional>  // less
+#include <iterator>    // prev
+#include <utility>     // move
+#include <vector>      // vector, erase_if
 
 #include "tactile/base/container/lookup.hpp"
 #include "tactile/base/io/save/ir.hpp"
@@ -11,6 +17,7 @@
 #include "tactile/core/debug/assert.hpp"
 #include "tactile/core/entity/registry.hpp"
 #include "tactile/core/io/texture.hpp"
+#include "tactile/core/io/texture_cache.hpp"
 #include "tactile/core/log/logger.hpp"
 #include "tactile/core/log/set_log_scope.hpp"
 #include "tactile/core/meta/meta.hpp"
@@ -23,6 +30,31 @@
 namespace tactile::core {
 namespace {
 
+[[nodiscard]]
+auto _find_tileset_range_after(const CTileCache& tile_cache, const TileID tile_id)
+    -> std::vector<TilesetRange>::const_iterator
+{
+  return std::ranges::upper_bound(tile_cache.tileset_ranges,
+                                  tile_id,
+                                  std::less {},
+                                  [](const TilesetRange& range) {
+                                    return range.tile_range.first_id;
+                                  });
+}
+
+[[nodiscard]]
+auto _find_tileset_range(const CTileCache& tile_cache, const TileID tile_id)
+    -> const TilesetRange*
+{
+  const auto iter = _find_tileset_range_after(tile_cache, tile_id);
+  if (iter == tile_cache.tileset_ranges.begin()) {
+    return nullptr;
+  }
+
+  const auto& range = *std::prev(iter);
+  return has_tile(range.tile_range, tile_id) ? &range : nullptr;
+}
+
 [[nodiscard]]
 auto _add_tileset_component(Registry& registry,
                             const EntityID tileset_id,
@@ -48,6 +80,7 @@ auto _add_tileset_component(Registry& registry,
   tileset.tile_size = tile_size;
   tileset.uv_tile_size = vec_cast<Float2>(tileset.tile_size) / vec_cast<Float2>(texture_size);
   tileset.extent = extent;
+  tileset.tile_count = extent.rows * extent.cols;
 
   return {};
 }
@@ -62,50 +95,60 @@ void _add_viewport_component(Registry& registry,
   viewport.scale = 1.0f;
 }
 
-void _create_tiles(Registry& registry, CTileset& tileset)
+[[nodiscard]]
+auto _is_valid_tile_index(const CTileset& tileset, const TileIndex tile_index) -> bool
 {
-  const auto tile_count = tileset.extent.rows * tileset.extent.cols;
-  tileset.tiles.reserve(tile_count);
-
-  for (std::size_t index = 0; index < tile_count; ++index) {
-    const auto tile_index = saturate_cast<TileIndex>(index);
-    const auto tile_entity = make_tile(registry, tile_index);
-
-    tileset.tiles.push_back(tile_entity);
-  }
+  return tile_index >= 0 && saturate_cast<std::size_t>(tile_index) < tileset.tile_count;
 }
 
 [[nodiscard]]
 auto _create_tiles(Registry& registry, CTileset& tileset, const ir::Tileset& ir_tileset)
     -> std::expected<void, ErrorCode>
 {
-  const auto tile_count = saturate_cast<std::size_t>(ir_tileset.tile_count);
-  tileset.tiles.resize(tile_count, kInvalidEntity);
+  // Only tiles with data are included in the IR, the other tiles remain implicit.
+  tileset.tile_count = saturate_cast<std::size_t>(ir_tileset.tile_count);
+  tileset.tiles.reserve(ir_tileset.tiles.size());
 
   for (const auto& ir_tile : ir_tileset.tiles) {
+    if (!_is_valid_tile_index(tileset, ir_tile.index)) {
+      return std::unexpected {ErrorCode::kBadState};
+    }
+
     const auto tile_id = make_tile(registry, ir_tile);
     if (!tile_id.has_value()) {
       return std::unexpected {tile_id.error()};
     }
 
-    const auto tile_index = saturate_cast<std::size_t>(ir_tile.index);
-    if (tile_index >= tileset.tiles.size()) {
-      return std::unexpected {ErrorCode::kBadState};
-    }
-
-    tileset.tiles[tile_index] = *tile_id;
-  }
-
-  TACTILE_ASSERT(tileset.tiles.size() == tile_count);
-  for (std::size_t tile_index = 0; tile_index < tile_count; ++tile_index) {
-    if (tileset.tiles[tile_index] == kInvalidEntity) {
-      tileset.tiles[tile_index] = make_tile(registry, saturate_cast<TileIndex>(tile_index));
-    }
+    tileset.tiles.insert_or_assign(ir_tile.index, *tile_id);
   }
 
   return {};
 }
 
+[[nodiscard]]
+auto _make_placeholder_texture(const ir::Tileset& ir_tileset) -> CTexture
+{
+  return CTexture {
+    .raw_handle = nullptr,
+    .id = TextureID {0},
+    .size = ir_tileset.image_size,
+    .path = ir_tileset.image_path,
+  };
+}
+
+[[nodiscard]]
+auto _get_placeholder_color(const std::filesystem::path& image_path) -> UColor
+{
+  // The color only has to be stable for each tileset, and distinct from the background.
+  const auto hash = std::filesystem::hash_value(image_path);
+  return UColor {
+    .red = static_cast<UColor::value_type>(0x40 + (hash & 0x7F)),
+    .green = static_cast<UColor::value_type>(0x40 + ((hash >> 8) & 0x7F)),
+    .blue = static_cast<UColor::value_type>(0x40 + ((hash >> 16) & 0x7F)),
+    .alpha = 0xFF,
+  };
+}
+
 }  // namespace
 
 auto is_tileset(const Registry& registry, const EntityID entity) -> bool
@@ -136,8 +179,7 @@ auto make_tileset(Registry& registry, const TilesetSpec& spec) -> EntityID
   registry.add<CMeta>(tileset_id);
   registry.add<CTexture>(tileset_id, spec.texture);
 
-  auto& tileset = registry.get<CTileset>(tileset_id);
-  _create_tiles(registry, tileset);
+  const auto& tileset = registry.get<CTileset>(tileset_id);
 
   TACTILE_ASSERT(is_tileset(registry, tileset_id));
   TACTILE_ASSERT(tileset.extent.rows > 0);
@@ -146,10 +188,44 @@ auto make_tileset(Registry& registry, const TilesetSpec& spec) -> EntityID
 }
 
 auto make_tileset(Registry& registry,
-                  IRenderer& renderer,
+                  TextureCache& texture_cache,
                   const ir::TilesetRef& ir_tileset_ref) -> std::expected<EntityID, ErrorCode>
 {
-  auto texture_result = load_texture(renderer, ir_tileset_ref.tileset.image_path);
+  return make_tileset(registry,
+                      texture_cache,
+                      ir_tileset_ref,
+                      texture_cache.acquire_async(ir_tileset_ref.tileset.image_path),
+                      TextureLoadMode::kBlocking);
+}
+
+auto make_tileset(Registry& registry,
+                  TextureCache& texture_cache,
+                  const ir::TilesetRef& ir_tileset_ref,
+                  PendingTexture pending_texture,
+                  const TextureLoadMode load_mode) -> std::expected<EntityID, ErrorCode>
+{
+  if (const auto* cache_ref = registry.find<CTextureCacheRef>()) {
+    TACTILE_ASSERT(cache_ref->cache == &texture_cache);
+  }
+  else {
+    registry.add<CTextureCacheRef>(&texture_cache);
+  }
+
+  const auto& image_size = ir_tileset_ref.tileset.image_size;
+
+  // Placeholders are sized according to the IR, since the image isn't decoded yet.
+  const auto use_placeholder = load_mode == TextureLoadMode::kDeferred &&
+                               image_size.x() > 0 && image_size.y() > 0 &&
+                               !pending_texture.is_ready();
+
+  std::expected<CTexture, ErrorCode> texture_result {};
+  if (use_placeholder) {
+    texture_result = _make_placeholder_texture(ir_tileset_ref.tileset);
+  }
+  else {
+    texture_result = texture_cache.acquire(std::move(pending_texture));
+  }
+
   if (!texture_result.has_value()) {
     return std::unexpected {texture_result.error()};
   }
@@ -159,6 +235,12 @@ auto make_tileset(Registry& registry,
 
   const auto& texture = registry.add<CTexture>(tileset_id, std::move(*texture_result));
 
+  if (use_placeholder) {
+    registry.add<CPendingTexture>(tileset_id,
+                                  std::move(pending_texture),
+                                  _get_placeholder_color(texture.path));
+  }
+
   _add_viewport_component(registry, tileset_id, texture.size);
 
   const auto add_tileset_result = _add_tileset_component(registry,
@@ -191,6 +273,60 @@ auto make_tileset(Registry& registry,
   return tileset_id;
 }
 
+auto update_tileset_textures(Registry& registry) -> std::size_t
+{
+  const auto* cache_ref = registry.find<CTextureCacheRef>();
+  if (cache_ref == nullptr) {
+    return 0;
+  }
+
+  std::vector<EntityID> ready_tilesets {};
+  std::size_t pending_count {0};
+
+  for (const auto& [tileset_id, pending_texture] : registry.each<CPendingTexture>()) {
+    if (pending_texture.texture.is_ready()) {
+      ready_tilesets.push_back(tileset_id);
+    }
+    else {
+      ++pending_count;
+    }
+  }
+
+  if (ready_tilesets.empty()) {
+    return pending_count;
+  }
+
+  for (const auto tileset_id : ready_tilesets) {
+    auto& pending_texture = registry.get<CPendingTexture>(tileset_id);
+    auto texture = cache_ref->cache->acquire(std::move(pending_texture.texture));
+    registry.erase<CPendingTexture>(tileset_id);
+
+    // The placeholder remains (without being rendered) if the texture couldn't be loaded.
+    if (!texture.has_value()) {
+      TACTILE_LOG_ERROR("Could not load tileset texture: {}", to_string(texture.error()));
+      continue;
+    }
+
+    auto& tileset_texture = registry.get<CTexture>(tileset_id);
+    if (texture->size != tileset_texture.size) {
+      TACTILE_LOG_WARN("Tileset texture size {} differs from the expected size {}",
+                       texture->size,
+                       tileset_texture.size);
+
+      auto& tileset = registry.get<CTileset>(tileset_id);
+      tileset.uv_tile_size =
+          vec_cast<Float2>(tileset.tile_size) / vec_cast<Float2>(texture->size);
+    }
+
+    tileset_texture = std::move(*texture);
+  }
+
+  // Forces the tile render cache to pick up the new texture handles.
+  ++registry.get<CTileCache>().version;
+
+  return pending_count;
+}
+
 auto init_tileset_instance(Registry& registry,
                            const EntityID tileset_entity,
                            const TileID first_tile_id) -> std::expected<void, ErrorCode>
@@ -212,7 +348,7 @@ auto init_tileset_instance(Registry& registry,
 
   const TileRange tile_range {
     .first_id = first_tile_id,
-    .count = saturate_cast<std::int32_t>(tileset.tiles.size()),
+    .count = saturate_cast<std::int32_t>(tileset.tile_count),
   };
 
   if (!is_tile_range_available(registry, tile_range)) {
@@ -227,12 +363,11 @@ auto init_tileset_instance(Registry& registry,
   instance.is_embedded = false;  // TODO
 
   auto& tile_cache = registry.get<CTileCache>();
-  tile_cache.tileset_mapping.reserve(tile_cache.tileset_mapping.size() + tileset.tiles.size());
 
-  for (std::int32_t index = 0; index < tile_range.count; ++index) {
-    const TileID tile_id {tile_range.first_id + index};
-    tile_cache.tileset_mapping.insert_or_assign(tile_id, tileset_entity);
-  }
+  const auto ranges_iter = _find_tileset_range_after(tile_cache, tile_range.first_id);
+  tile_cache.tileset_ranges.insert(ranges_iter, TilesetRange {tile_range, tileset_entity});
+
+  ++tile_cache.version;
 
   TACTILE_LOG_DEBUG("Initialized tileset instance with tile range [{}, {})",
                     tile_range.first_id,
@@ -266,16 +401,21 @@ void destroy_tileset(Registry& registry, const EntityID tileset_entity)
   TACTILE_ASSERT(is_tileset(registry, tileset_entity));
   const auto& tileset = registry.get<CTileset>(tileset_entity);
 
-  for (const auto tile_entity : tileset.tiles) {
+  for (const auto& [tile_index, tile_entity] : tileset.tiles) {
     destroy_tile(registry, tile_entity);
   }
 
+  if (const auto* cache_ref = registry.find<CTextureCacheRef>()) {
+    cache_ref->cache->release(registry.get<CTexture>(tileset_entity).id);
+  }
+
   if (const auto* instance = registry.find<CTilesetInstance>(tileset_entity)) {
     auto& tile_cache = registry.get<CTileCache>();
-    for (std::int32_t index = 0; index < instance->tile_range.count; ++index) {
-      const TileID tile_id {instance->tile_range.first_id + index};
-      tile_cache.tileset_mapping.erase(tile_id);
-    }
+    std::erase_if(tile_cache.tileset_ranges, [&](const TilesetRange& range) {
+      return range.tileset_entity == tileset_entity;
+    });
+
+    ++tile_cache.version;
   }
 
   registry.destroy(tileset_entity);
@@ -295,10 +435,11 @@ auto copy_tileset(Registry& registry, const EntityID old_tileset_entity) -> Enti
   new_tileset.extent = old_tileset.extent;
   new_tileset.tile_size = old_tileset.tile_size;
   new_tileset.uv_tile_size = old_tileset.uv_tile_size;
+  new_tileset.tile_count = old_tileset.tile_count;
 
   new_tileset.tiles.reserve(old_tileset.tiles.size());
-  for (const auto old_tile_entity : old_tileset.tiles) {
-    new_tileset.tiles.push_back(copy_tile(registry, old_tile_entity));
+  for (const auto& [tile_index, old_tile_entity] : old_tileset.tiles) {
+    new_tileset.tiles.insert_or_assign(tile_index, copy_tile(registry, old_tile_entity));
   }
 
   if (const auto* instance = registry.find<CTilesetInstance>(old_tileset_entity)) {
@@ -308,16 +449,58 @@ auto copy_tileset(Registry& registry, const EntityID old_tileset_entity) -> Enti
   return new_tileset_entity;
 }
 
+auto find_tile(const Registry& registry,
+               const EntityID tileset_entity,
+               const TileIndex tile_index) -> EntityID
+{
+  TACTILE_ASSERT(is_tileset(registry, tileset_entity));
+  const auto& tileset = registry.get<CTileset>(tileset_entity);
+
+  if (const auto* tile_entity = find_in(tileset.tiles, tile_index)) {
+    return *tile_entity;
+  }
+
+  return kInvalidEntity;
+}
+
+auto get_or_make_tile(Registry& registry,
+                      const EntityID tileset_entity,
+                      const TileIndex tile_index) -> EntityID
+{
+  TACTILE_ASSERT(is_tileset(registry, tileset_entity));
+
+  if (!_is_valid_tile_index(registry.get<CTileset>(tileset_entity), tile_index)) {
+    TACTILE_LOG_ERROR("Tried to materialize invalid tile index {}", tile_index);
+    return kInvalidEntity;
+  }
+
+  if (const auto tile_entity = find_tile(registry, tileset_entity, tile_index);
+      tile_entity != kInvalidEntity) {
+    return tile_entity;
+  }
+
+  // The tile must be created before fetching the tileset component, since
+  // creating entities may invalidate component references.
+  const auto tile_entity = make_tile(registry, tile_index);
+
+  auto& tileset = registry.get<CTileset>(tileset_entity);
+  tileset.tiles.insert_or_assign(tile_index, tile_entity);
+
+  return tile_entity;
+}
+
 auto get_tile_appearance(const Registry& registry,
                          const EntityID tileset_entity,
                          const TileIndex tile_index) -> TileIndex
 {
-  TACTILE_ASSERT(is_tileset(registry, tileset_entity));
-  const auto& tileset = registry.get<CTileset>(tileset_entity);
+  const auto tile_entity = find_tile(registry, tileset_entity, tile_index);
+  if (tile_entity == kInvalidEntity) {
+    return tile_index;
+  }
 
-  const auto tile_entity = tileset.tiles.at(static_cast<std::size_t>(tile_index));
   if (const auto* animation = registry.find<CAnimation>(tile_entity)) {
-    return animation->frames.at(animation->frame_index).tile_index;
+    const auto frame_index = get_current_animation_frame_index(registry, *animation);
+    return animation->frames.at(frame_index).tile_index;
   }
 
   return tile_index;
@@ -328,9 +511,8 @@ auto find_tileset(const Registry& registry, const TileID tile_id) -> EntityID
   TACTILE_ASSERT(registry.has<CTileCache>());
   const auto& tile_cache = registry.get<CTileCache>();
 
-  const auto* tileset_entity = find_in(tile_cache.tileset_mapping, tile_id);
-  if (tileset_entity != nullptr) {
-    return *tileset_entity;
+  if (const auto* range = _find_tileset_range(tile_cache, tile_id)) {
+    return range->tileset_entity;
   }
 
   return kInvalidEntity;
@@ -339,12 +521,10 @@ auto find_tileset(const Registry& registry, const TileID tile_id) -> EntityID
 auto get_tile_index(const Registry& registry, const TileID tile_id) -> std::optional<TileIndex>
 {
   TACTILE_ASSERT(registry.has<CTileCache>());
+  const auto& tile_cache = registry.get<CTileCache>();
 
-  const auto tileset_entity = find_tileset(registry, tile_id);
-
-  const auto* instance = registry.find<CTilesetInstance>(tileset_entity);
-  if (instance != nullptr && has_tile(instance->tile_range, tile_id)) {
-    return TileIndex {tile_id - instance->tile_range.first_id};
+  if (const auto* range = _find_tileset_range(tile_cache, tile_id)) {
+    return TileIndex {tile_id - range->tile_range.first_id};
   }
 
   return std::nullopt;
@@ -352,16 +532,25 @@ auto get_tile_index(const Registry& registry, const TileID tile_id) -> std::opti
 
 auto is_tile_range_available(const Registry& registry, const TileRange& range) -> bool
 {
-  const auto first_tile = range.first_id;
-  const auto last_tile = range.first_id + range.count - 1;
+  TACTILE_ASSERT(registry.has<CTileCache>());
+  const auto& tile_cache = registry.get<CTileCache>();
+
+  if (range.first_id < TileID {1}) {
+    return false;
+  }
+
+  const auto end_id = range.first_id + range.count;
+  const auto next_iter = _find_tileset_range_after(tile_cache, range.first_id);
 
-  if (first_tile < TileID {1}) {
+  // The ranges are disjoint, so only the neighbors of the new range may overlap it.
+  if (next_iter != tile_cache.tileset_ranges.end() &&
+      next_iter->tile_range.first_id < end_id) {
     return false;
   }
 
-  for (const auto& [tileset_entity, instance] : registry.each<CTilesetInstance>()) {
-    if (has_tile(instance.tile_range, first_tile) ||
-        has_tile(instance.tile_range, last_tile)) {
+  if (next_iter != tile_cache.tileset_ranges.begin()) {
+    const auto& prev_range = std::prev(next_iter)->tile_range;
+    if (prev_range.first_id + prev_range.count > range.first_id) {
       return false;
     }
   }
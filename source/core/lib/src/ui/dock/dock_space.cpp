@@ -62,6 +62,7 @@ void DockSpace::reset_layout(const Language& language)
   ImGui::DockBuilderDockWindow(language.get(NounLabel::kComponentDock), right_top_node);
   ImGui::DockBuilderDockWindow(language.get(NounLabel::kLayerDock), right_bottom_node);
   ImGui::DockBuilderDockWindow(language.get(NounLabel::kLogDock), bottom_node);
+  ImGui::DockBuilderDockWindow(language.get(NounLabel::kProfilerDock), bottom_node);
 
   ImGui::DockBuilderFinish(root_node);
 }
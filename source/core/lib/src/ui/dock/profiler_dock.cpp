@@ -0,0 +1,110 @@
+// Copyright (C) 2024 Albin Johansson (GNU General Public License v3.0)
+
+#include "tactile/core/ui/dock/profiler_dock.hpp"
+
+#include <limits>  // numeric_limits
+#include <vector>  // vector
+
+#include <imgui.h>
+
+#include "tactile/base/util/format.hpp"
+#include "tactile/core/debug/profiler.hpp"
+#include "tactile/core/event/event_dispatcher.hpp"
+#include "tactile/core/ui/common/widgets.hpp"
+#include "tactile/core/ui/common/window.hpp"
+#include "tactile/core/ui/i18n/language.hpp"
+
+namespace tactile::core::ui {
+namespace {
+
+inline constexpr float kGraphHeight = 40.0f;
+
+void _push_history_graph(const char* label,
+                         const std::vector<float>& frame_times_ms,
+                         const char* overlay_text)
+{
+  ImGui::PlotLines(label,
+                   frame_times_ms.data(),
+                   static_cast<int>(frame_times_ms.size()),
+                   0,
+                   overlay_text,
+                   0.0f,
+                   std::numeric_limits<float>::max(),
+                   ImVec2 {-std::numeric_limits<float>::min(), kGraphHeight});
+}
+
+}  // namespace
+
+void ProfilerDock::push(const Language& language, const EventDispatcher& dispatcher)
+{
+  if (!m_is_open) {
+    return;
+  }
+
+  const Window dock_window {language.get(NounLabel::kProfilerDock),
+                            ImGuiWindowFlags_NoCollapse,
+                            &m_is_open};
+  if (!dock_window.is_open()) {
+    return;
+  }
+
+  auto is_enabled = is_profiler_enabled();
+  if (ImGui::Checkbox(language.get(ActionLabel::kToggleProfiler), &is_enabled)) {
+    set_profiler_enabled(is_enabled);
+  }
+
+  const auto& event_stats = dispatcher.get_stats();
+  ImGui::SeparatorText(language.get(NounLabel::kEvents));
+  ImGui::Text("%s: %zu", language.get(NounLabel::kPushedEvents), event_stats.pushed_count);
+  ImGui::Text("%s: %zu",
+              language.get(NounLabel::kCoalescedEvents),
+              event_stats.coalesced_count);
+  ImGui::Text("%s: %zu",
+              language.get(NounLabel::kDispatchedEvents),
+              event_stats.dispatched_count);
+  ImGui::Text("%s: %zu",
+              language.get(NounLabel::kPendingJobs),
+              event_stats.pending_job_count);
+
+  const auto stats = get_profiler_frame_stats();
+  if (stats.frame_times_ms.empty()) {
+    return;
+  }
+
+  LabelBuffer overlay_buffer;  // NOLINT uninitialized
+  format_to_buffer(overlay_buffer, "{:.2f} ms", stats.frame_times_ms.back());
+  overlay_buffer.set_terminator('\0');
+
+  ImGui::SeparatorText(language.get(NounLabel::kFrame));
+  _push_history_graph("##Frame", stats.frame_times_ms, overlay_buffer.data());
+
+  ImGui::SeparatorText(language.get(NounLabel::kZones));
+  for (const auto& zone_stats : stats.zones) {
+    const IdScope zone_scope {zone_stats.name.c_str()};
+
+    overlay_buffer.clear();
+    format_to_buffer(overlay_buffer,
+                     "{:.2f} ms ({}: {:.2f}, {}: {:.2f})",
+                     zone_stats.frame_times_ms.back(),
+                     language.get(NounLabel::kAverage),
+                     zone_stats.average_ms,
+                     language.get(NounLabel::kMaximum),
+                     zone_stats.max_ms);
+    overlay_buffer.set_terminator('\0');
+
+    ImGui::TextUnformatted(zone_stats.name.c_str());
+    _push_history_graph("##Zone", zone_stats.frame_times_ms, overlay_buffer.data());
+  }
+}
+
+void ProfilerDock::toggle()
+{
+  m_is_open = !m_is_open;
+}
+
+auto ProfilerDock::is_open() const -> bool
+{
+  return m_is_open;
+}
+
+}  // namespace tactile::core::ui
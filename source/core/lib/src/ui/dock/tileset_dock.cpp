@@ -10,6 +10,7 @@
 #include "tactile/core/event/event_dispatcher.hpp"
 #include "tactile/core/event/events.hpp"
 #include "tactile/core/io/texture.hpp"
+#include "tactile/core/io/texture_cache.hpp"
 #include "tactile/core/map/map.hpp"
 #include "tactile/core/meta/meta.hpp"
 #include "tactile/core/tile/tileset_types.hpp"
@@ -20,6 +21,7 @@
 #include "tactile/core/ui/common/widgets.hpp"
 #include "tactile/core/ui/common/window.hpp"
 #include "tactile/core/ui/i18n/language.hpp"
+#include "tactile/core/ui/render/primitives.hpp"
 #include "tactile/core/ui/viewport.hpp"
 
 namespace tactile::core::ui {
@@ -85,10 +87,15 @@ void _push_tileset_tab(const Registry& registry,
     const auto texture_pos = canvas_renderer.to_screen_pos(Float2 {0, 0});
     const auto texture_size = vec_cast<Float2>(texture.size);
 
-    auto* draw_list = ImGui::GetWindowDrawList();
-    draw_list->AddImage(texture.raw_handle,
-                        to_imvec2(texture_pos),
-                        to_imvec2(texture_pos + texture_size));
+    if (texture.raw_handle != nullptr) {
+      auto* draw_list = ImGui::GetWindowDrawList();
+      draw_list->AddImage(texture.raw_handle,
+                          to_imvec2(texture_pos),
+                          to_imvec2(texture_pos + texture_size));
+    }
+    else if (const auto* pending_texture = registry.find<CPendingTexture>(tileset_id)) {
+      fill_rect(texture_pos, texture_size, pending_texture->placeholder_color);
+    }
 
     canvas_renderer.draw_orthogonal_grid(kColorBlack);
 
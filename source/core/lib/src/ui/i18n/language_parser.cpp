@@ -71,6 +71,16 @@ auto _get_noun_names() -> std::unordered_map<std::string_view, NounLabel>
     {"default", NounLabel::kDefault},
     {"version", NounLabel::kVersion},
     {"project_dir", NounLabel::kProjectDir},
+    {"history", NounLabel::kHistory},
+    {"events", NounLabel::kEvents},
+    {"pushed_events", NounLabel::kPushedEvents},
+    {"coalesced_events", NounLabel::kCoalescedEvents},
+    {"dispatched_events", NounLabel::kDispatchedEvents},
+    {"pending_jobs", NounLabel::kPendingJobs},
+    {"frame", NounLabel::kFrame},
+    {"zones", NounLabel::kZones},
+    {"average", NounLabel::kAverage},
+    {"maximum", NounLabel::kMaximum},
     {"file_menu", NounLabel::kFileMenu},
     {"edit_menu", NounLabel::kEditMenu},
     {"view_menu", NounLabel::kViewMenu},
@@ -89,6 +99,7 @@ auto _get_noun_names() -> std::unordered_map<std::string_view, NounLabel>
     {"component_dock", NounLabel::kComponentDock},
     {"animation_dock", NounLabel::kAnimationDock},
     {"log_dock", NounLabel::kLogDock},
+    {"profiler_dock", NounLabel::kProfilerDock},
     {"style_editor", NounLabel::kStyleEditorWidget},
     {"godot_export_dialog", NounLabel::kGodotExportDialog},
   };
@@ -133,6 +144,7 @@ auto _get_action_names() -> std::unordered_map<std::string_view, ActionLabel>
     {"pan_right", ActionLabel::kPanRight},
     {"highlight_active_layer", ActionLabel::kHighlightActiveLayer},
     {"toggle_ui", ActionLabel::kToggleUi},
+    {"toggle_profiler", ActionLabel::kToggleProfiler},
     {"stamp_tool", ActionLabel::kStampTool},
     {"eraser_tool", ActionLabel::kEraserTool},
     {"bucket_tool", ActionLabel::kBucketTool},
@@ -160,6 +172,8 @@ auto _get_action_names() -> std::unordered_map<std::string_view, ActionLabel>
     {"open_style_editor", ActionLabel::kOpenStyleEditor},
     {"open_demo_window", ActionLabel::kOpenDemoWindow},
     {"open_storage_dir", ActionLabel::kOpenStorageDir},
+    {"start_trace_capture", ActionLabel::kStartTraceCapture},
+    {"save_trace_capture", ActionLabel::kSaveTraceCapture},
     {"tile_layer_item", ActionLabel::kTileLayerItem},
     {"object_layer_item", ActionLabel::kObjectLayerItem},
     {"group_layer_item", ActionLabel::kGroupLayerItem},
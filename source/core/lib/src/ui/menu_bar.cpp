@@ -2,9 +2,16 @@
 
 #include "tactile/core/ui/menu_bar.hpp"
 
+#include <cstddef>  // size_t
+#include <limits>   // numeric_limits
+
 #include <SDL2/SDL.h>
 #include <imgui.h>
 
+#include "tactile/base/container/buffer.hpp"
+#include "tactile/base/util/format.hpp"
+#include "tactile/core/debug/chrome_trace.hpp"
+#include "tactile/core/debug/profiler.hpp"
 #include "tactile/core/document/document_info.hpp"
 #include "tactile/core/entity/registry.hpp"
 #include "tactile/core/event/event_dispatcher.hpp"
@@ -12,6 +19,7 @@
 #include "tactile/core/log/logger.hpp"
 #include "tactile/core/map/map.hpp"
 #include "tactile/core/model/model.hpp"
+#include "tactile/core/platform/file_dialog.hpp"
 #include "tactile/core/platform/filesystem.hpp"
 #include "tactile/core/ui/common/menus.hpp"
 #include "tactile/core/ui/common/widgets.hpp"
@@ -22,6 +30,32 @@
 namespace tactile::core::ui {
 namespace {
 
+void _push_history_memory_usage(const Language& language, const CommandStack& history)
+{
+  constexpr double kBytesPerMiB = 1'024.0 * 1'024.0;
+
+  const auto memory_usage = static_cast<double>(history.memory_usage()) / kBytesPerMiB;
+  const auto memory_budget = history.memory_budget();
+
+  Buffer<char, 64> label_buffer;  // NOLINT uninitialized
+  if (memory_budget == std::numeric_limits<std::size_t>::max()) {
+    format_to_buffer(label_buffer,
+                     "{}: {:.1f} MiB",
+                     language.get(NounLabel::kHistory),
+                     memory_usage);
+  }
+  else {
+    format_to_buffer(label_buffer,
+                     "{}: {:.1f} / {:.1f} MiB",
+                     language.get(NounLabel::kHistory),
+                     memory_usage,
+                     static_cast<double>(memory_budget) / kBytesPerMiB);
+  }
+  label_buffer.set_terminator('\0');
+
+  ImGui::TextDisabled("%s", label_buffer.data());
+}
+
 void _push_recent_files_menu(const Language& language, EventDispatcher& dispatcher)
 {
   if (const MenuScope menu {language.get(NounLabel::kRecentFilesMenu)}; menu.is_open()) {
@@ -114,6 +148,10 @@ void _push_edit_menu(const Model& model, EventDispatcher& dispatcher)
       dispatcher.push<RedoEvent>();
     }
 
+    if (history != nullptr) {
+      _push_history_memory_usage(language, *history);
+    }
+
     ImGui::Separator();
 
     if (ImGui::MenuItem(language.get(ActionLabel::kStampTool), nullptr, false, false)) {
@@ -198,6 +236,10 @@ void _push_widgets_menu(const Language& language, EventDispatcher& dispatcher)
     if (ImGui::MenuItem(language.get(NounLabel::kLogDock), nullptr, true)) {
       dispatcher.push<ToggleLogDockEvent>();
     }
+
+    if (ImGui::MenuItem(language.get(NounLabel::kProfilerDock), nullptr, false)) {
+      dispatcher.push<ToggleProfilerDockEvent>();
+    }
   }
 }
 
@@ -508,6 +550,27 @@ void MenuBar::_push_debug_menu(const Model& model)
         std::ignore = open_directory_in_finder(*persistent_dir);
       }
     }
+
+    ImGui::Separator();
+
+    const auto is_capturing = is_profiler_capturing();
+
+    if (ImGui::MenuItem(language.get(ActionLabel::kStartTraceCapture),
+                        nullptr,
+                        false,
+                        !is_capturing)) {
+      start_profiler_capture();
+    }
+
+    if (ImGui::MenuItem(language.get(ActionLabel::kSaveTraceCapture),
+                        nullptr,
+                        false,
+                        is_capturing)) {
+      const auto events = stop_profiler_capture();
+      if (const auto trace_path = FileDialog::save_trace()) {
+        std::ignore = save_chrome_trace(*trace_path, events);
+      }
+    }
   }
 
   if (m_show_debugger) {
@@ -3,20 +3,20 @@
 #include "tactile/core/ui/render/orthogonal_renderer.hpp"
 
 #include <algorithm>  // min
+#include <vector>     // vector
 
-#include "tactile/base/container/lookup.hpp"
 #include "tactile/base/meta/color.hpp"
 #include "tactile/core/debug/assert.hpp"
+#include "tactile/core/debug/profiler.hpp"
 #include "tactile/core/entity/registry.hpp"
-#include "tactile/core/io/texture.hpp"
 #include "tactile/core/layer/group_layer.hpp"
 #include "tactile/core/layer/layer.hpp"
 #include "tactile/core/layer/object.hpp"
+#include "tactile/core/layer/object_index.hpp"
 #include "tactile/core/layer/object_layer.hpp"
 #include "tactile/core/layer/tile_layer.hpp"
 #include "tactile/core/map/map.hpp"
-#include "tactile/core/tile/tileset.hpp"
-#include "tactile/core/tile/tileset_types.hpp"
+#include "tactile/core/tile/tile_render_cache.hpp"
 #include "tactile/core/ui/canvas_renderer.hpp"
 #include "tactile/core/ui/common/window.hpp"
 #include "tactile/core/ui/imgui_compat.hpp"
@@ -27,21 +27,27 @@ namespace {
 
 void _render_tile(const CanvasRenderer& canvas_renderer,
                   const Index2D& position_in_world,
-                  const Index2D& position_in_tileset,
-                  void* texture_handle,
-                  const Float2& uv_tile_size)
+                  const TileRenderInfo& render_info)
 {
-  const auto position_in_texture = to_float2(position_in_tileset) * uv_tile_size;
-
   const auto world_pos = canvas_renderer.to_screen_pos(position_in_world);
   const auto world_size = canvas_renderer.get_canvas_tile_size();
 
   auto* draw_list = ImGui::GetWindowDrawList();
-  draw_list->AddImage(texture_handle,
+  draw_list->AddImage(render_info.texture_handle,
                       to_imvec2(world_pos),
                       to_imvec2(world_pos + world_size),
-                      to_imvec2(position_in_texture),
-                      to_imvec2(position_in_texture + uv_tile_size));
+                      to_imvec2(render_info.uv_pos),
+                      to_imvec2(render_info.uv_pos + render_info.uv_size));
+}
+
+void _render_placeholder_tile(const CanvasRenderer& canvas_renderer,
+                              const Index2D& position_in_world,
+                              const TileRenderInfo& render_info)
+{
+  const auto world_pos = canvas_renderer.to_screen_pos(position_in_world);
+  const auto world_size = canvas_renderer.get_canvas_tile_size();
+
+  fill_rect(world_pos, world_size, render_info.placeholder_color);
 }
 
 void _render_tile_layer(const CanvasRenderer& canvas_renderer,
@@ -49,7 +55,7 @@ void _render_tile_layer(const CanvasRenderer& canvas_renderer,
                         const EntityID layer_id)
 {
   const auto& render_bounds = canvas_renderer.get_render_bounds();
-  const auto& tile_cache = registry.get<CTileCache>();
+  const auto& render_cache = registry.get<CTileRenderCache>();
 
   each_layer_tile(
       registry,
@@ -57,28 +63,17 @@ void _render_tile_layer(const CanvasRenderer& canvas_renderer,
       render_bounds.begin,
       render_bounds.end,
       [&](const Index2D& position_in_world, const TileID tile_id) {
-        if (tile_id == kEmptyTile) {
+        const auto* render_info = find_tile_render_info(render_cache, tile_id);
+        if (render_info == nullptr) {
           return;
         }
 
-        const auto tileset_id = lookup_in(tile_cache.tileset_mapping, tile_id);
-
-        const auto& texture = registry.get<CTexture>(tileset_id);
-        const auto& tileset = registry.get<CTileset>(tileset_id);
-        const auto& tileset_instance = registry.get<CTilesetInstance>(tileset_id);
-
-        const TileIndex tile_index {tile_id - tileset_instance.tile_range.first_id};
-        const auto apparent_tile_index = get_tile_appearance(registry, tileset_id, tile_index);
-
-        const auto position_in_tileset =
-            Index2D::from_1d(static_cast<Extent2D::value_type>(apparent_tile_index),
-                             tileset.extent.cols);
-
-        _render_tile(canvas_renderer,
-                     position_in_world,
-                     position_in_tileset,
-                     texture.raw_handle,
-                     tileset.uv_tile_size);
+        if (render_info->texture_handle != nullptr) {
+          _render_tile(canvas_renderer, position_in_world, *render_info);
+        }
+        else if (render_info->placeholder_color.alpha != 0) {
+          _render_placeholder_tile(canvas_renderer, position_in_world, *render_info);
+        }
       });
 }
 
@@ -92,8 +87,6 @@ void _render_object(const CanvasRenderer& canvas_renderer,
     return;
   }
 
-  // TODO cull objects outside of render bounds
-
   const auto canvas_scale = canvas_renderer.get_scale();
   const auto scaled_pos = object.position * canvas_scale;
   const auto scaled_size = object.size * canvas_scale;
@@ -124,8 +117,22 @@ void _render_object_layer(const CanvasRenderer& canvas_renderer,
                           const Registry& registry,
                           const EntityID layer_id)
 {
-  const auto& object_layer = registry.get<CObjectLayer>(layer_id);
-  for (const auto object_id : object_layer.objects) {
+  // Objects are drawn slightly outside of their bounds, e.g., points are drawn as circles.
+  constexpr float kScreenMargin = 8.0f;
+
+  const auto canvas_scale = canvas_renderer.get_scale();
+  const auto& visible_region = canvas_renderer.get_visible_region();
+  const auto margin = Float2 {kScreenMargin, kScreenMargin} / canvas_scale;
+
+  std::vector<EntityID> visible_objects {};
+  query_objects(registry,
+                layer_id,
+                visible_region.begin / canvas_scale - margin,
+                visible_region.end / canvas_scale + margin,
+                visible_objects);
+
+  // The objects are provided in layer order, so later objects are drawn on top.
+  for (const auto object_id : visible_objects) {
     _render_object(canvas_renderer, registry, object_id);
   }
 }
@@ -159,6 +166,7 @@ void render_orthogonal_map(const CanvasRenderer& canvas_renderer,
                            const EntityID map_id)
 {
   TACTILE_ASSERT(is_map(registry, map_id));
+  TACTILE_PROFILE_ZONE("render_orthogonal_map");
 
   constexpr UColor bg_color {50, 50, 50, 255};
   constexpr UColor border_color {255, 0, 0, 255};
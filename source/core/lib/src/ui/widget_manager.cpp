@@ -29,6 +29,8 @@ void WidgetManager::push(const Model& model, EventDispatcher& dispatcher)
     mLogDock.push(model, dispatcher);
   }
 
+  mProfilerDock.push(language, dispatcher);
+
   mNewMapDialog.push(model, dispatcher);
   mNewTilesetDialog.push(model, dispatcher);
   mNewPropertyDialog.push(model, dispatcher);
@@ -48,6 +50,11 @@ auto WidgetManager::get_new_map_dialog() -> NewMapDialog&
   return mNewMapDialog;
 }
 
+auto WidgetManager::get_profiler_dock() -> ProfilerDock&
+{
+  return mProfilerDock;
+}
+
 auto WidgetManager::get_godot_export_dialog() -> GodotExportDialog&
 {
   return m_godot_export_dialog;
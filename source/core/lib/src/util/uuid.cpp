@@ -14,7 +14,8 @@ namespace tactile::core {
 
 auto UUID::generate() -> UUID
 {
-  static boost::uuids::random_generator uuid_generator {};
+  // The generator isn't thread-safe, and UUIDs are generated by converter threads.
+  thread_local boost::uuids::random_generator uuid_generator {};
   const auto value = uuid_generator();
 
   UUID uuid {};
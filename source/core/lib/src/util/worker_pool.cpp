@@ -0,0 +1,70 @@
+// Copyright (C) 2024 Albin Johansson (GNU General Public License v3.0)
+
+#include "tactile/core/util/worker_pool.hpp"
+
+#include <algorithm>  // max
+#include <utility>    // move
+
+namespace tactile::core {
+
+WorkerPool::WorkerPool(const std::size_t worker_count)
+  : mMutex {},
+    mTaskCondition {},
+    mTasks {},
+    mWorkers {}
+{
+  const auto thread_count = std::max(worker_count, std::size_t {1});
+  mWorkers.reserve(thread_count);
+
+  for (std::size_t index = 0; index < thread_count; ++index) {
+    mWorkers.emplace_back([this](const std::stop_token& stop_token) { _run(stop_token); });
+  }
+}
+
+WorkerPool::~WorkerPool() noexcept
+{
+  for (auto& worker : mWorkers) {
+    worker.request_stop();
+  }
+
+  mWorkers.clear();
+}
+
+void WorkerPool::_enqueue(std::function<void()> task)
+{
+  {
+    const std::scoped_lock lock {mMutex};
+    mTasks.push_back(std::move(task));
+  }
+
+  mTaskCondition.notify_one();
+}
+
+void WorkerPool::_run(const std::stop_token& stop_token)
+{
+  while (true) {
+    std::function<void()> task {};
+
+    {
+      std::unique_lock lock {mMutex};
+
+      // The wait stops early if a stop is requested, but queued tasks are still run.
+      mTaskCondition.wait(lock, stop_token, [this] { return !mTasks.empty(); });
+      if (mTasks.empty()) {
+        return;
+      }
+
+      task = std::move(mTasks.front());
+      mTasks.pop_front();
+    }
+
+    task();
+  }
+}
+
+auto WorkerPool::worker_count() const noexcept -> std::size_t
+{
+  return mWorkers.size();
+}
+
+}  // namespace tactile::core
@@ -0,0 +1,124 @@
+// Copyright (C) 2024 Albin Johansson (GNU General Public License v3.0)
+
+#include "tactile/core/cmd/command_journal.hpp"
+
+#include <algorithm>   // equal
+#include <cstddef>     // size_t
+#include <filesystem>  // path, temp_directory_path, remove, resize_file, file_size
+#include <fstream>     // ofstream
+#include <ios>         // ios
+#include <vector>      // vector
+
+#include <gtest/gtest.h>
+
+namespace tactile::core {
+namespace {
+
+inline constexpr CommandJournalKey kTestKey {.file_size = 1'234, .write_time = 42};
+
+[[nodiscard]]
+auto _make_record(const LayerID layer_id, const TileID new_tile) -> CommandJournalRecord
+{
+  CommandJournalRecord record {.layer_id = layer_id, .diff = TileDiff {}};
+  record.diff.record(Index2D {1, 2}, kEmptyTile, new_tile);
+  record.diff.record(Index2D {2, 2}, kEmptyTile, new_tile);
+  record.diff.record(Index2D {900, 700}, TileID {3}, new_tile);
+  return record;
+}
+
+}  // namespace
+
+// tactile::core::write_command_journal
+// tactile::core::read_command_journal
+TEST(CommandJournal, WriteAndRead)
+{
+  const auto path = std::filesystem::temp_directory_path() / "tactile_journal_1.journal";
+
+  const std::vector records {_make_record(1, TileID {7}), _make_record(-5, TileID {100'000})};
+
+  const auto write_result = write_command_journal(path, kTestKey, records, 1'024);
+  ASSERT_TRUE(write_result.has_value());
+  EXPECT_EQ(*write_result, 2);
+
+  const auto read_result = read_command_journal(path, kTestKey);
+  ASSERT_TRUE(read_result.has_value());
+  ASSERT_EQ(read_result->size(), 2);
+
+  for (std::size_t index = 0; index < records.size(); ++index) {
+    const auto& record = (*read_result)[index];
+    EXPECT_EQ(record.layer_id, records[index].layer_id);
+    EXPECT_EQ(record.diff.tile_count(), records[index].diff.tile_count());
+    EXPECT_TRUE(std::ranges::equal(record.diff.get_runs(), records[index].diff.get_runs()));
+  }
+
+  std::filesystem::remove(path);
+}
+
+// tactile::core::read_command_journal
+TEST(CommandJournal, ReadWithOutdatedKey)
+{
+  const auto path = std::filesystem::temp_directory_path() / "tactile_journal_2.journal";
+
+  const std::vector records {_make_record(1, TileID {7})};
+  ASSERT_TRUE(write_command_journal(path, kTestKey, records, 1'024).has_value());
+
+  const CommandJournalKey other_key {.file_size = 1'234, .write_time = 43};
+  EXPECT_EQ(read_command_journal(path, other_key).error(), ErrorCode::kBadState);
+
+  std::filesystem::remove(path);
+}
+
+// tactile::core::write_command_journal
+TEST(CommandJournal, WriteWithByteBudget)
+{
+  const auto path = std::filesystem::temp_directory_path() / "tactile_journal_3.journal";
+
+  const std::vector records {_make_record(1, TileID {1}),
+                             _make_record(2, TileID {2}),
+                             _make_record(3, TileID {4})};
+
+  // The header is 32 bytes and each record is 14 bytes.
+  const auto write_result = write_command_journal(path, kTestKey, records, 70);
+  ASSERT_TRUE(write_result.has_value());
+  EXPECT_EQ(*write_result, 2);
+  EXPECT_EQ(std::filesystem::file_size(path), 60);
+
+  // The oldest records are dropped first.
+  const auto read_result = read_command_journal(path, kTestKey);
+  ASSERT_TRUE(read_result.has_value());
+  ASSERT_EQ(read_result->size(), 2);
+  EXPECT_EQ(read_result->at(0).layer_id, 2);
+  EXPECT_EQ(read_result->at(1).layer_id, 3);
+
+  std::filesystem::remove(path);
+}
+
+// tactile::core::read_command_journal
+TEST(CommandJournal, ReadTruncatedJournal)
+{
+  const auto path = std::filesystem::temp_directory_path() / "tactile_journal_4.journal";
+
+  const std::vector records {_make_record(1, TileID {7})};
+  ASSERT_TRUE(write_command_journal(path, kTestKey, records, 1'024).has_value());
+
+  std::filesystem::resize_file(path, std::filesystem::file_size(path) - 1);
+  EXPECT_EQ(read_command_journal(path, kTestKey).error(), ErrorCode::kParseError);
+
+  {
+    std::ofstream stream {path, std::ios::out | std::ios::binary | std::ios::trunc};
+    stream << "not a journal";
+  }
+
+  EXPECT_EQ(read_command_journal(path, kTestKey).error(), ErrorCode::kParseError);
+
+  std::filesystem::remove(path);
+}
+
+// tactile::core::read_command_journal
+TEST(CommandJournal, ReadMissingJournal)
+{
+  const auto path = std::filesystem::temp_directory_path() / "tactile_journal_5.journal";
+  EXPECT_EQ(read_command_journal(path, kTestKey).error(), ErrorCode::kNoSuchFile);
+}
+
+}  // namespace tactile::core
@@ -2,6 +2,8 @@
 
 #include "tactile/core/cmd/command_stack.hpp"
 
+#include <cstddef>  // size_t
+
 #include <gtest/gtest.h>
 
 namespace tactile::core {
@@ -24,6 +26,85 @@ struct C2 final : ICommand
   {}
 };
 
+// Keeps more data alive when reverted, like commands that create entities.
+struct C3 final : ICommand
+{
+  explicit C3(const int size)
+    : memory_usage {static_cast<std::size_t>(size)}
+  {}
+
+  void undo() override
+  {
+    was_reverted = true;
+  }
+
+  void redo() override
+  {
+    was_reverted = false;
+  }
+
+  [[nodiscard]]
+  auto get_memory_usage() const -> std::size_t override
+  {
+    return was_reverted ? 2 * memory_usage : memory_usage;
+  }
+
+  std::size_t memory_usage;
+  bool was_reverted {false};
+};
+
+// Merges with other commands of the same type, and counts memory usage queries.
+struct C4 final : ICommand
+{
+  C4(const int size, int* query_count)
+    : memory_usage {static_cast<std::size_t>(size)},
+      query_count {query_count}
+  {}
+
+  void undo() override
+  {}
+
+  void redo() override
+  {}
+
+  [[nodiscard]]
+  auto merge_with(const ICommand* cmd) -> bool override
+  {
+    if (const auto* other = dynamic_cast<const C4*>(cmd)) {
+      memory_usage += other->memory_usage;
+      return true;
+    }
+
+    return false;
+  }
+
+  [[nodiscard]]
+  auto get_memory_usage() const -> std::size_t override
+  {
+    ++*query_count;
+    return memory_usage;
+  }
+
+  std::size_t memory_usage;
+  int* query_count;
+};
+
+struct CountingObserver final : ICommandObserver
+{
+  void on_command_executed(const ICommand&) override
+  {
+    ++executed_count;
+  }
+
+  void on_command_reverted(const ICommand&) override
+  {
+    ++reverted_count;
+  }
+
+  int executed_count {0};
+  int reverted_count {0};
+};
+
 // tactile::core::CommandStack::CommandStack
 TEST(CommandStack, Constructor)
 {
@@ -275,4 +356,132 @@ TEST(CommandStack, DynamicCapacityChange)
   EXPECT_EQ(stack.capacity(), 25);
 }
 
+// tactile::core::CommandStack::push
+// tactile::core::CommandStack::memory_usage
+TEST(CommandStack, MemoryBudgetOverflow)
+{
+  CommandStack stack {100, 1'000};
+  EXPECT_EQ(stack.memory_budget(), 1'000);
+  EXPECT_EQ(stack.memory_usage(), 0);
+
+  stack.push<C3>(400);
+  stack.push<C1>();
+  stack.push<C3>(400);
+  EXPECT_EQ(stack.size(), 3);
+  EXPECT_EQ(stack.memory_usage(), 800);
+
+  // The first command is removed to make room for the new command.
+  stack.push<C3>(300);
+  EXPECT_EQ(stack.size(), 3);
+  EXPECT_EQ(stack.index(), 2);
+  EXPECT_EQ(stack.memory_usage(), 700);
+
+  // The most recent command is kept, even if it exceeds the budget on its own.
+  stack.push<C3>(2'000);
+  EXPECT_EQ(stack.size(), 1);
+  EXPECT_EQ(stack.index(), 0);
+  EXPECT_EQ(stack.memory_usage(), 2'000);
+  EXPECT_TRUE(stack.can_undo());
+}
+
+// tactile::core::CommandStack::undo
+// tactile::core::CommandStack::redo
+TEST(CommandStack, MemoryUsageOfRevertedCommands)
+{
+  CommandStack stack {100, 1'000};
+
+  stack.push<C3>(300);
+  stack.push<C3>(300);
+  EXPECT_EQ(stack.memory_usage(), 600);
+
+  // [ C3, current:C3 ] -undo-> [ current:C3, C3 ]
+  stack.undo();
+  EXPECT_EQ(stack.size(), 2);
+  EXPECT_EQ(stack.memory_usage(), 900);
+
+  // [ current:C3, C3 ] -undo-> [ C3 ]
+  stack.undo();
+  EXPECT_EQ(stack.size(), 1);
+  EXPECT_EQ(stack.index(), std::nullopt);
+  EXPECT_EQ(stack.memory_usage(), 600);
+  EXPECT_TRUE(stack.can_redo());
+
+  stack.redo();
+  EXPECT_EQ(stack.memory_usage(), 300);
+  EXPECT_FALSE(stack.can_redo());
+}
+
+// tactile::core::CommandStack::push
+// tactile::core::CommandStack::undo
+TEST(CommandStack, CachedMemoryUsage)
+{
+  CommandStack stack {100, 1'000};
+  int query_count {0};
+
+  for (int index = 0; index < 10; ++index) {
+    stack.push<C1>();
+  }
+
+  stack.push<C4>(100, &query_count);
+  stack.push<C4>(200, &query_count);
+  EXPECT_EQ(stack.size(), 11);
+  EXPECT_EQ(stack.memory_usage(), 300);
+
+  // Only the pushed (or merged) command is queried, not the entire history.
+  EXPECT_EQ(query_count, 2);
+
+  stack.undo();
+  stack.undo();
+  EXPECT_EQ(query_count, 3);
+  EXPECT_EQ(stack.memory_usage(), 300);
+}
+
+// tactile::core::CommandStack::set_memory_budget
+TEST(CommandStack, DynamicMemoryBudgetChange)
+{
+  CommandStack stack {100};
+
+  for (int index = 0; index < 10; ++index) {
+    stack.push<C3>(100);
+  }
+
+  EXPECT_EQ(stack.size(), 10);
+  EXPECT_EQ(stack.memory_usage(), 1'000);
+
+  stack.set_memory_budget(450);
+  EXPECT_EQ(stack.size(), 4);
+  EXPECT_EQ(stack.index(), 3);
+  EXPECT_EQ(stack.memory_budget(), 450);
+  EXPECT_EQ(stack.memory_usage(), 400);
+
+  stack.set_memory_budget(1'000);
+  EXPECT_EQ(stack.size(), 4);
+  EXPECT_EQ(stack.memory_usage(), 400);
+}
+
+// tactile::core::CommandStack::set_observer
+TEST(CommandStack, Observer)
+{
+  CountingObserver observer {};
+
+  CommandStack stack {64};
+  stack.set_observer(&observer);
+
+  stack.push<C1>();
+  stack.store<C2>();
+  EXPECT_EQ(observer.executed_count, 2);
+  EXPECT_EQ(observer.reverted_count, 0);
+
+  stack.undo();
+  stack.undo();
+  EXPECT_EQ(observer.reverted_count, 2);
+
+  stack.redo();
+  EXPECT_EQ(observer.executed_count, 3);
+
+  stack.set_observer(nullptr);
+  stack.redo();
+  EXPECT_EQ(observer.executed_count, 3);
+}
+
 }  // namespace tactile::core
@@ -0,0 +1,100 @@
+// Copyright (C) 2024 Albin Johansson (GNU General Public License v3.0)
+
+#include "tactile/core/cmd/layer/bucket_fill_command.hpp"
+
+#include <optional>  // optional
+#include <utility>   // move
+
+#include <gtest/gtest.h>
+
+#include "tactile/core/cmd/layer/create_layer_command.hpp"
+#include "tactile/core/document/document_info.hpp"
+#include "tactile/core/document/map_document.hpp"
+#include "tactile/core/entity/registry.hpp"
+#include "tactile/core/layer/layer_types.hpp"
+#include "tactile/core/layer/tile_layer.hpp"
+#include "tactile/core/map/map.hpp"
+#include "test/document_testing.hpp"
+
+namespace tactile::core {
+
+class BucketFillCommandTest : public testing::Test
+{
+ protected:
+  void SetUp() override
+  {
+    {
+      auto document = MapDocument::make(kOrthogonalMapSpec);
+      ASSERT_TRUE(document.has_value());
+      mDocument = std::move(document.value());
+    }
+
+    auto& registry = mDocument->get_registry();
+    mMapId = registry.get<CDocumentInfo>().root;
+
+    CreateLayerCommand create_layer {&mDocument.value(), LayerType::kTileLayer};
+    create_layer.redo();
+
+    const auto& map = registry.get<CMap>(mMapId);
+    mLayerId = map.active_layer;
+  }
+
+  std::optional<MapDocument> mDocument;
+  EntityID mMapId {kInvalidEntity};
+  EntityID mLayerId {kInvalidEntity};
+};
+
+// tactile::core::BucketFillCommand::redo
+// tactile::core::BucketFillCommand::undo
+TEST_F(BucketFillCommandTest, RedoUndo)
+{
+  auto& registry = mDocument->get_registry();
+  const auto& extent = registry.get<CTileLayer>(mLayerId).extent;
+
+  const Index2D wall_index {.x = 0, .y = 1};
+  const Index2D last_index {.x = extent.cols - 1, .y = extent.rows - 1};
+  set_layer_tile(registry, mLayerId, wall_index, TileID {1});
+
+  BucketFillCommand fill {&mDocument.value(), mLayerId, Index2D {0, 0}, TileID {2}};
+
+  fill.redo();
+  EXPECT_EQ(get_layer_tile(registry, mLayerId, Index2D {0, 0}), TileID {2});
+  EXPECT_EQ(get_layer_tile(registry, mLayerId, last_index), TileID {2});
+  EXPECT_EQ(get_layer_tile(registry, mLayerId, wall_index), TileID {1});
+
+  fill.undo();
+  EXPECT_EQ(get_layer_tile(registry, mLayerId, Index2D {0, 0}), kEmptyTile);
+  EXPECT_EQ(get_layer_tile(registry, mLayerId, last_index), kEmptyTile);
+  EXPECT_EQ(get_layer_tile(registry, mLayerId, wall_index), TileID {1});
+
+  fill.redo();
+  EXPECT_EQ(get_layer_tile(registry, mLayerId, Index2D {0, 0}), TileID {2});
+  EXPECT_EQ(get_layer_tile(registry, mLayerId, last_index), TileID {2});
+  EXPECT_EQ(get_layer_tile(registry, mLayerId, wall_index), TileID {1});
+}
+
+// tactile::core::BucketFillCommand::redo
+// tactile::core::BucketFillCommand::undo
+TEST_F(BucketFillCommandTest, RedoUndoWithRegion)
+{
+  auto& registry = mDocument->get_registry();
+
+  const TileRegion region {
+    .begin = Index2D {.x = 1, .y = 1},
+    .end = Index2D {.x = 3, .y = 3},
+  };
+
+  BucketFillCommand fill {&mDocument.value(), mLayerId, Index2D {1, 1}, TileID {3}, region};
+
+  fill.redo();
+  EXPECT_EQ(get_layer_tile(registry, mLayerId, Index2D {1, 1}), TileID {3});
+  EXPECT_EQ(get_layer_tile(registry, mLayerId, Index2D {2, 2}), TileID {3});
+  EXPECT_EQ(get_layer_tile(registry, mLayerId, Index2D {0, 0}), kEmptyTile);
+  EXPECT_EQ(get_layer_tile(registry, mLayerId, Index2D {3, 3}), kEmptyTile);
+
+  fill.undo();
+  EXPECT_EQ(get_layer_tile(registry, mLayerId, Index2D {1, 1}), kEmptyTile);
+  EXPECT_EQ(get_layer_tile(registry, mLayerId, Index2D {2, 2}), kEmptyTile);
+}
+
+}  // namespace tactile::core
@@ -0,0 +1,95 @@
+// Copyright (C) 2024 Albin Johansson (GNU General Public License v3.0)
+
+#include "tactile/core/cmd/layer/erase_tiles_command.hpp"
+
+#include <optional>  // optional
+#include <utility>   // move
+
+#include <gtest/gtest.h>
+
+#include "tactile/core/cmd/command_stack.hpp"
+#include "tactile/core/cmd/layer/create_layer_command.hpp"
+#include "tactile/core/document/document_info.hpp"
+#include "tactile/core/document/map_document.hpp"
+#include "tactile/core/entity/registry.hpp"
+#include "tactile/core/layer/tile_layer.hpp"
+#include "tactile/core/map/map.hpp"
+#include "test/document_testing.hpp"
+
+namespace tactile::core {
+
+class EraseTilesCommandTest : public testing::Test
+{
+ protected:
+  void SetUp() override
+  {
+    {
+      auto document = MapDocument::make(kOrthogonalMapSpec);
+      ASSERT_TRUE(document.has_value());
+      mDocument = std::move(document.value());
+    }
+
+    auto& registry = mDocument->get_registry();
+    mMapId = registry.get<CDocumentInfo>().root;
+
+    CreateLayerCommand create_layer {&mDocument.value(), LayerType::kTileLayer};
+    create_layer.redo();
+
+    const auto& map = registry.get<CMap>(mMapId);
+    mLayerId = map.active_layer;
+
+    for (Index2D::value_type col = 0; col < 10; ++col) {
+      set_layer_tile(registry, mLayerId, Index2D {col, 0}, TileID {1});
+    }
+  }
+
+  std::optional<MapDocument> mDocument;
+  EntityID mMapId {kInvalidEntity};
+  EntityID mLayerId {kInvalidEntity};
+};
+
+// tactile::core::EraseTilesCommand::redo
+// tactile::core::EraseTilesCommand::undo
+TEST_F(EraseTilesCommandTest, RedoUndo)
+{
+  auto& registry = mDocument->get_registry();
+
+  EraseTilesCommand erase {&mDocument.value(), mLayerId, 1, Index2D {3, 0}};
+
+  erase.redo();
+  EXPECT_EQ(get_layer_tile(registry, mLayerId, Index2D {3, 0}), kEmptyTile);
+  EXPECT_EQ(get_layer_tile(registry, mLayerId, Index2D {4, 0}), TileID {1});
+
+  erase.undo();
+  EXPECT_EQ(get_layer_tile(registry, mLayerId, Index2D {3, 0}), TileID {1});
+
+  erase.redo();
+  EXPECT_EQ(get_layer_tile(registry, mLayerId, Index2D {3, 0}), kEmptyTile);
+}
+
+// tactile::core::EraseTilesCommand::merge_with
+TEST_F(EraseTilesCommandTest, MergeStrokeSamples)
+{
+  auto& registry = mDocument->get_registry();
+
+  CommandStack commands {10};
+
+  for (Index2D::value_type col = 0; col < 10; ++col) {
+    commands.push<EraseTilesCommand>(&mDocument.value(), mLayerId, 1, Index2D {col, 0});
+  }
+
+  EXPECT_EQ(commands.size(), 1);
+  EXPECT_EQ(get_layer_tile(registry, mLayerId, Index2D {9, 0}), kEmptyTile);
+
+  commands.undo();
+  for (Index2D::value_type col = 0; col < 10; ++col) {
+    EXPECT_EQ(get_layer_tile(registry, mLayerId, Index2D {col, 0}), TileID {1});
+  }
+
+  commands.redo();
+  for (Index2D::value_type col = 0; col < 10; ++col) {
+    EXPECT_EQ(get_layer_tile(registry, mLayerId, Index2D {col, 0}), kEmptyTile);
+  }
+}
+
+}  // namespace tactile::core
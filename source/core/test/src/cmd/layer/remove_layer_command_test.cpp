@@ -8,11 +8,14 @@
 #include <gtest/gtest.h>
 
 #include "tactile/core/cmd/layer/create_layer_command.hpp"
+#include "tactile/core/cmd/undo_payload_store.hpp"
 #include "tactile/core/document/document_info.hpp"
 #include "tactile/core/document/map_document.hpp"
 #include "tactile/core/entity/registry.hpp"
 #include "tactile/core/layer/group_layer.hpp"
 #include "tactile/core/layer/layer.hpp"
+#include "tactile/core/layer/layer_types.hpp"
+#include "tactile/core/layer/tile_layer.hpp"
 #include "tactile/core/map/map.hpp"
 #include "test/document_testing.hpp"
 
@@ -144,4 +147,40 @@ TEST_F(RemoveLayerCommandTest, Dispose)
   EXPECT_FALSE(is_layer(registry, layer_id));
 }
 
+// tactile::core::RemoveLayerCommand::redo
+// tactile::core::RemoveLayerCommand::undo
+TEST_F(RemoveLayerCommandTest, OffloadLargeTileLayer)
+{
+  auto& registry = mDocument->get_registry();
+  const auto& payload_store = mDocument->get_undo_payload_store();
+
+  const auto layer_id = add_layer(LayerType::kTileLayer);
+  resize_tile_layer(registry, layer_id, Extent2D {.rows = 100, .cols = 80});
+
+  set_layer_tile(registry, layer_id, Index2D {.x = 0, .y = 0}, TileID {1});
+  set_layer_tile(registry, layer_id, Index2D {.x = 79, .y = 42}, TileID {2});
+  set_layer_tile(registry, layer_id, Index2D {.x = 13, .y = 99}, TileID {3});
+
+  const auto original_tiles = registry.get<CDenseTileLayer>(layer_id).tiles;
+
+  RemoveLayerCommand remove_layer {&mDocument.value(), layer_id};
+
+  remove_layer.redo();
+  EXPECT_EQ(payload_store.payload_count(), 1);
+  EXPECT_TRUE(registry.get<CDenseTileLayer>(layer_id).tiles.empty());
+  EXPECT_LT(remove_layer.get_memory_usage(), 100 * 80 * sizeof(TileID) / 8);
+
+  remove_layer.undo();
+  EXPECT_EQ(payload_store.payload_count(), 0);
+  EXPECT_EQ(registry.get<CDenseTileLayer>(layer_id).tiles, original_tiles);
+  EXPECT_EQ(remove_layer.get_memory_usage(), 0);
+
+  remove_layer.redo();
+  EXPECT_EQ(payload_store.payload_count(), 1);
+
+  remove_layer.dispose();
+  EXPECT_EQ(payload_store.payload_count(), 0);
+  EXPECT_FALSE(registry.is_valid(layer_id));
+}
+
 }  // namespace tactile::core
@@ -0,0 +1,114 @@
+// Copyright (C) 2024 Albin Johansson (GNU General Public License v3.0)
+
+#include "tactile/core/cmd/layer/stamp_tiles_command.hpp"
+
+#include <optional>  // optional
+#include <utility>   // move
+
+#include <gtest/gtest.h>
+
+#include "tactile/core/cmd/command_stack.hpp"
+#include "tactile/core/cmd/layer/create_layer_command.hpp"
+#include "tactile/core/document/document_info.hpp"
+#include "tactile/core/document/map_document.hpp"
+#include "tactile/core/entity/registry.hpp"
+#include "tactile/core/layer/tile_layer.hpp"
+#include "tactile/core/map/map.hpp"
+#include "test/document_testing.hpp"
+
+namespace tactile::core {
+
+class StampTilesCommandTest : public testing::Test
+{
+ protected:
+  void SetUp() override
+  {
+    {
+      auto document = MapDocument::make(kOrthogonalMapSpec);
+      ASSERT_TRUE(document.has_value());
+      mDocument = std::move(document.value());
+    }
+
+    auto& registry = mDocument->get_registry();
+    mMapId = registry.get<CDocumentInfo>().root;
+
+    CreateLayerCommand create_layer {&mDocument.value(), LayerType::kTileLayer};
+    create_layer.redo();
+
+    const auto& map = registry.get<CMap>(mMapId);
+    mLayerId = map.active_layer;
+  }
+
+  std::optional<MapDocument> mDocument;
+  EntityID mMapId {kInvalidEntity};
+  EntityID mLayerId {kInvalidEntity};
+};
+
+// tactile::core::StampTilesCommand::redo
+// tactile::core::StampTilesCommand::undo
+TEST_F(StampTilesCommandTest, RedoUndo)
+{
+  auto& registry = mDocument->get_registry();
+  set_layer_tile(registry, mLayerId, Index2D {2, 2}, TileID {9});
+
+  const TileMatrix pattern {
+    {TileID {1}, TileID {2}},
+    {kEmptyTile, TileID {3}},
+  };
+
+  StampTilesCommand stamp {&mDocument.value(), mLayerId, 1, Index2D {1, 1}, pattern};
+
+  stamp.redo();
+  EXPECT_EQ(get_layer_tile(registry, mLayerId, Index2D {1, 1}), TileID {1});
+  EXPECT_EQ(get_layer_tile(registry, mLayerId, Index2D {2, 1}), TileID {2});
+  EXPECT_EQ(get_layer_tile(registry, mLayerId, Index2D {1, 2}), kEmptyTile);
+  EXPECT_EQ(get_layer_tile(registry, mLayerId, Index2D {2, 2}), TileID {3});
+
+  stamp.undo();
+  EXPECT_EQ(get_layer_tile(registry, mLayerId, Index2D {1, 1}), kEmptyTile);
+  EXPECT_EQ(get_layer_tile(registry, mLayerId, Index2D {2, 1}), kEmptyTile);
+  EXPECT_EQ(get_layer_tile(registry, mLayerId, Index2D {2, 2}), TileID {9});
+
+  stamp.redo();
+  EXPECT_EQ(get_layer_tile(registry, mLayerId, Index2D {1, 1}), TileID {1});
+  EXPECT_EQ(get_layer_tile(registry, mLayerId, Index2D {2, 2}), TileID {3});
+}
+
+// tactile::core::StampTilesCommand::merge_with
+TEST_F(StampTilesCommandTest, MergeStrokeSamples)
+{
+  auto* document = &mDocument.value();
+  auto& registry = document->get_registry();
+  const TileMatrix pattern {{TileID {5}}};
+
+  CommandStack commands {10};
+
+  // Overlapping samples of the same stroke.
+  for (Index2D::value_type col = 0; col < 8; ++col) {
+    commands.push<StampTilesCommand>(document, mLayerId, 1, Index2D {col, 0}, pattern);
+    commands.push<StampTilesCommand>(document, mLayerId, 1, Index2D {col, 0}, pattern);
+  }
+
+  // A separate stroke.
+  commands.push<StampTilesCommand>(document, mLayerId, 2, Index2D {0, 1}, pattern);
+
+  EXPECT_EQ(commands.size(), 2);
+  EXPECT_EQ(get_layer_tile(registry, mLayerId, Index2D {7, 0}), TileID {5});
+  EXPECT_EQ(get_layer_tile(registry, mLayerId, Index2D {0, 1}), TileID {5});
+
+  commands.undo();
+  EXPECT_EQ(get_layer_tile(registry, mLayerId, Index2D {0, 1}), kEmptyTile);
+  EXPECT_EQ(get_layer_tile(registry, mLayerId, Index2D {7, 0}), TileID {5});
+
+  commands.undo();
+  for (Index2D::value_type col = 0; col < 8; ++col) {
+    EXPECT_EQ(get_layer_tile(registry, mLayerId, Index2D {col, 0}), kEmptyTile);
+  }
+
+  commands.redo();
+  for (Index2D::value_type col = 0; col < 8; ++col) {
+    EXPECT_EQ(get_layer_tile(registry, mLayerId, Index2D {col, 0}), TileID {5});
+  }
+}
+
+}  // namespace tactile::core
@@ -0,0 +1,212 @@
+// Copyright (C) 2024 Albin Johansson (GNU General Public License v3.0)
+
+#include "tactile/core/cmd/undo_payload_store.hpp"
+
+#include <cstddef>     // size_t
+#include <cstdint>     // uint8_t
+#include <filesystem>  // temp_directory_path, create_directories, exists
+#include <fstream>     // ofstream
+
+#include <gtest/gtest.h>
+
+#include "tactile/base/io/compress/compression_format.hpp"
+
+namespace tactile::core {
+namespace {
+
+class FakeCompressionFormat final : public ICompressionFormat
+{
+ public:
+  [[nodiscard]]
+  auto compress(const ByteSpan input_data) const
+      -> std::expected<ByteStream, ErrorCode> override
+  {
+    ++compress_count;
+    last_input.assign(input_data.begin(), input_data.end());
+    return ByteStream {0x42};
+  }
+
+  [[nodiscard]]
+  auto decompress(ByteSpan) const -> std::expected<ByteStream, ErrorCode> override
+  {
+    ++decompress_count;
+    return last_input;
+  }
+
+  mutable ByteStream last_input {};
+  mutable int compress_count {0};
+  mutable int decompress_count {0};
+};
+
+[[nodiscard]]
+auto _make_tile_like_bytes(const std::size_t size) -> ByteStream
+{
+  ByteStream bytes(size, 0);
+  for (std::size_t index = 0; index < size; index += 512) {
+    bytes[index] = static_cast<std::uint8_t>(index / 512);
+  }
+
+  return bytes;
+}
+
+[[nodiscard]]
+auto _make_noisy_bytes(const std::size_t size) -> ByteStream
+{
+  ByteStream bytes(size);
+
+  std::uint32_t state {0x12345678};
+  for (auto& byte : bytes) {
+    state = state * 1'664'525u + 1'013'904'223u;
+    byte = static_cast<std::uint8_t>(state >> 24u);
+  }
+
+  return bytes;
+}
+
+}  // namespace
+
+// tactile::core::UndoPayloadStore::store
+// tactile::core::UndoPayloadStore::load
+TEST(UndoPayloadStore, StoreSmallPayload)
+{
+  UndoPayloadStore store {};
+
+  const ByteStream bytes {1, 2, 3, 4, 5};
+  const auto id = store.store(bytes);
+
+  EXPECT_EQ(store.payload_count(), 1);
+  EXPECT_EQ(store.get_resident_size(id), bytes.size());
+  EXPECT_EQ(store.get_resident_size(), bytes.size());
+  EXPECT_EQ(store.load(id), bytes);
+}
+
+// tactile::core::UndoPayloadStore::store
+// tactile::core::UndoPayloadStore::load
+TEST(UndoPayloadStore, CompressRepetitivePayload)
+{
+  UndoPayloadStore store {};
+
+  const auto bytes = _make_tile_like_bytes(64 * 1'024 + 3);
+  const auto id = store.store(bytes);
+
+  EXPECT_LT(store.get_resident_size(id), bytes.size() / 16);
+  EXPECT_EQ(store.load(id), bytes);
+}
+
+// tactile::core::UndoPayloadStore::store
+// tactile::core::UndoPayloadStore::load
+TEST(UndoPayloadStore, StoreIncompressiblePayload)
+{
+  UndoPayloadStore store {};
+
+  const auto bytes = _make_noisy_bytes(10'001);
+  const auto id = store.store(bytes);
+
+  EXPECT_EQ(store.get_resident_size(id), bytes.size());
+  EXPECT_EQ(store.load(id), bytes);
+}
+
+// tactile::core::UndoPayloadStore::release
+TEST(UndoPayloadStore, Release)
+{
+  UndoPayloadStore store {};
+
+  const auto id1 = store.store(_make_noisy_bytes(100));
+  const auto id2 = store.store(_make_noisy_bytes(200));
+  EXPECT_NE(id1, id2);
+  EXPECT_EQ(store.get_resident_size(), 300);
+
+  store.release(id1);
+  EXPECT_EQ(store.payload_count(), 1);
+  EXPECT_EQ(store.get_resident_size(), 200);
+  EXPECT_EQ(store.load(id1).error(), ErrorCode::kBadParam);
+
+  store.release(id1);
+  EXPECT_EQ(store.payload_count(), 1);
+
+  store.release(id2);
+  EXPECT_EQ(store.payload_count(), 0);
+  EXPECT_EQ(store.get_resident_size(), 0);
+}
+
+// tactile::core::UndoPayloadStore::set_spill_threshold
+TEST(UndoPayloadStore, SpillPayloads)
+{
+  UndoPayloadStore store {};
+
+  const auto bytes1 = _make_noisy_bytes(3'000);
+  const auto bytes2 = _make_tile_like_bytes(8'000);
+  const auto bytes3 = _make_noisy_bytes(2'000);
+
+  const auto id1 = store.store(bytes1);
+  const auto id2 = store.store(bytes2);
+  const auto id3 = store.store(bytes3);
+
+  // The oldest payloads are spilled first.
+  store.set_spill_threshold(2'100);
+  EXPECT_EQ(store.get_resident_size(id1), 0);
+  EXPECT_EQ(store.get_resident_size(id2), 0);
+  EXPECT_EQ(store.get_resident_size(id3), bytes3.size());
+  EXPECT_EQ(store.get_resident_size(), bytes3.size());
+
+  EXPECT_EQ(store.load(id1), bytes1);
+  EXPECT_EQ(store.load(id2), bytes2);
+  EXPECT_EQ(store.load(id3), bytes3);
+
+  store.release(id1);
+  EXPECT_EQ(store.payload_count(), 2);
+  EXPECT_EQ(store.get_resident_size(), bytes3.size());
+
+  store.set_spill_threshold(0);
+  EXPECT_EQ(store.get_resident_size(), 0);
+  EXPECT_EQ(store.load(id3), bytes3);
+}
+
+// tactile::core::remove_stale_undo_spill_directories
+TEST(UndoPayloadStore, RemoveStaleUndoSpillDirectories)
+{
+  const auto stale_dir =
+      std::filesystem::temp_directory_path() / "tactile" / "undo-stale-spill-test";
+  std::filesystem::create_directories(stale_dir);
+  std::ofstream {stale_dir / "spill.lock"};
+  std::ofstream {stale_dir / "1.bin"} << "abc";
+
+  UndoPayloadStore store {};
+
+  const auto bytes = _make_noisy_bytes(3'000);
+  const auto id = store.store(bytes);
+
+  store.set_spill_threshold(0);
+  ASSERT_EQ(store.get_resident_size(id), 0);
+
+  EXPECT_GE(remove_stale_undo_spill_directories(), 1);
+  EXPECT_FALSE(std::filesystem::exists(stale_dir));
+
+  // The spill directory of the store is locked, so it's left alone.
+  EXPECT_EQ(store.load(id), bytes);
+}
+
+// tactile::core::UndoPayloadStore::set_compression_format
+TEST(UndoPayloadStore, UseCompressionFormat)
+{
+  const FakeCompressionFormat compression_format {};
+
+  UndoPayloadStore store {};
+  store.set_compression_format(&compression_format);
+
+  const auto small_id = store.store(ByteStream {1, 2, 3});
+  EXPECT_EQ(compression_format.compress_count, 0);
+
+  const auto bytes = _make_noisy_bytes(4'096);
+  const auto id = store.store(bytes);
+  EXPECT_EQ(compression_format.compress_count, 1);
+  EXPECT_EQ(store.get_resident_size(id), 1);
+
+  EXPECT_EQ(store.load(id), bytes);
+  EXPECT_EQ(compression_format.decompress_count, 1);
+
+  EXPECT_EQ(store.load(small_id), (ByteStream {1, 2, 3}));
+  EXPECT_EQ(compression_format.decompress_count, 1);
+}
+
+}  // namespace tactile::core
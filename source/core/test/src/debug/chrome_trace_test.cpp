@@ -0,0 +1,95 @@
+// Copyright (C) 2024 Albin Johansson (GNU General Public License v3.0)
+
+#include "tactile/core/debug/chrome_trace.hpp"
+
+#include <array>       // array
+#include <filesystem>  // temp_directory_path, remove
+#include <fstream>     // ofstream
+#include <sstream>     // ostringstream
+
+#include "tactile/base/io/file_io.hpp"
+
+#include <gtest/gtest.h>
+
+namespace tactile::core {
+
+/// \trace tactile::core::write_chrome_trace
+TEST(ChromeTrace, WriteEmptyTrace)
+{
+  std::ostringstream stream {};
+  write_chrome_trace(stream, {});
+
+  const auto trace = stream.str();
+  EXPECT_EQ(trace.front(), '{');
+  EXPECT_NE(trace.find(R"("traceEvents":[)"), std::string::npos);
+  EXPECT_EQ(trace.find(R"("ph":"X")"), std::string::npos);
+}
+
+/// \trace tactile::core::write_chrome_trace
+TEST(ChromeTrace, WriteEvents)
+{
+  const std::array events {
+    ProfileZoneEvent {
+      .name = "outer",
+      .thread_index = 0,
+      .depth = 0,
+      .start_ns = 1'000,
+      .duration_ns = 5'000,
+    },
+    ProfileZoneEvent {
+      .name = "\"quoted\"",
+      .thread_index = 1,
+      .depth = 1,
+      .start_ns = 2'000,
+      .duration_ns = 1'000,
+    },
+  };
+
+  std::ostringstream stream {};
+  write_chrome_trace(stream, events);
+
+  const auto trace = stream.str();
+  EXPECT_NE(trace.find(R"("name":"outer")"), std::string::npos);
+  EXPECT_NE(trace.find(R"("name":"\"quoted\"")"), std::string::npos);
+  EXPECT_NE(trace.find(R"("ph":"X")"), std::string::npos);
+  EXPECT_NE(trace.find(R"("tid":1)"), std::string::npos);
+  EXPECT_NE(trace.find(R"("ph":"M")"), std::string::npos);
+  EXPECT_NE(trace.rfind("]}"), std::string::npos);
+}
+
+/// \trace tactile::core::save_chrome_trace
+TEST(ChromeTrace, SaveTrace)
+{
+  const auto trace_path = std::filesystem::temp_directory_path() / "tactile_trace_test.json";
+  std::ofstream {trace_path} << "old trace";
+
+  const std::array events {
+    ProfileZoneEvent {
+      .name = "zone",
+      .thread_index = 0,
+      .depth = 0,
+      .start_ns = 1'000,
+      .duration_ns = 1'000,
+    },
+  };
+
+  ASSERT_TRUE(save_chrome_trace(trace_path, events).has_value());
+
+  std::ostringstream stream {};
+  write_chrome_trace(stream, events);
+  EXPECT_EQ(read_binary_file(trace_path), stream.str());
+
+  std::filesystem::remove(trace_path);
+}
+
+/// \trace tactile::core::save_chrome_trace
+TEST(ChromeTrace, SaveTraceToMissingDirectory)
+{
+  const auto trace_path =
+      std::filesystem::temp_directory_path() / "tactile_missing_dir" / "trace.json";
+
+  EXPECT_FALSE(save_chrome_trace(trace_path, {}).has_value());
+  EXPECT_FALSE(std::filesystem::exists(trace_path));
+}
+
+}  // namespace tactile::core
@@ -0,0 +1,196 @@
+// Copyright (C) 2024 Albin Johansson (GNU General Public License v3.0)
+
+#include "tactile/core/debug/profiler.hpp"
+
+#include <algorithm>    // find_if
+#include <cstddef>      // size_t
+#include <string_view>  // string_view
+#include <thread>       // thread
+
+#include <gtest/gtest.h>
+
+namespace tactile::core {
+
+class ProfilerTest : public testing::Test
+{
+ public:
+  void SetUp() override
+  {
+    set_profiler_enabled(true);
+    reset_profiler();
+  }
+
+  void TearDown() override
+  {
+    set_profiler_enabled(true);
+    reset_profiler();
+  }
+
+  [[nodiscard]]
+  static auto find_zone(const ProfilerFrameStats& stats, const std::string_view name)
+      -> const ProfileZoneStats*
+  {
+    const auto iter = std::ranges::find_if(stats.zones, [name](const ProfileZoneStats& zone) {
+      return zone.name == name;
+    });
+
+    return iter != stats.zones.end() ? &*iter : nullptr;
+  }
+};
+
+/// \trace tactile::core::mark_profiler_frame
+/// \trace tactile::core::get_profiler_frame_stats
+TEST_F(ProfilerTest, NestedZones)
+{
+  EXPECT_TRUE(get_profiler_frame_stats().frame_times_ms.empty());
+
+  mark_profiler_frame();
+
+  {
+    const ProfileZone outer_zone {"outer"};
+    const ProfileZone inner_zone {"inner"};
+  }
+
+  mark_profiler_frame();
+
+  const auto stats = get_profiler_frame_stats();
+  ASSERT_EQ(stats.frame_times_ms.size(), 2);
+  ASSERT_EQ(stats.zones.size(), 2);
+
+  // Zones are sorted by name.
+  EXPECT_EQ(stats.zones.at(0).name, "inner");
+  EXPECT_EQ(stats.zones.at(1).name, "outer");
+
+  for (const auto& zone : stats.zones) {
+    ASSERT_EQ(zone.frame_times_ms.size(), 2);
+    EXPECT_EQ(zone.frame_times_ms.front(), 0.0f);
+    EXPECT_GE(zone.frame_times_ms.back(), 0.0f);
+    EXPECT_GE(zone.max_ms, zone.average_ms);
+  }
+
+  const auto& inner = stats.zones.at(0);
+  const auto& outer = stats.zones.at(1);
+  EXPECT_LE(inner.frame_times_ms.back(), outer.frame_times_ms.back());
+}
+
+/// \trace tactile::core::set_profiler_enabled
+/// \trace tactile::core::is_profiler_enabled
+TEST_F(ProfilerTest, DisabledProfiler)
+{
+  set_profiler_enabled(false);
+  EXPECT_FALSE(is_profiler_enabled());
+
+  {
+    TACTILE_PROFILE_ZONE("disabled");
+  }
+
+  mark_profiler_frame();
+  EXPECT_TRUE(get_profiler_frame_stats().zones.empty());
+
+  set_profiler_enabled(true);
+  EXPECT_TRUE(is_profiler_enabled());
+}
+
+/// \trace tactile::core::begin_profile_zone
+/// \trace tactile::core::end_profile_zone
+TEST_F(ProfilerTest, ZonesFromOtherThreads)
+{
+  std::thread worker {[] {
+    begin_profile_zone("worker");
+    end_profile_zone();
+
+    // Unmatched calls should have no effect.
+    end_profile_zone();
+  }};
+  worker.join();
+
+  mark_profiler_frame();
+
+  const auto stats = get_profiler_frame_stats();
+  EXPECT_NE(find_zone(stats, "worker"), nullptr);
+}
+
+/// \trace tactile::core::begin_profile_zone
+/// \trace tactile::core::end_profile_zone
+TEST_F(ProfilerTest, ReuseBuffersOfExitedThreads)
+{
+  start_profiler_capture();
+
+  std::thread first_worker {[] { TACTILE_PROFILE_ZONE("first"); }};
+  first_worker.join();
+
+  // The events of the first thread haven't been read when its buffer is reused.
+  std::thread second_worker {[] { TACTILE_PROFILE_ZONE("second"); }};
+  second_worker.join();
+
+  mark_profiler_frame();
+  const auto events = stop_profiler_capture();
+
+  const auto find_event = [&events](const std::string_view name) {
+    return std::ranges::find_if(events, [name](const ProfileZoneEvent& event) {
+      return event.name == name;
+    });
+  };
+
+  const auto first_event = find_event("first");
+  const auto second_event = find_event("second");
+  ASSERT_NE(first_event, events.end());
+  ASSERT_NE(second_event, events.end());
+
+  EXPECT_EQ(first_event->thread_index, second_event->thread_index);
+}
+
+/// \trace tactile::core::mark_profiler_frame
+TEST_F(ProfilerTest, FrameHistoryCapacity)
+{
+  for (std::size_t frame = 0; frame < kProfilerFrameCapacity + 10; ++frame) {
+    TACTILE_PROFILE_ZONE("frame");
+    mark_profiler_frame();
+  }
+
+  const auto stats = get_profiler_frame_stats();
+  EXPECT_EQ(stats.frame_times_ms.size(), kProfilerFrameCapacity);
+
+  const auto* zone = find_zone(stats, "frame");
+  ASSERT_NE(zone, nullptr);
+  EXPECT_EQ(zone->frame_times_ms.size(), kProfilerFrameCapacity);
+}
+
+/// \trace tactile::core::start_profiler_capture
+/// \trace tactile::core::stop_profiler_capture
+/// \trace tactile::core::is_profiler_capturing
+TEST_F(ProfilerTest, Capture)
+{
+  EXPECT_FALSE(is_profiler_capturing());
+
+  {
+    TACTILE_PROFILE_ZONE("before");
+  }
+
+  mark_profiler_frame();
+
+  start_profiler_capture();
+  EXPECT_TRUE(is_profiler_capturing());
+
+  for (int frame = 0; frame < 3; ++frame) {
+    {
+      TACTILE_PROFILE_ZONE("captured");
+    }
+
+    mark_profiler_frame();
+  }
+
+  const auto events = stop_profiler_capture();
+  EXPECT_FALSE(is_profiler_capturing());
+
+  ASSERT_EQ(events.size(), 3);
+  for (const auto& event : events) {
+    EXPECT_EQ(std::string_view {event.name}, "captured");
+    EXPECT_EQ(event.depth, 0);
+    EXPECT_GE(event.duration_ns, 0);
+  }
+
+  EXPECT_TRUE(stop_profiler_capture().empty());
+}
+
+}  // namespace tactile::core
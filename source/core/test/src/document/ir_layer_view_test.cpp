@@ -0,0 +1,134 @@
+// Copyright (C) 2024 Albin Johansson (GNU General Public License v3.0)
+
+#include "tactile/core/document/ir_layer_view.hpp"
+
+#include <cstddef>  // size_t
+#include <vector>   // vector
+
+#include <gtest/gtest.h>
+
+#include "tactile/base/document/document_visitor.hpp"
+#include "tactile/base/document/layer_view.hpp"
+#include "tactile/base/document/object_view.hpp"
+#include "tactile/core/document/ir_map_view.hpp"
+#include "tactile/test_util/ir.hpp"
+#include "tactile/test_util/ir_presets.hpp"
+
+namespace tactile::core {
+namespace {
+
+class LayerIndexVisitor final : public IDocumentVisitor
+{
+ public:
+  auto visit(const IComponentView&) -> std::expected<void, ErrorCode> override
+  {
+    return {};
+  }
+
+  auto visit(const IMapView&) -> std::expected<void, ErrorCode> override
+  {
+    return {};
+  }
+
+  auto visit(const ILayerView& layer) -> std::expected<void, ErrorCode> override
+  {
+    layer_indices.push_back(layer.get_global_index());
+
+    const auto* parent_layer = layer.get_parent_layer();
+    parent_indices.push_back(parent_layer ? parent_layer->get_global_index() : kNoParent);
+
+    return {};
+  }
+
+  auto visit(const IObjectView& object) -> std::expected<void, ErrorCode> override
+  {
+    if (const auto* parent_layer = object.get_parent_layer()) {
+      object_layer_indices.push_back(parent_layer->get_global_index());
+    }
+
+    return {};
+  }
+
+  auto visit(const ITilesetView&) -> std::expected<void, ErrorCode> override
+  {
+    return {};
+  }
+
+  auto visit(const ITileView&) -> std::expected<void, ErrorCode> override
+  {
+    return {};
+  }
+
+  static constexpr std::size_t kNoParent = 999;
+
+  std::vector<std::size_t> layer_indices {};
+  std::vector<std::size_t> parent_indices {};
+  std::vector<std::size_t> object_layer_indices {};
+};
+
+}  // namespace
+
+class IrLayerViewTest : public testing::Test
+{
+ protected:
+  ir::Map mMap {test::make_complex_ir_map(test::make_ir_tile_format())};
+};
+
+// tactile::core::IrLayerView::accept
+// tactile::core::IrLayerView::get_global_index
+// tactile::core::count_ir_layers
+TEST_F(IrLayerViewTest, GlobalIndices)
+{
+  constexpr auto kNone = LayerIndexVisitor::kNoParent;
+
+  const IrMapView map_view {&mMap, nullptr};
+  EXPECT_EQ(map_view.layer_count(), 12);
+  EXPECT_EQ(count_ir_layers(mMap.layers.at(2)), 10);
+
+  LayerIndexVisitor visitor {};
+  ASSERT_TRUE(map_view.accept(visitor).has_value());
+
+  const std::vector<std::size_t> expected_layer_indices {0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11};
+  const std::vector<std::size_t> expected_parent_indices {
+    kNone, kNone, kNone, 2, 2, 2, 5, 5, 7, 7, 7, 5,
+  };
+  const std::vector<std::size_t> expected_object_layer_indices {1, 1, 1, 9, 9, 9};
+
+  EXPECT_EQ(visitor.layer_indices, expected_layer_indices);
+  EXPECT_EQ(visitor.parent_indices, expected_parent_indices);
+  EXPECT_EQ(visitor.object_layer_indices, expected_object_layer_indices);
+}
+
+// tactile::core::IrLayerView::get_tile
+// tactile::core::IrLayerView::get_tile_position_in_tileset
+// tactile::core::IrLayerView::is_tile_animated
+TEST_F(IrLayerViewTest, Tiles)
+{
+  const IrLayerView tile_layer_view {&mMap, &mMap.layers.at(0), nullptr, 0};
+
+  EXPECT_EQ(tile_layer_view.get_type(), LayerType::kTileLayer);
+  EXPECT_EQ(tile_layer_view.get_extent(), mMap.extent);
+  EXPECT_EQ(tile_layer_view.get_tile(Index2D {0, 0}), TileID {1});
+  EXPECT_EQ(tile_layer_view.get_tile(Index2D {9, 0}), TileID {10});
+  EXPECT_EQ(tile_layer_view.get_tile(Index2D {10, 0}), std::nullopt);
+
+  // The tileset contains tiles [10, 33], with 6 columns.
+  EXPECT_EQ(tile_layer_view.get_tile_position_in_tileset(TileID {1}), std::nullopt);
+  EXPECT_EQ(tile_layer_view.get_tile_position_in_tileset(TileID {10}), (Index2D {0, 0}));
+  EXPECT_EQ(tile_layer_view.get_tile_position_in_tileset(TileID {17}), (Index2D {1, 1}));
+  EXPECT_EQ(tile_layer_view.get_tile_position_in_tileset(TileID {34}), std::nullopt);
+
+  // Only the first three tiles in the tileset are animated.
+  EXPECT_FALSE(tile_layer_view.is_tile_animated(Index2D {0, 0}));
+  EXPECT_TRUE(tile_layer_view.is_tile_animated(Index2D {9, 0}));
+  EXPECT_FALSE(tile_layer_view.is_tile_animated(Index2D {2, 1}));
+
+  const IrLayerView object_layer_view {&mMap, &mMap.layers.at(1), nullptr, 1};
+
+  EXPECT_EQ(object_layer_view.get_type(), LayerType::kObjectLayer);
+  EXPECT_EQ(object_layer_view.get_extent(), std::nullopt);
+  EXPECT_EQ(object_layer_view.get_tile(Index2D {0, 0}), std::nullopt);
+  EXPECT_EQ(object_layer_view.object_count(), 3);
+}
+
+}  // namespace tactile::core
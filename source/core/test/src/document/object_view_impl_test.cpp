@@ -95,9 +95,7 @@ TEST_F(ObjectViewImplTest, ObjectInTile)
   auto& registry = mDocument.get_registry();
 
   const auto tileset_id = make_tileset(registry, kDummyTilesetSpec);
-  const auto& tileset = registry.get<CTileset>(tileset_id);
-
-  const auto tile_id = tileset.tiles.front();
+  const auto tile_id = get_or_make_tile(registry, tileset_id, TileIndex {0});
   const auto object_id = make_object(registry, ObjectID {1}, ObjectType::kRect);
 
   auto& tile = registry.get<CTile>(tile_id);
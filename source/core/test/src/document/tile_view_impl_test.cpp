@@ -47,9 +47,7 @@ TEST_F(TileViewImplTest, Getters)
   add_tileset_to_map(registry, map_id, kDummyTilesetSpec).value();
 
   const auto tileset_id = map.attached_tilesets.back();
-  const auto& tileset = registry.get<CTileset>(tileset_id);
-
-  const auto tile_id = tileset.tiles.front();
+  const auto tile_id = get_or_make_tile(registry, tileset_id, TileIndex {0});
   const auto& tile = registry.get<CTile>(tile_id);
 
   add_animation_frame(registry,
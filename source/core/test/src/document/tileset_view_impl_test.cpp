@@ -54,12 +54,12 @@ TEST_F(TilesetViewImplTest, Getters)
 
   ASSERT_TRUE(
       add_animation_frame(registry,
-                          tileset.tiles.at(0),
+                          get_or_make_tile(registry, tileset_id, TileIndex {0}),
                           0,
                           AnimationFrame {TileIndex {0}, std::chrono::milliseconds {50}}));
   ASSERT_TRUE(
       add_animation_frame(registry,
-                          tileset.tiles.at(1),
+                          get_or_make_tile(registry, tileset_id, TileIndex {1}),
                           0,
                           AnimationFrame {TileIndex {1}, std::chrono::milliseconds {50}}));
 
@@ -96,6 +96,18 @@ TEST_F(RegistryTest, Erase)
   EXPECT_TRUE(mRegistry.is_valid(entity));
 }
 
+/// \trace tactile::core::Registry::erase
+TEST_F(RegistryTest, EraseFromRegistry)
+{
+  mRegistry.add<int>(42);
+  EXPECT_TRUE(mRegistry.has<int>());
+
+  mRegistry.erase<int>();
+  EXPECT_FALSE(mRegistry.has<int>());
+
+  EXPECT_NO_THROW(mRegistry.erase<int>());
+}
+
 /// \trace tactile::core::Registry::detach
 TEST_F(RegistryTest, Detach)
 {
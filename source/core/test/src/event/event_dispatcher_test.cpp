@@ -2,11 +2,21 @@
 
 #include "tactile/core/event/event_dispatcher.hpp"
 
+#include <thread>  // this_thread
 #include <vector>  // vector
 
 #include <gtest/gtest.h>
 
 namespace tactile::core {
+namespace {
+
+struct KeyedEvent final
+{
+  int key;
+  int value;
+};
+
+}  // namespace
 
 class EventDispatcherTest : public testing::Test
 {
@@ -21,10 +31,31 @@ class EventDispatcherTest : public testing::Test
     mFloats.push_back(value);
   }
 
+  void on_keyed(const KeyedEvent& event)
+  {
+    mKeyedEvents.push_back(event);
+  }
+
+  auto on_int_job(const int value) -> Job
+  {
+    mJobThreads.push_back(std::this_thread::get_id());
+
+    // The job returns its result as an event, since it can't access the test state.
+    return [this, value]() -> JobCompletion {
+      const auto job_thread = std::this_thread::get_id();
+      return [this, value, job_thread](EventDispatcher& dispatcher) {
+        mJobThreads.push_back(job_thread);
+        dispatcher.push<float>(static_cast<float>(value) * 0.5f);
+      };
+    };
+  }
+
  protected:
   EventDispatcher mDispatcher {};
   std::vector<int> mInts {};
   std::vector<float> mFloats {};
+  std::vector<KeyedEvent> mKeyedEvents {};
+  std::vector<std::thread::id> mJobThreads {};
 };
 
 /**
@@ -116,4 +147,116 @@ TEST_F(EventDispatcherTest, TriggerUnregisteredEvent)
   EXPECT_EQ(mFloats.size(), 0);
 }
 
+/**
+ * \trace tactile::core::EventDispatcher::coalesce
+ * \trace tactile::core::EventDispatcher::push
+ * \trace tactile::core::EventDispatcher::update
+ */
+TEST_F(EventDispatcherTest, CoalesceKeepLast)
+{
+  mDispatcher.bind<KeyedEvent, &EventDispatcherTest::on_keyed>(this);
+  mDispatcher.coalesce<KeyedEvent, &KeyedEvent::key>();
+
+  mDispatcher.push<KeyedEvent>(1, 10);
+  mDispatcher.push<KeyedEvent>(2, 20);
+  mDispatcher.push<KeyedEvent>(1, 11);
+  mDispatcher.push<KeyedEvent>(1, 12);
+  mDispatcher.update();
+
+  // Merged events keep the position of the first pending event.
+  ASSERT_EQ(mKeyedEvents.size(), 2);
+  EXPECT_EQ(mKeyedEvents.at(0).key, 1);
+  EXPECT_EQ(mKeyedEvents.at(0).value, 12);
+  EXPECT_EQ(mKeyedEvents.at(1).key, 2);
+  EXPECT_EQ(mKeyedEvents.at(1).value, 20);
+
+  // Events are only coalesced within a single update.
+  mDispatcher.push<KeyedEvent>(1, 13);
+  mDispatcher.update();
+
+  ASSERT_EQ(mKeyedEvents.size(), 3);
+  EXPECT_EQ(mKeyedEvents.at(2).value, 13);
+}
+
+/**
+ * \trace tactile::core::EventDispatcher::coalesce
+ * \trace tactile::core::EventDispatcher::push
+ * \trace tactile::core::EventDispatcher::update
+ */
+TEST_F(EventDispatcherTest, CoalesceSum)
+{
+  mDispatcher.bind<KeyedEvent, &EventDispatcherTest::on_keyed>(this);
+  mDispatcher.coalesce<KeyedEvent, &KeyedEvent::key, SumEventMember<&KeyedEvent::value>>();
+
+  mDispatcher.push<KeyedEvent>(7, 1);
+  mDispatcher.push<KeyedEvent>(7, 2);
+  mDispatcher.push<KeyedEvent>(7, -4);
+  mDispatcher.update();
+
+  ASSERT_EQ(mKeyedEvents.size(), 1);
+  EXPECT_EQ(mKeyedEvents.at(0).key, 7);
+  EXPECT_EQ(mKeyedEvents.at(0).value, -1);
+}
+
+/**
+ * \trace tactile::core::EventDispatcher::bind_job
+ * \trace tactile::core::EventDispatcher::wait_for_jobs
+ * \trace tactile::core::EventDispatcher::update
+ */
+TEST_F(EventDispatcherTest, BindJob)
+{
+  mDispatcher.bind_job<int, &EventDispatcherTest::on_int_job>(this);
+  mDispatcher.bind<float, &EventDispatcherTest::on_float>(this);
+
+  mDispatcher.push<int>(3);
+  mDispatcher.update();
+
+  ASSERT_EQ(mJobThreads.size(), 1);
+  EXPECT_EQ(mJobThreads.at(0), std::this_thread::get_id());
+  EXPECT_EQ(mDispatcher.get_stats().pending_job_count, 1);
+
+  // Completion events are dispatched in the update that completes the job.
+  mDispatcher.wait_for_jobs();
+  mDispatcher.update();
+
+  ASSERT_EQ(mJobThreads.size(), 2);
+  EXPECT_NE(mJobThreads.at(1), std::this_thread::get_id());
+  EXPECT_EQ(mDispatcher.get_stats().pending_job_count, 0);
+
+  ASSERT_EQ(mFloats.size(), 1);
+  EXPECT_EQ(mFloats.at(0), 1.5f);
+}
+
+/**
+ * \trace tactile::core::EventDispatcher::get_stats
+ */
+TEST_F(EventDispatcherTest, Stats)
+{
+  mDispatcher.bind<int, &EventDispatcherTest::on_int>(this);
+  mDispatcher.bind<KeyedEvent, &EventDispatcherTest::on_keyed>(this);
+  mDispatcher.coalesce<KeyedEvent, &KeyedEvent::key>();
+
+  EXPECT_EQ(mDispatcher.get_stats().pushed_count, 0);
+  EXPECT_EQ(mDispatcher.get_stats().coalesced_count, 0);
+  EXPECT_EQ(mDispatcher.get_stats().dispatched_count, 0);
+
+  mDispatcher.push<int>(1);
+  mDispatcher.push<int>(2);
+  mDispatcher.push<float>(3.0f);  // No listener
+  mDispatcher.push<KeyedEvent>(1, 1);
+  mDispatcher.push<KeyedEvent>(1, 2);
+  mDispatcher.push<KeyedEvent>(2, 3);
+  mDispatcher.update();
+
+  EXPECT_EQ(mDispatcher.get_stats().pushed_count, 5);
+  EXPECT_EQ(mDispatcher.get_stats().coalesced_count, 1);
+  EXPECT_EQ(mDispatcher.get_stats().dispatched_count, 4);
+
+  mDispatcher.update();
+
+  EXPECT_EQ(mDispatcher.get_stats().pushed_count, 0);
+  EXPECT_EQ(mDispatcher.get_stats().coalesced_count, 0);
+  EXPECT_EQ(mDispatcher.get_stats().dispatched_count, 0);
+}
+
 }  // namespace tactile::core
@@ -0,0 +1,163 @@
+// Copyright (C) 2024 Albin Johansson (GNU General Public License v3.0)
+
+#include "tactile/core/event/job_system.hpp"
+
+#include <atomic>     // atomic_bool
+#include <chrono>     // seconds
+#include <future>     // promise, shared_future, future_status
+#include <memory>     // make_shared
+#include <stdexcept>  // runtime_error
+#include <vector>     // vector
+
+#include <gtest/gtest.h>
+
+#include "tactile/core/event/event_dispatcher.hpp"
+
+namespace tactile::core {
+
+class JobSystemTest : public testing::Test
+{
+ protected:
+  EventDispatcher mDispatcher {};
+  JobSystem mJobSystem {2};
+};
+
+// tactile::core::JobSystem::submit
+// tactile::core::JobSystem::update
+// tactile::core::JobSystem::wait
+TEST_F(JobSystemTest, CompleteInSubmissionOrder)
+{
+  auto first_job_gate = std::make_shared<std::promise<void>>();
+  std::vector<int> completed_jobs {};
+
+  mJobSystem.submit([&completed_jobs, first_job_gate]() -> JobCompletion {
+    first_job_gate->get_future().wait();
+    return [&completed_jobs](EventDispatcher&) { completed_jobs.push_back(1); };
+  });
+
+  mJobSystem.submit([&completed_jobs]() -> JobCompletion {
+    return [&completed_jobs](EventDispatcher&) { completed_jobs.push_back(2); };
+  });
+
+  mJobSystem.submit([]() -> JobCompletion { return {}; });
+  mJobSystem.submit(Job {});  // Ignored
+  EXPECT_EQ(mJobSystem.pending_count(), 3);
+
+  // The second job is held back until the first job has finished.
+  mJobSystem.update(mDispatcher);
+  EXPECT_TRUE(completed_jobs.empty());
+  EXPECT_EQ(mJobSystem.pending_count(), 3);
+
+  first_job_gate->set_value();
+  mJobSystem.wait();
+  mJobSystem.update(mDispatcher);
+
+  ASSERT_EQ(completed_jobs.size(), 2);
+  EXPECT_EQ(completed_jobs.at(0), 1);
+  EXPECT_EQ(completed_jobs.at(1), 2);
+  EXPECT_EQ(mJobSystem.pending_count(), 0);
+}
+
+// tactile::core::JobSystem::update
+TEST_F(JobSystemTest, JobThrowsException)
+{
+  bool completed = false;
+
+  mJobSystem.submit([]() -> JobCompletion { throw std::runtime_error {"job"}; });
+  mJobSystem.submit([&completed]() -> JobCompletion {
+    return [&completed](EventDispatcher&) { completed = true; };
+  });
+
+  mJobSystem.wait();
+  EXPECT_NO_THROW(mJobSystem.update(mDispatcher));
+
+  EXPECT_TRUE(completed);
+  EXPECT_EQ(mJobSystem.pending_count(), 0);
+}
+
+// tactile::core::JobSystem::update
+TEST_F(JobSystemTest, SubmitFromCompletion)
+{
+  bool completed = false;
+
+  mJobSystem.submit([this, &completed]() -> JobCompletion {
+    return [this, &completed](EventDispatcher&) {
+      mJobSystem.submit([&completed]() -> JobCompletion {
+        return [&completed](EventDispatcher&) { completed = true; };
+      });
+    };
+  });
+
+  mJobSystem.wait();
+  mJobSystem.update(mDispatcher);
+  EXPECT_FALSE(completed);
+  EXPECT_EQ(mJobSystem.pending_count(), 1);
+
+  mJobSystem.wait();
+  mJobSystem.update(mDispatcher);
+  EXPECT_TRUE(completed);
+}
+
+// tactile::core::JobSystem::submit
+// tactile::core::JobSystem::update
+TEST_F(JobSystemTest, CompleteDeferredJob)
+{
+  auto is_ready = std::make_shared<std::atomic_bool>(false);
+  std::vector<int> completed_jobs {};
+
+  mJobSystem.submit(DeferredJob {
+    .is_ready = [is_ready] { return is_ready->load(); },
+    .wait = [] {},
+    .completion = [&completed_jobs](EventDispatcher&) { completed_jobs.push_back(1); },
+  });
+
+  mJobSystem.submit([&completed_jobs]() -> JobCompletion {
+    return [&completed_jobs](EventDispatcher&) { completed_jobs.push_back(2); };
+  });
+
+  mJobSystem.submit(DeferredJob {});  // Ignored
+  EXPECT_EQ(mJobSystem.pending_count(), 2);
+
+  // The regular job is held back until the deferred job is ready.
+  mJobSystem.wait();
+  mJobSystem.update(mDispatcher);
+  EXPECT_TRUE(completed_jobs.empty());
+  EXPECT_EQ(mJobSystem.pending_count(), 2);
+
+  is_ready->store(true);
+  mJobSystem.update(mDispatcher);
+
+  ASSERT_EQ(completed_jobs.size(), 2);
+  EXPECT_EQ(completed_jobs.at(0), 1);
+  EXPECT_EQ(completed_jobs.at(1), 2);
+  EXPECT_EQ(mJobSystem.pending_count(), 0);
+}
+
+// tactile::core::JobSystem::wait
+TEST_F(JobSystemTest, WaitForDeferredJob)
+{
+  auto gate = std::make_shared<std::promise<void>>();
+  auto result = gate->get_future().share();
+  bool completed = false;
+
+  mJobSystem.submit(DeferredJob {
+    .is_ready = [result] {
+      return result.wait_for(std::chrono::seconds::zero()) == std::future_status::ready;
+    },
+    .wait = [result] { result.wait(); },
+    .completion = [&completed](EventDispatcher&) { completed = true; },
+  });
+
+  mJobSystem.submit([gate]() -> JobCompletion {
+    gate->set_value();
+    return {};
+  });
+
+  mJobSystem.wait();
+  mJobSystem.update(mDispatcher);
+
+  EXPECT_TRUE(completed);
+  EXPECT_EQ(mJobSystem.pending_count(), 0);
+}
+
+}  // namespace tactile::core
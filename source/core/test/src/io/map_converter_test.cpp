@@ -0,0 +1,113 @@
+// Copyright (C) 2024 Albin Johansson (GNU General Public License v3.0)
+
+#include "tactile/core/io/map_converter.hpp"
+
+#include <filesystem>   // path, temp_directory_path, remove
+#include <fstream>      // ofstream
+#include <ios>          // ios
+#include <string>       // string
+#include <string_view>  // string_view
+
+#include <gtest/gtest.h>
+
+namespace tactile::core {
+namespace {
+
+[[nodiscard]]
+auto _write_temporary_file(const std::string_view name, const std::string_view content)
+    -> std::filesystem::path
+{
+  auto path = std::filesystem::temp_directory_path() / name;
+  std::ofstream {path, std::ios::out | std::ios::trunc} << content;
+  return path;
+}
+
+}  // namespace
+
+/**
+ * \trace tactile::core::guess_save_format
+ */
+TEST(MapConverter, GuessSaveFormat)
+{
+  EXPECT_EQ(guess_save_format("map.yaml"), SaveFormatId::kTactileYaml);
+  EXPECT_EQ(guess_save_format("map.yml"), SaveFormatId::kTactileYaml);
+  EXPECT_EQ(guess_save_format("foo/map.tmj"), SaveFormatId::kTiledTmj);
+  EXPECT_EQ(guess_save_format("foo/map.json"), SaveFormatId::kTiledTmj);
+  EXPECT_EQ(guess_save_format("foo/bar/map.tmx"), SaveFormatId::kTiledTmx);
+  EXPECT_EQ(guess_save_format("foo/bar/map.xml"), SaveFormatId::kTiledTmx);
+  EXPECT_EQ(guess_save_format("map.tscn"), SaveFormatId::kGodotTscn);
+
+  EXPECT_EQ(guess_save_format("map"), std::nullopt);
+  EXPECT_EQ(guess_save_format("map.png"), std::nullopt);
+  EXPECT_EQ(guess_save_format("map.tmx.bak"), std::nullopt);
+}
+
+/**
+ * \trace tactile::core::get_save_format_extension
+ */
+TEST(MapConverter, GetSaveFormatExtension)
+{
+  for (const auto format_id : {SaveFormatId::kTactileYaml,
+                               SaveFormatId::kTiledTmj,
+                               SaveFormatId::kTiledTmx,
+                               SaveFormatId::kGodotTscn}) {
+    const std::filesystem::path path {std::string {"map"} +
+                                      get_save_format_extension(format_id)};
+    EXPECT_EQ(guess_save_format(path), format_id);
+  }
+}
+
+/**
+ * \trace tactile::core::is_convertible_map_file
+ */
+TEST(MapConverter, IsConvertibleMapFileWithJson)
+{
+  const auto map_path = _write_temporary_file(
+      "tactile_map_converter_map.json",
+      R"({"tilesets": [{"name": "a", "type": "tileset"}], "type": "map"})");
+  const auto tileset_path =
+      _write_temporary_file("tactile_map_converter_tileset.json",
+                            R"({"properties": [{"type": "map"}], "type": "tileset"})");
+  const auto escaped_path = _write_temporary_file(
+      "tactile_map_converter_escaped.json",
+      R"({"name": "\"type\": \"map\"", "type": "tileset"})");
+
+  EXPECT_TRUE(is_convertible_map_file(map_path));
+  EXPECT_FALSE(is_convertible_map_file(tileset_path));
+  EXPECT_FALSE(is_convertible_map_file(escaped_path));
+
+  std::filesystem::remove(map_path);
+  std::filesystem::remove(tileset_path);
+  std::filesystem::remove(escaped_path);
+}
+
+/**
+ * \trace tactile::core::is_convertible_map_file
+ */
+TEST(MapConverter, IsConvertibleMapFileWithXml)
+{
+  const auto map_path = _write_temporary_file(
+      "tactile_map_converter_map.xml",
+      "<?xml version=\"1.0\"?>\n<!-- <tileset> -->\n<map version=\"1.7\"></map>");
+  const auto tileset_path = _write_temporary_file(
+      "tactile_map_converter_tileset.xml",
+      "<?xml version=\"1.0\"?>\n<tileset name=\"map\"></tileset>");
+
+  EXPECT_TRUE(is_convertible_map_file(map_path));
+  EXPECT_FALSE(is_convertible_map_file(tileset_path));
+
+  std::filesystem::remove(map_path);
+  std::filesystem::remove(tileset_path);
+}
+
+/**
+ * \trace tactile::core::is_convertible_map_file
+ */
+TEST(MapConverter, IsConvertibleMapFileWithUnsupportedFile)
+{
+  EXPECT_FALSE(is_convertible_map_file("tactile_map_converter_missing.tmj"));
+  EXPECT_FALSE(is_convertible_map_file("map.tscn"));
+  EXPECT_FALSE(is_convertible_map_file("map.png"));
+}
+
+}  // namespace tactile::core
@@ -0,0 +1,43 @@
+// Copyright (C) 2024 Albin Johansson (GNU General Public License v3.0)
+
+#include "tactile/core/io/map_snapshot.hpp"
+
+#include <filesystem>  // path
+
+#include <gtest/gtest.h>
+
+#include "tactile/core/document/ir_map_view.hpp"
+#include "tactile/test_util/ir.hpp"
+#include "tactile/test_util/ir_presets.hpp"
+
+namespace tactile::core {
+
+// tactile::core::make_map_snapshot
+TEST(MapSnapshot, CopyMap)
+{
+  const auto ir_map = test::make_complex_ir_map(ir::TileFormat {
+    .encoding = TileEncoding::kBase64,
+    .compression = CompressionFormatId::kZstd,
+    .compression_level = 3,
+  });
+
+  const std::filesystem::path map_path {"maps/map.tmj"};
+  const IrMapView map_view {&ir_map, &map_path};
+  EXPECT_EQ(map_view.get_path(), &map_path);
+
+  const auto snapshot = make_map_snapshot(map_view);
+  ASSERT_TRUE(snapshot.has_value());
+  EXPECT_EQ(*snapshot, ir_map);
+}
+
+// tactile::core::make_map_snapshot
+TEST(MapSnapshot, CopyEmptyMap)
+{
+  const auto ir_map = test::make_ir_map(Extent2D {3, 4});
+
+  const auto snapshot = make_map_snapshot(IrMapView {&ir_map, nullptr});
+  ASSERT_TRUE(snapshot.has_value());
+  EXPECT_EQ(*snapshot, ir_map);
+}
+
+}  // namespace tactile::core
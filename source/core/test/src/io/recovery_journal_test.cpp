@@ -0,0 +1,283 @@
+// Copyright (C) 2024 Albin Johansson (GNU General Public License v3.0)
+
+#include "tactile/core/io/recovery_journal.hpp"
+
+#include <filesystem>  // path, temp_directory_path, exists, remove
+#include <fstream>     // ofstream
+#include <ios>         // ios
+#include <optional>    // optional
+#include <utility>     // move
+
+#include <gtest/gtest.h>
+
+namespace tactile::core {
+namespace {
+
+class JournaledCommand final : public ICommand
+{
+ public:
+  explicit JournaledCommand(std::optional<CommandJournalRecord> record)
+    : mRecord {std::move(record)}
+  {}
+
+  void undo() override
+  {}
+
+  void redo() override
+  {}
+
+  [[nodiscard]]
+  auto write_journal_record(CommandJournalRecord& record) const -> bool override
+  {
+    if (mRecord.has_value()) {
+      record = *mRecord;
+      return true;
+    }
+
+    return false;
+  }
+
+ private:
+  std::optional<CommandJournalRecord> mRecord;
+};
+
+[[nodiscard]]
+auto _make_record(const LayerID layer_id, const TileID old_tile, const TileID new_tile)
+    -> CommandJournalRecord
+{
+  CommandJournalRecord record {.layer_id = layer_id, .diff = TileDiff {}};
+  record.diff.record(Index2D {3, 4}, old_tile, new_tile);
+  record.diff.record(Index2D {4, 4}, old_tile, new_tile);
+  return record;
+}
+
+[[nodiscard]]
+auto _make_base(std::filesystem::path path, const bool is_snapshot) -> RecoveryJournalBase
+{
+  return RecoveryJournalBase {
+    .file_path = std::move(path),
+    .format = SaveFormatId::kTiledTmj,
+    .key = CommandJournalKey {.file_size = 100, .write_time = -7},
+    .is_snapshot = is_snapshot,
+  };
+}
+
+}  // namespace
+
+class RecoveryJournalTest : public testing::Test
+{
+ protected:
+  void SetUp() override
+  {
+    mDir = std::filesystem::temp_directory_path() / "tactile_recovery_journal_test";
+    std::filesystem::remove_all(mDir);
+    mJournalPath = mDir / "document.journal";
+  }
+
+  void TearDown() override
+  {
+    std::filesystem::remove_all(mDir);
+  }
+
+  std::filesystem::path mDir {};
+  std::filesystem::path mJournalPath {};
+};
+
+// tactile::core::RecoveryJournal::reset
+// tactile::core::RecoveryJournal::flush
+// tactile::core::read_recovery_journal
+TEST_F(RecoveryJournalTest, WriteAndRead)
+{
+  RecoveryJournal journal {mJournalPath};
+  EXPECT_FALSE(journal.is_valid());
+
+  // Commands are ignored until the journal has a base file.
+  journal.on_command_executed(JournaledCommand {_make_record(1, kEmptyTile, TileID {1})});
+  EXPECT_FALSE(journal.has_records());
+
+  const std::filesystem::path map_path {"maps/ü/map.tmj"};
+  const auto base = _make_base(mDir / "map.tmj", false);
+  ASSERT_TRUE(journal.reset(base, &map_path).has_value());
+  EXPECT_TRUE(journal.is_valid());
+
+  journal.on_command_executed(JournaledCommand {_make_record(1, kEmptyTile, TileID {2})});
+  journal.on_command_executed(JournaledCommand {_make_record(-3, TileID {2}, TileID {9})});
+  EXPECT_TRUE(journal.has_records());
+  ASSERT_TRUE(journal.flush().has_value());
+
+  const auto content = read_recovery_journal(mJournalPath);
+  ASSERT_TRUE(content.has_value());
+  EXPECT_EQ(content->base, base);
+  EXPECT_EQ(content->map_path, map_path);
+  ASSERT_EQ(content->records.size(), 2);
+  EXPECT_EQ(content->records[0].layer_id, 1);
+  EXPECT_EQ(content->records[1].layer_id, -3);
+  EXPECT_EQ(content->records[1].diff.tile_count(), 2);
+  EXPECT_EQ(content->records[1].diff.get_runs()[0].new_tile, TileID {9});
+}
+
+// tactile::core::RecoveryJournal::on_command_reverted
+TEST_F(RecoveryJournalTest, RecordRevertedCommand)
+{
+  RecoveryJournal journal {mJournalPath};
+  ASSERT_TRUE(journal.reset(_make_base(mDir / "map.tmj", false), nullptr).has_value());
+
+  journal.on_command_reverted(JournaledCommand {_make_record(5, TileID {1}, TileID {2})});
+  ASSERT_TRUE(journal.flush().has_value());
+
+  const auto content = read_recovery_journal(mJournalPath);
+  ASSERT_TRUE(content.has_value());
+  EXPECT_FALSE(content->map_path.has_value());
+  ASSERT_EQ(content->records.size(), 1);
+
+  const auto& run = content->records[0].diff.get_runs()[0];
+  EXPECT_EQ(run.old_tile, TileID {2});
+  EXPECT_EQ(run.new_tile, TileID {1});
+}
+
+// tactile::core::RecoveryJournal::on_command_executed
+TEST_F(RecoveryJournalTest, InvalidateJournal)
+{
+  RecoveryJournal journal {mJournalPath};
+  ASSERT_TRUE(journal.reset(_make_base(mDir / "map.tmj", false), nullptr).has_value());
+
+  journal.on_command_executed(JournaledCommand {_make_record(1, kEmptyTile, TileID {1})});
+  journal.on_command_executed(JournaledCommand {std::nullopt});
+  journal.on_command_executed(JournaledCommand {_make_record(1, TileID {1}, TileID {2})});
+  EXPECT_FALSE(journal.is_valid());
+  ASSERT_TRUE(journal.flush().has_value());
+
+  // Records written before the journal was invalidated are kept.
+  const auto content = read_recovery_journal(mJournalPath);
+  ASSERT_TRUE(content.has_value());
+  EXPECT_EQ(content->records.size(), 1);
+
+  // A new base file discards the old records.
+  ASSERT_TRUE(journal.reset(_make_base(mDir / "snapshot.tmj", true), nullptr).has_value());
+  EXPECT_TRUE(journal.is_valid());
+  EXPECT_FALSE(journal.has_records());
+  EXPECT_TRUE(read_recovery_journal(mJournalPath)->records.empty());
+}
+
+// tactile::core::RecoveryJournal::begin_snapshot
+// tactile::core::RecoveryJournal::finish_snapshot
+TEST_F(RecoveryJournalTest, FinishSnapshot)
+{
+  RecoveryJournal journal {mJournalPath};
+  ASSERT_TRUE(journal.reset(_make_base(mDir / "map.tmj", false), nullptr).has_value());
+
+  journal.on_command_executed(JournaledCommand {std::nullopt});
+  EXPECT_FALSE(journal.is_valid());
+
+  journal.begin_snapshot();
+  EXPECT_TRUE(journal.is_snapshot_pending());
+
+  // Changes made while the snapshot is written are kept for the new journal.
+  journal.on_command_executed(JournaledCommand {_make_record(2, kEmptyTile, TileID {1})});
+  journal.on_command_reverted(JournaledCommand {_make_record(2, kEmptyTile, TileID {1})});
+  EXPECT_FALSE(journal.has_records());
+
+  const auto base = _make_base(mDir / "snapshot.tmj", true);
+  ASSERT_TRUE(journal.finish_snapshot(base, nullptr).has_value());
+  EXPECT_FALSE(journal.is_snapshot_pending());
+  EXPECT_TRUE(journal.is_valid());
+  EXPECT_GT(journal.record_size(), 0);
+
+  journal.on_command_executed(JournaledCommand {_make_record(3, kEmptyTile, TileID {4})});
+  ASSERT_TRUE(journal.flush().has_value());
+
+  const auto content = read_recovery_journal(mJournalPath);
+  ASSERT_TRUE(content.has_value());
+  EXPECT_EQ(content->base, base);
+  ASSERT_EQ(content->records.size(), 3);
+  EXPECT_EQ(content->records[0].layer_id, 2);
+  EXPECT_EQ(content->records[1].diff.get_runs()[0].new_tile, kEmptyTile);
+  EXPECT_EQ(content->records[2].layer_id, 3);
+}
+
+// tactile::core::RecoveryJournal::finish_snapshot
+TEST_F(RecoveryJournalTest, FinishInvalidatedSnapshot)
+{
+  RecoveryJournal journal {mJournalPath};
+  ASSERT_TRUE(journal.reset(_make_base(mDir / "map.tmj", false), nullptr).has_value());
+
+  journal.begin_snapshot();
+  journal.on_command_executed(JournaledCommand {_make_record(1, kEmptyTile, TileID {1})});
+  journal.on_command_executed(JournaledCommand {std::nullopt});
+  journal.on_command_executed(JournaledCommand {_make_record(1, TileID {1}, TileID {2})});
+
+  // The snapshot is still usable, but it needs to be followed by another one.
+  ASSERT_TRUE(journal.finish_snapshot(_make_base(mDir / "snapshot.tmj", true), nullptr)
+                  .has_value());
+  EXPECT_FALSE(journal.is_valid());
+
+  const auto content = read_recovery_journal(mJournalPath);
+  ASSERT_TRUE(content.has_value());
+  EXPECT_EQ(content->records.size(), 1);
+}
+
+// tactile::core::RecoveryJournal::reset
+// tactile::core::RecoveryJournal::finish_snapshot
+TEST_F(RecoveryJournalTest, ResetAbandonsSnapshot)
+{
+  const auto map_base = _make_base(mDir / "map.tmj", false);
+
+  RecoveryJournal journal {mJournalPath};
+  ASSERT_TRUE(journal.reset(map_base, nullptr).has_value());
+
+  journal.begin_snapshot();
+  ASSERT_TRUE(journal.reset(map_base, nullptr).has_value());
+  EXPECT_FALSE(journal.is_snapshot_pending());
+
+  const auto finish_result =
+      journal.finish_snapshot(_make_base(mDir / "snapshot.tmj", true), nullptr);
+  ASSERT_FALSE(finish_result.has_value());
+  EXPECT_EQ(finish_result.error(), ErrorCode::kBadState);
+  EXPECT_EQ(read_recovery_journal(mJournalPath)->base, map_base);
+}
+
+// tactile::core::read_recovery_journal
+TEST_F(RecoveryJournalTest, ReadIncompleteRecord)
+{
+  RecoveryJournal journal {mJournalPath};
+  ASSERT_TRUE(journal.reset(_make_base(mDir / "map.tmj", false), nullptr).has_value());
+
+  journal.on_command_executed(JournaledCommand {_make_record(1, kEmptyTile, TileID {1})});
+  ASSERT_TRUE(journal.flush().has_value());
+
+  {
+    // Simulates a crash in the middle of writing a record.
+    std::ofstream stream {mJournalPath, std::ios::out | std::ios::binary | std::ios::app};
+    stream.put(static_cast<char>(0x02));
+    stream.put(static_cast<char>(0x81));
+  }
+
+  const auto content = read_recovery_journal(mJournalPath);
+  ASSERT_TRUE(content.has_value());
+  EXPECT_EQ(content->records.size(), 1);
+}
+
+// tactile::core::RecoveryJournal::reset
+// tactile::core::RecoveryJournal::discard
+TEST_F(RecoveryJournalTest, RemoveSnapshots)
+{
+  const auto snapshot_path1 = mDir / "snapshot-1.tmj";
+  const auto snapshot_path2 = mDir / "snapshot-2.tmj";
+
+  RecoveryJournal journal {mJournalPath};
+  ASSERT_TRUE(journal.reset(_make_base(snapshot_path1, true), nullptr).has_value());
+  std::ofstream {snapshot_path1} << "1";
+
+  // The previous snapshot is removed when replaced.
+  ASSERT_TRUE(journal.reset(_make_base(snapshot_path2, true), nullptr).has_value());
+  std::ofstream {snapshot_path2} << "2";
+  EXPECT_FALSE(std::filesystem::exists(snapshot_path1));
+  EXPECT_TRUE(std::filesystem::exists(snapshot_path2));
+
+  journal.discard();
+  EXPECT_FALSE(journal.is_valid());
+  EXPECT_FALSE(std::filesystem::exists(snapshot_path2));
+  EXPECT_FALSE(std::filesystem::exists(mJournalPath));
+}
+
+}  // namespace tactile::core
@@ -0,0 +1,204 @@
+// Copyright (C) 2024 Albin Johansson (GNU General Public License v3.0)
+
+#include "tactile/core/io/texture_cache.hpp"
+
+#include <filesystem>  // path, temp_directory_path, copy_file, remove
+#include <fstream>     // ofstream
+#include <ios>         // ios
+#include <thread>      // this_thread
+#include <utility>     // move
+
+#include <gtest/gtest.h>
+
+#include "tactile/base/render/texture.hpp"
+#include "tactile/null_renderer/null_renderer.hpp"
+
+namespace tactile::core {
+
+class TextureCacheTest : public testing::Test
+{
+ protected:
+  inline static const std::filesystem::path kImagePath {"assets/images/dummy.png"};
+
+  null_renderer::NullRenderer mRenderer {nullptr};
+  TextureCache mTextureCache {&mRenderer};
+};
+
+// tactile::core::TextureCache::acquire
+// tactile::core::TextureCache::release
+TEST_F(TextureCacheTest, AcquireAndRelease)
+{
+  EXPECT_EQ(mTextureCache.size(), 0);
+
+  const auto texture1 = mTextureCache.acquire(kImagePath);
+  const auto texture2 = mTextureCache.acquire(kImagePath);
+  ASSERT_TRUE(texture1.has_value());
+  ASSERT_TRUE(texture2.has_value());
+
+  EXPECT_EQ(texture1->id, texture2->id);
+  EXPECT_EQ(texture1->size, texture2->size);
+  EXPECT_EQ(mTextureCache.size(), 1);
+  EXPECT_EQ(mTextureCache.use_count(texture1->id), 2);
+
+  mTextureCache.release(texture1->id);
+  EXPECT_EQ(mTextureCache.use_count(texture1->id), 1);
+  EXPECT_NE(mRenderer.find_texture(texture1->id), nullptr);
+
+  mTextureCache.release(texture2->id);
+  EXPECT_EQ(mTextureCache.use_count(texture1->id), 0);
+  EXPECT_EQ(mTextureCache.size(), 0);
+  EXPECT_EQ(mRenderer.find_texture(texture1->id), nullptr);
+
+  // The texture should be loaded again after being unloaded.
+  const auto texture3 = mTextureCache.acquire(kImagePath);
+  ASSERT_TRUE(texture3.has_value());
+  EXPECT_EQ(mTextureCache.use_count(texture3->id), 1);
+  EXPECT_NE(mRenderer.find_texture(texture3->id), nullptr);
+}
+
+// tactile::core::TextureCache::acquire
+TEST_F(TextureCacheTest, AcquireIdenticalCopy)
+{
+  const auto copy_path = std::filesystem::temp_directory_path() / "tactile_texture_copy.png";
+  std::filesystem::copy_file(kImagePath,
+                             copy_path,
+                             std::filesystem::copy_options::overwrite_existing);
+
+  const auto texture1 = mTextureCache.acquire(kImagePath);
+  const auto texture2 = mTextureCache.acquire(copy_path);
+  ASSERT_TRUE(texture1.has_value());
+  ASSERT_TRUE(texture2.has_value());
+
+  EXPECT_EQ(texture1->id, texture2->id);
+  EXPECT_EQ(texture1->path, kImagePath);
+  EXPECT_EQ(texture2->path, copy_path);
+  EXPECT_EQ(mTextureCache.size(), 1);
+  EXPECT_EQ(mTextureCache.use_count(texture1->id), 2);
+
+  mTextureCache.release(texture1->id);
+  mTextureCache.release(texture2->id);
+  EXPECT_EQ(mTextureCache.size(), 0);
+
+  std::filesystem::remove(copy_path);
+}
+
+// tactile::core::TextureCache::acquire
+TEST_F(TextureCacheTest, AcquireCopyOfModifiedImage)
+{
+  const auto temp_dir = std::filesystem::temp_directory_path();
+  const auto source_path = temp_dir / "tactile_texture_source.png";
+  const auto copy_path = temp_dir / "tactile_texture_source_copy.png";
+
+  std::filesystem::copy_file(kImagePath,
+                             source_path,
+                             std::filesystem::copy_options::overwrite_existing);
+  std::filesystem::copy_file(kImagePath,
+                             copy_path,
+                             std::filesystem::copy_options::overwrite_existing);
+
+  const auto texture1 = mTextureCache.acquire(source_path);
+  ASSERT_TRUE(texture1.has_value());
+
+  // The hashes still match, but the contents of the files no longer do.
+  {
+    std::ofstream stream {source_path, std::ios::out | std::ios::binary | std::ios::in};
+    stream.seekp(-1, std::ios::end);
+    stream.put('\x7F');
+  }
+
+  const auto texture2 = mTextureCache.acquire(copy_path);
+  ASSERT_TRUE(texture2.has_value());
+
+  EXPECT_NE(texture1->id, texture2->id);
+  EXPECT_EQ(mTextureCache.size(), 2);
+
+  mTextureCache.release(texture1->id);
+  mTextureCache.release(texture2->id);
+  EXPECT_EQ(mTextureCache.size(), 0);
+
+  std::filesystem::remove(source_path);
+  std::filesystem::remove(copy_path);
+}
+
+// tactile::core::TextureCache::acquire
+TEST_F(TextureCacheTest, AcquireMissingFile)
+{
+  const auto texture = mTextureCache.acquire("foo/bar.png");
+  ASSERT_FALSE(texture.has_value());
+  EXPECT_EQ(texture.error(), ErrorCode::kNoSuchFile);
+  EXPECT_EQ(mTextureCache.size(), 0);
+}
+
+// tactile::core::TextureCache::acquire_async
+// tactile::core::TextureCache::acquire
+TEST_F(TextureCacheTest, AcquireAsync)
+{
+  auto pending_texture1 = mTextureCache.acquire_async(kImagePath);
+  auto pending_texture2 = mTextureCache.acquire_async(kImagePath);
+  EXPECT_EQ(pending_texture1.get_path(), kImagePath);
+  EXPECT_EQ(mTextureCache.size(), 0);
+
+  const auto texture1 = mTextureCache.acquire(std::move(pending_texture1));
+  const auto texture2 = mTextureCache.acquire(std::move(pending_texture2));
+  ASSERT_TRUE(texture1.has_value());
+  ASSERT_TRUE(texture2.has_value());
+
+  EXPECT_EQ(texture1->id, texture2->id);
+  EXPECT_EQ(texture1->path, kImagePath);
+  EXPECT_EQ(mTextureCache.size(), 1);
+  EXPECT_EQ(mTextureCache.use_count(texture1->id), 2);
+
+  const auto* renderer_texture = mRenderer.find_texture(texture1->id);
+  ASSERT_NE(renderer_texture, nullptr);
+  EXPECT_EQ(texture1->size.x(), renderer_texture->get_size().width);
+  EXPECT_EQ(texture1->size.y(), renderer_texture->get_size().height);
+
+  mTextureCache.release(texture1->id);
+  mTextureCache.release(texture2->id);
+  EXPECT_EQ(mTextureCache.size(), 0);
+}
+
+// tactile::core::TextureCache::acquire_async
+// tactile::core::TextureCache::acquire
+TEST_F(TextureCacheTest, AcquireAsyncAfterRelease)
+{
+  const auto texture1 = mTextureCache.acquire(kImagePath);
+  ASSERT_TRUE(texture1.has_value());
+
+  // Decoding is skipped here, since the texture is in the cache...
+  auto pending_texture = mTextureCache.acquire_async(kImagePath);
+  while (!pending_texture.is_ready()) {
+    std::this_thread::yield();
+  }
+
+  // ...but the texture is unloaded before the pending texture is acquired.
+  mTextureCache.release(texture1->id);
+  EXPECT_EQ(mTextureCache.size(), 0);
+
+  const auto texture2 = mTextureCache.acquire(std::move(pending_texture));
+  ASSERT_TRUE(texture2.has_value());
+  EXPECT_EQ(mTextureCache.size(), 1);
+  EXPECT_NE(mRenderer.find_texture(texture2->id), nullptr);
+
+  mTextureCache.release(texture2->id);
+}
+
+// tactile::core::TextureCache::acquire_async
+TEST_F(TextureCacheTest, AcquireAsyncMissingFile)
+{
+  auto pending_texture = mTextureCache.acquire_async("foo/bar.png");
+
+  const auto texture = mTextureCache.acquire(std::move(pending_texture));
+  ASSERT_FALSE(texture.has_value());
+  EXPECT_EQ(texture.error(), ErrorCode::kNoSuchFile);
+  EXPECT_EQ(mTextureCache.size(), 0);
+}
+
+// tactile::core::TextureCache::release
+TEST_F(TextureCacheTest, ReleaseUnknownTexture)
+{
+  EXPECT_NO_THROW(mTextureCache.release(TextureID {42}));
+  EXPECT_EQ(mTextureCache.size(), 0);
+}
+
+}  // namespace tactile::core
@@ -221,27 +221,21 @@ void compare_tileset(const Registry& registry,
   EXPECT_EQ(texture.size, ir_tileset.image_size);
   EXPECT_EQ(texture.path, ir_tileset.image_path);
 
-  ASSERT_EQ(tileset.tiles.size(), ir_tileset.tile_count);
-  EXPECT_EQ(tileset.tiles.capacity(), ir_tileset.tile_count);
-
-  const auto& tile_cache = registry.get<CTileCache>();
-
-  for (std::size_t index = 0, count = tileset.tiles.size(); index < count; ++index) {
-    const auto tile_id = tileset.tiles.at(index);
-    EXPECT_NE(tile_id, kInvalidEntity) << "tile #" << index << " is invalid";
-    EXPECT_TRUE(is_tile(registry, tile_id));
+  ASSERT_EQ(tileset.tile_count, ir_tileset.tile_count);
+  EXPECT_EQ(tileset.tiles.size(), ir_tileset.tiles.size());
 
+  for (std::size_t index = 0, count = tileset.tile_count; index < count; ++index) {
     const auto global_tile_id =
         tileset_instance.tile_range.first_id + saturate_cast<TileID>(index);
 
-    ASSERT_TRUE(tile_cache.tileset_mapping.contains(global_tile_id))
+    EXPECT_EQ(find_tileset(registry, global_tile_id), tileset_id)
         << "tile " << global_tile_id << " is not in tile cache";
-    EXPECT_EQ(tile_cache.tileset_mapping.at(global_tile_id), tileset_id);
   }
 
   for (const auto& ir_tile : ir_tileset.tiles) {
-    const auto tile_index = saturate_cast<std::size_t>(ir_tile.index);
-    const auto tile_id = tileset.tiles.at(tile_index);
+    const auto tile_id = find_tile(registry, tileset_id, ir_tile.index);
+    EXPECT_NE(tile_id, kInvalidEntity) << "tile #" << ir_tile.index << " is invalid";
+    EXPECT_TRUE(is_tile(registry, tile_id));
     compare_tile(registry, tile_id, ir_tile);
   }
 
@@ -55,4 +55,18 @@ TEST(LayerCommon, MakeLayerWithGroupLayerIR)
   compare_layer(registry, layer_id, ir_layer);
 }
 
+// tactile::core::estimate_layer_memory_usage
+TEST(LayerCommon, EstimateDenseTileLayerMemoryUsage)
+{
+  Registry registry {};
+
+  const auto layer_id = make_tile_layer(registry, Extent2D {.rows = 100, .cols = 80});
+  const auto full_usage = estimate_layer_memory_usage(registry, layer_id);
+  EXPECT_GE(full_usage, 100 * 80 * sizeof(TileID));
+
+  // Layers without tile data, e.g., with offloaded tiles, are cheap.
+  registry.get<CDenseTileLayer>(layer_id).tiles = TileMatrix {};
+  EXPECT_LT(estimate_layer_memory_usage(registry, layer_id), full_usage / 8);
+}
+
 }  // namespace tactile::core
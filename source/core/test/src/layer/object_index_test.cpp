@@ -0,0 +1,152 @@
+// Copyright (C) 2024 Albin Johansson (GNU General Public License v3.0)
+
+#include "tactile/core/layer/object_index.hpp"
+
+#include <algorithm>  // sort
+#include <vector>     // vector
+
+#include <gtest/gtest.h>
+
+#include "tactile/core/entity/registry.hpp"
+#include "tactile/core/layer/layer_types.hpp"
+#include "tactile/core/layer/object.hpp"
+#include "tactile/core/layer/object_layer.hpp"
+
+namespace tactile::core {
+
+class ObjectIndexTest : public testing::Test
+{
+ public:
+  [[nodiscard]]
+  auto add_object(const Float2& position, const Float2& size) -> EntityID
+  {
+    const auto object_id = make_object(mRegistry, mNextObjectId++, ObjectType::kRect);
+
+    auto& object = mRegistry.get<CObject>(object_id);
+    object.position = position;
+    object.size = size;
+
+    auto& object_layer = mRegistry.get<CObjectLayer>(mLayerId);
+    object_layer.objects.push_back(object_id);
+    add_object_to_index(mRegistry, mLayerId, object_id);
+
+    return object_id;
+  }
+
+  [[nodiscard]]
+  auto query(const Float2& region_begin, const Float2& region_end) const
+      -> std::vector<EntityID>
+  {
+    std::vector<EntityID> objects {};
+    query_objects(mRegistry, mLayerId, region_begin, region_end, objects);
+
+    std::ranges::sort(objects);
+    return objects;
+  }
+
+ protected:
+  Registry mRegistry {};
+  EntityID mLayerId {make_object_layer(mRegistry)};
+  ObjectID mNextObjectId {1};
+};
+
+/// \trace tactile::core::add_object_to_index
+/// \trace tactile::core::query_objects
+TEST_F(ObjectIndexTest, QueryObjects)
+{
+  const auto object1 = add_object(Float2 {10, 10}, Float2 {20, 20});
+  const auto object2 = add_object(Float2 {300, 10}, Float2 {20, 20});
+  const auto object3 = add_object(Float2 {250, 250}, Float2 {20, 20});
+
+  EXPECT_EQ(query(Float2 {0, 0}, Float2 {100, 100}), std::vector {object1});
+  EXPECT_EQ(query(Float2 {290, 0}, Float2 {400, 100}), std::vector {object2});
+  EXPECT_TRUE(query(Float2 {500, 500}, Float2 {600, 600}).empty());
+
+  // The third object is stored in a cell before the region, but still intersects it.
+  EXPECT_EQ(query(Float2 {260, 260}, Float2 {261, 261}), std::vector {object3});
+
+  auto expected = std::vector {object1, object2, object3};
+  std::ranges::sort(expected);
+  EXPECT_EQ(query(Float2 {-1'000, -1'000}, Float2 {1'000, 1'000}), expected);
+}
+
+/// \trace tactile::core::add_object_to_index
+/// \trace tactile::core::query_objects
+TEST_F(ObjectIndexTest, LargeObjects)
+{
+  const auto object_id = add_object(Float2 {0, 0}, Float2 {2'000, 100});
+
+  const auto& index = mRegistry.get<CObjectIndex>(mLayerId);
+  EXPECT_EQ(index.large_objects.size(), 1);
+  EXPECT_TRUE(index.cells.empty());
+
+  EXPECT_EQ(query(Float2 {1'500, 50}, Float2 {1'600, 60}), std::vector {object_id});
+  EXPECT_TRUE(query(Float2 {1'500, 150}, Float2 {1'600, 160}).empty());
+}
+
+/// \trace tactile::core::update_object_in_index
+TEST_F(ObjectIndexTest, UpdateObjectInIndex)
+{
+  const auto object_id = add_object(Float2 {10, 10}, Float2 {20, 20});
+
+  auto& object = mRegistry.get<CObject>(object_id);
+  object.position = Float2 {1'000, 1'000};
+  update_object_in_index(mRegistry, object_id);
+
+  EXPECT_TRUE(query(Float2 {0, 0}, Float2 {100, 100}).empty());
+  EXPECT_EQ(query(Float2 {990, 990}, Float2 {1'010, 1'010}), std::vector {object_id});
+
+  const auto& index = mRegistry.get<CObjectIndex>(mLayerId);
+  EXPECT_EQ(index.cells.size(), 1);
+  EXPECT_EQ(index.entries.size(), 1);
+}
+
+/// \trace tactile::core::remove_object_from_index
+TEST_F(ObjectIndexTest, RemoveObjectFromIndex)
+{
+  const auto object_id = add_object(Float2 {10, 10}, Float2 {20, 20});
+  remove_object_from_index(mRegistry, mLayerId, object_id);
+
+  const auto& index = mRegistry.get<CObjectIndex>(mLayerId);
+  EXPECT_TRUE(index.cells.empty());
+  EXPECT_TRUE(index.entries.empty());
+  EXPECT_TRUE(query(Float2 {0, 0}, Float2 {100, 100}).empty());
+
+  // Removing an object that isn't indexed should have no effect.
+  remove_object_from_index(mRegistry, mLayerId, object_id);
+}
+
+/// \trace tactile::core::rebuild_object_index
+TEST_F(ObjectIndexTest, RebuildObjectIndex)
+{
+  const auto object_id = add_object(Float2 {10, 10}, Float2 {20, 20});
+
+  mRegistry.erase<CObjectIndex>(mLayerId);
+  EXPECT_EQ(query(Float2 {0, 0}, Float2 {100, 100}), std::vector {object_id});
+
+  rebuild_object_index(mRegistry, mLayerId);
+  ASSERT_TRUE(mRegistry.has<CObjectIndex>(mLayerId));
+  EXPECT_EQ(query(Float2 {0, 0}, Float2 {100, 100}), std::vector {object_id});
+}
+
+/// \trace tactile::core::query_objects
+/// \trace tactile::core::update_object_in_index
+TEST_F(ObjectIndexTest, QueryObjectsInLayerOrder)
+{
+  const auto object1 = add_object(Float2 {0, 0}, Float2 {2'000, 2'000});
+  const auto object2 = add_object(Float2 {700, 700}, Float2 {20, 20});
+  const auto object3 = add_object(Float2 {10, 10}, Float2 {20, 20});
+  const auto object4 = add_object(Float2 {300, 10}, Float2 {20, 20});
+
+  // Moved objects keep their position in the layer.
+  auto& object = mRegistry.get<CObject>(object2);
+  object.position = Float2 {1'200, 50};
+  update_object_in_index(mRegistry, object2);
+
+  std::vector<EntityID> objects {};
+  query_objects(mRegistry, mLayerId, Float2 {0, 0}, Float2 {2'000, 2'000}, objects);
+
+  EXPECT_EQ(objects, (std::vector {object1, object2, object3, object4}));
+}
+
+}  // namespace tactile::core
@@ -7,6 +7,7 @@
 #include "tactile/core/entity/registry.hpp"
 #include "tactile/core/layer/layer_types.hpp"
 #include "tactile/core/layer/object.hpp"
+#include "tactile/core/layer/object_index.hpp"
 #include "tactile/core/meta/meta.hpp"
 
 namespace tactile::core {
@@ -31,6 +32,7 @@ TEST(ObjectLayer, MakeObjectLayer)
   EXPECT_TRUE(registry.has<CMeta>(object_layer_entity));
   EXPECT_TRUE(registry.has<CLayer>(object_layer_entity));
   EXPECT_TRUE(registry.has<CObjectLayer>(object_layer_entity));
+  EXPECT_TRUE(registry.has<CObjectIndex>(object_layer_entity));
 
   const auto& meta = registry.get<CMeta>(object_layer_entity);
   const auto& layer = registry.get<CLayer>(object_layer_entity);
@@ -0,0 +1,165 @@
+// Copyright (C) 2024 Albin Johansson (GNU General Public License v3.0)
+
+#include "tactile/core/layer/tile_diff.hpp"
+
+#include <gtest/gtest.h>
+
+#include "tactile/core/entity/registry.hpp"
+#include "tactile/core/layer/tile_layer.hpp"
+
+namespace tactile::core {
+
+class TileDiffTest : public testing::TestWithParam<bool>
+{
+ protected:
+  Registry mRegistry {};
+
+  [[nodiscard]]
+  auto make_test_layer(const Extent2D& extent)
+  {
+    const auto layer_id = make_tile_layer(mRegistry, extent);
+
+    if (GetParam()) {
+      convert_to_dense_tile_layer(mRegistry, layer_id);
+    }
+    else {
+      convert_to_sparse_tile_layer(mRegistry, layer_id);
+    }
+
+    return layer_id;
+  }
+};
+
+INSTANTIATE_TEST_SUITE_P(DenseAndSparse, TileDiffTest, testing::Bool());
+
+// tactile::core::TileDiff::record
+TEST(TileDiff, Record)
+{
+  TileDiff diff {};
+  EXPECT_TRUE(diff.empty());
+
+  diff.record(Index2D {2, 1}, TileID {1}, TileID {1});
+  EXPECT_TRUE(diff.empty());
+
+  diff.record(Index2D {2, 1}, TileID {1}, kEmptyTile);
+  diff.record(Index2D {3, 1}, TileID {1}, kEmptyTile);
+  diff.record(Index2D {4, 1}, TileID {1}, kEmptyTile);
+  diff.record(Index2D {5, 1}, TileID {2}, kEmptyTile);
+  diff.record(Index2D {0, 2}, TileID {2}, kEmptyTile);
+
+  EXPECT_EQ(diff.tile_count(), 5);
+  ASSERT_EQ(diff.get_runs().size(), 3);
+
+  const auto& first_run = diff.get_runs()[0];
+  EXPECT_EQ(first_run.position, (Index2D {2, 1}));
+  EXPECT_EQ(first_run.length, 3);
+  EXPECT_EQ(first_run.old_tile, TileID {1});
+  EXPECT_EQ(first_run.new_tile, kEmptyTile);
+
+  EXPECT_EQ(diff.get_runs()[1].length, 1);
+  EXPECT_EQ(diff.get_runs()[2].length, 1);
+}
+
+// tactile::core::TileDiff::append
+TEST(TileDiff, Append)
+{
+  TileDiff diff1 {};
+  diff1.record(Index2D {0, 0}, TileID {1}, TileID {2});
+  diff1.record(Index2D {1, 0}, TileID {1}, TileID {2});
+
+  TileDiff diff2 {};
+  diff2.record(Index2D {2, 0}, TileID {1}, TileID {2});
+  diff2.record(Index2D {0, 1}, TileID {1}, TileID {2});
+
+  diff1.append(diff2);
+
+  EXPECT_EQ(diff1.tile_count(), 4);
+  ASSERT_EQ(diff1.get_runs().size(), 2);
+  EXPECT_EQ(diff1.get_runs()[0].length, 3);
+  EXPECT_EQ(diff1.get_runs()[1].position, (Index2D {0, 1}));
+}
+
+// tactile::core::TileDiff::record_run
+TEST(TileDiff, RecordRun)
+{
+  TileDiff diff {};
+  diff.record_run(TileDiffRun {Index2D {2, 3}, 4, TileID {1}, TileID {2}});
+  diff.record_run(TileDiffRun {Index2D {6, 3}, 2, TileID {1}, TileID {2}});
+  diff.record_run(TileDiffRun {Index2D {0, 0}, 0, TileID {1}, TileID {2}});
+  diff.record_run(TileDiffRun {Index2D {0, 0}, 5, TileID {7}, TileID {7}});
+  diff.record_run(TileDiffRun {Index2D {0, 4}, 1, TileID {2}, TileID {0}});
+
+  EXPECT_EQ(diff.tile_count(), 7);
+  ASSERT_EQ(diff.get_runs().size(), 2);
+  EXPECT_EQ(diff.get_runs()[0], (TileDiffRun {Index2D {2, 3}, 6, TileID {1}, TileID {2}}));
+  EXPECT_EQ(diff.get_runs()[1], (TileDiffRun {Index2D {0, 4}, 1, TileID {2}, TileID {0}}));
+}
+
+// tactile::core::TileDiff::apply
+// tactile::core::TileDiff::revert
+TEST_P(TileDiffTest, ApplyAndRevert)
+{
+  const auto layer_id = make_test_layer(Extent2D {4, 4});
+  set_layer_tile(mRegistry, layer_id, Index2D {1, 1}, TileID {7});
+
+  TileDiff diff {};
+  diff.record(Index2D {0, 1}, kEmptyTile, TileID {3});
+  diff.record(Index2D {1, 1}, TileID {7}, TileID {3});
+  diff.record(Index2D {2, 1}, kEmptyTile, TileID {3});
+
+  // The same tile is changed again, e.g. by a later sample in a tool stroke.
+  diff.record(Index2D {1, 1}, TileID {3}, TileID {4});
+
+  diff.apply(mRegistry, layer_id);
+  EXPECT_EQ(get_layer_tile(mRegistry, layer_id, Index2D {0, 1}), TileID {3});
+  EXPECT_EQ(get_layer_tile(mRegistry, layer_id, Index2D {1, 1}), TileID {4});
+  EXPECT_EQ(get_layer_tile(mRegistry, layer_id, Index2D {2, 1}), TileID {3});
+  EXPECT_EQ(get_layer_tile(mRegistry, layer_id, Index2D {3, 1}), kEmptyTile);
+
+  diff.revert(mRegistry, layer_id);
+  EXPECT_EQ(get_layer_tile(mRegistry, layer_id, Index2D {0, 1}), kEmptyTile);
+  EXPECT_EQ(get_layer_tile(mRegistry, layer_id, Index2D {1, 1}), TileID {7});
+  EXPECT_EQ(get_layer_tile(mRegistry, layer_id, Index2D {2, 1}), kEmptyTile);
+}
+
+// tactile::core::TileDiff::make_inverse
+TEST_P(TileDiffTest, MakeInverse)
+{
+  const auto layer_id = make_test_layer(Extent2D {4, 4});
+  set_layer_tile(mRegistry, layer_id, Index2D {1, 2}, TileID {5});
+
+  TileDiff diff {};
+  diff.record(Index2D {0, 2}, kEmptyTile, TileID {3});
+  diff.record(Index2D {1, 2}, TileID {5}, TileID {3});
+  diff.record(Index2D {1, 2}, TileID {3}, TileID {9});
+
+  const auto inverse = diff.make_inverse();
+  EXPECT_EQ(inverse.tile_count(), diff.tile_count());
+
+  diff.apply(mRegistry, layer_id);
+  inverse.apply(mRegistry, layer_id);
+
+  EXPECT_EQ(get_layer_tile(mRegistry, layer_id, Index2D {0, 2}), kEmptyTile);
+  EXPECT_EQ(get_layer_tile(mRegistry, layer_id, Index2D {1, 2}), TileID {5});
+}
+
+// tactile::core::TileDiff::apply
+TEST_P(TileDiffTest, ApplyAfterShrinkingLayer)
+{
+  const auto layer_id = make_test_layer(Extent2D {4, 4});
+
+  TileDiff diff {};
+  diff.record(Index2D {1, 1}, kEmptyTile, TileID {1});
+  diff.record(Index2D {2, 1}, kEmptyTile, TileID {1});
+  diff.record(Index2D {3, 3}, kEmptyTile, TileID {1});
+
+  resize_tile_layer(mRegistry, layer_id, Extent2D {2, 2});
+
+  diff.apply(mRegistry, layer_id);
+  EXPECT_EQ(get_layer_tile(mRegistry, layer_id, Index2D {1, 1}), TileID {1});
+
+  diff.revert(mRegistry, layer_id);
+  EXPECT_EQ(get_layer_tile(mRegistry, layer_id, Index2D {1, 1}), kEmptyTile);
+}
+
+}  // namespace tactile::core
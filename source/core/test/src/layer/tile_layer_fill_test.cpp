@@ -0,0 +1,205 @@
+// Copyright (C) 2024 Albin Johansson (GNU General Public License v3.0)
+
+#include "tactile/core/layer/tile_layer_fill.hpp"
+
+#include <cstddef>  // size_t
+
+#include <gtest/gtest.h>
+
+#include "tactile/core/entity/registry.hpp"
+#include "tactile/core/layer/tile_layer.hpp"
+
+namespace tactile::core {
+namespace {
+
+[[nodiscard]]
+auto _count_tiles(const std::vector<TileSpan>& spans) -> std::size_t
+{
+  std::size_t count {0};
+
+  for (const auto& span : spans) {
+    count += span.end_col - span.begin_col;
+  }
+
+  return count;
+}
+
+}  // namespace
+
+class TileLayerFillTest : public testing::TestWithParam<bool>
+{
+ protected:
+  Registry mRegistry {};
+  bool mTestingDenseLayer {};
+
+  void SetUp() override
+  {
+    mTestingDenseLayer = GetParam();
+  }
+
+  [[nodiscard]]
+  auto make_test_layer(const Extent2D& extent)
+  {
+    const auto layer_id = make_tile_layer(mRegistry, extent);
+
+    if (mTestingDenseLayer) {
+      convert_to_dense_tile_layer(mRegistry, layer_id);
+    }
+    else {
+      convert_to_sparse_tile_layer(mRegistry, layer_id);
+    }
+
+    return layer_id;
+  }
+
+  [[nodiscard]]
+  auto count_layer_tiles(const EntityID layer_id, const TileID tile_id) const -> std::size_t
+  {
+    std::size_t count {0};
+
+    each_layer_tile(mRegistry, layer_id, [&](const Index2D&, const TileID id) {
+      if (id == tile_id) {
+        ++count;
+      }
+    });
+
+    return count;
+  }
+};
+
+INSTANTIATE_TEST_SUITE_P(DenseAndSparse, TileLayerFillTest, testing::Bool());
+
+// tactile::core::flood_fill_tile_layer
+TEST_P(TileLayerFillTest, FillEmptyLayer)
+{
+  constexpr Extent2D extent {4, 6};
+  const auto layer_id = make_test_layer(extent);
+
+  const auto spans = flood_fill_tile_layer(mRegistry, layer_id, Index2D {2, 1}, TileID {7});
+
+  EXPECT_EQ(spans.size(), extent.rows);
+  EXPECT_EQ(_count_tiles(spans), extent.rows * extent.cols);
+  EXPECT_EQ(count_layer_tiles(layer_id, TileID {7}), extent.rows * extent.cols);
+
+  for (const auto& span : spans) {
+    EXPECT_EQ(span.begin_col, 0);
+    EXPECT_EQ(span.end_col, extent.cols);
+  }
+}
+
+// tactile::core::flood_fill_tile_layer
+TEST_P(TileLayerFillTest, FillIsBoundedByOtherTiles)
+{
+  // . . # . .
+  // . . # . .
+  // . . # # #
+  // . . . . .
+  const auto layer_id = make_test_layer(Extent2D {4, 5});
+  set_layer_tile(mRegistry, layer_id, Index2D {2, 0}, TileID {1});
+  set_layer_tile(mRegistry, layer_id, Index2D {2, 1}, TileID {1});
+  set_layer_tile(mRegistry, layer_id, Index2D {2, 2}, TileID {1});
+  set_layer_tile(mRegistry, layer_id, Index2D {3, 2}, TileID {1});
+  set_layer_tile(mRegistry, layer_id, Index2D {4, 2}, TileID {1});
+
+  const auto spans = flood_fill_tile_layer(mRegistry, layer_id, Index2D {4, 0}, TileID {2});
+
+  EXPECT_EQ(_count_tiles(spans), 4);
+  EXPECT_EQ(count_layer_tiles(layer_id, TileID {2}), 4);
+  EXPECT_EQ(get_layer_tile(mRegistry, layer_id, Index2D {3, 0}), TileID {2});
+  EXPECT_EQ(get_layer_tile(mRegistry, layer_id, Index2D {4, 1}), TileID {2});
+  EXPECT_EQ(get_layer_tile(mRegistry, layer_id, Index2D {0, 0}), kEmptyTile);
+
+  // The remaining empty tiles are connected around the wall.
+  const auto other_spans =
+      flood_fill_tile_layer(mRegistry, layer_id, Index2D {0, 3}, TileID {3});
+
+  EXPECT_EQ(_count_tiles(other_spans), 11);
+  EXPECT_EQ(count_layer_tiles(layer_id, kEmptyTile), 0);
+}
+
+// tactile::core::flood_fill_tile_layer
+TEST_P(TileLayerFillTest, FillWithSameTile)
+{
+  const auto layer_id = make_test_layer(Extent2D {3, 3});
+
+  const auto spans = flood_fill_tile_layer(mRegistry, layer_id, Index2D {1, 1}, kEmptyTile);
+
+  EXPECT_TRUE(spans.empty());
+  EXPECT_EQ(count_layer_tiles(layer_id, kEmptyTile), 9);
+}
+
+// tactile::core::flood_fill_tile_layer
+TEST_P(TileLayerFillTest, FillOutsideLayer)
+{
+  const auto layer_id = make_test_layer(Extent2D {3, 3});
+
+  const auto spans = flood_fill_tile_layer(mRegistry, layer_id, Index2D {3, 0}, TileID {1});
+
+  EXPECT_TRUE(spans.empty());
+  EXPECT_EQ(count_layer_tiles(layer_id, TileID {1}), 0);
+}
+
+// tactile::core::flood_fill_tile_layer
+TEST_P(TileLayerFillTest, RegionLimitedFill)
+{
+  const auto layer_id = make_test_layer(Extent2D {6, 6});
+
+  const TileRegion region {
+    .begin = Index2D {.x = 1, .y = 2},
+    .end = Index2D {.x = 4, .y = 10},
+  };
+
+  const auto spans =
+      flood_fill_tile_layer(mRegistry, layer_id, Index2D {2, 3}, TileID {5}, region);
+
+  // The region is clamped to the layer extent, i.e., 3 columns and 4 rows.
+  EXPECT_EQ(spans.size(), 4);
+  EXPECT_EQ(_count_tiles(spans), 12);
+  EXPECT_EQ(count_layer_tiles(layer_id, TileID {5}), 12);
+  EXPECT_EQ(get_layer_tile(mRegistry, layer_id, Index2D {0, 3}), kEmptyTile);
+  EXPECT_EQ(get_layer_tile(mRegistry, layer_id, Index2D {2, 1}), kEmptyTile);
+
+  // Origins outside of the region are ignored.
+  EXPECT_TRUE(
+      flood_fill_tile_layer(mRegistry, layer_id, Index2D {0, 0}, TileID {6}, region).empty());
+}
+
+// tactile::core::flood_fill_tile_layer
+TEST_P(TileLayerFillTest, FillHugeRegion)
+{
+  if (!mTestingDenseLayer) {
+    GTEST_SKIP() << "Sparse layers aren't intended for huge amounts of tiles";
+  }
+
+  constexpr Extent2D extent {2'000, 2'000};
+  const auto layer_id = make_test_layer(extent);
+
+  const auto spans = flood_fill_tile_layer(mRegistry, layer_id, Index2D {1'000, 1'000}, 1);
+
+  EXPECT_EQ(spans.size(), extent.rows);
+  EXPECT_EQ(_count_tiles(spans), extent.rows * extent.cols);
+}
+
+// tactile::core::set_layer_tile_spans
+TEST_P(TileLayerFillTest, SetLayerTileSpans)
+{
+  const auto layer_id = make_test_layer(Extent2D {4, 4});
+
+  const std::vector<TileSpan> spans {
+    TileSpan {.row = 0, .begin_col = 0, .end_col = 2},
+    TileSpan {.row = 3, .begin_col = 1, .end_col = 10},
+    TileSpan {.row = 4, .begin_col = 0, .end_col = 4},
+  };
+
+  set_layer_tile_spans(mRegistry, layer_id, spans, TileID {8});
+
+  EXPECT_EQ(count_layer_tiles(layer_id, TileID {8}), 5);
+  EXPECT_EQ(get_layer_tile(mRegistry, layer_id, Index2D {1, 0}), TileID {8});
+  EXPECT_EQ(get_layer_tile(mRegistry, layer_id, Index2D {2, 0}), kEmptyTile);
+  EXPECT_EQ(get_layer_tile(mRegistry, layer_id, Index2D {3, 3}), TileID {8});
+
+  set_layer_tile_spans(mRegistry, layer_id, spans, kEmptyTile);
+  EXPECT_EQ(count_layer_tiles(layer_id, TileID {8}), 0);
+}
+
+}  // namespace tactile::core
@@ -5,6 +5,7 @@
 #include <gtest/gtest.h>
 
 #include "tactile/core/entity/registry.hpp"
+#include "tactile/core/io/texture_cache.hpp"
 #include "tactile/core/layer/group_layer.hpp"
 #include "tactile/core/layer/layer_types.hpp"
 #include "tactile/core/map/map_spec.hpp"
@@ -30,6 +31,7 @@ class MapTest : public testing::Test
  protected:
   Registry mRegistry {};
   null_renderer::NullRenderer mRenderer {nullptr};
+  TextureCache mTextureCache {&mRenderer};
 };
 
 // tactile::core::is_map
@@ -103,12 +105,12 @@ TEST_F(MapTest, MakeMap)
   EXPECT_EQ(viewport.scale, 1.0f);
 }
 
-// tactile::core::make_map [Registry&, IRenderer&, const ir::Map&]
+// tactile::core::make_map [Registry&, TextureCache&, const ir::Map&]
 TEST_F(MapTest, MakeMapFromIR)
 {
   const auto ir_map = test::make_complex_ir_map(test::make_ir_tile_format());
 
-  const auto map_id = make_map(mRegistry, mRenderer, ir_map);
+  const auto map_id = make_map(mRegistry, mTextureCache, ir_map, TextureLoadMode::kBlocking);
   ASSERT_TRUE(map_id.has_value());
   ASSERT_TRUE(is_map(mRegistry, *map_id));
 
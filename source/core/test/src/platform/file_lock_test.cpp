@@ -0,0 +1,45 @@
+// Copyright (C) 2024 Albin Johansson (GNU General Public License v3.0)
+
+#include "tactile/core/platform/file_lock.hpp"
+
+#include <filesystem>  // path, temp_directory_path, remove
+#include <optional>    // optional
+#include <utility>     // move
+
+#include <gtest/gtest.h>
+
+namespace tactile::core {
+
+/// \trace tactile::core::FileLock::try_lock
+/// \trace tactile::core::FileLock::unlock
+TEST(FileLock, TryLock)
+{
+  const auto path = std::filesystem::temp_directory_path() / "tactile_file_lock.lock";
+  std::filesystem::remove(path);
+
+  {
+    auto lock = FileLock::try_lock(path);
+    ASSERT_TRUE(lock.has_value());
+    EXPECT_TRUE(std::filesystem::exists(path));
+
+    // The file can't be locked twice, even by the same process.
+    const auto other_lock = FileLock::try_lock(path);
+    ASSERT_FALSE(other_lock.has_value());
+    EXPECT_EQ(other_lock.error(), ErrorCode::kBadState);
+
+    // Moved locks remain locked.
+    std::optional<FileLock> moved_lock {std::move(*lock)};
+    EXPECT_FALSE(FileLock::try_lock(path).has_value());
+  }
+
+  // Locks are released when destroyed.
+  auto lock = FileLock::try_lock(path);
+  ASSERT_TRUE(lock.has_value());
+
+  lock->unlock();
+  EXPECT_TRUE(FileLock::try_lock(path).has_value());
+
+  std::filesystem::remove(path);
+}
+
+}  // namespace tactile::core
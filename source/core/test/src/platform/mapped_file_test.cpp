@@ -0,0 +1,60 @@
+// Copyright (C) 2024 Albin Johansson (GNU General Public License v3.0)
+
+#include "tactile/core/platform/mapped_file.hpp"
+
+#include <filesystem>  // path, temp_directory_path, remove
+#include <fstream>     // ofstream
+#include <ios>         // ios
+#include <utility>     // move
+
+#include <gtest/gtest.h>
+
+namespace tactile::core {
+
+/// \trace tactile::core::MappedFile::open
+/// \trace tactile::core::MappedFile::get_bytes
+TEST(MappedFile, Open)
+{
+  const auto path = std::filesystem::temp_directory_path() / "tactile_mapped_file.bin";
+  {
+    std::ofstream stream {path, std::ios::out | std::ios::binary | std::ios::trunc};
+    stream << "abc";
+  }
+
+  auto file = MappedFile::open(path);
+  ASSERT_TRUE(file.has_value());
+
+  const auto moved_file = std::move(*file);
+  EXPECT_TRUE(file->get_bytes().empty());
+
+  const auto bytes = moved_file.get_bytes();
+  ASSERT_EQ(bytes.size(), 3);
+  EXPECT_EQ(bytes[0], 'a');
+  EXPECT_EQ(bytes[1], 'b');
+  EXPECT_EQ(bytes[2], 'c');
+
+  std::filesystem::remove(path);
+}
+
+/// \trace tactile::core::MappedFile::open
+TEST(MappedFile, OpenEmptyFile)
+{
+  const auto path = std::filesystem::temp_directory_path() / "tactile_empty_file.bin";
+  std::ofstream {path, std::ios::out | std::ios::trunc}.close();
+
+  const auto file = MappedFile::open(path);
+  ASSERT_TRUE(file.has_value());
+  EXPECT_TRUE(file->get_bytes().empty());
+
+  std::filesystem::remove(path);
+}
+
+/// \trace tactile::core::MappedFile::open
+TEST(MappedFile, OpenMissingFile)
+{
+  const auto file = MappedFile::open("foo/bar.bin");
+  ASSERT_FALSE(file.has_value());
+  EXPECT_EQ(file.error(), ErrorCode::kNoSuchFile);
+}
+
+}  // namespace tactile::core
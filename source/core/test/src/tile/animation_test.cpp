@@ -7,6 +7,7 @@
 #include "tactile/core/entity/registry.hpp"
 #include "tactile/core/tile/animation_types.hpp"
 #include "tactile/core/tile/tile.hpp"
+#include "tactile/core/tile/tileset_types.hpp"
 
 namespace tactile::core {
 
@@ -58,6 +59,171 @@ TEST(Animation, UpdateAnimations)
   EXPECT_EQ(registry.get<CAnimation>(tile3_entity).frame_index, 0);
 }
 
+/**
+ * \trace tactile::core::update_animations
+ */
+TEST(Animation, UpdateAnimationsOnlyVisitsDueFrames)
+{
+  Registry registry {};
+
+  const auto fast_tile_entity = make_tile(registry, TileIndex {1});
+  const auto slow_tile_entity = make_tile(registry, TileIndex {2});
+
+  constexpr AnimationFrame fast_frame {TileIndex {10}, std::chrono::milliseconds::zero()};
+  constexpr AnimationFrame slow_frame {TileIndex {20}, std::chrono::hours {1}};
+
+  ASSERT_TRUE(add_animation_frame(registry, fast_tile_entity, 0, fast_frame).has_value());
+  ASSERT_TRUE(add_animation_frame(registry, fast_tile_entity, 1, fast_frame).has_value());
+  ASSERT_TRUE(add_animation_frame(registry, slow_tile_entity, 0, slow_frame).has_value());
+  ASSERT_TRUE(add_animation_frame(registry, slow_tile_entity, 1, slow_frame).has_value());
+
+  const auto& schedule = registry.get<CAnimationSchedule>();
+  EXPECT_EQ(schedule.version, 0);
+
+  update_animations(registry);
+
+  EXPECT_EQ(registry.get<CAnimation>(fast_tile_entity).frame_index, 1);
+  EXPECT_EQ(registry.get<CAnimation>(slow_tile_entity).frame_index, 0);
+  EXPECT_EQ(schedule.version, 1);
+  ASSERT_EQ(schedule.changed_tiles.size(), 1);
+  EXPECT_EQ(schedule.changed_tiles.front(), fast_tile_entity);
+
+  // The fast animation is rescheduled, and its stale entry has been discarded.
+  ASSERT_EQ(schedule.queue.size(), 3);
+  EXPECT_EQ(schedule.queue.front().tile_entity, fast_tile_entity);
+
+  ASSERT_TRUE(remove_animation_frame(registry, fast_tile_entity, 1).has_value());
+  ASSERT_TRUE(remove_animation_frame(registry, fast_tile_entity, 0).has_value());
+
+  update_animations(registry);
+
+  EXPECT_EQ(registry.get<CAnimation>(slow_tile_entity).frame_index, 0);
+  EXPECT_EQ(schedule.version, 1);
+  EXPECT_TRUE(schedule.changed_tiles.empty());
+}
+
+/**
+ * \trace tactile::core::get_animation_frame_index
+ */
+TEST(Animation, GetAnimationFrameIndex)
+{
+  Registry registry {};
+  const auto tile_entity = make_tile(registry, TileIndex {1});
+
+  using std::chrono::milliseconds;
+
+  // [0, 100) [100, 150) [150, 450)
+  const AnimationFrame frame1 {TileIndex {10}, milliseconds {100}};
+  const AnimationFrame frame2 {TileIndex {20}, milliseconds {50}};
+  const AnimationFrame frame3 {TileIndex {30}, milliseconds {300}};
+
+  ASSERT_TRUE(add_animation_frame(registry, tile_entity, 0, frame1).has_value());
+  ASSERT_TRUE(add_animation_frame(registry, tile_entity, 1, frame2).has_value());
+  ASSERT_TRUE(add_animation_frame(registry, tile_entity, 2, frame3).has_value());
+
+  const auto& animation = registry.get<CAnimation>(tile_entity);
+  EXPECT_EQ(get_animation_frame_index(animation, milliseconds {0}), 0);
+  EXPECT_EQ(get_animation_frame_index(animation, milliseconds {99}), 0);
+  EXPECT_EQ(get_animation_frame_index(animation, milliseconds {100}), 1);
+  EXPECT_EQ(get_animation_frame_index(animation, milliseconds {149}), 1);
+  EXPECT_EQ(get_animation_frame_index(animation, milliseconds {150}), 2);
+  EXPECT_EQ(get_animation_frame_index(animation, milliseconds {449}), 2);
+  EXPECT_EQ(get_animation_frame_index(animation, milliseconds {450}), 0);
+  EXPECT_EQ(get_animation_frame_index(animation, milliseconds {4'600}), 1);
+}
+
+/**
+ * \trace tactile::core::get_next_animation_frame_time
+ */
+TEST(Animation, GetNextAnimationFrameTime)
+{
+  Registry registry {};
+  const auto tile_entity = make_tile(registry, TileIndex {1});
+
+  using std::chrono::milliseconds;
+
+  // [0, 100) [100, 150) [150, 450)
+  const AnimationFrame frame1 {TileIndex {10}, milliseconds {100}};
+  const AnimationFrame frame2 {TileIndex {20}, milliseconds {50}};
+  const AnimationFrame frame3 {TileIndex {30}, milliseconds {300}};
+
+  ASSERT_TRUE(add_animation_frame(registry, tile_entity, 0, frame1).has_value());
+  ASSERT_TRUE(add_animation_frame(registry, tile_entity, 1, frame2).has_value());
+  ASSERT_TRUE(add_animation_frame(registry, tile_entity, 2, frame3).has_value());
+
+  const auto& animation = registry.get<CAnimation>(tile_entity);
+  EXPECT_EQ(get_next_animation_frame_time(animation, milliseconds {0}), milliseconds {100});
+  EXPECT_EQ(get_next_animation_frame_time(animation, milliseconds {100}), milliseconds {150});
+  EXPECT_EQ(get_next_animation_frame_time(animation, milliseconds {449}), milliseconds {450});
+  EXPECT_EQ(get_next_animation_frame_time(animation, milliseconds {4'600}),
+            milliseconds {4'650});
+
+  const auto static_tile_entity = make_tile(registry, TileIndex {2});
+  const AnimationFrame static_frame {TileIndex {40}, milliseconds::zero()};
+  ASSERT_TRUE(add_animation_frame(registry, static_tile_entity, 0, static_frame).has_value());
+
+  const auto& static_animation = registry.get<CAnimation>(static_tile_entity);
+  EXPECT_EQ(get_next_animation_frame_time(static_animation, milliseconds {0}), std::nullopt);
+}
+
+/**
+ * \trace tactile::core::enable_animation_clock
+ * \trace tactile::core::set_animation_clock_time
+ * \trace tactile::core::pause_animation_clock
+ * \trace tactile::core::get_current_animation_frame_index
+ */
+TEST(Animation, AnimationClock)
+{
+  Registry registry {};
+  const auto tile_entity = make_tile(registry, TileIndex {1});
+
+  using std::chrono::milliseconds;
+
+  const AnimationFrame frame1 {TileIndex {10}, milliseconds {100}};
+  const AnimationFrame frame2 {TileIndex {20}, milliseconds {100}};
+
+  ASSERT_TRUE(add_animation_frame(registry, tile_entity, 0, frame1).has_value());
+  ASSERT_TRUE(add_animation_frame(registry, tile_entity, 1, frame2).has_value());
+
+  enable_animation_clock(registry);
+  pause_animation_clock(registry, true);
+  set_animation_clock_time(registry, milliseconds {150});
+
+  update_animations(registry);
+
+  const auto& animation = registry.get<CAnimation>(tile_entity);
+  EXPECT_EQ(registry.get<CAnimationClock>().time, milliseconds {150});
+  EXPECT_EQ(animation.frame_index, 0);
+  EXPECT_EQ(get_current_animation_frame_index(registry, animation), 1);
+
+  set_animation_clock_time(registry, milliseconds {250});
+  EXPECT_EQ(get_current_animation_frame_index(registry, animation), 0);
+
+  pause_animation_clock(registry, false);
+  update_animations(registry);
+  EXPECT_GE(registry.get<CAnimationClock>().time, milliseconds {250});
+}
+
+/**
+ * \trace tactile::core::disable_animation_clock
+ */
+TEST(Animation, DisableAnimationClock)
+{
+  Registry registry {};
+  registry.add<CTileCache>();
+
+  EXPECT_NO_THROW(disable_animation_clock(registry));
+  EXPECT_EQ(registry.get<CTileCache>().version, 0);
+
+  enable_animation_clock(registry);
+  EXPECT_TRUE(registry.has<CAnimationClock>());
+  EXPECT_EQ(registry.get<CTileCache>().version, 1);
+
+  disable_animation_clock(registry);
+  EXPECT_FALSE(registry.has<CAnimationClock>());
+  EXPECT_EQ(registry.get<CTileCache>().version, 2);
+}
+
 /**
  * \trace tactile::core::add_animation_frame
  */
@@ -0,0 +1,230 @@
+// Copyright (C) 2024 Albin Johansson (GNU General Public License v3.0)
+
+#include "tactile/core/tile/tile_render_cache.hpp"
+
+#include <chrono>  // milliseconds
+#include <tuple>   // ignore
+
+#include <gtest/gtest.h>
+
+#include "tactile/core/entity/registry.hpp"
+#include "tactile/core/io/texture.hpp"
+#include "tactile/core/tile/animation.hpp"
+#include "tactile/core/tile/animation_types.hpp"
+#include "tactile/core/tile/tileset.hpp"
+#include "tactile/core/tile/tileset_types.hpp"
+
+namespace tactile::core {
+
+class TileRenderCacheTest : public testing::Test
+{
+ public:
+  TileRenderCacheTest()
+  {
+    mRegistry.add<CTileCache>();
+    mRegistry.add<CTileRenderCache>();
+  }
+
+  [[nodiscard]]
+  auto make_tileset_with_100_tiles(const TileID first_tile_id) -> EntityID
+  {
+    CTexture texture {};
+    texture.raw_handle = &mDummyTexture;
+    texture.id = TextureID {1};
+    texture.size = Int2 {100, 100};
+    texture.path = "foo/bar.png";
+
+    const TilesetSpec spec {
+      .tile_size = Int2 {10, 10},
+      .texture = texture,
+    };
+
+    const auto tileset_id = make_tileset_instance(mRegistry, spec, first_tile_id);
+    return tileset_id.value();
+  }
+
+ protected:
+  Registry mRegistry {};
+  int mDummyTexture {};
+};
+
+// tactile::core::update_tile_render_cache
+// tactile::core::find_tile_render_info
+TEST_F(TileRenderCacheTest, Build)
+{
+  const auto& render_cache = mRegistry.get<CTileRenderCache>();
+
+  update_tile_render_cache(mRegistry);
+  EXPECT_TRUE(render_cache.tiles.empty());
+  EXPECT_EQ(find_tile_render_info(render_cache, TileID {1}), nullptr);
+
+  const auto tileset_id = make_tileset_with_100_tiles(TileID {1});
+  update_tile_render_cache(mRegistry);
+
+  ASSERT_EQ(render_cache.tiles.size(), 100);
+  EXPECT_TRUE(render_cache.animations.empty());
+
+  EXPECT_EQ(find_tile_render_info(render_cache, kEmptyTile), nullptr);
+  EXPECT_EQ(find_tile_render_info(render_cache, TileID {101}), nullptr);
+
+  const auto* tile12 = find_tile_render_info(render_cache, TileID {12});
+  ASSERT_NE(tile12, nullptr);
+  EXPECT_EQ(tile12->texture_handle, &mDummyTexture);
+  EXPECT_EQ(tile12->uv_pos, (Float2 {0.1f, 0.1f}));
+  EXPECT_EQ(tile12->uv_size, (Float2 {0.1f, 0.1f}));
+  EXPECT_EQ(tile12->animation_slot, kNoAnimationSlot);
+
+  destroy_tileset(mRegistry, tileset_id);
+  update_tile_render_cache(mRegistry);
+
+  EXPECT_TRUE(render_cache.tiles.empty());
+  EXPECT_EQ(find_tile_render_info(render_cache, TileID {12}), nullptr);
+}
+
+// tactile::core::update_tile_render_cache
+// tactile::core::find_tile_render_info
+TEST_F(TileRenderCacheTest, LargeTileIdentifiers)
+{
+  const auto& render_cache = mRegistry.get<CTileRenderCache>();
+
+  std::ignore = make_tileset_with_100_tiles(TileID {1});
+  std::ignore = make_tileset_with_100_tiles(TileID {50'000'001});
+  update_tile_render_cache(mRegistry);
+
+  // The table size only depends on the number of tiles.
+  ASSERT_EQ(render_cache.tiles.size(), 200);
+  ASSERT_EQ(render_cache.ranges.size(), 2);
+
+  EXPECT_NE(find_tile_render_info(render_cache, TileID {100}), nullptr);
+  EXPECT_EQ(find_tile_render_info(render_cache, TileID {101}), nullptr);
+  EXPECT_EQ(find_tile_render_info(render_cache, TileID {50'000'000}), nullptr);
+  EXPECT_EQ(find_tile_render_info(render_cache, TileID {50'000'101}), nullptr);
+
+  const auto* tile12 = find_tile_render_info(render_cache, TileID {50'000'012});
+  ASSERT_NE(tile12, nullptr);
+  EXPECT_EQ(tile12, &render_cache.tiles.at(111));
+  EXPECT_EQ(tile12->texture_handle, &mDummyTexture);
+  EXPECT_EQ(tile12->uv_pos, (Float2 {0.1f, 0.1f}));
+}
+
+// tactile::core::update_tile_render_cache
+TEST_F(TileRenderCacheTest, AnimatedTiles)
+{
+  const auto tileset_id = make_tileset_with_100_tiles(TileID {1});
+  const auto& render_cache = mRegistry.get<CTileRenderCache>();
+
+  constexpr AnimationFrame frame1 {TileIndex {0}, std::chrono::milliseconds::zero()};
+  constexpr AnimationFrame frame2 {TileIndex {11}, std::chrono::milliseconds::zero()};
+
+  const auto tile_entity = get_or_make_tile(mRegistry, tileset_id, TileIndex {0});
+  ASSERT_TRUE(add_animation_frame(mRegistry, tile_entity, 0, frame1).has_value());
+  ASSERT_TRUE(add_animation_frame(mRegistry, tile_entity, 1, frame2).has_value());
+
+  update_tile_render_cache(mRegistry);
+  ASSERT_EQ(render_cache.animations.size(), 1);
+
+  const auto* tile1 = find_tile_render_info(render_cache, TileID {1});
+  ASSERT_NE(tile1, nullptr);
+  EXPECT_EQ(tile1->animation_slot, 0);
+  EXPECT_EQ(tile1->uv_pos, (Float2 {0.0f, 0.0f}));
+
+  update_animations(mRegistry);
+  update_tile_render_cache(mRegistry);
+  EXPECT_EQ(tile1->uv_pos, (Float2 {0.1f, 0.1f}));
+
+  update_animations(mRegistry);
+  update_tile_render_cache(mRegistry);
+  EXPECT_EQ(tile1->uv_pos, (Float2 {0.0f, 0.0f}));
+
+  ASSERT_TRUE(remove_animation_frame(mRegistry, tile_entity, 1).has_value());
+  ASSERT_TRUE(remove_animation_frame(mRegistry, tile_entity, 0).has_value());
+
+  update_tile_render_cache(mRegistry);
+  EXPECT_TRUE(render_cache.animations.empty());
+
+  tile1 = find_tile_render_info(render_cache, TileID {1});
+  ASSERT_NE(tile1, nullptr);
+  EXPECT_EQ(tile1->animation_slot, kNoAnimationSlot);
+}
+
+// tactile::core::update_tile_render_cache
+TEST_F(TileRenderCacheTest, ClockAnimatedTiles)
+{
+  const auto tileset_id = make_tileset_with_100_tiles(TileID {1});
+  const auto& render_cache = mRegistry.get<CTileRenderCache>();
+
+  using std::chrono::milliseconds;
+
+  constexpr AnimationFrame frame1 {TileIndex {0}, milliseconds {100}};
+  constexpr AnimationFrame frame2 {TileIndex {11}, milliseconds {100}};
+
+  const auto tile_entity = get_or_make_tile(mRegistry, tileset_id, TileIndex {0});
+  ASSERT_TRUE(add_animation_frame(mRegistry, tile_entity, 0, frame1).has_value());
+  ASSERT_TRUE(add_animation_frame(mRegistry, tile_entity, 1, frame2).has_value());
+
+  enable_animation_clock(mRegistry);
+  pause_animation_clock(mRegistry, true);
+
+  update_tile_render_cache(mRegistry);
+  ASSERT_EQ(render_cache.animation_changes.size(), 1);
+  EXPECT_EQ(render_cache.animation_changes.front().time, milliseconds {100});
+
+  const auto* tile1 = find_tile_render_info(render_cache, TileID {1});
+  ASSERT_NE(tile1, nullptr);
+  EXPECT_EQ(tile1->uv_pos, (Float2 {0.0f, 0.0f}));
+
+  // Not due yet.
+  set_animation_clock_time(mRegistry, milliseconds {99});
+  update_tile_render_cache(mRegistry);
+  EXPECT_EQ(tile1->uv_pos, (Float2 {0.0f, 0.0f}));
+
+  set_animation_clock_time(mRegistry, milliseconds {150});
+  update_tile_render_cache(mRegistry);
+  EXPECT_EQ(tile1->uv_pos, (Float2 {0.1f, 0.1f}));
+  ASSERT_EQ(render_cache.animation_changes.size(), 1);
+  EXPECT_EQ(render_cache.animation_changes.front().time, milliseconds {200});
+
+  // Skipping several cycles only visits the tile once.
+  set_animation_clock_time(mRegistry, milliseconds {1'020});
+  update_tile_render_cache(mRegistry);
+  EXPECT_EQ(tile1->uv_pos, (Float2 {0.0f, 0.0f}));
+  ASSERT_EQ(render_cache.animation_changes.size(), 1);
+  EXPECT_EQ(render_cache.animation_changes.front().time, milliseconds {1'100});
+
+  // The changes are rescheduled if the clock goes backwards.
+  set_animation_clock_time(mRegistry, milliseconds {120});
+  update_tile_render_cache(mRegistry);
+  EXPECT_EQ(tile1->uv_pos, (Float2 {0.1f, 0.1f}));
+  ASSERT_EQ(render_cache.animation_changes.size(), 1);
+  EXPECT_EQ(render_cache.animation_changes.front().time, milliseconds {200});
+}
+
+// tactile::core::update_tile_render_cache
+TEST_F(TileRenderCacheTest, AnimatedTilesAfterMissedUpdates)
+{
+  const auto tileset_id = make_tileset_with_100_tiles(TileID {1});
+  const auto& render_cache = mRegistry.get<CTileRenderCache>();
+
+  constexpr AnimationFrame frame1 {TileIndex {0}, std::chrono::milliseconds::zero()};
+  constexpr AnimationFrame frame2 {TileIndex {11}, std::chrono::milliseconds::zero()};
+  constexpr AnimationFrame frame3 {TileIndex {22}, std::chrono::milliseconds::zero()};
+
+  const auto tile_entity = get_or_make_tile(mRegistry, tileset_id, TileIndex {0});
+  ASSERT_TRUE(add_animation_frame(mRegistry, tile_entity, 0, frame1).has_value());
+  ASSERT_TRUE(add_animation_frame(mRegistry, tile_entity, 1, frame2).has_value());
+  ASSERT_TRUE(add_animation_frame(mRegistry, tile_entity, 2, frame3).has_value());
+
+  update_tile_render_cache(mRegistry);
+
+  // The render cache isn't updated between these animation updates.
+  update_animations(mRegistry);
+  update_animations(mRegistry);
+  update_tile_render_cache(mRegistry);
+
+  const auto* tile1 = find_tile_render_info(render_cache, TileID {1});
+  ASSERT_NE(tile1, nullptr);
+  EXPECT_EQ(tile1->uv_pos, (Float2 {0.2f, 0.2f}));
+  EXPECT_EQ(render_cache.animation_version, mRegistry.get<CAnimationSchedule>().version);
+}
+
+}  // namespace tactile::core
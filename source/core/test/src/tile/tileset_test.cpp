@@ -2,11 +2,14 @@
 
 #include "tactile/core/tile/tileset.hpp"
 
+#include <thread>  // this_thread
+
 #include <gtest/gtest.h>
 
 #include "tactile/base/numeric/saturate_cast.hpp"
 #include "tactile/core/entity/registry.hpp"
 #include "tactile/core/io/texture.hpp"
+#include "tactile/core/io/texture_cache.hpp"
 #include "tactile/core/meta/meta.hpp"
 #include "tactile/core/test/ir_comparison.hpp"
 #include "tactile/core/tile/animation.hpp"
@@ -56,6 +59,7 @@ class TilesetTest : public testing::Test
  protected:
   Registry mRegistry {};
   null_renderer::NullRenderer mRenderer {nullptr};
+  TextureCache mTextureCache {&mRenderer};
 };
 
 // tactile::core::make_tileset [Registry&, const TilesetSpec&]
@@ -81,13 +85,11 @@ TEST_F(TilesetTest, MakeTileset)
   EXPECT_EQ(tileset.tile_size, spec.tile_size);
   EXPECT_EQ(tileset.extent.rows, spec.texture.size.y() / spec.tile_size.y());
   EXPECT_EQ(tileset.extent.cols, spec.texture.size.x() / spec.tile_size.x());
-  EXPECT_EQ(tileset.tiles.size(), 132);
-  EXPECT_EQ(tileset.tiles.size(), tileset.extent.rows * tileset.extent.cols);
+  EXPECT_EQ(tileset.tile_count, 132);
+  EXPECT_EQ(tileset.tile_count, tileset.extent.rows * tileset.extent.cols);
 
-  for (const auto tile_entity : tileset.tiles) {
-    EXPECT_TRUE(mRegistry.is_valid(ts_entity));
-    EXPECT_TRUE(is_tile(mRegistry, tile_entity));
-  }
+  // Tiles are implicit until they need to be materialized.
+  EXPECT_TRUE(tileset.tiles.empty());
 
   EXPECT_EQ(texture.raw_handle, spec.texture.raw_handle);
   EXPECT_EQ(texture.id, spec.texture.id);
@@ -100,14 +102,14 @@ TEST_F(TilesetTest, MakeTileset)
   EXPECT_EQ(viewport.pos.y(), 0.0f);
 }
 
-// tactile::core::make_tileset [Registry&, IRenderer&, const ir::TilesetRef&]
+// tactile::core::make_tileset [Registry&, TextureCache&, const ir::TilesetRef&]
 TEST_F(TilesetTest, MakeTilesetFromIR)
 {
   TileID next_tile_id {1000};
   ObjectID next_object_id {10};
   const auto ir_tileset_ref = test::make_complex_ir_tileset(next_tile_id, next_object_id);
 
-  const auto tileset_id = make_tileset(mRegistry, mRenderer, ir_tileset_ref);
+  const auto tileset_id = make_tileset(mRegistry, mTextureCache, ir_tileset_ref);
   ASSERT_TRUE(tileset_id.has_value());
 
   compare_tileset(mRegistry, *tileset_id, ir_tileset_ref);
@@ -117,7 +119,7 @@ TEST_F(TilesetTest, MakeTilesetFromIR)
 TEST_F(TilesetTest, InitTilesetInstance)
 {
   const auto& tile_cache = mRegistry.get<CTileCache>();
-  ASSERT_EQ(tile_cache.tileset_mapping.size(), 0);
+  ASSERT_EQ(tile_cache.tileset_ranges.size(), 0);
 
   const auto ts_entity = make_dummy_tileset_with_100_tiles();
   ASSERT_FALSE(mRegistry.has<CTilesetInstance>(ts_entity));
@@ -131,17 +133,20 @@ TEST_F(TilesetTest, InitTilesetInstance)
   const auto& instance = mRegistry.get<CTilesetInstance>(ts_entity);
 
   EXPECT_EQ(instance.tile_range.first_id, first_tile);
-  EXPECT_EQ(instance.tile_range.count, saturate_cast<std::int32_t>(tileset.tiles.size()));
+  EXPECT_EQ(instance.tile_range.count, saturate_cast<std::int32_t>(tileset.tile_count));
   EXPECT_FALSE(instance.is_embedded);
 
-  EXPECT_EQ(tile_cache.tileset_mapping.size(), tileset.tiles.size());
+  ASSERT_EQ(tile_cache.tileset_ranges.size(), 1);
+  EXPECT_EQ(tile_cache.tileset_ranges.front().tileset_entity, ts_entity);
+  EXPECT_EQ(tile_cache.tileset_ranges.front().tile_range.first_id, first_tile);
+  EXPECT_EQ(tile_cache.tileset_ranges.front().tile_range.count, instance.tile_range.count);
 
-  EXPECT_FALSE(tile_cache.tileset_mapping.contains(first_tile - TileID {1}));
-  EXPECT_FALSE(tile_cache.tileset_mapping.contains(first_tile + instance.tile_range.count));
+  EXPECT_EQ(find_tileset(mRegistry, first_tile - TileID {1}), kInvalidEntity);
+  EXPECT_EQ(find_tileset(mRegistry, first_tile + instance.tile_range.count), kInvalidEntity);
 
   for (std::int32_t index = 0; index < instance.tile_range.count; ++index) {
     const TileID tile_id {instance.tile_range.first_id + index};
-    EXPECT_TRUE(tile_cache.tileset_mapping.contains(tile_id));
+    EXPECT_EQ(find_tileset(mRegistry, tile_id), ts_entity);
   }
 }
 
@@ -166,7 +171,7 @@ TEST_F(TilesetTest, InitTilesetInstanceMoreThanOnce)
 TEST_F(TilesetTest, InitTilesetInstanceTileRangeCollisionDetection)
 {
   const auto& tile_cache = mRegistry.get<CTileCache>();
-  ASSERT_EQ(tile_cache.tileset_mapping.size(), 0);
+  ASSERT_EQ(tile_cache.tileset_ranges.size(), 0);
 
   const auto ts1_entity = make_dummy_tileset_with_100_tiles();
   const auto ts2_entity = make_dummy_tileset_with_100_tiles();
@@ -187,13 +192,15 @@ TEST_F(TilesetTest, InitTilesetInstanceTileRangeCollisionDetection)
 TEST_F(TilesetTest, DestroyTileset)
 {
   const auto ts_entity = make_dummy_tileset_with_100_tiles();
+  ASSERT_NE(get_or_make_tile(mRegistry, ts_entity, TileIndex {0}), kInvalidEntity);
+  ASSERT_NE(get_or_make_tile(mRegistry, ts_entity, TileIndex {42}), kInvalidEntity);
 
   EXPECT_TRUE(mRegistry.is_valid(ts_entity));
-  EXPECT_EQ(mRegistry.count<CMeta>(), 101);
+  EXPECT_EQ(mRegistry.count<CMeta>(), 3);
   EXPECT_EQ(mRegistry.count<CTileset>(), 1);
   EXPECT_EQ(mRegistry.count<CTilesetInstance>(), 0);
   EXPECT_EQ(mRegistry.count<CTexture>(), 1);
-  EXPECT_EQ(mRegistry.count<CTile>(), 100);
+  EXPECT_EQ(mRegistry.count<CTile>(), 2);
   EXPECT_GT(mRegistry.count(), 0);
 
   destroy_tileset(mRegistry, ts_entity);
@@ -215,16 +222,18 @@ TEST_F(TilesetTest, DestroyTilesetInstance)
   const TileID first_tile {25};
   ASSERT_TRUE(init_tileset_instance(mRegistry, ts_entity, first_tile).has_value());
 
+  ASSERT_NE(get_or_make_tile(mRegistry, ts_entity, TileIndex {7}), kInvalidEntity);
+
   const auto& tile_cache = mRegistry.get<CTileCache>();
 
   EXPECT_TRUE(mRegistry.is_valid(ts_entity));
-  EXPECT_EQ(mRegistry.count<CMeta>(), 101);
+  EXPECT_EQ(mRegistry.count<CMeta>(), 2);
   EXPECT_EQ(mRegistry.count<CTileset>(), 1);
   EXPECT_EQ(mRegistry.count<CTilesetInstance>(), 1);
   EXPECT_EQ(mRegistry.count<CTexture>(), 1);
-  EXPECT_EQ(mRegistry.count<CTile>(), 100);
+  EXPECT_EQ(mRegistry.count<CTile>(), 1);
   EXPECT_GT(mRegistry.count(), 0);
-  EXPECT_EQ(tile_cache.tileset_mapping.size(), 100);
+  EXPECT_EQ(tile_cache.tileset_ranges.size(), 1);
 
   destroy_tileset(mRegistry, ts_entity);
 
@@ -235,14 +244,113 @@ TEST_F(TilesetTest, DestroyTilesetInstance)
   EXPECT_EQ(mRegistry.count<CTexture>(), 0);
   EXPECT_EQ(mRegistry.count<CTile>(), 0);
   EXPECT_EQ(mRegistry.count(), 0);
-  EXPECT_EQ(tile_cache.tileset_mapping.size(), 0);
+  EXPECT_EQ(tile_cache.tileset_ranges.size(), 0);
+}
+
+// tactile::core::destroy_tileset
+TEST_F(TilesetTest, DestroyTilesetReleasesTexture)
+{
+  TileID next_tile_id {1};
+  ObjectID next_object_id {1};
+  const auto ir_tileset_ref1 = test::make_complex_ir_tileset(next_tile_id, next_object_id);
+  const auto ir_tileset_ref2 = test::make_complex_ir_tileset(next_tile_id, next_object_id);
+
+  const auto ts1_entity = make_tileset(mRegistry, mTextureCache, ir_tileset_ref1);
+  const auto ts2_entity = make_tileset(mRegistry, mTextureCache, ir_tileset_ref2);
+  ASSERT_TRUE(ts1_entity.has_value());
+  ASSERT_TRUE(ts2_entity.has_value());
+
+  const auto texture_id = mRegistry.get<CTexture>(*ts1_entity).id;
+  EXPECT_EQ(mRegistry.get<CTexture>(*ts2_entity).id, texture_id);
+  EXPECT_EQ(mTextureCache.size(), 1);
+  EXPECT_EQ(mTextureCache.use_count(texture_id), 2);
+
+  destroy_tileset(mRegistry, *ts1_entity);
+  EXPECT_EQ(mTextureCache.use_count(texture_id), 1);
+  EXPECT_NE(mRenderer.find_texture(texture_id), nullptr);
+
+  destroy_tileset(mRegistry, *ts2_entity);
+  EXPECT_EQ(mTextureCache.size(), 0);
+  EXPECT_EQ(mRenderer.find_texture(texture_id), nullptr);
+}
+
+// tactile::core::make_tileset [Registry&, TextureCache&, const ir::TilesetRef&, ...]
+// tactile::core::update_tileset_textures
+TEST_F(TilesetTest, MakeTilesetWithDeferredTexture)
+{
+  TileID next_tile_id {1};
+  ObjectID next_object_id {1};
+  const auto ir_tileset_ref = test::make_complex_ir_tileset(next_tile_id, next_object_id);
+
+  const auto tileset_id =
+      make_tileset(mRegistry,
+                   mTextureCache,
+                   ir_tileset_ref,
+                   mTextureCache.acquire_async(ir_tileset_ref.tileset.image_path),
+                   TextureLoadMode::kDeferred);
+  ASSERT_TRUE(tileset_id.has_value());
+
+  // The texture size is known up front, regardless of whether the image is decoded yet.
+  const auto& texture = mRegistry.get<CTexture>(*tileset_id);
+  EXPECT_EQ(texture.size, ir_tileset_ref.tileset.image_size);
+  EXPECT_EQ(texture.path, ir_tileset_ref.tileset.image_path);
+
+  const auto initial_version = mRegistry.get<CTileCache>().version;
+  const auto was_pending = mRegistry.has<CPendingTexture>(*tileset_id);
+
+  while (update_tileset_textures(mRegistry) > 0) {
+    std::this_thread::yield();
+  }
+
+  EXPECT_FALSE(mRegistry.has<CPendingTexture>(*tileset_id));
+  EXPECT_NE(texture.id, TextureID {0});
+  EXPECT_EQ(texture.size, ir_tileset_ref.tileset.image_size);
+  EXPECT_EQ(mTextureCache.use_count(texture.id), 1);
+
+  if (was_pending) {
+    EXPECT_GT(mRegistry.get<CTileCache>().version, initial_version);
+  }
+
+  destroy_tileset(mRegistry, *tileset_id);
+  EXPECT_EQ(mTextureCache.size(), 0);
+}
+
+// tactile::core::update_tileset_textures
+TEST_F(TilesetTest, UpdateTilesetTexturesWithoutTextureCache)
+{
+  const auto version = mRegistry.get<CTileCache>().version;
+
+  EXPECT_EQ(update_tileset_textures(mRegistry), 0);
+  EXPECT_EQ(mRegistry.get<CTileCache>().version, version);
+}
+
+// tactile::core::find_tile
+// tactile::core::get_or_make_tile
+TEST_F(TilesetTest, GetOrMakeTile)
+{
+  const auto ts_entity = make_dummy_tileset_with_100_tiles();
+  const TileIndex index {23};
+
+  EXPECT_EQ(find_tile(mRegistry, ts_entity, index), kInvalidEntity);
+
+  const auto tile_entity = get_or_make_tile(mRegistry, ts_entity, index);
+  ASSERT_NE(tile_entity, kInvalidEntity);
+  EXPECT_TRUE(is_tile(mRegistry, tile_entity));
+  EXPECT_EQ(mRegistry.get<CTile>(tile_entity).index, index);
+
+  EXPECT_EQ(find_tile(mRegistry, ts_entity, index), tile_entity);
+  EXPECT_EQ(get_or_make_tile(mRegistry, ts_entity, index), tile_entity);
+  EXPECT_EQ(mRegistry.count<CTile>(), 1);
+
+  EXPECT_EQ(get_or_make_tile(mRegistry, ts_entity, TileIndex {-1}), kInvalidEntity);
+  EXPECT_EQ(get_or_make_tile(mRegistry, ts_entity, TileIndex {100}), kInvalidEntity);
+  EXPECT_EQ(mRegistry.count<CTile>(), 1);
 }
 
 // tactile::core::get_tile_appearance
 TEST_F(TilesetTest, GetTileAppearance)
 {
   const auto ts_entity = make_dummy_tileset_with_100_tiles();
-  const auto& tileset = mRegistry.get<CTileset>(ts_entity);
 
   const TileIndex index10 {10};
   const TileIndex index11 {11};
@@ -252,7 +360,7 @@ TEST_F(TilesetTest, GetTileAppearance)
   EXPECT_EQ(get_tile_appearance(mRegistry, ts_entity, index11), index11);
   EXPECT_EQ(get_tile_appearance(mRegistry, ts_entity, index12), index12);
 
-  const auto tile10_entity = tileset.tiles.at(10);
+  const auto tile10_entity = get_or_make_tile(mRegistry, ts_entity, index10);
   ASSERT_TRUE(add_animation_frame(mRegistry,
                                   tile10_entity,
                                   0,
@@ -378,6 +486,9 @@ TEST_F(TilesetTest, IsTileRangeAvailable)
   // Large overlap
   EXPECT_FALSE(is_tile_range_available(mRegistry, {TileID {1}, 20}));
   EXPECT_FALSE(is_tile_range_available(mRegistry, {TileID {40}, 100}));
+
+  // Enclosing range
+  EXPECT_FALSE(is_tile_range_available(mRegistry, {TileID {1}, 200}));
 }
 
 // tactile::core::has_tile
@@ -5,7 +5,10 @@
 #include <algorithm>    // count, count_if
 #include <cctype>       // isxdigit
 #include <map>          // map
+#include <set>          // set
+#include <thread>       // jthread
 #include <type_traits>  // ...
+#include <vector>       // vector
 
 #include <gtest/gtest.h>
 
@@ -50,6 +53,33 @@ TEST(UUID, Generate)
   EXPECT_FALSE(c.is_null());
 }
 
+/** \trace tactile::core::UUID::generate */
+TEST(UUID, GenerateConcurrently)
+{
+  constexpr std::size_t kThreadCount = 8;
+  constexpr std::size_t kUuidsPerThread = 1'000;
+
+  std::vector<std::vector<UUID>> uuids(kThreadCount);
+
+  {
+    std::vector<std::jthread> threads {};
+    for (auto& thread_uuids : uuids) {
+      threads.emplace_back([&thread_uuids] {
+        for (std::size_t index = 0; index < kUuidsPerThread; ++index) {
+          thread_uuids.push_back(UUID::generate());
+        }
+      });
+    }
+  }
+
+  std::set<UUID> unique_uuids {};
+  for (const auto& thread_uuids : uuids) {
+    unique_uuids.insert(thread_uuids.begin(), thread_uuids.end());
+  }
+
+  EXPECT_EQ(unique_uuids.size(), kThreadCount * kUuidsPerThread);
+}
+
 /**
  * \trace tactile:UUID::generate
  * \trace tactile:UUID::hash_code
@@ -0,0 +1,64 @@
+// Copyright (C) 2024 Albin Johansson (GNU General Public License v3.0)
+
+#include "tactile/core/util/worker_pool.hpp"
+
+#include <atomic>  // atomic_int
+#include <future>  // future
+#include <thread>  // this_thread
+#include <tuple>   // ignore
+#include <vector>  // vector
+
+#include <gtest/gtest.h>
+
+namespace tactile::core {
+
+// tactile::core::WorkerPool::WorkerPool
+TEST(WorkerPool, WorkerCount)
+{
+  const WorkerPool pool1 {0};
+  const WorkerPool pool2 {3};
+
+  EXPECT_EQ(pool1.worker_count(), 1);
+  EXPECT_EQ(pool2.worker_count(), 3);
+}
+
+// tactile::core::WorkerPool::submit
+TEST(WorkerPool, Submit)
+{
+  WorkerPool pool {4};
+
+  std::vector<std::future<int>> futures {};
+  for (int value = 0; value < 100; ++value) {
+    futures.push_back(pool.submit([value] { return value * 2; }));
+  }
+
+  for (int value = 0; value < 100; ++value) {
+    EXPECT_EQ(futures[value].get(), value * 2);
+  }
+}
+
+// tactile::core::WorkerPool::submit
+TEST(WorkerPool, SubmitOnWorkerThread)
+{
+  WorkerPool pool {1};
+
+  auto future = pool.submit([] { return std::this_thread::get_id(); });
+  EXPECT_NE(future.get(), std::this_thread::get_id());
+}
+
+// tactile::core::WorkerPool::~WorkerPool
+TEST(WorkerPool, DestructorRunsQueuedTasks)
+{
+  std::atomic_int counter {0};
+
+  {
+    WorkerPool pool {2};
+    for (int index = 0; index < 50; ++index) {
+      std::ignore = pool.submit([&counter] { ++counter; });
+    }
+  }
+
+  EXPECT_EQ(counter.load(), 50);
+}
+
+}  // namespace tactile::core
@@ -5,14 +5,16 @@
 #include <exception>   // exception
 #include <expected>    // expected
 #include <filesystem>  // path
-#include <fstream>     // ifstream, ofstream
+#include <fstream>     // ifstream
 #include <iomanip>     // setw
 #include <ios>         // ios
 #include <optional>    // optional, nullopt
+#include <ostream>     // ostream
 
 #include <nlohmann/json.hpp>
 
 #include "tactile/base/debug/error_code.hpp"
+#include "tactile/base/io/atomic_file.hpp"
 #include "tactile/runtime/logging.hpp"
 
 namespace tactile {
@@ -54,6 +56,10 @@ inline auto load_json(const std::filesystem::path& path) -> std::optional<nlohma
 /**
  * Attempts to save a JSON object to a file.
  *
+ * \details
+ * The file is replaced atomically, so existing files are left intact if the
+ * JSON object can't be written.
+ *
  * \param path        The destination file path.
  * \param json        The JSON object to save.
  * \param indentation The indentation level to use.
@@ -69,14 +75,15 @@ inline auto save_json(const std::filesystem::path& path,
   runtime::log(LogLevel::kDebug, "Saving JSON: {}", path.string());
 
   try {
-    std::ofstream stream {path, std::ios::out | std::ios::trunc};
-
-    if (stream.good()) {
+    const auto write_result = write_file_atomically(path, [&](std::ostream& stream) {
       stream << std::setw(indentation) << json;
-      return {};
+    });
+
+    if (!write_result.has_value()) {
+      runtime::log(LogLevel::kError, "Could not write JSON file");
     }
 
-    runtime::log(LogLevel::kError, "Could not open JSON stream");
+    return write_result;
   }
   catch (const std::exception& error) {
     runtime::log(LogLevel::kError, "JSON save error: {}", error.what());
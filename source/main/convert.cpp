@@ -0,0 +1,8 @@
+// Copyright (C) 2024 Albin Johansson (GNU General Public License v3.0)
+
+#include "tactile/runtime/launcher.hpp"
+
+auto main(const int argc, char* argv[]) -> int
+{
+  return tactile::runtime::launch_converter(argc, argv);
+}
@@ -4,12 +4,12 @@
 
 #include <cstddef>  // size_t
 #include <format>   // format
-#include <fstream>  // ofstream
 #include <iomanip>  // quoted, setprecision
 #include <ios>      // boolalpha, fixed
 #include <ostream>  // ostream
 #include <sstream>  // stringstream
 
+#include "tactile/base/io/atomic_file.hpp"
 #include "tactile/base/numeric/saturate_cast.hpp"
 #include "tactile/godot_tscn/gd3_scene_writer.hpp"
 #include "tactile/godot_tscn/gd3_types.hpp"
@@ -438,40 +438,35 @@ auto _emit_map_file(const Gd3Map& map, const SaveFormatWriteOptions& options)
   const auto path = options.base_dir / "map.tscn";
   runtime::log(LogLevel::kDebug, "Generating map scene '{}'", path.string());
 
-  std::ofstream stream {path, std::ios::out | std::ios::trunc};
-  if (!stream.good()) {
-    return std::unexpected {ErrorCode::kBadFileStream};
-  }
-
-  Gd3SceneWriter writer {stream};
-
-  const auto load_steps = map.resources.ext_resources.size() +
-                          saturate_cast<std::size_t>(map.resources.next_sub_resource_id - 1);
-  writer.gd_scene_header(load_steps);
+  return write_file_atomically(path, [&](std::ostream& stream) {
+    Gd3SceneWriter writer {stream};
 
-  _emit_resources(writer, map.resources);
+    const auto load_steps = map.resources.ext_resources.size() +
+                            saturate_cast<std::size_t>(map.resources.next_sub_resource_id - 1);
+    writer.gd_scene_header(load_steps);
 
-  for (const auto& [id, texture] : map.atlas_textures) {
-    _emit_atlas_texture(writer, id, texture);
-  }
+    _emit_resources(writer, map.resources);
 
-  for (const auto& [id, shape] : map.rect_shapes) {
-    writer.newline()
-        .sub_resource_header("RectangleShape2D", id)
-        .vector2_variable("extents", shape.extents);
-  }
+    for (const auto& [id, texture] : map.atlas_textures) {
+      _emit_atlas_texture(writer, id, texture);
+    }
 
-  _emit_sprite_frames(writer, map.sprite_frames);
-  _emit_tileset(writer, map.tileset);
+    for (const auto& [id, shape] : map.rect_shapes) {
+      writer.newline()
+          .sub_resource_header("RectangleShape2D", id)
+          .vector2_variable("extents", shape.extents);
+    }
 
-  writer.newline().node_header("Root", "Node2D");
-  _emit_metadata(writer, map.meta);
+    _emit_sprite_frames(writer, map.sprite_frames);
+    _emit_tileset(writer, map.tileset);
 
-  for (const auto& layer : map.layers) {
-    _emit_layer(writer, layer, map.tileset.id, map.sprite_frames.id);
-  }
+    writer.newline().node_header("Root", "Node2D");
+    _emit_metadata(writer, map.meta);
 
-  return {};
+    for (const auto& layer : map.layers) {
+      _emit_layer(writer, layer, map.tileset.id, map.sprite_frames.id);
+    }
+  });
 }
 
 [[nodiscard]]
@@ -3,8 +3,10 @@
 #include "tactile//tiled_tmx/tmx_common.hpp"
 
 #include <fstream>    // ifstream
+#include <ostream>    // ostream
 #include <stdexcept>  // invalid_argument
 
+#include "tactile/base/io/atomic_file.hpp"
 #include "tactile/runtime/logging.hpp"
 
 namespace tactile::tiled_tmx {
@@ -52,12 +54,15 @@ auto save_xml_document(const pugi::xml_document& document, const std::filesystem
 {
   runtime::log(LogLevel::kTrace, "Saving XML document to {}", path.string());
 
-  if (!document.save_file(path.c_str(), "  ")) {
+  const auto write_result = write_file_atomically(path, [&](std::ostream& stream) {
+    document.save(stream, "  ");
+  });
+
+  if (!write_result.has_value()) {
     runtime::log(LogLevel::kError, "Could not save XML document");
-    return std::unexpected {ErrorCode::kWriteError};
   }
 
-  return {};
+  return write_result;
 }
 
 auto read_property_type(const std::string_view name) -> std::expected<AttributeType, ErrorCode>
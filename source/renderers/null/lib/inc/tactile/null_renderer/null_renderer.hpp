@@ -2,28 +2,73 @@
 
 #pragma once
 
+#include <chrono>         // steady_clock
+#include <cstdint>        // uint64_t
+#include <mutex>          // mutex
 #include <unordered_map>  // unordered_map
 
 #include "tactile/base/id.hpp"
+#include "tactile/base/prelude.hpp"
 #include "tactile/base/render/renderer.hpp"
 #include "tactile/null_renderer/api.hpp"
 #include "tactile/null_renderer/null_texture.hpp"
 
 namespace tactile::null_renderer {
 
+/**
+ * Provides statistics about the ImGui draw data submitted by the null renderer.
+ */
+struct NullRenderStats final
+{
+  /** The number of draw lists, i.e., roughly the number of windows. */
+  std::uint64_t draw_list_count;
+
+  /** The number of draw commands, i.e., the number of draw calls a GPU renderer issues. */
+  std::uint64_t draw_command_count;
+
+  /** The number of submitted vertices. */
+  std::uint64_t vertex_count;
+
+  /** The number of submitted indices. */
+  std::uint64_t index_count;
+
+  /** The number of quads, approximated as six indices per quad. */
+  std::uint64_t quad_count;
+
+  /** The number of draw commands that use another texture than the previous command. */
+  std::uint64_t texture_switch_count;
+};
+
 /**
  * A null renderer implementation.
+ *
+ * \details
+ * The renderer owns a regular ImGui context, so the editor can run as usual
+ * without a GPU. Instead of rendering anything, the draw data of each frame is
+ * inspected to collect draw statistics, which is useful for tracking the draw
+ * call count of the editor in automated tests.
+ *
+ * Textures may be loaded, unloaded, and queried concurrently from several
+ * threads. Texture pointers remain valid until the texture is unloaded.
  */
 class TACTILE_NULL_RENDERER_API NullRenderer final : public IRenderer
 {
  public:
+  TACTILE_DELETE_COPY(NullRenderer);
+  TACTILE_DELETE_MOVE(NullRenderer);
+
   /**
    * Creates a renderer.
    *
-   * \param window The associated window.
+   * \details
+   * The created ImGui context isn't made current, see \c get_imgui_context.
+   *
+   * \param window The associated window, may be null.
    */
   explicit NullRenderer(IWindow* window);
 
+  ~NullRenderer() noexcept override;
+
   [[nodiscard]]
   auto begin_frame() -> bool override;
 
@@ -33,6 +78,17 @@ class TACTILE_NULL_RENDERER_API NullRenderer final : public IRenderer
   auto load_texture(const std::filesystem::path& image_path)
       -> std::expected<TextureID, ErrorCode> override;
 
+  [[nodiscard]]
+  auto decode_image(const std::filesystem::path& image_path) const
+      -> std::expected<ImageData, ErrorCode> override;
+
+  [[nodiscard]]
+  auto get_image_cache_tag() const -> std::string_view override;
+
+  [[nodiscard]]
+  auto upload_texture(const std::filesystem::path& image_path, const ImageData& image)
+      -> std::expected<TextureID, ErrorCode> override;
+
   void unload_texture(TextureID id) override;
 
   [[nodiscard]]
@@ -57,9 +113,42 @@ class TACTILE_NULL_RENDERER_API NullRenderer final : public IRenderer
   [[nodiscard]]
   auto get_options() -> const RendererOptions& override;
 
+  /**
+   * Returns the draw statistics of the most recently rendered frame.
+   *
+   * \return
+   * The statistics of the last frame.
+   */
+  [[nodiscard]]
+  auto get_frame_stats() const -> const NullRenderStats&;
+
+  /**
+   * Returns the accumulated draw statistics of all rendered frames.
+   *
+   * \return
+   * The total statistics.
+   */
+  [[nodiscard]]
+  auto get_total_stats() const -> const NullRenderStats&;
+
+  /**
+   * Returns the number of rendered frames.
+   *
+   * \return
+   * A frame count.
+   */
+  [[nodiscard]]
+  auto get_frame_count() const -> std::uint64_t;
+
  private:
   RendererOptions m_options;
   IWindow* m_window;
+  ImGuiContext* m_imgui_context;
+  std::chrono::steady_clock::time_point m_last_frame_time;
+  NullRenderStats m_frame_stats;
+  NullRenderStats m_total_stats;
+  std::uint64_t m_frame_count;
+  mutable std::mutex m_texture_mutex;
   std::unordered_map<TextureID, NullTexture> m_textures;
   TextureID m_next_texture_id;
 };
@@ -15,7 +15,8 @@ namespace tactile::null_renderer {
  * Manages the null renderer plugin.
  *
  * \note
- * This plugin is only intended for testing purposes.
+ * This plugin is intended for testing purposes and headless use, e.g. batch
+ * conversions. The renderer is installed even if no window is available.
  */
 class TACTILE_NULL_RENDERER_API NullRendererPlugin final : public IPlugin
 {
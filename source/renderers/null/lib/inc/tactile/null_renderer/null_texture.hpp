@@ -2,10 +2,13 @@
 
 #pragma once
 
+#include <cstddef>   // size_t
+#include <cstdint>   // uint32_t
 #include <expected>  // expected
 
 #include "tactile/base/debug/error_code.hpp"
 #include "tactile/base/prelude.hpp"
+#include "tactile/base/render/image_data.hpp"
 #include "tactile/base/render/texture.hpp"
 #include "tactile/null_renderer/api.hpp"
 
@@ -13,6 +16,11 @@ namespace tactile::null_renderer {
 
 /**
  * A null texture implementation.
+ *
+ * \details
+ * Null textures don't store any pixel data, but they keep track of the
+ * metadata of the uploaded images. The handle of a null texture is unique
+ * among all live textures, so that texture switches can be detected.
  */
 class TACTILE_NULL_RENDERER_API NullTexture final : public ITexture
 {
@@ -31,6 +39,29 @@ class TACTILE_NULL_RENDERER_API NullTexture final : public ITexture
   [[nodiscard]]
   static auto load(std::filesystem::path path) -> std::expected<NullTexture, ErrorCode>;
 
+  /**
+   * Decodes an image, without creating a texture.
+   *
+   * \param path The image path.
+   *
+   * \return
+   * The decoded image if successful; an error code otherwise.
+   */
+  [[nodiscard]]
+  static auto decode(const std::filesystem::path& path) -> std::expected<ImageData, ErrorCode>;
+
+  /**
+   * Creates a texture from a decoded image.
+   *
+   * \param path  The image path.
+   * \param image The decoded image.
+   *
+   * \return
+   * A texture.
+   */
+  [[nodiscard]]
+  static auto upload(std::filesystem::path path, const ImageData& image) -> NullTexture;
+
   [[nodiscard]]
   auto get_handle() const -> void* override;
 
@@ -40,11 +71,41 @@ class TACTILE_NULL_RENDERER_API NullTexture final : public ITexture
   [[nodiscard]]
   auto get_path() const -> const std::filesystem::path& override;
 
+  /**
+   * Returns the format of the uploaded image.
+   *
+   * \return
+   * An image format.
+   */
+  [[nodiscard]]
+  auto get_format() const -> ImageFormat;
+
+  /**
+   * Returns the number of mip levels in the uploaded image.
+   *
+   * \return
+   * A mip level count.
+   */
+  [[nodiscard]]
+  auto get_mip_count() const -> std::uint32_t;
+
+  /**
+   * Returns the amount of memory that the texture would occupy on a GPU.
+   *
+   * \return
+   * A size in bytes.
+   */
+  [[nodiscard]]
+  auto get_byte_count() const -> std::size_t;
+
  private:
   TextureSize m_size;
   std::filesystem::path m_path;
+  ImageFormat m_format;
+  std::uint32_t m_mip_count;
+  std::size_t m_byte_count;
 
-  NullTexture(TextureSize size, std::filesystem::path path);
+  NullTexture(const ImageData& image, std::filesystem::path path);
 };
 
 }  // namespace tactile::null_renderer
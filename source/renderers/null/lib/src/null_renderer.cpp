@@ -2,49 +2,214 @@
 
 #include "tactile/null_renderer/null_renderer.hpp"
 
-#include <utility>  // move
+#include <mutex>     // scoped_lock
+#include <optional>  // optional
+#include <utility>   // move
+
+#include <SDL2/SDL.h>
+#include <imgui.h>
+
+#include "tactile/base/render/window.hpp"
+#include "tactile/runtime/profiling.hpp"
 
 namespace tactile::null_renderer {
+namespace {
+
+// Used as the display size when there is no window to query.
+inline constexpr ImVec2 kFallbackDisplaySize {1920.0f, 1080.0f};
+
+[[nodiscard]]
+auto _get_display_size(IWindow* window) -> ImVec2
+{
+  if (window == nullptr) {
+    return kFallbackDisplaySize;
+  }
+
+  int width {};
+  int height {};
+  SDL_GetWindowSize(window->get_handle(), &width, &height);
+
+  return ImVec2 {static_cast<float>(width), static_cast<float>(height)};
+}
+
+void _prepare_font_atlas(const ImTextureID font_texture_id)
+{
+  auto& io = ImGui::GetIO();
+
+  // This builds the atlas if needed, the pixels are never used.
+  unsigned char* pixels {};
+  int width {};
+  int height {};
+  io.Fonts->GetTexDataAsRGBA32(&pixels, &width, &height);
+
+  io.Fonts->SetTexID(font_texture_id);
+}
+
+[[nodiscard]]
+auto _collect_render_stats(const ImDrawData& draw_data) -> NullRenderStats
+{
+  NullRenderStats stats {};
+  stats.draw_list_count = static_cast<std::uint64_t>(draw_data.CmdListsCount);
+
+  std::optional<ImTextureID> current_texture_id {};
+
+  for (int list_index = 0; list_index < draw_data.CmdListsCount; ++list_index) {
+    const auto* draw_list = draw_data.CmdLists[list_index];
+    stats.vertex_count += static_cast<std::uint64_t>(draw_list->VtxBuffer.Size);
+
+    for (const auto& command : draw_list->CmdBuffer) {
+      // Callbacks, e.g. render state resets, don't result in any draw calls.
+      if (command.UserCallback != nullptr) {
+        continue;
+      }
+
+      ++stats.draw_command_count;
+      stats.index_count += command.ElemCount;
+      stats.quad_count += command.ElemCount / 6;
+
+      const auto texture_id = command.GetTexID();
+      if (current_texture_id != texture_id) {
+        current_texture_id = texture_id;
+        ++stats.texture_switch_count;
+      }
+    }
+  }
+
+  return stats;
+}
+
+void _accumulate_render_stats(NullRenderStats& total, const NullRenderStats& frame)
+{
+  total.draw_list_count += frame.draw_list_count;
+  total.draw_command_count += frame.draw_command_count;
+  total.vertex_count += frame.vertex_count;
+  total.index_count += frame.index_count;
+  total.quad_count += frame.quad_count;
+  total.texture_switch_count += frame.texture_switch_count;
+}
+
+}  // namespace
 
 NullRenderer::NullRenderer(IWindow* window)
   : m_options {},
     m_window {window},
+    m_imgui_context {ImGui::CreateContext()},
+    m_last_frame_time {std::chrono::steady_clock::now()},
+    m_frame_stats {},
+    m_total_stats {},
+    m_frame_count {0},
+    m_texture_mutex {},
     m_textures {},
     m_next_texture_id {1}
-{}
+{
+  // The context is only made current while it's configured, so that the
+  // current context of the caller is left untouched.
+  auto* previous_context = ImGui::GetCurrentContext();
+  ImGui::SetCurrentContext(m_imgui_context);
+
+  auto& io = ImGui::GetIO();
+  io.BackendRendererName = "tactile-null-renderer";
+  io.DisplaySize = _get_display_size(m_window);
+
+  ImGui::SetCurrentContext(previous_context);
+}
+
+NullRenderer::~NullRenderer() noexcept
+{
+  ImGui::DestroyContext(m_imgui_context);
+}
 
 auto NullRenderer::begin_frame() -> bool
 {
+  TACTILE_RUNTIME_PROFILE_ZONE("NullRenderer::begin_frame");
+
+  auto& io = ImGui::GetIO();
+
+  if (!io.Fonts->IsBuilt()) {
+    _prepare_font_atlas(reinterpret_cast<ImTextureID>(this));
+  }
+
+  const auto now = std::chrono::steady_clock::now();
+  const std::chrono::duration<float> delta_time = now - m_last_frame_time;
+  m_last_frame_time = now;
+
+  // ImGui requires strictly positive frame times.
+  io.DeltaTime = delta_time.count() > 0.0f ? delta_time.count() : (1.0f / 60.0f);
+  io.DisplaySize = _get_display_size(m_window);
+
+  ImGui::NewFrame();
+
   return true;
 }
 
 void NullRenderer::end_frame()
-{}
+{
+  TACTILE_RUNTIME_PROFILE_ZONE("NullRenderer::end_frame");
+
+  ImGui::Render();
+
+  if (const auto* draw_data = ImGui::GetDrawData()) {
+    m_frame_stats = _collect_render_stats(*draw_data);
+  }
+  else {
+    m_frame_stats = NullRenderStats {};
+  }
+
+  _accumulate_render_stats(m_total_stats, m_frame_stats);
+  ++m_frame_count;
+}
 
 auto NullRenderer::load_texture(const std::filesystem::path& image_path)
     -> std::expected<TextureID, ErrorCode>
 {
-  auto texture = NullTexture::load(image_path);
+  // Images are decoded before acquiring the lock, since that's the slow part.
+  const auto image = decode_image(image_path);
 
-  if (!texture.has_value()) {
-    return std::unexpected {texture.error()};
+  if (!image.has_value()) {
+    return std::unexpected {image.error()};
   }
 
+  return upload_texture(image_path, *image);
+}
+
+auto NullRenderer::decode_image(const std::filesystem::path& image_path) const
+    -> std::expected<ImageData, ErrorCode>
+{
+  return NullTexture::decode(image_path);
+}
+
+auto NullRenderer::get_image_cache_tag() const -> std::string_view
+{
+  // Decoding is cheap enough in headless contexts, and shouldn't leave files behind.
+  return {};
+}
+
+auto NullRenderer::upload_texture(const std::filesystem::path& image_path,
+                                  const ImageData& image)
+    -> std::expected<TextureID, ErrorCode>
+{
+  auto texture = NullTexture::upload(image_path, image);
+
+  const std::scoped_lock lock {m_texture_mutex};
+
   const auto texture_id = m_next_texture_id;
   ++m_next_texture_id.value;
 
-  m_textures.insert_or_assign(texture_id, std::move(*texture));
+  m_textures.insert_or_assign(texture_id, std::move(texture));
 
   return texture_id;
 }
 
 void NullRenderer::unload_texture(const TextureID id)
 {
+  const std::scoped_lock lock {m_texture_mutex};
   m_textures.erase(id);
 }
 
 auto NullRenderer::find_texture(const TextureID id) const -> const ITexture*
 {
+  const std::scoped_lock lock {m_texture_mutex};
+
   const auto iter = m_textures.find(id);
 
   if (iter != m_textures.end()) {
@@ -55,11 +220,13 @@ auto NullRenderer::find_texture(const TextureID id) const -> const ITexture*
 }
 
 void NullRenderer::try_reload_fonts()
-{}
+{
+  _prepare_font_atlas(reinterpret_cast<ImTextureID>(this));
+}
 
 auto NullRenderer::can_reload_fonts() const -> bool
 {
-  return false;
+  return true;
 }
 
 auto NullRenderer::get_window() -> IWindow*
@@ -74,7 +241,7 @@ auto NullRenderer::get_window() const -> const IWindow*
 
 auto NullRenderer::get_imgui_context() -> ImGuiContext*
 {
-  return nullptr;
+  return m_imgui_context;
 }
 
 void NullRenderer::process_event(const SDL_Event&)
@@ -85,4 +252,19 @@ auto NullRenderer::get_options() -> const RendererOptions&
   return m_options;
 }
 
+auto NullRenderer::get_frame_stats() const -> const NullRenderStats&
+{
+  return m_frame_stats;
+}
+
+auto NullRenderer::get_total_stats() const -> const NullRenderStats&
+{
+  return m_total_stats;
+}
+
+auto NullRenderer::get_frame_count() const -> std::uint64_t
+{
+  return m_frame_count;
+}
+
 }  // namespace tactile::null_renderer
@@ -4,6 +4,8 @@
 
 #include <new>  // nothrow
 
+#include <imgui.h>
+
 #include "tactile/base/runtime/runtime.hpp"
 #include "tactile/runtime/logging.hpp"
 
@@ -18,10 +20,15 @@ void NullRendererPlugin::load(IRuntime* runtime)
   auto* window = m_runtime->get_window();
 
   if (!window) {
-    runtime::log(LogLevel::kError, "Could not initialize window");
-    return;
+    runtime::log(LogLevel::kDebug, "Using null renderer without a window");
   }
 
+  ImGuiMemAllocFunc imgui_alloc_fn {};
+  ImGuiMemFreeFunc imgui_free_fn {};
+  void* imgui_user_data {};
+  m_runtime->get_imgui_allocator_functions(&imgui_alloc_fn, &imgui_free_fn, &imgui_user_data);
+  ImGui::SetAllocatorFunctions(imgui_alloc_fn, imgui_free_fn, imgui_user_data);
+
   m_renderer = std::make_unique<NullRenderer>(window);
   m_runtime->set_renderer(m_renderer.get());
 }
@@ -30,6 +37,22 @@ void NullRendererPlugin::unload()
 {
   runtime::log(LogLevel::kTrace, "Unloading null renderer plugin");
 
+  if (m_renderer && m_renderer->get_frame_count() > 0) {
+    const auto frame_count = m_renderer->get_frame_count();
+    const auto& stats = m_renderer->get_total_stats();
+
+    runtime::log(LogLevel::kInfo,
+                 "Rendered {} frames: {} draw commands ({:.1f}/frame), {} quads "
+                 "({:.1f}/frame), {} texture switches ({:.1f}/frame)",
+                 frame_count,
+                 stats.draw_command_count,
+                 static_cast<double>(stats.draw_command_count) / frame_count,
+                 stats.quad_count,
+                 static_cast<double>(stats.quad_count) / frame_count,
+                 stats.texture_switch_count,
+                 static_cast<double>(stats.texture_switch_count) / frame_count);
+  }
+
   m_runtime->set_renderer(nullptr);
   m_runtime = nullptr;
 
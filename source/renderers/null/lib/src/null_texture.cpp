@@ -2,6 +2,7 @@
 
 #include "tactile/null_renderer/null_texture.hpp"
 
+#include <cstddef>  // size_t
 #include <utility>  // move
 
 #define STB_IMAGE_IMPLEMENTATION
@@ -11,18 +12,36 @@
 
 namespace tactile::null_renderer {
 
-NullTexture::NullTexture(const TextureSize size, std::filesystem::path path)
-  : m_size {size},
-    m_path {std::move(path)}
+NullTexture::NullTexture(const ImageData& image, std::filesystem::path path)
+  : m_size {image.size},
+    m_path {std::move(path)},
+    m_format {image.format},
+    m_mip_count {image.mip_count},
+    m_byte_count {image.pixels.size()}
 {}
 
 auto NullTexture::load(std::filesystem::path path) -> std::expected<NullTexture, ErrorCode>
 {
-  TextureSize size {};
+  const auto image = decode(path);
+
+  if (!image.has_value()) {
+    return std::unexpected {image.error()};
+  }
+
+  return upload(std::move(path), *image);
+}
+
+auto NullTexture::decode(const std::filesystem::path& path)
+    -> std::expected<ImageData, ErrorCode>
+{
+  ImageData image {};
 
   const auto path_string = path.string();
-  auto* pixels =
-      stbi_load(path_string.c_str(), &size.width, &size.height, nullptr, STBI_default);
+  auto* pixels = stbi_load(path_string.c_str(),
+                           &image.size.width,
+                           &image.size.height,
+                           nullptr,
+                           STBI_rgb_alpha);
 
   if (!pixels) {
     runtime::log(LogLevel::kError,
@@ -32,14 +51,23 @@ auto NullTexture::load(std::filesystem::path path) -> std::expected<NullTexture,
     return std::unexpected {ErrorCode::kBadImage};
   }
 
+  const auto byte_count = static_cast<std::size_t>(image.size.width) *
+                          static_cast<std::size_t>(image.size.height) * 4;
+  image.pixels.assign(pixels, pixels + byte_count);
   stbi_image_free(pixels);
 
-  return NullTexture {size, std::move(path)};
+  return image;
+}
+
+auto NullTexture::upload(std::filesystem::path path, const ImageData& image) -> NullTexture
+{
+  return NullTexture {image, std::move(path)};
 }
 
 auto NullTexture::get_handle() const -> void*
 {
-  return nullptr;
+  // The address is stable, since textures are never moved after being stored.
+  return const_cast<NullTexture*>(this);
 }
 
 auto NullTexture::get_size() const -> TextureSize
@@ -52,4 +80,19 @@ auto NullTexture::get_path() const -> const std::filesystem::path&
   return m_path;
 }
 
+auto NullTexture::get_format() const -> ImageFormat
+{
+  return m_format;
+}
+
+auto NullTexture::get_mip_count() const -> std::uint32_t
+{
+  return m_mip_count;
+}
+
+auto NullTexture::get_byte_count() const -> std::size_t
+{
+  return m_byte_count;
+}
+
 }  // namespace tactile::null_renderer
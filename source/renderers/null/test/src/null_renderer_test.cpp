@@ -0,0 +1,119 @@
+// Copyright (C) 2024 Albin Johansson (GNU General Public License v3.0)
+
+#include "tactile/null_renderer/null_renderer.hpp"
+
+#include <array>        // array
+#include <string_view>  // string_view
+
+#include <gtest/gtest.h>
+#include <imgui.h>
+
+#include "tactile/runtime/command_line_options.hpp"
+
+namespace tactile::null_renderer {
+
+class NullRendererTest : public testing::Test
+{
+ protected:
+  void SetUp() override
+  {
+    ImGui::SetCurrentContext(mRenderer.get_imgui_context());
+    ImGui::GetIO().IniFilename = nullptr;
+  }
+
+  void TearDown() override
+  {
+    ImGui::SetCurrentContext(nullptr);
+  }
+
+  NullRenderer mRenderer {nullptr};
+};
+
+/// \trace tactile::null_renderer::NullRenderer::NullRenderer
+TEST(NullRenderer, Constructor)
+{
+  auto* context = ImGui::CreateContext();
+  ImGui::SetCurrentContext(context);
+
+  {
+    NullRenderer renderer {nullptr};
+    ASSERT_NE(renderer.get_imgui_context(), nullptr);
+    EXPECT_NE(renderer.get_imgui_context(), context);
+
+    // The current context is left untouched, only the new context is configured.
+    EXPECT_EQ(ImGui::GetCurrentContext(), context);
+    EXPECT_EQ(ImGui::GetIO().BackendRendererName, nullptr);
+
+    ImGui::SetCurrentContext(renderer.get_imgui_context());
+    EXPECT_EQ(std::string_view {ImGui::GetIO().BackendRendererName},
+              "tactile-null-renderer");
+
+    ImGui::SetCurrentContext(context);
+  }
+
+  EXPECT_EQ(ImGui::GetCurrentContext(), context);
+  ImGui::DestroyContext(context);
+}
+
+/// \trace tactile::null_renderer::NullRenderer::end_frame
+/// \trace tactile::null_renderer::NullRenderer::get_frame_stats
+/// \trace tactile::null_renderer::NullRenderer::get_total_stats
+TEST_F(NullRendererTest, RenderStats)
+{
+  int texture_a {};
+  int texture_b {};
+  const auto texture_a_id = reinterpret_cast<ImTextureID>(&texture_a);
+  const auto texture_b_id = reinterpret_cast<ImTextureID>(&texture_b);
+
+  ASSERT_TRUE(mRenderer.begin_frame());
+
+  // Consecutive quads with the same texture are merged into a single command.
+  auto* draw_list = ImGui::GetForegroundDrawList();
+  draw_list->AddImage(texture_a_id, ImVec2 {0, 0}, ImVec2 {10, 10});
+  draw_list->AddImage(texture_a_id, ImVec2 {10, 0}, ImVec2 {20, 10});
+  draw_list->AddImage(texture_b_id, ImVec2 {20, 0}, ImVec2 {30, 10});
+  draw_list->AddCallback([](const ImDrawList*, const ImDrawCmd*) {}, nullptr);
+  draw_list->AddImage(texture_a_id, ImVec2 {30, 0}, ImVec2 {40, 10});
+
+  mRenderer.end_frame();
+
+  const auto& frame_stats = mRenderer.get_frame_stats();
+  EXPECT_EQ(frame_stats.draw_list_count, 1);
+  EXPECT_EQ(frame_stats.draw_command_count, 3);
+  EXPECT_EQ(frame_stats.vertex_count, 16);
+  EXPECT_EQ(frame_stats.index_count, 24);
+  EXPECT_EQ(frame_stats.quad_count, 4);
+  EXPECT_EQ(frame_stats.texture_switch_count, 3);
+
+  ASSERT_TRUE(mRenderer.begin_frame());
+  mRenderer.end_frame();
+
+  EXPECT_EQ(mRenderer.get_frame_stats().draw_list_count, 0);
+  EXPECT_EQ(mRenderer.get_frame_stats().draw_command_count, 0);
+  EXPECT_EQ(mRenderer.get_frame_count(), 2);
+
+  const auto& total_stats = mRenderer.get_total_stats();
+  EXPECT_EQ(total_stats.draw_command_count, 3);
+  EXPECT_EQ(total_stats.quad_count, 4);
+  EXPECT_EQ(total_stats.texture_switch_count, 3);
+}
+
+/// \trace tactile::runtime::parse_command_line_options
+TEST(NullRenderer, ParseRendererOption)
+{
+  std::array<char, 8> program {"tactile"};
+  std::array<char, 11> renderer_flag {"--renderer"};
+  std::array<char, 5> renderer_name {"null"};
+  std::array args {program.data(), renderer_flag.data(), renderer_name.data()};
+
+  const auto options = runtime::parse_command_line_options(static_cast<int>(args.size()),
+                                                           args.data());
+  ASSERT_TRUE(options.has_value());
+  EXPECT_EQ(options->renderer_backend, runtime::RendererBackendId::kNull);
+
+  const auto default_options = runtime::parse_command_line_options(1, args.data());
+  ASSERT_TRUE(default_options.has_value());
+  EXPECT_EQ(default_options->renderer_backend, runtime::RendererBackendId::kOpenGL);
+}
+
+}  // namespace tactile::null_renderer
@@ -6,6 +6,7 @@
 
 #include "tactile/base/debug/error_code.hpp"
 #include "tactile/base/prelude.hpp"
+#include "tactile/base/render/image_data.hpp"
 #include "tactile/base/render/texture.hpp"
 #include "tactile/opengl/api.hpp"
 
@@ -21,6 +22,41 @@ class TACTILE_OPENGL_API OpenGLTexture final : public ITexture
  public:
   using id_type = unsigned;
 
+  /**
+   * Decodes an image on disk, without creating a texture.
+   *
+   * \note
+   * This function doesn't use the OpenGL API, so it may be called from any thread.
+   *
+   * \param image_path The path to the image file.
+   *
+   * \return
+   * The decoded image if successful; an error code otherwise.
+   */
+  [[nodiscard]]
+  static auto decode(const std::filesystem::path& image_path)
+      -> std::expected<ImageData, ErrorCode>;
+
+  /**
+   * Creates a texture from a decoded image.
+   *
+   * \details
+   * Block compressed images are uploaded as-is, along with their mip levels.
+   * The mipmap option only affects uncompressed images.
+   *
+   * \param image_path The path to the image file the image was decoded from.
+   * \param image      The decoded image.
+   * \param options    The renderer options to use.
+   *
+   * \return
+   * A texture if successful; an error code otherwise.
+   */
+  [[nodiscard]]
+  static auto upload(const std::filesystem::path& image_path,
+                     const ImageData& image,
+                     const RendererOptions& options)
+      -> std::expected<OpenGLTexture, ErrorCode>;
+
   /**
    * Loads a texture from an image on disk.
    *
@@ -0,0 +1,51 @@
+// Copyright (C) 2024 Albin Johansson (GNU General Public License v3.0)
+
+#pragma once
+
+#include "tactile/base/prelude.hpp"
+#include "tactile/base/render/image_data.hpp"
+#include "tactile/opengl/api.hpp"
+
+namespace tactile {
+
+/**
+ * Generates the full mip chain of an uncompressed image.
+ *
+ * \details
+ * Each mip level is computed from the previous level using a 2x2 box filter,
+ * until the level size is 1x1.
+ *
+ * \pre The image must use the RGBA8 format and only contain a single mip level.
+ *
+ * \param image The source image.
+ *
+ * \return
+ * An RGBA8 image that contains all mip levels.
+ */
+[[nodiscard]]
+TACTILE_OPENGL_API auto generate_image_mipmaps(const ImageData& image) -> ImageData;
+
+/**
+ * Compresses an image using BC3 (DXT5) block compression.
+ *
+ * \details
+ * BC3 images use a quarter of the memory of RGBA8 images, at the cost of some
+ * image quality. The encoder is tuned for speed rather than quality, since the
+ * results are expected to be cached.
+ *
+ * \note
+ * This function doesn't use the OpenGL API, so it may be called from any thread.
+ *
+ * \pre The image must use the RGBA8 format and only contain a single mip level.
+ *
+ * \param image            The source image.
+ * \param generate_mipmaps Whether to include the full mip chain in the result.
+ *
+ * \return
+ * A BC3 image.
+ */
+[[nodiscard]]
+TACTILE_OPENGL_API auto compress_image_bc3(const ImageData& image, bool generate_mipmaps)
+    -> ImageData;
+
+}  // namespace tactile
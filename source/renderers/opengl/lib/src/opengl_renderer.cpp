@@ -19,7 +19,9 @@
 #include "tactile/base/util/scope_exit.hpp"
 #include "tactile/opengl/opengl_error.hpp"
 #include "tactile/opengl/opengl_texture.hpp"
+#include "tactile/opengl/opengl_texture_compression.hpp"
 #include "tactile/runtime/logging.hpp"
+#include "tactile/runtime/profiling.hpp"
 
 namespace tactile {
 
@@ -31,6 +33,22 @@ struct GLContextDeleter final
   }
 };
 
+namespace {
+
+[[nodiscard]]
+auto _decode_compressed_image(const std::filesystem::path& image_path,
+                              const bool use_mipmaps) -> std::expected<ImageData, ErrorCode>
+{
+  const auto image = OpenGLTexture::decode(image_path);
+  if (!image.has_value()) {
+    return std::unexpected {image.error()};
+  }
+
+  return compress_image_bc3(*image, use_mipmaps);
+}
+
+}  // namespace
+
 struct OpenGLRenderer::Data final  // NOLINT(*-member-init)
 {
   RendererOptions options;
@@ -42,6 +60,7 @@ struct OpenGLRenderer::Data final  // NOLINT(*-member-init)
   ScopeExit imgui_renderer_impl_deleter {};
   std::unordered_map<TextureID, OpenGLTexture> textures;
   TextureID next_texture_id;
+  bool supports_s3tc;
 };
 
 auto OpenGLRenderer::make(const RendererOptions& options, IWindow* window)
@@ -71,6 +90,11 @@ auto OpenGLRenderer::make(const RendererOptions& options, IWindow* window)
     return std::unexpected {ErrorCode::kBadInit};
   }
 
+  data.supports_s3tc = GLAD_GL_EXT_texture_compression_s3tc != 0;
+  if (options.use_texture_compression && !data.supports_s3tc) {
+    runtime::log(LogLevel::kWarn, "Texture compression is not supported, ignoring option");
+  }
+
   data.imgui_context = ImGui::CreateContext();
 
   if (!data.imgui_context) {
@@ -121,6 +145,8 @@ OpenGLRenderer::~OpenGLRenderer() noexcept = default;
 
 auto OpenGLRenderer::begin_frame() -> bool
 {
+  TACTILE_RUNTIME_PROFILE_ZONE("OpenGLRenderer::begin_frame");
+
   ImGui_ImplSDL2_NewFrame();
   ImGui_ImplOpenGL3_NewFrame();
   ImGui::NewFrame();
@@ -136,6 +162,8 @@ auto OpenGLRenderer::begin_frame() -> bool
 
 void OpenGLRenderer::end_frame()
 {
+  TACTILE_RUNTIME_PROFILE_ZONE("OpenGLRenderer::end_frame");
+
   ImGui::Render();
   ImGui_ImplOpenGL3_RenderDrawData(ImGui::GetDrawData());
 
@@ -148,7 +176,42 @@ void OpenGLRenderer::end_frame()
 auto OpenGLRenderer::load_texture(const std::filesystem::path& image_path)
     -> std::expected<TextureID, ErrorCode>
 {
-  auto texture = OpenGLTexture::load(image_path, mData->options);
+  const auto image = decode_image(image_path);
+  if (!image.has_value()) {
+    return std::unexpected {image.error()};
+  }
+
+  return upload_texture(image_path, *image);
+}
+
+auto OpenGLRenderer::decode_image(const std::filesystem::path& image_path) const
+    -> std::expected<ImageData, ErrorCode>
+{
+  const auto& data = *mData;
+
+  if (data.options.use_texture_compression && data.supports_s3tc) {
+    return _decode_compressed_image(image_path, data.options.use_mipmaps);
+  }
+
+  return OpenGLTexture::decode(image_path);
+}
+
+auto OpenGLRenderer::get_image_cache_tag() const -> std::string_view
+{
+  const auto& data = *mData;
+
+  if (data.options.use_texture_compression && data.supports_s3tc) {
+    return data.options.use_mipmaps ? "bc3m" : "bc3";
+  }
+
+  return "rgba8";
+}
+
+auto OpenGLRenderer::upload_texture(const std::filesystem::path& image_path,
+                                    const ImageData& image)
+    -> std::expected<TextureID, ErrorCode>
+{
+  auto texture = OpenGLTexture::upload(image_path, image, mData->options);
   if (!texture.has_value()) {
     return std::unexpected {texture.error()};
   }
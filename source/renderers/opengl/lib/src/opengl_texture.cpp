@@ -5,7 +5,8 @@
 #define STB_IMAGE_IMPLEMENTATION
 
 #include <bit>      // bit_cast
-#include <cstdint>  // uintptr_t
+#include <cstddef>  // size_t
+#include <cstdint>  // uint32_t, uintptr_t
 #include <utility>  // move, exchange
 
 #include <glad/glad.h>
@@ -16,8 +17,30 @@
 
 namespace tactile {
 
-auto OpenGLTexture::load(const std::filesystem::path& image_path,
-                         const RendererOptions& options)
+auto OpenGLTexture::decode(const std::filesystem::path& image_path)
+    -> std::expected<ImageData, ErrorCode>
+{
+  ImageData image {};
+  auto* pixel_data = stbi_load(image_path.string().c_str(),
+                               &image.size.width,
+                               &image.size.height,
+                               nullptr,
+                               STBI_rgb_alpha);
+  if (!pixel_data) {
+    return std::unexpected {ErrorCode::kBadImage};
+  }
+
+  const auto byte_count = static_cast<std::size_t>(image.size.width) *
+                          static_cast<std::size_t>(image.size.height) * 4;
+  image.pixels.assign(pixel_data, pixel_data + byte_count);
+  stbi_image_free(pixel_data);
+
+  return image;
+}
+
+auto OpenGLTexture::upload(const std::filesystem::path& image_path,
+                           const ImageData& image,
+                           const RendererOptions& options)
     -> std::expected<OpenGLTexture, ErrorCode>
 {
   unsigned texture_id {};
@@ -25,6 +48,9 @@ auto OpenGLTexture::load(const std::filesystem::path& image_path,
   glGenTextures(1, &texture_id);
   glBindTexture(GL_TEXTURE_2D, texture_id);
 
+  // Makes sure that the texture is deleted if something goes wrong.
+  OpenGLTexture texture {texture_id, image.size, image_path};
+
   const auto filter_mode =
       options.texture_filter_mode == TextureFilterMode::kNearest ? GL_NEAREST : GL_LINEAR;
   glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, filter_mode);
@@ -37,36 +63,62 @@ auto OpenGLTexture::load(const std::filesystem::path& image_path,
     return std::unexpected {map_opengl_error_code(err)};
   }
 
-  TextureSize texture_size {};
-  auto* pixel_data = stbi_load(image_path.string().c_str(),
-                               &texture_size.width,
-                               &texture_size.height,
-                               nullptr,
-                               STBI_rgb_alpha);
-  if (!pixel_data) {
-    return std::unexpected {ErrorCode::kBadImage};
+  if (image.format == ImageFormat::kBC3) {
+    // Compressed images provide their own mip levels, if any.
+    std::size_t offset {0};
+    for (std::uint32_t level = 0; level < image.mip_count; ++level) {
+      const auto level_size = get_mip_level_size(image.size, level);
+      const auto level_byte_count = get_image_byte_size(image.format, level_size);
+
+      glCompressedTexImage2D(GL_TEXTURE_2D,
+                             static_cast<GLint>(level),
+                             GL_COMPRESSED_RGBA_S3TC_DXT5_EXT,
+                             level_size.width,
+                             level_size.height,
+                             0,
+                             static_cast<GLsizei>(level_byte_count),
+                             image.pixels.data() + offset);
+
+      offset += level_byte_count;
+    }
+
+    glTexParameteri(GL_TEXTURE_2D,
+                    GL_TEXTURE_MAX_LEVEL,
+                    static_cast<GLint>(image.mip_count) - 1);
   }
-
-  glTexImage2D(GL_TEXTURE_2D,
-               0,                    // LOD index
-               GL_RGBA,              // Internal image format
-               texture_size.width,   // Width
-               texture_size.height,  // Height
-               0,                    // Border (must be 0)
-               GL_RGBA,              // Pixel data format
-               GL_UNSIGNED_BYTE,     // Data type of pixels
-               pixel_data);
-  stbi_image_free(pixel_data);
-
-  if (options.use_mipmaps) {
-    glGenerateMipmap(GL_TEXTURE_2D);
+  else {
+    glTexImage2D(GL_TEXTURE_2D,
+                 0,                  // LOD index
+                 GL_RGBA,            // Internal image format
+                 image.size.width,   // Width
+                 image.size.height,  // Height
+                 0,                  // Border (must be 0)
+                 GL_RGBA,            // Pixel data format
+                 GL_UNSIGNED_BYTE,   // Data type of pixels
+                 image.pixels.data());
+
+    if (options.use_mipmaps) {
+      glGenerateMipmap(GL_TEXTURE_2D);
+    }
   }
 
   if (const auto err = glGetError(); err != GL_NONE) {
     return std::unexpected {map_opengl_error_code(err)};
   }
 
-  return OpenGLTexture {texture_id, texture_size, image_path};
+  return texture;
+}
+
+auto OpenGLTexture::load(const std::filesystem::path& image_path,
+                         const RendererOptions& options)
+    -> std::expected<OpenGLTexture, ErrorCode>
+{
+  const auto image = decode(image_path);
+  if (!image.has_value()) {
+    return std::unexpected {image.error()};
+  }
+
+  return upload(image_path, *image, options);
 }
 
 OpenGLTexture::OpenGLTexture(const id_type id,
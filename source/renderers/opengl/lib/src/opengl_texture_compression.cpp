@@ -0,0 +1,284 @@
+// Copyright (C) 2024 Albin Johansson (GNU General Public License v3.0)
+
+#include "tactile/opengl/opengl_texture_compression.hpp"
+
+#include <algorithm>  // min, max, swap
+#include <array>      // array
+#include <cstddef>    // size_t
+#include <cstdint>    // uint8_t, uint16_t, uint32_t, uint64_t
+#include <cstdlib>    // abs
+#include <span>       // span
+#include <vector>     // vector
+
+namespace tactile {
+namespace {
+
+using Pixel = std::array<std::uint8_t, 4>;
+using PixelBlock = std::array<Pixel, 16>;
+
+[[nodiscard]]
+auto _get_mip_count(const TextureSize& size) -> std::uint32_t
+{
+  std::uint32_t mip_count {1};
+
+  auto extent = std::max(size.width, size.height);
+  while (extent > 1) {
+    extent >>= 1;
+    ++mip_count;
+  }
+
+  return mip_count;
+}
+
+[[nodiscard]]
+auto _get_pixel(const std::span<const std::uint8_t> pixels,
+                const TextureSize& size,
+                const int x,
+                const int y) -> Pixel
+{
+  // Clamping to the edges avoids bleeding in garbage for partial blocks.
+  const auto clamped_x = static_cast<std::size_t>(std::min(x, size.width - 1));
+  const auto clamped_y = static_cast<std::size_t>(std::min(y, size.height - 1));
+  const auto offset = (clamped_y * static_cast<std::size_t>(size.width) + clamped_x) * 4;
+
+  return Pixel {pixels[offset], pixels[offset + 1], pixels[offset + 2], pixels[offset + 3]};
+}
+
+void _downsample(const std::span<const std::uint8_t> src_pixels,
+                 const TextureSize& src_size,
+                 const TextureSize& dst_size,
+                 std::vector<std::uint8_t>& dst_pixels)
+{
+  for (int y = 0; y < dst_size.height; ++y) {
+    for (int x = 0; x < dst_size.width; ++x) {
+      const std::array samples {
+        _get_pixel(src_pixels, src_size, x * 2, y * 2),
+        _get_pixel(src_pixels, src_size, x * 2 + 1, y * 2),
+        _get_pixel(src_pixels, src_size, x * 2, y * 2 + 1),
+        _get_pixel(src_pixels, src_size, x * 2 + 1, y * 2 + 1),
+      };
+
+      for (std::size_t channel = 0; channel < 4; ++channel) {
+        unsigned sum {2};  // Rounds to the nearest value.
+        for (const auto& sample : samples) {
+          sum += sample[channel];
+        }
+
+        dst_pixels.push_back(static_cast<std::uint8_t>(sum / 4));
+      }
+    }
+  }
+}
+
+[[nodiscard]]
+auto _to_rgb565(const Pixel& pixel) -> std::uint16_t
+{
+  const auto r = static_cast<unsigned>(pixel[0]) >> 3;
+  const auto g = static_cast<unsigned>(pixel[1]) >> 2;
+  const auto b = static_cast<unsigned>(pixel[2]) >> 3;
+  return static_cast<std::uint16_t>((r << 11) | (g << 5) | b);
+}
+
+[[nodiscard]]
+auto _from_rgb565(const std::uint16_t color) -> Pixel
+{
+  const auto r = static_cast<unsigned>(color >> 11) & 0x1Fu;
+  const auto g = static_cast<unsigned>(color >> 5) & 0x3Fu;
+  const auto b = static_cast<unsigned>(color) & 0x1Fu;
+
+  return Pixel {static_cast<std::uint8_t>((r << 3) | (r >> 2)),
+                static_cast<std::uint8_t>((g << 2) | (g >> 4)),
+                static_cast<std::uint8_t>((b << 3) | (b >> 2)),
+                0xFF};
+}
+
+[[nodiscard]]
+auto _get_color_distance(const Pixel& a, const Pixel& b) -> int
+{
+  int distance {0};
+  for (std::size_t channel = 0; channel < 3; ++channel) {
+    const auto delta = static_cast<int>(a[channel]) - static_cast<int>(b[channel]);
+    distance += delta * delta;
+  }
+
+  return distance;
+}
+
+void _append_le(std::vector<std::uint8_t>& bytes,
+                const std::uint64_t value,
+                const std::size_t byte_count)
+{
+  for (std::size_t index = 0; index < byte_count; ++index) {
+    bytes.push_back(static_cast<std::uint8_t>(value >> (index * 8)));
+  }
+}
+
+void _encode_alpha_block(const PixelBlock& block, std::vector<std::uint8_t>& bytes)
+{
+  std::uint8_t max_alpha {0x00};
+  std::uint8_t min_alpha {0xFF};
+  for (const auto& pixel : block) {
+    max_alpha = std::max(max_alpha, pixel[3]);
+    min_alpha = std::min(min_alpha, pixel[3]);
+  }
+
+  // Uses the eight value mode, i.e., the first endpoint is the largest one.
+  std::array<int, 8> palette {max_alpha, min_alpha};
+  for (int index = 1; index < 7; ++index) {
+    palette[static_cast<std::size_t>(index) + 1] =
+        ((7 - index) * max_alpha + index * min_alpha) / 7;
+  }
+
+  std::uint64_t indices {0};
+  for (std::size_t pixel_index = 0; pixel_index < block.size(); ++pixel_index) {
+    const auto alpha = static_cast<int>(block[pixel_index][3]);
+
+    std::uint64_t best_index {0};
+    auto best_distance = 0xFF + 1;
+    for (std::size_t index = 0; index < palette.size(); ++index) {
+      const auto distance = std::abs(palette[index] - alpha);
+      if (distance < best_distance) {
+        best_index = index;
+        best_distance = distance;
+      }
+    }
+
+    indices |= best_index << (pixel_index * 3);
+  }
+
+  bytes.push_back(max_alpha);
+  bytes.push_back(min_alpha);
+  _append_le(bytes, indices, 6);
+}
+
+void _encode_color_block(const PixelBlock& block, std::vector<std::uint8_t>& bytes)
+{
+  Pixel min_color {0xFF, 0xFF, 0xFF, 0xFF};
+  Pixel max_color {0x00, 0x00, 0x00, 0xFF};
+  for (const auto& pixel : block) {
+    for (std::size_t channel = 0; channel < 3; ++channel) {
+      min_color[channel] = std::min(min_color[channel], pixel[channel]);
+      max_color[channel] = std::max(max_color[channel], pixel[channel]);
+    }
+  }
+
+  auto color0 = _to_rgb565(max_color);
+  auto color1 = _to_rgb565(min_color);
+  if (color0 < color1) {
+    std::swap(color0, color1);
+  }
+
+  // BC3 color blocks always use the four color mode, regardless of endpoint order.
+  const auto endpoint0 = _from_rgb565(color0);
+  const auto endpoint1 = _from_rgb565(color1);
+
+  std::array<Pixel, 4> palette {endpoint0, endpoint1, endpoint0, endpoint1};
+  for (std::size_t channel = 0; channel < 3; ++channel) {
+    palette[2][channel] =
+        static_cast<std::uint8_t>((2 * endpoint0[channel] + endpoint1[channel]) / 3);
+    palette[3][channel] =
+        static_cast<std::uint8_t>((endpoint0[channel] + 2 * endpoint1[channel]) / 3);
+  }
+
+  std::uint32_t indices {0};
+  for (std::size_t pixel_index = 0; pixel_index < block.size(); ++pixel_index) {
+    std::uint32_t best_index {0};
+    auto best_distance = _get_color_distance(palette[0], block[pixel_index]);
+
+    for (std::uint32_t index = 1; index < palette.size(); ++index) {
+      const auto distance = _get_color_distance(palette[index], block[pixel_index]);
+      if (distance < best_distance) {
+        best_index = index;
+        best_distance = distance;
+      }
+    }
+
+    indices |= best_index << (pixel_index * 2);
+  }
+
+  _append_le(bytes, color0, 2);
+  _append_le(bytes, color1, 2);
+  _append_le(bytes, indices, 4);
+}
+
+void _compress_level(const std::span<const std::uint8_t> pixels,
+                     const TextureSize& size,
+                     std::vector<std::uint8_t>& bytes)
+{
+  PixelBlock block {};
+
+  for (int block_y = 0; block_y < size.height; block_y += 4) {
+    for (int block_x = 0; block_x < size.width; block_x += 4) {
+      for (int y = 0; y < 4; ++y) {
+        for (int x = 0; x < 4; ++x) {
+          block[static_cast<std::size_t>(y * 4 + x)] =
+              _get_pixel(pixels, size, block_x + x, block_y + y);
+        }
+      }
+
+      _encode_alpha_block(block, bytes);
+      _encode_color_block(block, bytes);
+    }
+  }
+}
+
+}  // namespace
+
+auto generate_image_mipmaps(const ImageData& image) -> ImageData
+{
+  ImageData result {};
+  result.size = image.size;
+  result.format = ImageFormat::kRGBA8;
+  result.mip_count = _get_mip_count(image.size);
+
+  std::size_t total_byte_count {0};
+  for (std::uint32_t level = 0; level < result.mip_count; ++level) {
+    total_byte_count +=
+        get_image_byte_size(ImageFormat::kRGBA8, get_mip_level_size(image.size, level));
+  }
+
+  result.pixels.reserve(total_byte_count);
+  result.pixels.assign(image.pixels.begin(), image.pixels.end());
+
+  std::size_t src_offset {0};
+  for (std::uint32_t level = 1; level < result.mip_count; ++level) {
+    const auto src_size = get_mip_level_size(image.size, level - 1);
+    const auto dst_size = get_mip_level_size(image.size, level);
+    const auto src_byte_count = get_image_byte_size(ImageFormat::kRGBA8, src_size);
+
+    // The capacity is reserved up front, so the source span stays valid.
+    const std::span<const std::uint8_t> src_pixels {result.pixels.data() + src_offset,
+                                                    src_byte_count};
+    _downsample(src_pixels, src_size, dst_size, result.pixels);
+
+    src_offset += src_byte_count;
+  }
+
+  return result;
+}
+
+auto compress_image_bc3(const ImageData& image, const bool generate_mipmaps) -> ImageData
+{
+  const auto mipmapped_image = generate_mipmaps ? generate_image_mipmaps(image) : image;
+
+  ImageData result {};
+  result.size = image.size;
+  result.format = ImageFormat::kBC3;
+  result.mip_count = mipmapped_image.mip_count;
+
+  std::size_t src_offset {0};
+  for (std::uint32_t level = 0; level < result.mip_count; ++level) {
+    const auto level_size = get_mip_level_size(image.size, level);
+    const auto level_byte_count = get_image_byte_size(ImageFormat::kRGBA8, level_size);
+
+    _compress_level(std::span {mipmapped_image.pixels}.subspan(src_offset, level_byte_count),
+                    level_size,
+                    result.pixels);
+
+    src_offset += level_byte_count;
+  }
+
+  return result;
+}
+
+}  // namespace tactile
@@ -0,0 +1,64 @@
+// Copyright (C) 2024 Albin Johansson (GNU General Public License v3.0)
+
+#include "tactile/opengl/opengl_texture_compression.hpp"
+
+#include <cstdint>  // uint8_t
+
+#include <gtest/gtest.h>
+
+namespace tactile {
+namespace {
+
+[[nodiscard]]
+auto _make_solid_image(const TextureSize& size, const std::uint8_t value) -> ImageData
+{
+  ImageData image {};
+  image.size = size;
+  image.pixels.assign(get_image_byte_size(ImageFormat::kRGBA8, size), value);
+  return image;
+}
+
+}  // namespace
+
+/// \trace tactile::generate_image_mipmaps
+TEST(OpenGLTextureCompression, GenerateImageMipmaps)
+{
+  const auto image = _make_solid_image(TextureSize {6, 5}, 0x80);
+  const auto mipmapped_image = generate_image_mipmaps(image);
+
+  // 6x5, 3x2, 1x1
+  EXPECT_EQ(mipmapped_image.format, ImageFormat::kRGBA8);
+  EXPECT_EQ(mipmapped_image.size.width, 6);
+  EXPECT_EQ(mipmapped_image.size.height, 5);
+  EXPECT_EQ(mipmapped_image.mip_count, 3);
+  ASSERT_EQ(mipmapped_image.pixels.size(), (6 * 5 + 3 * 2 + 1 * 1) * 4);
+
+  for (const auto value : mipmapped_image.pixels) {
+    EXPECT_EQ(value, 0x80);
+  }
+}
+
+/// \trace tactile::compress_image_bc3
+TEST(OpenGLTextureCompression, CompressImageBC3)
+{
+  const auto image = _make_solid_image(TextureSize {6, 5}, 0xFF);
+
+  const auto compressed_image = compress_image_bc3(image, false);
+  EXPECT_EQ(compressed_image.format, ImageFormat::kBC3);
+  EXPECT_EQ(compressed_image.size.width, 6);
+  EXPECT_EQ(compressed_image.size.height, 5);
+  EXPECT_EQ(compressed_image.mip_count, 1);
+  ASSERT_EQ(compressed_image.pixels.size(), 4 * 16);
+
+  // Alpha endpoints, followed by the color endpoints, of the first block.
+  EXPECT_EQ(compressed_image.pixels.at(0), 0xFF);
+  EXPECT_EQ(compressed_image.pixels.at(1), 0xFF);
+  EXPECT_EQ(compressed_image.pixels.at(8), 0xFF);
+  EXPECT_EQ(compressed_image.pixels.at(9), 0xFF);
+
+  const auto mipmapped_image = compress_image_bc3(image, true);
+  EXPECT_EQ(mipmapped_image.mip_count, 3);
+  EXPECT_EQ(mipmapped_image.pixels.size(), (4 + 1 + 1) * 16);
+}
+
+}  // namespace tactile
@@ -39,4 +39,16 @@ TEST_F(OpenGLTextureTest, Load)
   EXPECT_EQ(texture->get_size().height, 64);
 }
 
+/// \trace tactile::OpenGLTexture::decode
+TEST_F(OpenGLTextureTest, Decode)
+{
+  const auto image = OpenGLTexture::decode("assets/images/dummy.png");
+  ASSERT_TRUE(image.has_value());
+  EXPECT_EQ(image->size.width, 96);
+  EXPECT_EQ(image->size.height, 64);
+  EXPECT_EQ(image->pixels.size(), 96 * 64 * 4);
+
+  EXPECT_FALSE(OpenGLTexture::decode("a/b/c.png").has_value());
+}
+
 }  // namespace tactile
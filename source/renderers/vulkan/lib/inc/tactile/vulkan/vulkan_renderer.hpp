@@ -57,6 +57,17 @@ class TACTILE_VULKAN_API VulkanRenderer final : public IRenderer
   auto load_texture(const std::filesystem::path& image_path)
       -> std::expected<TextureID, ErrorCode> override;
 
+  [[nodiscard]]
+  auto decode_image(const std::filesystem::path& image_path) const
+      -> std::expected<ImageData, ErrorCode> override;
+
+  [[nodiscard]]
+  auto get_image_cache_tag() const -> std::string_view override;
+
+  [[nodiscard]]
+  auto upload_texture(const std::filesystem::path& image_path, const ImageData& image)
+      -> std::expected<TextureID, ErrorCode> override;
+
   void unload_texture(TextureID id) override;
 
   [[nodiscard]]
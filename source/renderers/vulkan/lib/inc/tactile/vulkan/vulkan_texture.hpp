@@ -9,6 +9,7 @@
 #include <vulkan/vulkan.h>
 
 #include "tactile/base/prelude.hpp"
+#include "tactile/base/render/image_data.hpp"
 #include "tactile/base/render/texture.hpp"
 #include "tactile/vulkan/api.hpp"
 #include "tactile/vulkan/vulkan_image.hpp"
@@ -36,6 +37,21 @@ class TACTILE_VULKAN_API VulkanTexture final : public ITexture
   void* imgui_handle {};
 };
 
+[[nodiscard]]
+TACTILE_VULKAN_API auto decode_vulkan_image(const std::filesystem::path& image_path)
+    -> std::expected<ImageData, VkResult>;
+
+[[nodiscard]]
+TACTILE_VULKAN_API auto upload_vulkan_texture(VkDevice device,
+                                              VkQueue queue,
+                                              VkCommandPool command_pool,
+                                              VmaAllocator allocator,
+                                              VkSampler sampler,
+                                              const std::filesystem::path& image_path,
+                                              const ImageData& image,
+                                              const RendererOptions& options)
+    -> std::expected<VulkanTexture, VkResult>;
+
 [[nodiscard]]
 TACTILE_VULKAN_API auto load_vulkan_texture(VkDevice device,
                                             VkQueue queue,
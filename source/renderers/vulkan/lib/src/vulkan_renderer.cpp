@@ -16,6 +16,7 @@
 #include "tactile/base/io/file_io.hpp"
 #include "tactile/base/render/window.hpp"
 #include "tactile/runtime/logging.hpp"
+#include "tactile/runtime/profiling.hpp"
 #include "tactile/vulkan/vulkan_buffer.hpp"
 #include "tactile/vulkan/vulkan_physical_device.hpp"
 #include "tactile/vulkan/vulkan_util.hpp"
@@ -122,6 +123,8 @@ VulkanRenderer::~VulkanRenderer() noexcept
 
 auto VulkanRenderer::begin_frame() -> bool
 {
+  TACTILE_RUNTIME_PROFILE_ZONE("VulkanRenderer::begin_frame");
+
   const auto& frame = m_frames.at(m_frame_index);
 
   int width {};
@@ -180,6 +183,8 @@ auto VulkanRenderer::begin_frame() -> bool
 
 void VulkanRenderer::end_frame()
 {
+  TACTILE_RUNTIME_PROFILE_ZONE("VulkanRenderer::end_frame");
+
   _record_commands();
   _submit_commands();
   _present_swapchain_image();
@@ -190,13 +195,43 @@ void VulkanRenderer::end_frame()
 auto VulkanRenderer::load_texture(const std::filesystem::path& image_path)
     -> std::expected<TextureID, ErrorCode>
 {
-  auto texture = load_vulkan_texture(m_device.handle,
-                                     m_graphics_queue,
-                                     m_graphics_command_pool.handle,
-                                     m_allocator.handle,
-                                     m_sampler.handle,
-                                     image_path,
-                                     m_options);
+  const auto image = decode_image(image_path);
+  if (!image.has_value()) {
+    return std::unexpected {image.error()};
+  }
+
+  return upload_texture(image_path, *image);
+}
+
+auto VulkanRenderer::decode_image(const std::filesystem::path& image_path) const
+    -> std::expected<ImageData, ErrorCode>
+{
+  auto image = decode_vulkan_image(image_path);
+
+  if (!image.has_value()) {
+    return std::unexpected {ErrorCode::kBadImage};
+  }
+
+  return std::move(*image);
+}
+
+auto VulkanRenderer::get_image_cache_tag() const -> std::string_view
+{
+  return "rgba8";
+}
+
+auto VulkanRenderer::upload_texture(const std::filesystem::path& image_path,
+                                    const ImageData& image)
+    -> std::expected<TextureID, ErrorCode>
+{
+  auto texture = upload_vulkan_texture(m_device.handle,
+                                       m_graphics_queue,
+                                       m_graphics_command_pool.handle,
+                                       m_allocator.handle,
+                                       m_sampler.handle,
+                                       image_path,
+                                       image,
+                                       m_options);
 
   if (!texture.has_value()) {
     // TODO log error
@@ -30,44 +30,56 @@ auto VulkanTexture::get_path() const -> const std::filesystem::path&
   return path;
 }
 
-auto load_vulkan_texture(VkDevice device,
-                         VkQueue queue,
-                         VkCommandPool command_pool,
-                         VmaAllocator allocator,
-                         VkSampler sampler,
-                         const std::filesystem::path& image_path,
-                         const RendererOptions& options)
-    -> std::expected<VulkanTexture, VkResult>
+auto decode_vulkan_image(const std::filesystem::path& image_path)
+    -> std::expected<ImageData, VkResult>
 {
-  int width {};
-  int height {};
-  int channels {};
-  auto* pixels =
-      stbi_load(image_path.string().c_str(), &width, &height, &channels, STBI_default);
+  ImageData image {};
+  auto* pixels = stbi_load(image_path.string().c_str(),
+                           &image.size.width,
+                           &image.size.height,
+                           nullptr,
+                           STBI_rgb_alpha);
 
   if (!pixels) {
     return std::unexpected {VK_ERROR_UNKNOWN};
   }
 
-  const auto pixel_bytes = width * height * channels;
   const ScopeExit pixels_deleter {[pixels] { stbi_image_free(pixels); }};
 
+  const auto pixel_bytes = static_cast<std::size_t>(image.size.width) *
+                           static_cast<std::size_t>(image.size.height) * 4;
+  image.pixels.assign(pixels, pixels + pixel_bytes);
+
+  return image;
+}
+
+auto upload_vulkan_texture(VkDevice device,
+                           VkQueue queue,
+                           VkCommandPool command_pool,
+                           VmaAllocator allocator,
+                           VkSampler sampler,
+                           const std::filesystem::path& image_path,
+                           const ImageData& image_data,
+                           const RendererOptions& options)
+    -> std::expected<VulkanTexture, VkResult>
+{
+  // Block compressed images are only produced by the OpenGL renderer.
+  if (image_data.format != ImageFormat::kRGBA8) {
+    return std::unexpected {VK_ERROR_FORMAT_NOT_SUPPORTED};
+  }
+
+  const auto pixel_bytes = image_data.pixels.size();
+
   auto staging_buffer = create_vulkan_staging_buffer(allocator, pixel_bytes, 0);
   if (!staging_buffer.has_value()) {
     return std::unexpected {staging_buffer.error()};
   }
 
-  VkFormat format {VK_FORMAT_UNDEFINED};
-  switch (channels) {
-    case STBI_rgb:        format = VK_FORMAT_R8G8B8_UNORM; break;
-    case STBI_rgb_alpha:  format = VK_FORMAT_R8G8B8A8_UNORM; break;
-    case STBI_grey:       [[fallthrough]];
-    case STBI_grey_alpha: [[fallthrough]];
-    default:              return std::unexpected {VK_ERROR_FORMAT_NOT_SUPPORTED};
-  }
+  // Decoded images always use four 8-bit channels.
+  constexpr VkFormat format {VK_FORMAT_R8G8B8A8_UNORM};
 
-  const VkExtent2D image_extent {static_cast<std::uint32_t>(width),
-                                 static_cast<std::uint32_t>(height)};
+  const VkExtent2D image_extent {static_cast<std::uint32_t>(image_data.size.width),
+                                 static_cast<std::uint32_t>(image_data.size.height)};
 
   auto image = create_vulkan_image(
       allocator,
@@ -84,7 +96,7 @@ auto load_vulkan_texture(VkDevice device,
     return std::unexpected {image.error()};
   }
 
-  auto result = set_buffer_data(*staging_buffer, pixels, pixel_bytes);
+  auto result = set_buffer_data(*staging_buffer, image_data.pixels.data(), pixel_bytes);
   if (result != VK_SUCCESS) {
     return std::unexpected {result};
   }
@@ -139,4 +151,28 @@ auto load_vulkan_texture(VkDevice device,
   return texture;
 }
 
+auto load_vulkan_texture(VkDevice device,
+                         VkQueue queue,
+                         VkCommandPool command_pool,
+                         VmaAllocator allocator,
+                         VkSampler sampler,
+                         const std::filesystem::path& image_path,
+                         const RendererOptions& options)
+    -> std::expected<VulkanTexture, VkResult>
+{
+  const auto image = decode_vulkan_image(image_path);
+  if (!image.has_value()) {
+    return std::unexpected {image.error()};
+  }
+
+  return upload_vulkan_texture(device,
+                               queue,
+                               command_pool,
+                               allocator,
+                               sampler,
+                               image_path,
+                               *image,
+                               options);
+}
+
 }  // namespace tactile
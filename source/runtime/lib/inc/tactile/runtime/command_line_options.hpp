@@ -2,10 +2,14 @@
 
 #pragma once
 
-#include <cstdint>   // uint8_t
-#include <format>    // formatter, format_to
-#include <optional>  // optional
+#include <cstddef>     // size_t
+#include <cstdint>     // uint8_t
+#include <filesystem>  // path
+#include <format>      // formatter, format_to
+#include <optional>    // optional
+#include <vector>      // vector
 
+#include "tactile/base/io/save/save_format_id.hpp"
 #include "tactile/base/log/log_level.hpp"
 #include "tactile/base/prelude.hpp"
 #include "tactile/base/render/renderer_options.hpp"
@@ -17,6 +21,7 @@ enum class RendererBackendId : std::uint8_t
 {
   kOpenGL,
   kVulkan,
+  kNull,
 };
 
 struct CommandLineOptions final
@@ -30,6 +35,17 @@ struct CommandLineOptions final
   bool load_tiled_tmj_format;
   bool load_tiled_tmx_format;
   bool load_godot_tscn_format;
+  std::optional<std::filesystem::path> trace_path;
+  bool headless;
+};
+
+struct ConverterOptions final
+{
+  CommandLineOptions runtime_options;
+  SaveFormatId output_format;
+  std::filesystem::path output_dir;
+  std::vector<std::filesystem::path> input_paths;
+  std::size_t worker_count;
 };
 
 [[nodiscard]]
@@ -39,6 +55,13 @@ TACTILE_RUNTIME_API auto get_default_command_line_options() -> CommandLineOption
 TACTILE_RUNTIME_API auto parse_command_line_options(int argc, char* argv[])
     -> std::optional<CommandLineOptions>;
 
+[[nodiscard]]
+TACTILE_RUNTIME_API auto get_default_converter_options() -> ConverterOptions;
+
+[[nodiscard]]
+TACTILE_RUNTIME_API auto parse_converter_options(int argc, char* argv[])
+    -> std::optional<ConverterOptions>;
+
 }  // namespace tactile::runtime
 
 template <>
@@ -60,6 +83,9 @@ struct std::formatter<tactile::runtime::RendererBackendId> final
       case tactile::runtime::RendererBackendId::kVulkan:
         return std::format_to(ctx.out(), "vulkan");
 
+      case tactile::runtime::RendererBackendId::kNull:
+        return std::format_to(ctx.out(), "null");
+
       default: return std::format_to(ctx.out(), "?");
     }
   }
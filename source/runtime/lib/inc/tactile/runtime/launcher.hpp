@@ -18,4 +18,20 @@ namespace tactile::runtime {
  */
 TACTILE_RUNTIME_API auto launch(int argc, char* argv[]) -> int;
 
+/**
+ * Launches the headless map converter.
+ *
+ * \details
+ * The converter loads the save format and compression plugins along with the
+ * null renderer, and converts the specified maps in parallel. No window is
+ * created, so this works without a display server.
+ *
+ * \param argc The number of command-line arguments.
+ * \param argv The command-line arguments.
+ *
+ * \return
+ * \c EXIT_SUCCESS if all maps were converted; \c EXIT_FAILURE otherwise.
+ */
+TACTILE_RUNTIME_API auto launch_converter(int argc, char* argv[]) -> int;
+
 }  // namespace tactile::runtime
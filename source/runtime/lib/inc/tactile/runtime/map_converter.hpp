@@ -0,0 +1,60 @@
+// Copyright (C) 2024 Albin Johansson (GNU General Public License v3.0)
+
+#pragma once
+
+#include <cstddef>     // size_t
+#include <filesystem>  // path
+#include <span>        // span
+
+#include "tactile/base/io/save/save_format_id.hpp"
+#include "tactile/base/prelude.hpp"
+#include "tactile/base/render/renderer.hpp"
+#include "tactile/base/runtime/runtime.hpp"
+#include "tactile/runtime/api.hpp"
+
+namespace tactile::runtime {
+
+/**
+ * Represents a single map file conversion.
+ */
+struct MapConversionJob final
+{
+  /** The path to the source map file, the save format is deduced from the extension. */
+  std::filesystem::path input_path;
+
+  /** The path to the destination map file. */
+  std::filesystem::path output_path;
+
+  /** The save format to use for the destination map file. */
+  SaveFormatId output_format;
+};
+
+/**
+ * Converts a collection of map files using a bounded pool of worker threads.
+ *
+ * \details
+ * Each map is loaded using the installed save formats into a temporary map
+ * document, which is then saved using the requested output save format. Jobs
+ * are distributed dynamically, so that a few large maps don't stall the other
+ * workers. The calling thread participates as one of the workers. Failed jobs
+ * are logged and don't affect other jobs.
+ *
+ * \note
+ * The renderer must support concurrent texture loading, such as the null
+ * renderer.
+ *
+ * \param runtime      The runtime that provides the save formats.
+ * \param renderer     The renderer used to load tileset textures.
+ * \param jobs         The conversions to perform.
+ * \param worker_count The maximum number of threads to use, clamped to [1, job count].
+ *
+ * \return
+ * The number of failed conversions.
+ */
+[[nodiscard]]
+TACTILE_RUNTIME_API auto convert_maps(const IRuntime& runtime,
+                                      IRenderer& renderer,
+                                      std::span<const MapConversionJob> jobs,
+                                      std::size_t worker_count) -> std::size_t;
+
+}  // namespace tactile::runtime
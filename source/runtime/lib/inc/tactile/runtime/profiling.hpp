@@ -0,0 +1,59 @@
+// Copyright (C) 2024 Albin Johansson (GNU General Public License v3.0)
+
+#pragma once
+
+#include "tactile/base/prelude.hpp"
+#include "tactile/runtime/api.hpp"
+
+/**
+ * Records the duration of the enclosing scope as a named profiler zone.
+ *
+ * \details
+ * This is the plugin counterpart of the core \c TACTILE_PROFILE_ZONE macro.
+ * The zone name must be a string literal.
+ */
+#define TACTILE_RUNTIME_PROFILE_ZONE(Name)                 \
+  const tactile::runtime::ProfileZone tactile_profile_zone \
+  {                                                        \
+    (Name)                                                 \
+  }
+
+namespace tactile::runtime {
+namespace internal {
+
+TACTILE_RUNTIME_API void begin_profile_zone(const char* name) noexcept;
+
+TACTILE_RUNTIME_API void end_profile_zone() noexcept;
+
+}  // namespace internal
+
+/**
+ * RAII type used to record a profiler zone using the internal profiler.
+ */
+class ProfileZone final
+{
+ public:
+  TACTILE_DELETE_COPY(ProfileZone);
+  TACTILE_DELETE_MOVE(ProfileZone);
+
+  /**
+   * Begins a profiler zone.
+   *
+   * \param name The name of the zone, must be a string literal.
+   */
+  [[nodiscard]]
+  explicit ProfileZone(const char* name) noexcept
+  {
+    internal::begin_profile_zone(name);
+  }
+
+  /**
+   * Ends the profiler zone.
+   */
+  ~ProfileZone() noexcept
+  {
+    internal::end_profile_zone();
+  }
+};
+
+}  // namespace tactile::runtime
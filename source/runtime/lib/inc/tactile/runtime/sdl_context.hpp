@@ -16,8 +16,13 @@ class TACTILE_RUNTIME_API SDLContext final
   TACTILE_DELETE_COPY(SDLContext);
   TACTILE_DELETE_MOVE(SDLContext);
 
+  /**
+   * Initializes the SDL library.
+   *
+   * \param headless True if the video subsystem should not be initialized.
+   */
   [[nodiscard]]
-  SDLContext();
+  explicit SDLContext(bool headless);
 
   ~SDLContext() noexcept;
 };
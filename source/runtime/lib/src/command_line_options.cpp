@@ -2,10 +2,15 @@
 
 #include "tactile/runtime/command_line_options.hpp"
 
-#include <cstdlib>    // exit, EXIT_SUCCESS
-#include <exception>  // exception
-#include <iostream>   // cout, cerr
-#include <string>     // string
+#include <algorithm>     // max
+#include <charconv>      // from_chars
+#include <cstdlib>       // exit, EXIT_SUCCESS
+#include <exception>     // exception
+#include <iostream>      // cout, cerr
+#include <stdexcept>     // invalid_argument
+#include <string>        // string
+#include <system_error>  // errc
+#include <thread>        // thread
 
 #include <argparse/argparse.hpp>
 
@@ -13,17 +18,19 @@ namespace tactile::runtime {
 namespace {
 
 constexpr const char* kUsageHelpMessage =
-    R"(Usage: tactile [--help] [--version] [--renderer <opengl|vulkan>] [--lang <en|en_GB|se>]
-               [--texture-filter <nearest|linear>] [--mipmaps <on|off>] [--vsync <on|off>]
+    R"(Usage: tactile [--help] [--version] [--renderer <opengl|vulkan|null>]
+               [--lang <en|en_GB|se>] [--texture-filter <nearest|linear>]
+               [--mipmaps <on|off>] [--vsync <on|off>]
                [--limit-fps <on|off>] [--zlib <on|off>] [--zstd <on|off>]
                [--yaml-format <on|off>] [--tiled-tmj-format <on|off>]
                [--tiled-tmx-format <on|off>] [--godot-tscn-format <on|off>]
-               [--vulkan-validation <on|off>] [--log-level <trc|dbg|inf|wrn|err|ftl>]
+               [--texture-compression <on|off>] [--vulkan-validation <on|off>]
+               [--log-level <trc|dbg|inf|wrn|err|ftl>] [--trace <path>]
 
 Options:
   -h, --help           Prints this help message
   -v, --version        Prints the current version
-  -r, --renderer       The renderer backend to use (default: "opengl")
+  -r, --renderer       The renderer backend to use, "null" renders nothing (default: "opengl")
   -l, --lang           The display language (default: "en")
   --texture-filter     The texture filtering mode for loaded textures (default: "nearest")
   --mipmaps            Generate mipmaps for loaded textures (default: "on")
@@ -35,8 +42,61 @@ Options:
   --tiled-tmj-format   Load Tiled TMJ save format plugin (default: "on")
   --tiled-tmx-format   Load Tiled TMX save format plugin (default: "on")
   --godot-tscn-format  Load Godot TSCN save format plugin (default: "on")
+  --texture-compression  Use lossy GPU texture compression, cached on disk (default: "off")
   --vulkan-validation  Load Vulkan validation layers (default: "off")
-  --log-level          The verbosity of log output (default: "inf"))";
+  --log-level          The verbosity of log output (default: "inf")
+  --trace              Save a Chrome trace of the session to the specified file on exit)";
+
+constexpr const char* kConverterUsageHelpMessage =
+    R"(Usage: tactile-convert [--help] [--version] --format <tmx|tmj|yaml|tscn>
+                       [--output <dir>] [--jobs <count>] [--zlib <on|off>] [--zstd <on|off>]
+                       [--log-level <trc|dbg|inf|wrn|err|ftl>] <input>...
+
+Converts map files between save formats without opening any windows.
+
+Positional arguments:
+  input                Map files, or directories that are searched recursively for map files
+
+Options:
+  -h, --help           Prints this help message
+  -v, --version        Prints the current version
+  -f, --format         The save format to convert the maps to
+  -o, --output         The directory in which converted maps are stored (default: ".")
+  -j, --jobs           The maximum number of maps converted in parallel (default: core count)
+  --zlib               Load Zlib compression format plugin (default: "on")
+  --zstd               Load Zstd compression format plugin (default: "on")
+  --log-level          The verbosity of log output (default: "inf")
+
+Maps in subdirectories of input directories keep their relative location in the output
+directory. Godot scenes are saved as "map.tscn" in a directory named after each map.)";
+
+void _add_log_level_argument(argparse::ArgumentParser& parser, LogLevel& log_level)
+{
+  parser.add_argument("--log-level")
+      .nargs(1)
+      .choices("trc", "dbg", "inf", "wrn", "err", "ftl")
+      .default_value("inf")
+      .action([&](const std::string& value) {
+        if (value == "trc") {
+          log_level = LogLevel::kTrace;
+        }
+        else if (value == "dbg") {
+          log_level = LogLevel::kDebug;
+        }
+        else if (value == "inf") {
+          log_level = LogLevel::kInfo;
+        }
+        else if (value == "wrn") {
+          log_level = LogLevel::kWarn;
+        }
+        else if (value == "err") {
+          log_level = LogLevel::kError;
+        }
+        else if (value == "ftl") {
+          log_level = LogLevel::kFatal;
+        }
+      });
+}
 
 void _add_bool_argument(argparse::ArgumentParser& parser,
                         const std::string_view name,
@@ -61,6 +121,7 @@ auto get_default_command_line_options() -> CommandLineOptions
           .use_mipmaps = true,
           .use_vsync = true,
           .limit_fps = false,
+          .use_texture_compression = false,
           .vulkan_validation = false,
         },
     .load_zlib = true,
@@ -69,6 +130,8 @@ auto get_default_command_line_options() -> CommandLineOptions
     .load_tiled_tmj_format = true,
     .load_tiled_tmx_format = true,
     .load_godot_tscn_format = true,
+    .trace_path = std::nullopt,
+    .headless = false,
   };
 }
 
@@ -94,12 +157,15 @@ auto parse_command_line_options(const int argc, char* argv[])
 
   parser.add_argument("-r", "--renderer")
       .nargs(1)
-      .choices("opengl", "vulkan")
+      .choices("opengl", "vulkan", "null")
       .default_value("opengl")
       .action([&](const std::string& value) {
         if (value == "vulkan") {
           options.renderer_backend = RendererBackendId::kVulkan;
         }
+        else if (value == "null") {
+          options.renderer_backend = RendererBackendId::kNull;
+        }
         else {
           options.renderer_backend = RendererBackendId::kOpenGL;
         }
@@ -111,30 +177,7 @@ auto parse_command_line_options(const int argc, char* argv[])
       .choices("en", "en_GB", "se")
       .default_value("en");
 
-  parser.add_argument("--log-level")
-      .nargs(1)
-      .choices("trc", "dbg", "inf", "wrn", "err", "ftl")
-      .default_value("inf")
-      .action([&](const std::string& value) {
-        if (value == "trc") {
-          options.log_level = LogLevel::kTrace;
-        }
-        else if (value == "dbg") {
-          options.log_level = LogLevel::kDebug;
-        }
-        else if (value == "inf") {
-          options.log_level = LogLevel::kInfo;
-        }
-        else if (value == "wrn") {
-          options.log_level = LogLevel::kWarn;
-        }
-        else if (value == "err") {
-          options.log_level = LogLevel::kError;
-        }
-        else if (value == "ftl") {
-          options.log_level = LogLevel::kFatal;
-        }
-      });
+  _add_log_level_argument(parser, options.log_level);
 
   parser.add_argument("--texture-filter")
       .nargs(1)
@@ -158,10 +201,17 @@ auto parse_command_line_options(const int argc, char* argv[])
   _add_bool_argument(parser, "--tiled-tmj-format", options.load_tiled_tmj_format);
   _add_bool_argument(parser, "--tiled-tmx-format", options.load_tiled_tmx_format);
   _add_bool_argument(parser, "--godot-tscn-format", options.load_godot_tscn_format);
+  _add_bool_argument(parser,
+                     "--texture-compression",
+                     options.renderer_options.use_texture_compression);
   _add_bool_argument(parser,
                      "--vulkan-validation",
                      options.renderer_options.vulkan_validation);
 
+  parser.add_argument("--trace").nargs(1).action([&](const std::string& value) {
+    options.trace_path = std::filesystem::path {value};
+  });
+
   try {
     parser.parse_args(argc, argv);
   }
@@ -173,4 +223,96 @@ auto parse_command_line_options(const int argc, char* argv[])
   return options;
 }
 
+auto get_default_converter_options() -> ConverterOptions
+{
+  auto runtime_options = get_default_command_line_options();
+  runtime_options.renderer_backend = RendererBackendId::kNull;
+  runtime_options.renderer_options.use_mipmaps = false;
+  runtime_options.renderer_options.use_vsync = false;
+  runtime_options.headless = true;
+
+  return {
+    .runtime_options = runtime_options,
+    .output_format = SaveFormatId::kTiledTmj,
+    .output_dir = ".",
+    .input_paths = {},
+    .worker_count = std::max(std::thread::hardware_concurrency(), 1u),
+  };
+}
+
+auto parse_converter_options(const int argc, char* argv[]) -> std::optional<ConverterOptions>
+{
+  auto options = get_default_converter_options();
+
+  argparse::ArgumentParser parser {"tactile-convert",
+                                   TACTILE_VERSION_STRING,
+                                   argparse::default_arguments::none};
+  parser.set_assign_chars("=");
+
+  parser.add_argument("-h", "--help").nargs(0).action([](const std::string&) {
+    std::cout << kConverterUsageHelpMessage << '\n';
+    std::exit(EXIT_SUCCESS);
+  });
+
+  parser.add_argument("-v", "--version").nargs(0).action([](const std::string&) {
+    std::cout << TACTILE_VERSION_STRING << '\n';
+    std::exit(EXIT_SUCCESS);
+  });
+
+  parser.add_argument("-f", "--format")
+      .required()
+      .nargs(1)
+      .choices("tmx", "tmj", "yaml", "tscn")
+      .action([&](const std::string& value) {
+        if (value == "tmx") {
+          options.output_format = SaveFormatId::kTiledTmx;
+        }
+        else if (value == "yaml") {
+          options.output_format = SaveFormatId::kTactileYaml;
+        }
+        else if (value == "tscn") {
+          options.output_format = SaveFormatId::kGodotTscn;
+        }
+        else {
+          options.output_format = SaveFormatId::kTiledTmj;
+        }
+      });
+
+  parser.add_argument("-o", "--output").nargs(1).action([&](const std::string& value) {
+    options.output_dir = std::filesystem::path {value};
+  });
+
+  parser.add_argument("-j", "--jobs").nargs(1).action([&](const std::string& value) {
+    std::size_t worker_count {};
+    const auto* value_end = value.data() + value.size();
+
+    const auto [ptr, error] = std::from_chars(value.data(), value_end, worker_count);
+    if (error != std::errc {} || ptr != value_end || worker_count == 0) {
+      throw std::invalid_argument {"--jobs must be a positive integer"};
+    }
+
+    options.worker_count = worker_count;
+  });
+
+  _add_log_level_argument(parser, options.runtime_options.log_level);
+  _add_bool_argument(parser, "--zlib", options.runtime_options.load_zlib);
+  _add_bool_argument(parser, "--zstd", options.runtime_options.load_zstd);
+
+  parser.add_argument("input").nargs(argparse::nargs_pattern::at_least_one);
+
+  try {
+    parser.parse_args(argc, argv);
+
+    for (const auto& input : parser.get<std::vector<std::string>>("input")) {
+      options.input_paths.emplace_back(input);
+    }
+  }
+  catch (const std::exception& error) {
+    std::cerr << "ERROR: " << error.what() << '\n';
+    return std::nullopt;
+  }
+
+  return options;
+}
+
 }  // namespace tactile::runtime
@@ -2,19 +2,28 @@
 
 #include "tactile/runtime/launcher.hpp"
 
-#include <exception>  // exception
-#include <utility>    // move
-#include <vector>     // vector
+#include <exception>     // exception
+#include <filesystem>    // path, recursive_directory_iterator, is_directory
+#include <map>           // map
+#include <span>          // span
+#include <system_error>  // error_code
+#include <tuple>         // ignore
+#include <utility>       // move
+#include <vector>        // vector
 
 #include <imgui.h>
 
 #include "tactile/base/render/renderer.hpp"
+#include "tactile/core/debug/chrome_trace.hpp"
 #include "tactile/core/debug/exception.hpp"
+#include "tactile/core/debug/profiler.hpp"
 #include "tactile/core/engine/engine.hpp"
+#include "tactile/core/io/map_converter.hpp"
 #include "tactile/core/log/logger.hpp"
 #include "tactile/core/tactile_app.hpp"
 #include "tactile/runtime/command_line_options.hpp"
 #include "tactile/runtime/dynamic_library.hpp"
+#include "tactile/runtime/map_converter.hpp"
 #include "tactile/runtime/plugin_instance.hpp"
 #include "tactile/runtime/runtime.hpp"
 
@@ -58,6 +67,10 @@ auto _get_plugin_names(const CommandLineOptions& options) -> std::vector<std::st
     case RendererBackendId::kVulkan:
       plugin_names.emplace_back("tactile-vulkan-renderer" TACTILE_DLL_EXT);
       break;
+
+    case RendererBackendId::kNull:
+      plugin_names.emplace_back("tactile-null-renderer" TACTILE_DLL_EXT);
+      break;
   }
 
   return plugin_names;
@@ -85,6 +98,90 @@ auto _load_plugins(IRuntime& runtime, const CommandLineOptions& options)
   return plugins;
 }
 
+[[nodiscard]]
+auto _get_output_path(const ConverterOptions& options, std::filesystem::path relative_path)
+    -> std::filesystem::path
+{
+  if (options.output_format == SaveFormatId::kGodotTscn) {
+    // The Godot exporter always uses the same file name, so each map gets a directory.
+    return options.output_dir / relative_path.replace_extension() / "map.tscn";
+  }
+
+  relative_path.replace_extension(core::get_save_format_extension(options.output_format));
+  return options.output_dir / relative_path;
+}
+
+[[nodiscard]]
+auto _collect_conversion_jobs(const ConverterOptions& options) -> std::vector<MapConversionJob>
+{
+  std::vector<MapConversionJob> jobs {};
+
+  for (const auto& input_path : options.input_paths) {
+    std::error_code error_code {};
+
+    if (!std::filesystem::is_directory(input_path, error_code)) {
+      jobs.push_back(MapConversionJob {
+        .input_path = input_path,
+        .output_path = _get_output_path(options, input_path.filename()),
+        .output_format = options.output_format,
+      });
+
+      continue;
+    }
+
+    for (const auto& entry : std::filesystem::recursive_directory_iterator {input_path}) {
+      // External tilesets may share extensions with maps, so only maps are queued here.
+      // Explicitly requested files are always converted, so mistakes are reported.
+      if (!entry.is_regular_file() || !core::is_convertible_map_file(entry.path())) {
+        continue;
+      }
+
+      const auto relative_path = entry.path().lexically_relative(input_path);
+      jobs.push_back(MapConversionJob {
+        .input_path = entry.path(),
+        .output_path = _get_output_path(options, relative_path),
+        .output_format = options.output_format,
+      });
+    }
+  }
+
+  return jobs;
+}
+
+/**
+ * Reports conversion jobs that would write to the same output file.
+ *
+ * \details
+ * This happens when maps only differ by their extension, e.g., "foo.json" and
+ * "foo.tmj", or when several input directories contain the same relative path.
+ *
+ * \param jobs The conversion jobs to check.
+ *
+ * \return
+ * True if any jobs share an output path; false otherwise.
+ */
+[[nodiscard]]
+auto _report_output_path_collisions(const std::span<const MapConversionJob> jobs) -> bool
+{
+  std::map<std::filesystem::path, const MapConversionJob*> jobs_by_output_path {};
+  auto found_collision = false;
+
+  for (const auto& job : jobs) {
+    const auto [iter, inserted] =
+        jobs_by_output_path.try_emplace(job.output_path.lexically_normal(), &job);
+
+    if (!inserted) {
+      TACTILE_LOG_ERROR("Both {} and {} would be converted to {}",
+                        iter->second->input_path.string(),
+                        job.input_path.string(),
+                        job.output_path.string());
+      found_collision = true;
+    }
+  }
+
+  return found_collision;
+}
+
 }  // namespace
 
 auto launch(const int argc, char* argv[]) -> int
@@ -122,9 +219,19 @@ auto launch(const int argc, char* argv[]) -> int
 
     core::TactileApp app {&runtime};
 
+    if (options->trace_path.has_value()) {
+      TACTILE_LOG_INFO("Capturing trace to {}", options->trace_path->string());
+      core::start_profiler_capture();
+    }
+
     core::Engine engine {&app, renderer};
     engine.run();
 
+    if (options->trace_path.has_value()) {
+      const auto events = core::stop_profiler_capture();
+      std::ignore = core::save_chrome_trace(*options->trace_path, events);
+    }
+
     return EXIT_SUCCESS;
   }
   catch (const core::Exception& exception) {
@@ -140,4 +247,50 @@ auto launch(const int argc, char* argv[]) -> int
   return EXIT_FAILURE;
 }
 
+auto launch_converter(const int argc, char* argv[]) -> int
+{
+  try {
+    const auto options = parse_converter_options(argc, argv);
+    if (!options.has_value()) {
+      return EXIT_FAILURE;
+    }
+
+    Runtime runtime {options->runtime_options};
+
+    const auto plugins [[maybe_unused]] = _load_plugins(runtime, options->runtime_options);
+
+    auto* renderer = runtime.get_renderer();
+    if (renderer == nullptr) {
+      TACTILE_LOG_ERROR("A renderer has not been installed");
+      return EXIT_FAILURE;
+    }
+
+    const auto jobs = _collect_conversion_jobs(*options);
+    if (jobs.empty()) {
+      TACTILE_LOG_WARN("Found no maps to convert");
+      return EXIT_SUCCESS;
+    }
+
+    if (_report_output_path_collisions(jobs)) {
+      return EXIT_FAILURE;
+    }
+
+    const auto failure_count = convert_maps(runtime, *renderer, jobs, options->worker_count);
+    TACTILE_LOG_INFO("Converted {} of {} maps", jobs.size() - failure_count, jobs.size());
+
+    return failure_count == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+  }
+  catch (const core::Exception& exception) {
+    TACTILE_LOG_FATAL("Unhandled exception: {}\n{}", exception.what(), exception.trace());
+  }
+  catch (const std::exception& exception) {
+    TACTILE_LOG_FATAL("Unhandled exception: {}", exception.what());
+  }
+  catch (...) {
+    TACTILE_LOG_FATAL("Unhandled exception");
+  }
+
+  return EXIT_FAILURE;
+}
+
 }  // namespace tactile::runtime
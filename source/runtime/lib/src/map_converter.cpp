@@ -0,0 +1,94 @@
+// Copyright (C) 2024 Albin Johansson (GNU General Public License v3.0)
+
+#include "tactile/runtime/map_converter.hpp"
+
+#include <algorithm>  // clamp
+#include <atomic>     // atomic, memory_order
+#include <exception>  // exception
+#include <thread>     // jthread
+#include <vector>     // vector
+
+#include "tactile/core/io/map_converter.hpp"
+#include "tactile/core/io/texture_cache.hpp"
+#include "tactile/core/log/logger.hpp"
+
+namespace tactile::runtime {
+namespace {
+
+[[nodiscard]]
+auto _run_job(const IRuntime& runtime,
+              core::TextureCache& texture_cache,
+              const MapConversionJob& job) -> bool
+{
+  try {
+    const core::MapConversionSpec spec {
+      .input_path = job.input_path,
+      .output_path = job.output_path,
+      .output_format = job.output_format,
+    };
+
+    if (core::convert_map(runtime, texture_cache, spec).has_value()) {
+      TACTILE_LOG_INFO("Converted {} to {}",
+                       job.input_path.string(),
+                       job.output_path.string());
+      return true;
+    }
+  }
+  catch (const std::exception& exception) {
+    TACTILE_LOG_ERROR("Could not convert {}: {}", job.input_path.string(), exception.what());
+  }
+  catch (...) {
+    TACTILE_LOG_ERROR("Could not convert {}", job.input_path.string());
+  }
+
+  return false;
+}
+
+}  // namespace
+
+auto convert_maps(const IRuntime& runtime,
+                  IRenderer& renderer,
+                  const std::span<const MapConversionJob> jobs,
+                  const std::size_t worker_count) -> std::size_t
+{
+  if (jobs.empty()) {
+    return 0;
+  }
+
+  const auto thread_count = std::clamp(worker_count, std::size_t {1}, jobs.size());
+  TACTILE_LOG_DEBUG("Converting {} maps using {} threads", jobs.size(), thread_count);
+
+  // Tilesets shared by maps that are converted at the same time are only loaded once.
+  core::TextureCache texture_cache {&renderer};
+
+  std::atomic_size_t next_job_index {0};
+  std::atomic_size_t failure_count {0};
+
+  const auto work = [&] {
+    while (true) {
+      const auto job_index = next_job_index.fetch_add(1, std::memory_order_relaxed);
+      if (job_index >= jobs.size()) {
+        break;
+      }
+
+      if (!_run_job(runtime, texture_cache, jobs[job_index])) {
+        failure_count.fetch_add(1, std::memory_order_relaxed);
+      }
+    }
+  };
+
+  {
+    std::vector<std::jthread> workers {};
+    workers.reserve(thread_count - 1);
+
+    for (std::size_t index = 1; index < thread_count; ++index) {
+      workers.emplace_back(work);
+    }
+
+    work();
+  }
+
+  return failure_count.load();
+}
+
+}  // namespace tactile::runtime
@@ -0,0 +1,19 @@
+// Copyright (C) 2024 Albin Johansson (GNU General Public License v3.0)
+
+#include "tactile/runtime/profiling.hpp"
+
+#include "tactile/core/debug/profiler.hpp"
+
+namespace tactile::runtime::internal {
+
+void begin_profile_zone(const char* name) noexcept
+{
+  core::begin_profile_zone(name);
+}
+
+void end_profile_zone() noexcept
+{
+  core::end_profile_zone();
+}
+
+}  // namespace tactile::runtime::internal
@@ -68,7 +68,10 @@ void _log_command_line_options(const CommandLineOptions& options)
   TACTILE_LOG_TRACE("use_mipmaps: {}", options.renderer_options.use_mipmaps);
   TACTILE_LOG_TRACE("use_vsync: {}", options.renderer_options.use_vsync);
   TACTILE_LOG_TRACE("limit_fps: {}", options.renderer_options.limit_fps);
+  TACTILE_LOG_TRACE("use_texture_compression: {}",
+                    options.renderer_options.use_texture_compression);
   TACTILE_LOG_TRACE("vulkan_validation: {}", options.renderer_options.vulkan_validation);
+  TACTILE_LOG_TRACE("headless: {}", options.headless);
 }
 
 }  // namespace
@@ -81,12 +84,15 @@ struct Runtime::Data final
   core::Logger logger;
   std::optional<Window> window {};
   IRenderer* renderer {};
+  bool headless;
   std::unordered_map<CompressionFormatId, ICompressionFormat*> compression_formats {};
   std::unordered_map<SaveFormatId, ISaveFormat*> save_formats {};
 
   explicit Data(const CommandLineOptions& options)
     : renderer_options {options.renderer_options},
-      logger {_make_logger(options.log_level)}
+      sdl_context {options.headless},
+      logger {_make_logger(options.log_level)},
+      headless {options.headless}
   {
     core::set_default_logger(&logger);
     _log_command_line_options(options);
@@ -115,6 +121,11 @@ Runtime::~Runtime() noexcept = default;
 
 void Runtime::init_window(const std::uint32_t flags)
 {
+  if (mData->headless) {
+    TACTILE_LOG_DEBUG("Skipping window initialization in headless mode");
+    return;
+  }
+
   if (auto window = Window::create(flags)) {
     core::win32_use_immersive_dark_mode(window->get_handle());
     mData->window = std::move(*window);
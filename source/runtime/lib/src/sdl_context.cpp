@@ -9,11 +9,15 @@
 
 namespace tactile::runtime {
 
-SDLContext::SDLContext()
+SDLContext::SDLContext(const bool headless)
 {
-  TACTILE_LOG_TRACE("Initializing SDL library");
+  TACTILE_LOG_TRACE("Initializing SDL library (headless: {})", headless);
 
-  if (SDL_Init(SDL_INIT_TIMER | SDL_INIT_EVENTS | SDL_INIT_VIDEO) != 0) {
+  const auto subsystems =
+      headless ? (SDL_INIT_TIMER | SDL_INIT_EVENTS)
+               : (SDL_INIT_TIMER | SDL_INIT_EVENTS | SDL_INIT_VIDEO);
+
+  if (SDL_Init(subsystems) != 0) {
     TACTILE_LOG_FATAL("Could not initialize SDL: {}", SDL_GetError());
     throw core::Exception {"Could not initialize SDL"};
   }
@@ -0,0 +1,209 @@
+// Copyright (C) 2024 Albin Johansson (GNU General Public License v3.0)
+
+#include "tactile/runtime/map_converter.hpp"
+
+#include <filesystem>  // current_path, create_directories, exists
+#include <optional>    // nullopt
+#include <string>      // to_string
+#include <vector>      // vector
+
+#include <gtest/gtest.h>
+
+#include "tactile/base/io/save/save_format.hpp"
+#include "tactile/null_renderer/null_renderer_plugin.hpp"
+#include "tactile/runtime/command_line_options.hpp"
+#include "tactile/runtime/document_factory.hpp"
+#include "tactile/runtime/runtime.hpp"
+#include "tactile/test_util/ir.hpp"
+#include "tactile/test_util/ir_eq.hpp"
+#include "tactile/test_util/ir_presets.hpp"
+
+#if defined(TACTILE_HAS_TILED_TMX) && defined(TACTILE_HAS_TILED_TMJ)
+  #include "tactile/tiled_tmj/tmj_format_plugin.hpp"
+  #include "tactile/tiled_tmx/tmx_format_plugin.hpp"
+#endif
+
+namespace tactile::runtime {
+namespace {
+
+#if defined(TACTILE_HAS_TILED_TMX) && defined(TACTILE_HAS_TILED_TMJ)
+
+class MapConverterTest : public testing::Test
+{
+ public:
+  void SetUp() override
+  {
+    m_null_renderer_plugin.load(&m_runtime);
+    m_tmx_format_plugin.load(&m_runtime);
+    m_tmj_format_plugin.load(&m_runtime);
+
+    m_renderer = m_runtime.get_renderer();
+    ASSERT_NE(m_renderer, nullptr);
+  }
+
+  void TearDown() override
+  {
+    m_tmj_format_plugin.unload();
+    m_tmx_format_plugin.unload();
+    m_null_renderer_plugin.unload();
+  }
+
+ protected:
+  Runtime m_runtime {_get_command_line_options()};
+  null_renderer::NullRendererPlugin m_null_renderer_plugin {};
+  tiled_tmx::TmxFormatPlugin m_tmx_format_plugin {};
+  TmjFormatPlugin m_tmj_format_plugin {};
+  IRenderer* m_renderer {};
+
+  [[nodiscard]]
+  static auto _get_command_line_options() -> CommandLineOptions
+  {
+    auto options = get_default_converter_options().runtime_options;
+    options.log_level = LogLevel::kTrace;
+    return options;
+  }
+};
+
+// tactile::runtime::convert_maps
+TEST_F(MapConverterTest, ConvertTmxToTmj)
+{
+  const auto* tmx_format = m_runtime.get_save_format(SaveFormatId::kTiledTmx);
+  const auto* tmj_format = m_runtime.get_save_format(SaveFormatId::kTiledTmj);
+  ASSERT_NE(tmx_format, nullptr);
+  ASSERT_NE(tmj_format, nullptr);
+
+  const auto ir_map = test::make_complex_ir_map(ir::TileFormat {
+    .encoding = TileEncoding::kPlainText,
+    .compression = std::nullopt,
+    .compression_level = std::nullopt,
+  });
+
+  const auto map_document = make_map_document(*m_renderer, ir_map);
+  ASSERT_NE(map_document, nullptr);
+
+  const auto map_view = make_map_view(*map_document);
+  ASSERT_NE(map_view, nullptr);
+
+  const auto map_dir = std::filesystem::current_path() / "tests" / "runtime" / "converter";
+  std::filesystem::create_directories(map_dir);
+
+  const auto input_path = map_dir / "input.tmx";
+  map_document->set_path(input_path);
+
+  const SaveFormatWriteOptions write_options {
+    .base_dir = map_dir,
+    .use_external_tilesets = false,
+    .use_indentation = true,
+    .fold_tile_layer_data = false,
+  };
+
+  ASSERT_TRUE(tmx_format->save_map(*map_view, write_options).has_value());
+
+  std::vector<MapConversionJob> jobs {};
+  for (int index = 0; index < 4; ++index) {
+    jobs.push_back(MapConversionJob {
+      .input_path = input_path,
+      .output_path = map_dir / "out" / ("map" + std::to_string(index) + ".tmj"),
+      .output_format = SaveFormatId::kTiledTmj,
+    });
+  }
+
+  jobs.push_back(MapConversionJob {
+    .input_path = map_dir / "missing.tmx",
+    .output_path = map_dir / "out" / "missing.tmj",
+    .output_format = SaveFormatId::kTiledTmj,
+  });
+
+  EXPECT_EQ(convert_maps(m_runtime, *m_renderer, jobs, 3), 1);
+
+  for (const auto& job : jobs) {
+    if (job.input_path != input_path) {
+      EXPECT_FALSE(std::filesystem::exists(job.output_path));
+      continue;
+    }
+
+    const SaveFormatReadOptions read_options {
+      .base_dir = job.output_path.parent_path(),
+      .strict_mode = false,
+    };
+
+    const auto converted_map = tmj_format->load_map(job.output_path, read_options);
+    ASSERT_TRUE(converted_map.has_value()) << "Error: " << to_string(converted_map.error());
+
+    test::expect_eq(ir_map,
+                    *converted_map,
+                    test::kSkipMetadataNameBit | test::kSkipVectorPropertiesBit);
+  }
+}
+
+// tactile::runtime::convert_maps
+TEST_F(MapConverterTest, ConvertMapsInParallel)
+{
+  const auto* tmx_format = m_runtime.get_save_format(SaveFormatId::kTiledTmx);
+  const auto* tmj_format = m_runtime.get_save_format(SaveFormatId::kTiledTmj);
+  ASSERT_NE(tmx_format, nullptr);
+  ASSERT_NE(tmj_format, nullptr);
+
+  const auto ir_map = test::make_complex_ir_map(ir::TileFormat {
+    .encoding = TileEncoding::kPlainText,
+    .compression = std::nullopt,
+    .compression_level = std::nullopt,
+  });
+
+  const auto map_dir = std::filesystem::current_path() / "tests" / "runtime" / "parallel";
+  std::filesystem::create_directories(map_dir);
+
+  const SaveFormatWriteOptions write_options {
+    .base_dir = map_dir,
+    .use_external_tilesets = false,
+    .use_indentation = true,
+    .fold_tile_layer_data = false,
+  };
+
+  // Each input map is a separate document, so documents are created concurrently.
+  std::vector<MapConversionJob> jobs {};
+  for (int index = 0; index < 8; ++index) {
+    const auto input_path = map_dir / ("map" + std::to_string(index) + ".tmx");
+
+    const auto map_document = make_map_document(*m_renderer, ir_map);
+    ASSERT_NE(map_document, nullptr);
+    map_document->set_path(input_path);
+
+    const auto map_view = make_map_view(*map_document);
+    ASSERT_NE(map_view, nullptr);
+    ASSERT_TRUE(tmx_format->save_map(*map_view, write_options).has_value());
+
+    jobs.push_back(MapConversionJob {
+      .input_path = input_path,
+      .output_path = map_dir / "out" / ("map" + std::to_string(index) + ".tmj"),
+      .output_format = SaveFormatId::kTiledTmj,
+    });
+  }
+
+  EXPECT_EQ(convert_maps(m_runtime, *m_renderer, jobs, jobs.size()), 0);
+
+  for (const auto& job : jobs) {
+    const SaveFormatReadOptions read_options {
+      .base_dir = job.output_path.parent_path(),
+      .strict_mode = false,
+    };
+
+    const auto converted_map = tmj_format->load_map(job.output_path, read_options);
+    ASSERT_TRUE(converted_map.has_value()) << "Error: " << to_string(converted_map.error());
+
+    test::expect_eq(ir_map,
+                    *converted_map,
+                    test::kSkipMetadataNameBit | test::kSkipVectorPropertiesBit);
+  }
+}
+
+// tactile::runtime::convert_maps
+TEST_F(MapConverterTest, ConvertNothing)
+{
+  EXPECT_EQ(convert_maps(m_runtime, *m_renderer, {}, 4), 0);
+}
+
+#endif
+
+}  // namespace
+}  // namespace tactile::runtime